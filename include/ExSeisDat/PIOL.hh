@@ -5,10 +5,15 @@
 #ifndef EXSEISDAT_PIOL_HH
 #define EXSEISDAT_PIOL_HH
 
+#include "ExSeisDat/PIOL/BlockCache.hh"
 #include "ExSeisDat/PIOL/CommunicatorInterface.hh"
 #include "ExSeisDat/PIOL/CommunicatorMPI.hh"
+#include "ExSeisDat/PIOL/DataAggregate.hh"
+#include "ExSeisDat/PIOL/DataCache.hh"
 #include "ExSeisDat/PIOL/DataInterface.hh"
 #include "ExSeisDat/PIOL/DataMPIIO.hh"
+#include "ExSeisDat/PIOL/DataMmap.hh"
+#include "ExSeisDat/PIOL/DataPOSIX.hh"
 #include "ExSeisDat/PIOL/ExSeis.hh"
 #include "ExSeisDat/PIOL/ExSeisPIOL.hh"
 #include "ExSeisDat/PIOL/Logger.hh"
@@ -16,12 +21,15 @@
 #include "ExSeisDat/PIOL/Model3dInterface.hh"
 #include "ExSeisDat/PIOL/ObjectInterface.hh"
 #include "ExSeisDat/PIOL/ObjectSEGY.hh"
+#include "ExSeisDat/PIOL/ObjectSU.hh"
 #include "ExSeisDat/PIOL/Param.h"
+#include "ExSeisDat/PIOL/ParamIndex.hh"
 #include "ExSeisDat/PIOL/ReadDirect.hh"
 #include "ExSeisDat/PIOL/ReadInterface.hh"
 #include "ExSeisDat/PIOL/ReadModel.hh"
 #include "ExSeisDat/PIOL/ReadSEGY.hh"
 #include "ExSeisDat/PIOL/ReadSEGYModel.hh"
+#include "ExSeisDat/PIOL/Request.hh"
 #include "ExSeisDat/PIOL/Rule.hh"
 #include "ExSeisDat/PIOL/RuleEntry.hh"
 #include "ExSeisDat/PIOL/SEGYRuleEntry.hh"
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief   A per-process cache of fixed-size file blocks
+/// @details The cache holds blocks of files which are aligned to the block
+///          size, with least recently used eviction once the memory budget is
+///          spent. A single cache can be shared by any number of DataCache
+///          layers, so repeated passes over a file are served from memory.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef EXSEISDAT_PIOL_BLOCKCACHE_HH
+#define EXSEISDAT_PIOL_BLOCKCACHE_HH
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace exseis {
+namespace PIOL {
+
+/*! @brief An LRU cache of aligned file blocks shared by data layers.
+ */
+class BlockCache {
+  public:
+    /*! @brief The block cache options structure.
+     */
+    struct Opt {
+        /// The size in bytes of a block. Blocks start at multiples of it.
+        size_t blockSz;
+
+        /// The most memory in bytes the cached blocks may use
+        size_t budget;
+
+        /// The constructor to set default options
+        Opt(void);
+    };
+
+  private:
+    /// A file and the index of a block within it
+    typedef std::pair<size_t, size_t> Key;
+
+    /// A cached block
+    struct Block {
+        /// The file and block index
+        Key key;
+
+        /// The contents of the block
+        std::vector<unsigned char> d;
+    };
+
+    /// The size in bytes of a block
+    size_t blockSz;
+
+    /// The largest number of blocks held
+    size_t maxBlocks;
+
+    /// The cached blocks, most recently used first
+    std::list<Block> lru;
+
+    /// The position in lru of each cached block
+    std::map<Key, std::list<Block>::iterator> index;
+
+    /// The identity of a file: its device, inode, size and modification
+    /// time in nanoseconds
+    typedef std::tuple<size_t, size_t, size_t, size_t> FileKey;
+
+    /// The id given to each file
+    std::map<FileKey, size_t> files;
+
+    /// The next file id to give out
+    size_t nextId;
+
+    /// The number of block lookups which were found
+    size_t hits;
+
+    /// The number of block lookups which were not found
+    size_t misses;
+
+    /// The number of bytes served from cached blocks
+    size_t saved;
+
+  public:
+    /*! @brief The block cache constructor.
+     *  @param[in] opt The block cache options
+     */
+    BlockCache(const Opt& opt = Opt());
+
+    /*! @brief Get the id used for the blocks of a file. Every data layer
+     *         opened on the same unchanged file shares the same blocks.
+     *  @param[in] name The file name
+     *  @return The id of the file
+     *
+     *  @details The file is identified by its device and inode, together
+     *           with its size and modification time, so a file rewritten
+     *           between opens gets a new id and none of the old blocks. A
+     *           file which cannot be examined gets an id of its own.
+     */
+    size_t fileId(const std::string& name);
+
+    /*! @brief Get the size of a block.
+     *  @return The block size in bytes
+     */
+    size_t getBlockSz(void) const { return blockSz; }
+
+    /*! @brief Get the largest number of blocks held.
+     *  @return The number of blocks which fit in the memory budget
+     */
+    size_t getMaxBlocks(void) const { return maxBlocks; }
+
+    /*! @brief Look up a block, marking it as the most recently used.
+     *  @param[in] file  The file id
+     *  @param[in] block The index of the block in the file
+     *  @return A pointer to the block contents, valid until the next insert
+     *          or erase, or nullptr if the block is not cached.
+     */
+    const unsigned char* find(size_t file, size_t block);
+
+    /*! @brief Add or replace a block, evicting the least recently used blocks
+     *         as needed.
+     *  @param[in] file  The file id
+     *  @param[in] block The index of the block in the file
+     *  @param[in] d     The block contents (size getBlockSz())
+     */
+    void insert(size_t file, size_t block, const unsigned char* d);
+
+    /*! @brief Drop a block if it is cached.
+     *  @param[in] file  The file id
+     *  @param[in] block The index of the block in the file
+     */
+    void erase(size_t file, size_t block);
+
+    /*! @brief Drop every cached block of a file.
+     *  @param[in] file The file id
+     */
+    void eraseFile(size_t file);
+
+    /*! @brief Record bytes which were served from cached blocks.
+     *  @param[in] sz The number of bytes
+     */
+    void countSaved(size_t sz) { saved += sz; }
+
+    /*! @brief Get the number of block lookups which were found.
+     *  @return The number of hits
+     */
+    size_t getHits(void) const { return hits; }
+
+    /*! @brief Get the number of block lookups which were not found.
+     *  @return The number of misses
+     */
+    size_t getMisses(void) const { return misses; }
+
+    /*! @brief Get the number of bytes served from memory instead of storage.
+     *  @return The number of bytes saved
+     */
+    size_t getBytesSaved(void) const { return saved; }
+
+    /*! @brief Get the number of blocks held.
+     *  @return The number of cached blocks
+     */
+    size_t size(void) const { return lru.size(); }
+};
+
+}  // namespace PIOL
+}  // namespace exseis
+
+#endif  // EXSEISDAT_PIOL_BLOCKCACHE_HH
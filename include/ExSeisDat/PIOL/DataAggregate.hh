@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief   A Data layer which aggregates list reads on each node
+/// @details The processes sharing a node send the offsets of their list reads
+///          to one aggregator process on the node. The aggregators read the
+///          union of the blocks through the underlying Data layer and place
+///          them in an MPI shared-memory window, from which every process on
+///          the node copies its blocks. All other operations go straight
+///          through to the underlying Data layer.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef EXSEISDAT_PIOL_DATAAGGREGATE_HH
+#define EXSEISDAT_PIOL_DATAAGGREGATE_HH
+
+#include "ExSeisDat/PIOL/DataInterface.hh"
+#include "ExSeisDat/utils/typedefs.h"
+
+#include <memory>
+#include <mpi.h>
+
+namespace exseis {
+namespace PIOL {
+
+/*! @brief The node aggregating Data class.
+ */
+class DataAggregate : public DataInterface {
+  public:
+    /*! @brief The aggregation options structure.
+     */
+    struct Opt {
+        /// The Type of the class this structure is nested in
+        typedef DataAggregate Type;
+
+        /// The size in bytes of the shared-memory window on each node. Larger
+        /// reads are done in several rounds. The window grows if a single
+        /// block does not fit.
+        size_t windowSz;
+
+        /// The constructor to set default options
+        Opt(void);
+    };
+
+  private:
+    /// The layer all operations go through
+    std::shared_ptr<DataInterface> base;
+
+    /// The processes sharing this node
+    MPI_Comm nodeComm;
+
+    /// The aggregators of every node, or MPI_COMM_NULL on other processes
+    MPI_Comm aggComm;
+
+    /// The rank of this process on its node
+    int nodeRank;
+
+    /// The number of processes on this node
+    int nodeSz;
+
+    /// Whether list reads are aggregated. They are not in FileMode::Write.
+    bool aggregate;
+
+    /// The shared-memory window
+    mutable MPI_Win win;
+
+    /// The start of the window memory of the aggregator
+    mutable unsigned char* window;
+
+    /// The size of the window in bytes
+    mutable size_t winSz;
+
+    /*! @brief The aggregation Init function. It is collective over the
+     *         processes of the PIOL communicator.
+     *  @param[in] opt  The aggregation options
+     *  @param[in] mode The filemode
+     */
+    void Init(const DataAggregate::Opt& opt, FileMode mode);
+
+    /*! @brief Make sure the window holds at least \c sz bytes. It is
+     *         collective over the node and every process must pass the same
+     *         value.
+     *  @param[in] sz The smallest window size in bytes
+     */
+    void reserveWindow(size_t sz) const;
+
+    /*! @brief Free the window, if any.
+     */
+    void freeWindow(void) const;
+
+    /*! @brief Order the window accesses of the processes of the node before
+     *         and after this call. It is collective over the node.
+     */
+    void syncWindow(void) const;
+
+    /*! @brief Log an MPI error if there is one.
+     *  @param[in] err The MPI error code
+     *  @param[in] msg The name of the MPI function
+     */
+    void checkErr(int err, const char* msg) const;
+
+  public:
+    /*! @brief The aggregation class constructor. The underlying layer is
+     *         MPI-IO with default options.
+     *  @param[in] piol_ This PIOL ptr is not modified but is used to
+     *                   instantiate another shared_ptr.
+     *  @param[in] name_ The name of the file associated with the instantiation.
+     *  @param[in] opt   The aggregation options
+     *  @param[in] mode  The filemode
+     */
+    DataAggregate(
+      std::shared_ptr<ExSeisPIOL> piol_,
+      std::string name_,
+      const DataAggregate::Opt& opt,
+      FileMode mode = FileMode::Read);
+
+    /*! @brief The aggregation class constructor for an existing Data layer.
+     *  @param[in] piol_ This PIOL ptr is not modified but is used to
+     *                   instantiate another shared_ptr.
+     *  @param[in] name_ The name of the file associated with the instantiation.
+     *  @param[in] opt   The aggregation options
+     *  @param[in] base_ The layer to pass other operations to
+     *  @param[in] mode  The filemode
+     */
+    DataAggregate(
+      std::shared_ptr<ExSeisPIOL> piol_,
+      std::string name_,
+      const DataAggregate::Opt& opt,
+      std::shared_ptr<DataInterface> base_,
+      FileMode mode = FileMode::Read);
+
+    ~DataAggregate(void);
+
+    /*! @brief Check whether this process does the I/O for its node.
+     *  @return Return true for the aggregator of the node.
+     */
+    bool isAggregator(void) const { return nodeRank == 0; }
+
+    size_t getFileSz() const;
+
+    void setFileSz(size_t sz) const;
+
+    void advise(AccessPattern pattern) const;
+
+    void read(size_t offset, size_t sz, unsigned char* d) const;
+
+    void read(
+      size_t offset, size_t bsz, size_t osz, size_t nb, unsigned char* d) const;
+
+    /*! @brief Read a list of blocks, aggregated on each node. It is
+     *         collective over the PIOL communicator. Processes may use
+     *         different block sizes, in which case the node reads blocks of
+     *         the largest size.
+     *  @param[in]  bsz    The size of a block in bytes
+     *  @param[in]  sz     The number of blocks to read
+     *  @param[in]  offset The list of offsets (size \c sz)
+     *  @param[out] d      The array to store the output in
+     */
+    void read(
+      size_t bsz, size_t sz, const size_t* offset, unsigned char* d) const;
+
+    void write(size_t offset, size_t sz, const unsigned char* d) const;
+
+    bool writeIndependent(
+      size_t offset, size_t sz, const unsigned char* d) const;
+
+    void write(
+      size_t offset,
+      size_t bsz,
+      size_t osz,
+      size_t nb,
+      const unsigned char* d) const;
+
+    void write(
+      size_t bsz,
+      size_t sz,
+      const size_t* offset,
+      const unsigned char* d) const;
+};
+
+}  // namespace PIOL
+}  // namespace exseis
+
+#endif  // EXSEISDAT_PIOL_DATAAGGREGATE_HH
@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief   A caching Data layer which sits on top of another Data layer
+/// @details Reads are served from a BlockCache where possible. Blocks which
+///          are not cached are fetched from the underlying layer with a single
+///          list read per call and kept for later calls. Writes go straight
+///          through to the underlying layer and drop the blocks of the file.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef EXSEISDAT_PIOL_DATACACHE_HH
+#define EXSEISDAT_PIOL_DATACACHE_HH
+
+#include "ExSeisDat/PIOL/BlockCache.hh"
+#include "ExSeisDat/PIOL/DataInterface.hh"
+#include "ExSeisDat/PIOL/DataMPIIO.hh"
+#include "ExSeisDat/utils/typedefs.h"
+
+#include <memory>
+#include <vector>
+
+namespace exseis {
+namespace PIOL {
+
+/*! @brief The caching Data class.
+ *  @details The cache is per process, so blocks written by other processes,
+ *           or by other programs, are not seen once cached. It is intended
+ *           for files which are only read while they are open.
+ */
+class DataCache : public DataInterface {
+  public:
+    /*! @brief The caching options structure.
+     */
+    struct Opt {
+        /// The Type of the class this structure is nested in
+        typedef DataCache Type;
+
+        /// The cache to use. If it is null, the cache of the ExSeisPIOL
+        /// object is used, or failing that a cache private to the file.
+        std::shared_ptr<BlockCache> cache;
+
+        /// The options of the MPI-IO layer underneath
+        DataMPIIO::Opt mpiio;
+
+        /// The constructor to set default options
+        Opt(void);
+    };
+
+  private:
+    /// The layer the blocks are read from and written to
+    std::shared_ptr<DataInterface> base;
+
+    /// The block cache
+    std::shared_ptr<BlockCache> cache;
+
+    /// The id of the file in the cache
+    size_t file;
+
+    /// The size of the file as far as this process knows. Blocks which
+    /// reach past it are not cached, as they were read short.
+    mutable size_t fsz;
+
+    /*! @brief Read a list of equally sized regions of the file through the
+     *         cache. Reads spanning more blocks than the cache holds go
+     *         straight to the underlying layer.
+     *  @param[in]  bsz    The size of each region
+     *  @param[in]  sz     The number of regions
+     *  @param[in]  offset The offset of each region
+     *  @param[out] d      The buffer the regions are stored in, one after
+     *                     another
+     */
+    void readRanges(
+      size_t bsz, size_t sz, const size_t* offset, unsigned char* d) const;
+
+    /*! @brief Drop the cached blocks of the file after it changes.
+     *  @param[in] end The end of the region written
+     */
+    void invalidate(size_t end) const;
+
+  public:
+    /*! @brief The caching class constructor. The underlying layer is MPI-IO
+     *         with the options in \c opt.
+     *  @param[in] piol_ This PIOL ptr is not modified but is used to
+     *                   instantiate another shared_ptr.
+     *  @param[in] name_ The name of the file associated with the instantiation.
+     *  @param[in] opt   The caching options
+     *  @param[in] mode  The filemode
+     */
+    DataCache(
+      std::shared_ptr<ExSeisPIOL> piol_,
+      std::string name_,
+      const DataCache::Opt& opt,
+      FileMode mode = FileMode::Read);
+
+    /*! @brief The caching class constructor for an existing Data layer.
+     *  @param[in] piol_  This PIOL ptr is not modified but is used to
+     *                    instantiate another shared_ptr.
+     *  @param[in] name_  The name of the file associated with the
+     *                    instantiation.
+     *  @param[in] base_  The layer to read and write through
+     *  @param[in] cache_ The block cache
+     */
+    DataCache(
+      std::shared_ptr<ExSeisPIOL> piol_,
+      std::string name_,
+      std::shared_ptr<DataInterface> base_,
+      std::shared_ptr<BlockCache> cache_);
+
+    /*! @brief Get the block cache.
+     *  @return The block cache, which may be shared with other files
+     */
+    std::shared_ptr<BlockCache> getCache(void) const { return cache; }
+
+    size_t getFileSz() const;
+
+    void setFileSz(size_t sz) const;
+
+    void advise(AccessPattern pattern) const;
+
+    const unsigned char* map(size_t offset, size_t sz) const;
+
+    /*! @copydoc DataInterface::read(size_t, size_t, unsigned char*) const
+     *  @details Every read makes exactly one list read of the underlying
+     *           layer, possibly of no blocks, so collective layers stay
+     *           matched across processes with different cache contents.
+     */
+    void read(size_t offset, size_t sz, unsigned char* d) const;
+
+    void read(
+      size_t offset, size_t bsz, size_t osz, size_t nb, unsigned char* d) const;
+
+    void read(
+      size_t bsz, size_t sz, const size_t* offset, unsigned char* d) const;
+
+    void write(size_t offset, size_t sz, const unsigned char* d) const;
+
+    bool writeIndependent(
+      size_t offset, size_t sz, const unsigned char* d) const;
+
+    void write(
+      size_t offset,
+      size_t bsz,
+      size_t osz,
+      size_t nb,
+      const unsigned char* d) const;
+
+    void write(
+      size_t bsz,
+      size_t sz,
+      const size_t* offset,
+      const unsigned char* d) const;
+};
+
+}  // namespace PIOL
+}  // namespace exseis
+
+#endif  // EXSEISDAT_PIOL_DATACACHE_HH
@@ -8,11 +8,42 @@
 #define EXSEISDAT_PIOL_DATAINTERFACE_HH
 
 #include "ExSeisDat/PIOL/ExSeisPIOL.hh"
+#include "ExSeisDat/PIOL/Request.hh"
 #include "ExSeisDat/utils/typedefs.h"
 
 namespace exseis {
 namespace PIOL {
 
+/*! The file modes possible for files.
+ */
+enum class FileMode : size_t {
+    /// Read-only mode
+    Read,
+
+    /// Write-only mode
+    Write,
+
+    /// Read or write
+    ReadWrite,
+
+    /// A test mode
+    Test
+};
+
+/*! The expected pattern of accesses to a file, used as a hint for data layers
+ *  which can make use of it.
+ */
+enum class AccessPattern : size_t {
+    /// No particular pattern
+    Normal,
+
+    /// Accesses will be in increasing order of file offset
+    Sequential,
+
+    /// Accesses will be in no particular order
+    Random
+};
+
 /*! @brief The Data layer interface. Specific data I/O implementations
  *  work off this base class.
  */
@@ -126,6 +157,56 @@ class DataInterface {
     virtual void write(
       size_t offset, size_t sz, const unsigned char* d) const = 0;
 
+    /*! @brief Get a pointer to a region of the file held in memory. Data layers
+     *         which cannot expose the file contents directly return nullptr.
+     *  @param[in] offset The offset in bytes from the start of the file
+     *  @param[in] sz     The size of the region in bytes
+     *  @return A pointer to the file contents at \c offset which is valid for
+     *          \c sz bytes, or nullptr.
+     */
+    virtual const unsigned char* map(size_t offset, size_t sz) const;
+
+    /*! @brief Hint at how the file will be accessed by subsequent calls.
+     *  @param[in] pattern The expected access pattern
+     */
+    virtual void advise(AccessPattern pattern) const;
+
+    /*! @brief Start reading from storage without blocking. Data layers
+     *         without non-blocking I/O complete the read before returning.
+     *  @param[in] offset The offset in bytes from the current internal shared
+     *                    pointer
+     *  @param[in] sz     The amount of data to read from disk
+     *  @param[out] d     The array to store the output in. It must not be
+     *                    accessed until the request has completed.
+     *  @return The request for the pending read.
+     */
+    virtual std::shared_ptr<Request> iread(
+      size_t offset, size_t sz, unsigned char* d) const;
+
+    /*! @brief Start writing to storage without blocking. Data layers without
+     *         non-blocking I/O complete the write before returning.
+     *  @param[in] offset The offset in bytes from the current internal shared
+     *                    pointer
+     *  @param[in] sz     The amount of data to write to disk
+     *  @param[in] d      The array to read data output from. It must not be
+     *                    modified until the request has completed.
+     *  @return The request for the pending write.
+     */
+    virtual std::shared_ptr<Request> iwrite(
+      size_t offset, size_t sz, const unsigned char* d) const;
+
+    /*! @brief Write to storage without other processes taking part, if the
+     *         Data layer can. The default implementation writes nothing.
+     *  @param[in] offset The offset in bytes from the current internal shared
+     *                    pointer
+     *  @param[in] sz     The amount of data to write to disk
+     *  @param[in] d      The array to read data output from
+     *  @return Return true if the data was written, or false if it must be
+     *          written by a call every process makes.
+     */
+    virtual bool writeIndependent(
+      size_t offset, size_t sz, const unsigned char* d) const;
+
     /*! @brief Write data to storage in blocks.
      *  @param[in] offset The offset in bytes from the current internal shared
      *                    pointer
@@ -140,6 +221,84 @@ class DataInterface {
       size_t osz,
       size_t nb,
       const unsigned char* d) const = 0;
+
+    /*! @brief Read contiguous blocks from storage, splitting each block
+     *         between two arrays. The first \c bsz1 bytes of block i go to
+     *         \c d1 + i * \c bsz1 and the remaining \c bsz2 bytes to
+     *         \c d2 + i * \c bsz2. The default stages the blocks in a
+     *         buffer.
+     *  @param[in] offset The offset in bytes from the current internal shared
+     *                    pointer
+     *  @param[in] bsz1   The size in bytes of the first part of a block
+     *  @param[in] bsz2   The size in bytes of the second part of a block
+     *  @param[in] nb     The number of blocks
+     *  @param[out] d1    The array to store the first parts in
+     *  @param[out] d2    The array to store the second parts in
+     */
+    virtual void readSplit(
+      size_t offset,
+      size_t bsz1,
+      size_t bsz2,
+      size_t nb,
+      unsigned char* d1,
+      unsigned char* d2) const;
+
+    /*! @brief Read a list of blocks from storage, splitting each block
+     *         between two arrays as for the contiguous readSplit.
+     *  @param[in] bsz1   The size in bytes of the first part of a block
+     *  @param[in] bsz2   The size in bytes of the second part of a block
+     *  @param[in] sz     The number of blocks to read and so the size of the
+     *                    offset array
+     *  @param[in] offset The list of offsets (in bytes from the current
+     *                    internal shared pointer)
+     *  @param[out] d1    The array to store the first parts in
+     *  @param[out] d2    The array to store the second parts in
+     */
+    virtual void readSplit(
+      size_t bsz1,
+      size_t bsz2,
+      size_t sz,
+      const size_t* offset,
+      unsigned char* d1,
+      unsigned char* d2) const;
+
+    /*! @brief Write contiguous blocks to storage, joining each block from two
+     *         arrays laid out as for readSplit. The default stages the blocks
+     *         in a buffer.
+     *  @param[in] offset The offset in bytes from the current internal shared
+     *                    pointer
+     *  @param[in] bsz1   The size in bytes of the first part of a block
+     *  @param[in] bsz2   The size in bytes of the second part of a block
+     *  @param[in] nb     The number of blocks
+     *  @param[in] d1     The array holding the first parts
+     *  @param[in] d2     The array holding the second parts
+     */
+    virtual void writeSplit(
+      size_t offset,
+      size_t bsz1,
+      size_t bsz2,
+      size_t nb,
+      const unsigned char* d1,
+      const unsigned char* d2) const;
+
+    /*! @brief Write a list of blocks to storage, joining each block from two
+     *         arrays laid out as for readSplit.
+     *  @param[in] bsz1   The size in bytes of the first part of a block
+     *  @param[in] bsz2   The size in bytes of the second part of a block
+     *  @param[in] sz     The number of blocks to write and so the size of the
+     *                    offset array
+     *  @param[in] offset The list of offsets (in bytes from the current
+     *                    internal shared pointer)
+     *  @param[in] d1     The array holding the first parts
+     *  @param[in] d2     The array holding the second parts
+     */
+    virtual void writeSplit(
+      size_t bsz1,
+      size_t bsz2,
+      size_t sz,
+      const size_t* offset,
+      const unsigned char* d1,
+      const unsigned char* d2) const;
 };
 
 }  // namespace PIOL
@@ -9,28 +9,13 @@
 #include "ExSeisDat/PIOL/DataInterface.hh"
 #include "ExSeisDat/utils/typedefs.h"
 
+#include <array>
 #include <functional>
+#include <list>
 
 namespace exseis {
 namespace PIOL {
 
-/*! The file modes possible for files.
- */
-enum class FileMode : size_t {
-    /// Read-only mode
-    Read,
-
-    /// Write-only mode
-    Write,
-
-    /// Read or write
-    ReadWrite,
-
-    /// A test mode
-    Test
-};
-
-
 /*! @brief This templated function pointer type allows us to refer to MPI
  *         functions more compactly.
  */
@@ -58,6 +43,15 @@ class DataMPIIO : public DataInterface {
         /// operation
         size_t maxSize;
 
+        /// The largest hole in bytes between the blocks of a list read which
+        /// is read over and discarded to join the blocks into one extent.
+        /// Only used for independent reads, as collective reads already
+        /// aggregate across holes.
+        size_t maxHole;
+
+        /// The number of strided datatypes to keep committed for reuse
+        size_t typeCacheSz;
+
         /// The MPI communicator to use for file access
         MPI_Comm fcomm;
 
@@ -84,6 +78,78 @@ class DataMPIIO : public DataInterface {
     /// @copydoc DataMPIIO::Opt::maxSize
     size_t maxSize;
 
+    /// @copydoc DataMPIIO::Opt::maxHole
+    size_t maxHole;
+
+    /*! @brief A committed strided datatype and the (block, stride) it was
+     *         created for. The view tiles the datatype, so it serves any
+     *         number of blocks.
+     */
+    struct CachedType {
+        /// The block size and stride of the datatype
+        std::array<size_t, 2> key;
+
+        /// The committed datatype
+        MPI_Datatype type;
+    };
+
+    /// The recently used strided datatypes, most recently used first
+    mutable std::list<CachedType> typeCache;
+
+    /// @copydoc DataMPIIO::Opt::typeCacheSz
+    size_t typeCacheSz;
+
+    /// The number of strided datatypes found in the cache
+    mutable size_t typeHits;
+
+    /// The number of strided datatypes which had to be created
+    mutable size_t typeMisses;
+
+    /// The number of times setting a view was skipped as it was already set
+    mutable size_t viewSkips;
+
+    /// The filetype of the current view. This is MPI_CHAR for the default
+    /// view and MPI_DATATYPE_NULL when it is no longer known.
+    mutable MPI_Datatype viewType;
+
+    /// The displacement of the current view
+    mutable MPI_Offset viewDisp;
+
+    /*! @brief Get a committed strided datatype from the cache, creating it
+     *         and evicting the least recently used one if necessary.
+     *  @param[in] bsz The size of a block in bytes
+     *  @param[in] osz The number of bytes between the start of blocks
+     *  @return The datatype. It is owned by the cache.
+     */
+    MPI_Datatype getStrideType(size_t bsz, size_t osz) const;
+
+    /*! @brief Set the view of the file. This is collective.
+     *  @param[in] disp The displacement of the view in bytes
+     *  @param[in] type The filetype of the view
+     */
+    void setView(MPI_Offset disp, MPI_Datatype type) const;
+
+    /*! @brief Set the view of the file, unless every process already has the
+     *         view it asks for. This is collective.
+     *  @param[in] disp The displacement of the view in bytes
+     *  @param[in] type The filetype of the view
+     */
+    void reuseView(MPI_Offset disp, MPI_Datatype type) const;
+
+    /*! @brief Set a view which makes strided blocks appear contiguous,
+     *         reusing the current view where possible. This is collective.
+     *  @param[in] offset The offset in bytes of the first block
+     *  @param[in] bsz    The size of a block in bytes
+     *  @param[in] osz    The number of bytes between the start of blocks
+     *  @param[in] nb     The number of blocks
+     */
+    void stridedView(size_t offset, size_t bsz, size_t osz, size_t nb) const;
+
+    /*! @brief Restore the default byte view of the file if it was changed.
+     *         This is collective if the view was changed.
+     */
+    void defaultView() const;
+
     /*! Read a file using MPI-IO views. This function does not handle the
      *  integer limit
      *  @param[in] offset The offset in bytes from the current internal shared
@@ -118,6 +184,23 @@ class DataMPIIO : public DataInterface {
      */
     void Init(const DataMPIIO::Opt& opt, FileMode mode);
 
+    /*! @brief Find the largest value over the processes of the file
+     *         communicator, which may be smaller than the PIOL communicator.
+     *  @param[in] val The value of this process
+     *  @return The largest value
+     */
+    size_t maxOverFile(size_t val) const;
+
+    /*! @brief Find how many extra, empty calls this process must make to a
+     *         collective I/O function so that every process makes the same
+     *         number of calls.
+     *  @param[in] calls      The number of calls this process needs to make
+     *  @param[in] collective Whether the calls are collective over the file
+     *                        communicator. If not, no agreement is needed.
+     *  @return The number of extra calls to make.
+     */
+    size_t extraCalls(size_t calls, bool collective) const;
+
     /*! @brief Perform I/O on contiguous or monotonically increasing blocked
      *         data
      *  @param[in] fn The MPI-IO style function to perform the I/O with
@@ -128,6 +211,7 @@ class DataMPIIO : public DataInterface {
      *  @param[in, out] d The array to get the input from or store the output
      *                    in.
      *  @param[in] msg The message to be written if there is an error
+     *  @param[in] collective Whether \c fn must be called by every process
      *  @param[in] bsz The block size in bytes (if not contiguous)
      *  @param[in] osz The stride size in bytes (block start to block start)
      */
@@ -137,9 +221,29 @@ class DataMPIIO : public DataInterface {
       size_t sz,
       unsigned char* d,
       std::string msg,
+      bool collective,
       size_t bsz = 1U,
       size_t osz = 1U) const;
 
+    /*! @brief Start non-blocking I/O on contiguous data.
+     *  @param[in] fn The non-blocking MPI-IO style function to perform the I/O
+     *                with
+     *  @param[in] offset The offset in bytes from the current internal shared
+     *                    pointer
+     *  @param[in] sz The amount of data to transfer. d must be an array with sz
+     *                elements.
+     *  @param[in, out] d The array to get the input from or store the output
+     *                    in.
+     *  @param[in] msg The message to be written if there is an error
+     *  @return The request for the pending operations.
+     */
+    std::shared_ptr<Request> icontigIO(
+      MFp<MPI_Request> fn,
+      size_t offset,
+      size_t sz,
+      unsigned char* d,
+      std::string msg) const;
+
     /*! @brief Perform I/O on blocks of data where each block starts at the
      *         location specified by an array of offsets.
      *  @param[in] fn The MPI-IO style function to perform the I/O with
@@ -150,6 +254,9 @@ class DataMPIIO : public DataInterface {
      *  @param[in, out] d The array to get the input from or store the output
      *                    in.
      *  @param[in] msg The message to be written if there is an error
+     *  @param[in] hole The largest hole in bytes between blocks which is read
+     *                  over. Blocks which are adjacent in the file are always
+     *                  merged.
      */
     void listIO(
       MFp<MPI_Status> fn,
@@ -157,6 +264,33 @@ class DataMPIIO : public DataInterface {
       size_t sz,
       const size_t* offset,
       unsigned char* d,
+      std::string msg,
+      size_t hole) const;
+
+    /*! @brief Perform I/O on blocks which are split between two arrays in
+     *         memory. The memory layout is described with a derived datatype,
+     *         so the blocks are never staged in a buffer.
+     *  @param[in] fn The MPI-IO style function to perform the I/O with
+     *  @param[in] start The offset in bytes of the first block, if the blocks
+     *                   are contiguous
+     *  @param[in] bsz1 The size in bytes of the first part of a block
+     *  @param[in] bsz2 The size in bytes of the second part of a block
+     *  @param[in] sz The number of blocks
+     *  @param[in] offset An array of block offsets in bytes, or nullptr if
+     *                    the blocks are contiguous from \c start
+     *  @param[in, out] d1 The array of first parts
+     *  @param[in, out] d2 The array of second parts
+     *  @param[in] msg The message to be written if there is an error
+     */
+    void splitIO(
+      MFp<MPI_Status> fn,
+      size_t start,
+      size_t bsz1,
+      size_t bsz2,
+      size_t sz,
+      const size_t* offset,
+      unsigned char* d1,
+      unsigned char* d2,
       std::string msg) const;
 
   public:
@@ -194,6 +328,19 @@ class DataMPIIO : public DataInterface {
     /// @return The size of the file
     size_t getFileSz() const;
 
+    /// Get the number of strided datatypes found in the cache
+    /// @return The number of cache hits
+    size_t getTypeCacheHits() const;
+
+    /// Get the number of strided datatypes which had to be created
+    /// @return The number of cache misses
+    size_t getTypeCacheMisses() const;
+
+    /// Get the number of times setting a view was skipped because every
+    /// process already had the view it asked for
+    /// @return The number of skipped view changes
+    size_t getViewSetsSkipped() const;
+
     /// Set the size of the file, either by truncating or expanding it.
     /// @param[in] sz The new size of the file.
     void setFileSz(size_t sz) const;
@@ -214,6 +361,36 @@ class DataMPIIO : public DataInterface {
     ///                    (pointer to array of size \c sz)
     void write(size_t offset, size_t sz, const unsigned char* d) const;
 
+    /// Write a contiguous chunk with MPI_File_write_at, whether or not
+    /// collective operations are in use. Only the default view is set
+    /// independently, so the write is refused while another view is set.
+    /// @param[in]  offset The file offset to start writing at
+    /// @param[in]  sz     The amount to write
+    /// @param[in]  d      The buffer to write from
+    ///                    (pointer to array of size \c sz)
+    /// @return Return true if the data was written.
+    bool writeIndependent(
+      size_t offset, size_t sz, const unsigned char* d) const;
+
+    /// Start reading a contiguous chunk with MPI_File_iread_at, or
+    /// MPI_File_iread_at_all if collective operations are in use.
+    /// @param[in]  offset The file offset to start reading at
+    /// @param[in]  sz     The amount to read
+    /// @param[out] d      The buffer to read into
+    ///                    (pointer to array of size \c sz)
+    /// @return The request for the pending read.
+    std::shared_ptr<Request> iread(
+      size_t offset, size_t sz, unsigned char* d) const;
+
+    /// Start writing a contiguous chunk with MPI_File_iwrite_at, or
+    /// MPI_File_iwrite_at_all if collective operations are in use.
+    /// @param[in]  offset The file offset to start writing at
+    /// @param[in]  sz     The amount to write
+    /// @param[in]  d      The buffer to write from
+    ///                    (pointer to array of size \c sz)
+    /// @return The request for the pending write.
+    std::shared_ptr<Request> iwrite(
+      size_t offset, size_t sz, const unsigned char* d) const;
 
     /// Read a file in regularly spaced, non-contiguous blocks.
     /// @param[in]  offset The position in the file to start reading from
@@ -262,6 +439,38 @@ class DataMPIIO : public DataInterface {
       size_t sz,
       const size_t* offset,
       const unsigned char* d) const;
+
+    void readSplit(
+      size_t offset,
+      size_t bsz1,
+      size_t bsz2,
+      size_t nb,
+      unsigned char* d1,
+      unsigned char* d2) const;
+
+    void readSplit(
+      size_t bsz1,
+      size_t bsz2,
+      size_t sz,
+      const size_t* offset,
+      unsigned char* d1,
+      unsigned char* d2) const;
+
+    void writeSplit(
+      size_t offset,
+      size_t bsz1,
+      size_t bsz2,
+      size_t nb,
+      const unsigned char* d1,
+      const unsigned char* d2) const;
+
+    void writeSplit(
+      size_t bsz1,
+      size_t bsz2,
+      size_t sz,
+      const size_t* offset,
+      const unsigned char* d1,
+      const unsigned char* d2) const;
 };
 
 }  // namespace PIOL
@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief   The memory-mapped implementation of the Data layer interface
+/// @details A read-only data layer which maps the whole file into memory.
+///          Reads are copies out of the page cache and the mapped memory can
+///          be handed directly to the object layer through map().
+////////////////////////////////////////////////////////////////////////////////
+#ifndef EXSEISDAT_PIOL_DATAMMAP_HH
+#define EXSEISDAT_PIOL_DATAMMAP_HH
+
+#include "ExSeisDat/PIOL/DataInterface.hh"
+#include "ExSeisDat/utils/typedefs.h"
+
+namespace exseis {
+namespace PIOL {
+
+/*! @brief The memory-mapped Data class. Only FileMode::Read is supported.
+ */
+class DataMmap : public DataInterface {
+  public:
+    /*! @brief The mmap options structure.
+     */
+    struct Opt {
+        /// The Type of the class this structure is nested in
+        typedef DataMmap Type;
+
+        /// Whether to fault in the whole mapping when the file is opened
+        bool populate;
+
+        /// The constructor to set default options
+        Opt(void);
+    };
+
+  private:
+    /// The POSIX file descriptor
+    int fd;
+
+    /// The start of the mapping, or nullptr if nothing is mapped
+    unsigned char* base;
+
+    /// The size of the file and the mapping
+    size_t fsz;
+
+    /// The last access pattern passed to madvise
+    mutable AccessPattern pattern;
+
+    /*! @brief The mmap Init function.
+     *  @param[in] opt  The mmap options
+     *  @param[in] mode The filemode
+     */
+    void Init(const DataMmap::Opt& opt, FileMode mode);
+
+    /*! @brief Copy a region of the file, truncated at the end of the file.
+     *  @param[in]  offset The file offset to start reading at
+     *  @param[in]  sz     The amount to read
+     *  @param[out] d      The buffer to read into
+     */
+    void copyOut(size_t offset, size_t sz, unsigned char* d) const;
+
+    /*! @brief Log an error for an operation which needs write access.
+     *  @param[in] op The name of the operation
+     */
+    void readOnly(const std::string& op) const;
+
+  public:
+    /*! @brief The mmap class constructor.
+     *  @param[in] piol_ This PIOL ptr is not modified but is used to
+     *                   instantiate another shared_ptr.
+     *  @param[in] name_ The name of the file associated with the instantiation.
+     *  @param[in] opt   The mmap options
+     *  @param[in] mode  The filemode
+     */
+    DataMmap(
+      std::shared_ptr<ExSeisPIOL> piol_,
+      std::string name_,
+      const DataMmap::Opt& opt,
+      FileMode mode = FileMode::Read);
+
+    /*! @brief The mmap class constructor.
+     *  @param[in] piol_ This PIOL ptr is not modified but is used to
+     *                   instantiate another shared_ptr.
+     *  @param[in] name_ The name of the file associated with the instantiation.
+     *  @param[in] mode  The filemode
+     */
+    DataMmap(
+      std::shared_ptr<ExSeisPIOL> piol_,
+      std::string name_,
+      FileMode mode = FileMode::Read);
+
+    ~DataMmap();
+
+    /// Test if the file failed to open
+    /// @return Returns \c true if there is no open file descriptor
+    bool isFileNull() const;
+
+    /// Get the size of the file
+    /// @return The size of the file
+    size_t getFileSz() const;
+
+    /// The file is read-only, so this logs an error.
+    /// @param[in] sz The new size of the file.
+    void setFileSz(size_t sz) const;
+
+    const unsigned char* map(size_t offset, size_t sz) const;
+
+    void advise(AccessPattern pattern) const;
+
+    /// Read a contiguous chunk of size \c sz beginning a position \c offset
+    /// from the file into the buffer \c d.
+    /// @param[in]  offset The file offset to start reading at
+    /// @param[in]  sz     The amount to read
+    /// @param[out] d      The buffer to read into
+    ///                    (pointer to array of size \c sz)
+    void read(size_t offset, size_t sz, unsigned char* d) const;
+
+    /// The file is read-only, so this logs an error.
+    /// @param[in]  offset The file offset to start writing at
+    /// @param[in]  sz     The amount to write
+    /// @param[out] d      The buffer to write from
+    void write(size_t offset, size_t sz, const unsigned char* d) const;
+
+    /// Read a file in regularly spaced, non-contiguous blocks.
+    /// @param[in]  offset The position in the file to start reading from
+    /// @param[in]  bsz    The block size to read in bytes
+    /// @param[in]  osz    The stride size in bytes, i.e. the total size from
+    ///                    the start of one block to the next
+    /// @param[in]  sz     The number of blocks to be read
+    /// @param[out] d      Pointer to the buffer to read the data into
+    ///                    (pointer to array of size \c bsz*sz)
+    void read(
+      size_t offset, size_t bsz, size_t osz, size_t sz, unsigned char* d) const;
+
+    /// The file is read-only, so this logs an error.
+    /// @param[in] offset The position in the file to start writing to
+    /// @param[in] bsz    The block size to write in bytes
+    /// @param[in] osz    The stride size in bytes
+    /// @param[in] nb     The number of blocks to be written
+    /// @param[in] d      Pointer to the buffer to write the data from
+    void write(
+      size_t offset,
+      size_t bsz,
+      size_t osz,
+      size_t nb,
+      const unsigned char* d) const;
+
+    /// Read a file in irregularly spaced, non-contiguous chunks
+    /// @param[in]  bsz    The block size to read in bytes
+    /// @param[in]  sz     The number of blocks to read
+    /// @param[in]  offset Pointer to array of block offsets (size \c sz)
+    /// @param[out] d      Pointer to the buffer to read the data into
+    ///                    (pointer to array of size \c bsz*sz)
+    void read(
+      size_t bsz, size_t sz, const size_t* offset, unsigned char* d) const;
+
+    /// The file is read-only, so this logs an error.
+    /// @param[in]  bsz    The block size to write in bytes
+    /// @param[in]  sz     The number of blocks to write
+    /// @param[in]  offset Pointer to array of block offsets (size \c sz)
+    /// @param[out] d      Pointer to the buffer to write the data from
+    void write(
+      size_t bsz,
+      size_t sz,
+      const size_t* offset,
+      const unsigned char* d) const;
+};
+
+}  // namespace PIOL
+}  // namespace exseis
+
+#endif  // EXSEISDAT_PIOL_DATAMMAP_HH
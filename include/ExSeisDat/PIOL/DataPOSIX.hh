@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief   The POSIX implementation of the Data layer interface
+/// @details POSIX implementation of data layer features such as reading. Each
+///          process opens the file independently and performs all I/O with
+///          pread/pwrite/preadv, so no MPI-IO views are set up per call.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef EXSEISDAT_PIOL_DATAPOSIX_HH
+#define EXSEISDAT_PIOL_DATAPOSIX_HH
+
+#include "ExSeisDat/PIOL/DataInterface.hh"
+#include "ExSeisDat/utils/typedefs.h"
+
+namespace exseis {
+namespace PIOL {
+
+/*! @brief The POSIX Data class.
+ */
+class DataPOSIX : public DataInterface {
+  public:
+    /*! @brief The POSIX options structure.
+     */
+    struct Opt {
+        /// The Type of the class this structure is nested in
+        typedef DataPOSIX Type;
+
+        /// The largest gap in bytes between two blocks which will be read
+        /// over (and discarded) so that both blocks are fetched by a single
+        /// preadv call. Larger gaps start a new call.
+        size_t maxHole;
+
+        /// The constructor to set default options
+        Opt(void);
+    };
+
+  private:
+    /// The POSIX file descriptor
+    int fd;
+
+    /// The mode the file was opened with
+    FileMode mode;
+
+    /// @copydoc DataPOSIX::Opt::maxHole
+    size_t maxHole;
+
+    /*! @brief The POSIX Init function.
+     *  @param[in] opt  The POSIX options
+     *  @param[in] mode The filemode
+     */
+    void Init(const DataPOSIX::Opt& opt, FileMode mode);
+
+  public:
+    /*! @brief The POSIX class constructor.
+     *  @param[in] piol_ This PIOL ptr is not modified but is used to
+     *                   instantiate another shared_ptr.
+     *  @param[in] name_ The name of the file associated with the instantiation.
+     *  @param[in] opt   The POSIX options
+     *  @param[in] mode  The filemode
+     */
+    DataPOSIX(
+      std::shared_ptr<ExSeisPIOL> piol_,
+      std::string name_,
+      const DataPOSIX::Opt& opt,
+      FileMode mode = FileMode::Read);
+
+    /*! @brief The POSIX class constructor.
+     *  @param[in] piol_ This PIOL ptr is not modified but is used to
+     *                   instantiate another shared_ptr.
+     *  @param[in] name_ The name of the file associated with the instantiation.
+     *  @param[in] mode  The filemode
+     */
+    DataPOSIX(
+      std::shared_ptr<ExSeisPIOL> piol_,
+      std::string name_,
+      FileMode mode = FileMode::Read);
+
+    ~DataPOSIX();
+
+    /// Test if the file failed to open
+    /// @return Returns \c true if there is no open file descriptor
+    bool isFileNull() const;
+
+    /// Get the size of the file
+    /// @return The size of the file
+    size_t getFileSz() const;
+
+    /// Set the size of the file, either by truncating or expanding it.
+    /// @param[in] sz The new size of the file.
+    void setFileSz(size_t sz) const;
+
+    /// Read a contiguous chunk of size \c sz beginning a position \c offset
+    /// from the file into the buffer \c d.
+    /// @param[in]  offset The file offset to start reading at
+    /// @param[in]  sz     The amount to read
+    /// @param[out] d      The buffer to read into
+    ///                    (pointer to array of size \c sz)
+    void read(size_t offset, size_t sz, unsigned char* d) const;
+
+    /// Write a contiguous chunk of size \c sz beginning a position \c offset
+    /// from the buffer \c d into the file.
+    /// @param[in]  offset The file offset to start writing at
+    /// @param[in]  sz     The amount to write
+    /// @param[out] d      The buffer to write from
+    ///                    (pointer to array of size \c sz)
+    void write(size_t offset, size_t sz, const unsigned char* d) const;
+
+    /// Write a contiguous chunk with write(). The write is always independent.
+    /// @param[in]  offset The file offset to start writing at
+    /// @param[in]  sz     The amount to write
+    /// @param[in]  d      The buffer to write from
+    ///                    (pointer to array of size \c sz)
+    /// @return Return true.
+    bool writeIndependent(
+      size_t offset, size_t sz, const unsigned char* d) const;
+
+    /// Read a file in regularly spaced, non-contiguous blocks.
+    /// @param[in]  offset The position in the file to start reading from
+    /// @param[in]  bsz    The block size to read in bytes
+    /// @param[in]  osz    The stride size in bytes, i.e. the total size from
+    ///                    the start of one block to the next
+    /// @param[in]  sz     The number of blocks to be read
+    /// @param[out] d      Pointer to the buffer to read the data into
+    ///                    (pointer to array of size \c bsz*sz)
+    void read(
+      size_t offset, size_t bsz, size_t osz, size_t sz, unsigned char* d) const;
+
+    /// Write to a file in regularly spaced, non-contiguous blocks.
+    /// @param[in] offset The position in the file to start writing to
+    /// @param[in] bsz    The block size to write in bytes
+    /// @param[in] osz    The stride size in bytes, i.e. the total size from
+    ///                    the start of one block to the next
+    /// @param[in] nb     The number of blocks to be written
+    /// @param[in] d      Pointer to the buffer to write the data from
+    ///                   (pointer to array of size \c bsz*sz)
+    void write(
+      size_t offset,
+      size_t bsz,
+      size_t osz,
+      size_t nb,
+      const unsigned char* d) const;
+
+    /// Read a file in irregularly spaced, non-contiguous chunks
+    /// @param[in]  bsz    The block size to read in bytes
+    /// @param[in]  sz     The number of blocks to read
+    /// @param[in]  offset Pointer to array of block offsets (size \c sz)
+    /// @param[out] d      Pointer to the buffer to read the data into
+    ///                    (pointer to array of size \c bsz*sz)
+    void read(
+      size_t bsz, size_t sz, const size_t* offset, unsigned char* d) const;
+
+    /// Write to a file in irregularly spaced, non-contiguous chunks
+    /// @param[in]  bsz    The block size to write in bytes
+    /// @param[in]  sz     The number of blocks to write
+    /// @param[in]  offset Pointer to array of block offsets (size \c sz)
+    /// @param[out] d      Pointer to the buffer to write the data from
+    ///                    (pointer to array of size \c bsz*sz)
+    void write(
+      size_t bsz,
+      size_t sz,
+      const size_t* offset,
+      const unsigned char* d) const;
+};
+
+}  // namespace PIOL
+}  // namespace exseis
+
+#endif  // EXSEISDAT_PIOL_DATAPOSIX_HH
@@ -6,6 +6,7 @@
 #ifndef EXSEISDAT_PIOL_EXSEISPIOL_HH
 #define EXSEISDAT_PIOL_EXSEISPIOL_HH
 
+#include "ExSeisDat/PIOL/BlockCache.hh"
 #include "ExSeisDat/PIOL/CommunicatorMPI.hh"
 #include "ExSeisDat/PIOL/Logger.hh"
 #include "ExSeisDat/PIOL/Verbosity.h"
@@ -38,6 +39,14 @@ class ExSeisPIOL {
     /// The ExSeisPIOL communication
     std::unique_ptr<CommunicatorMPI> comm;
 
+    /// The block cache used for files opened for reading with the default
+    /// layers, or null for no caching. Files opened while it is set share it.
+    std::shared_ptr<BlockCache> blockCache;
+
+    /// The number of threads each process uses to convert trace headers and
+    /// samples. It has no effect if the library is built without OpenMP.
+    size_t numThreads;
+
     /*! @brief A function to check if an error has occured in the PIOL. If an
      *         error has occured the log is printed, the object destructor is
      *         called and the code aborts.
@@ -16,7 +16,8 @@ namespace PIOL {
 
 class ObjectInterface;
 
-/*! Make the default object layer object.
+/*! Make the default object layer object. Files with the extension ".su" are
+ *  Seismic Unix files, and any other file is a SEG-Y file.
  * @param[in] piol The piol shared object.
  * @param[in] name The name of the file.
  * @param[in] mode The filemode.
@@ -40,6 +41,9 @@ class ObjectInterface {
     /// Pointer to the Data layer object (polymorphic).
     std::shared_ptr<DataInterface> data_;
 
+    /// The size in bytes of each element of a data-field.
+    size_t sampleSz_;
+
   public:
     /*! @brief The constructor.
      *  @param[in] piol A PIOL object. This PIOL ptr is not modified but is used
@@ -53,7 +57,8 @@ class ObjectInterface {
       std::shared_ptr<DataInterface> data) :
         piol_(piol),
         name_(name),
-        data_(data)
+        data_(data),
+        sampleSz_(sizeof(float))
     {
     }
 
@@ -73,6 +78,23 @@ class ObjectInterface {
     /// @return The stored Data layer object.
     virtual std::shared_ptr<DataInterface> data() { return data_; }
 
+    /*! @brief Set the size of each element of a data-field. It defaults to
+     *         the size of a float.
+     *  @param[in] sz The size in bytes
+     */
+    void setSampleSz(size_t sz) { sampleSz_ = sz; }
+
+    /*! @brief Find out the size of each element of a data-field.
+     *  @return The size in bytes
+     */
+    size_t getSampleSz(void) const { return sampleSz_; }
+
+    /*! @brief Find out the size of the header object at the start of the
+     *         file. The data-objects follow it.
+     *  @return The size in bytes. It defaults to the SEG-Y file header size.
+     */
+    virtual size_t getHOSz() const;
+
     /*! @brief Find out the file size.
      *  @return The file size in bytes.
      */
@@ -83,6 +105,63 @@ class ObjectInterface {
      */
     virtual void setFileSz(size_t sz) const;
 
+    /*! @brief Hint at how the file will be accessed by subsequent calls.
+     *  @param[in] pattern The expected access pattern
+     */
+    virtual void advise(AccessPattern pattern) const;
+
+    /*! @brief Get a pointer to a sequence of data-objects held in memory by
+     *         the Data layer, so they can be decoded without being copied.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-objects in a row.
+     *  @return A pointer to the start of the first data-object, which is
+     *          valid for \c sz data-objects, or nullptr if the data-objects
+     *          are not available in memory.
+     */
+    virtual const unsigned char* mapDO(
+      size_t offset, size_t ns, size_t sz) const;
+
+    /*! @brief Start reading a sequence of data-objects without blocking.
+     *         The default implementation completes the read before returning.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-objects to be read in a row.
+     *  @param[out] d An array which the caller guarantees is long enough for
+     *                the data-objects. It must not be accessed until the
+     *                request has completed.
+     *  @return The request for the pending read.
+     */
+    virtual std::shared_ptr<Request> ireadDO(
+      size_t offset, size_t ns, size_t sz, unsigned char* d) const;
+
+    /*! @brief Start writing a sequence of data-objects without blocking.
+     *         The default implementation completes the write before returning.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-objects to be written in a row.
+     *  @param[in] d An array which the caller guarantees is long enough for
+     *               the data-objects. It must not be modified until the
+     *               request has completed.
+     *  @return The request for the pending write.
+     */
+    virtual std::shared_ptr<Request> iwriteDO(
+      size_t offset, size_t ns, size_t sz, const unsigned char* d) const;
+
+    /*! @brief Write a sequence of data-objects without other processes taking
+     *         part, if the Data layer can. The default implementation writes
+     *         nothing.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-objects to be written in a row.
+     *  @param[in] d An array which the caller guarantees is long enough for
+     *               the data-objects.
+     *  @return Return true if the data-objects were written, or false if they
+     *          must be written by a call every process makes.
+     */
+    virtual bool writeDOIndependent(
+      size_t offset, size_t ns, size_t sz, const unsigned char* d) const;
+
     /*! @brief Read the header object.
      *  @param[out] ho An array which the caller guarantees is long enough
      *                 to hold the header object.
@@ -229,6 +308,193 @@ class ObjectInterface {
       size_t ns,
       size_t sz,
       const unsigned char* df) const = 0;
+
+    /*! @brief Read a sequence of data-objects, placing the metadata and the
+     *         data-fields in separate arrays. The default stages whole
+     *         data-objects in a buffer.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-objects to be read in a row.
+     *  @param[out] md An array which the caller guarantees is long enough for
+     *                 the metadata blocks.
+     *  @param[out] df An array which the caller guarantees is long enough for
+     *                 the data-fields.
+     */
+    virtual void readDO(
+      size_t offset,
+      size_t ns,
+      size_t sz,
+      unsigned char* md,
+      unsigned char* df) const;
+
+    /*! @brief Write a sequence of data-objects from separate arrays of
+     *         metadata and data-fields. The default stages whole data-objects
+     *         in a buffer.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-objects to be written in a row.
+     *  @param[in] md An array which the caller guarantees is long enough for
+     *                the metadata blocks.
+     *  @param[in] df An array which the caller guarantees is long enough for
+     *                the data-fields.
+     */
+    virtual void writeDO(
+      size_t offset,
+      size_t ns,
+      size_t sz,
+      const unsigned char* md,
+      const unsigned char* df) const;
+
+    /*! @brief Read a list of data-objects, placing the metadata and the
+     *         data-fields in separate arrays. The default stages whole
+     *         data-objects in a buffer.
+     *  @param[in] offset An array of the starting data-objects we are
+     *                    interested in
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-objects to be read
+     *  @param[out] md An array which the caller guarantees is long enough for
+     *                 the metadata blocks.
+     *  @param[out] df An array which the caller guarantees is long enough for
+     *                 the data-fields.
+     */
+    virtual void readDO(
+      const size_t* offset,
+      size_t ns,
+      size_t sz,
+      unsigned char* md,
+      unsigned char* df) const;
+
+    /*! @brief Write a list of data-objects from separate arrays of metadata
+     *         and data-fields. The default stages whole data-objects in a
+     *         buffer.
+     *  @param[in] offset An array of the starting data-object we are interested
+     *                    in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-objects to be written.
+     *  @param[in] md An array which the caller guarantees is long enough for
+     *                the metadata blocks.
+     *  @param[in] df An array which the caller guarantees is long enough for
+     *                the data-fields.
+     */
+    virtual void writeDO(
+      const size_t* offset,
+      size_t ns,
+      size_t sz,
+      const unsigned char* md,
+      const unsigned char* df) const;
+
+    /*! @brief Read part of a sequence of DOMDs. The default reads the whole
+     *         DOMDs and copies the part out.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of DOMDs to be read in a row.
+     *  @param[in] skip The first byte of each DOMD to read.
+     *  @param[in] bsz The number of bytes of each DOMD to read.
+     *  @param[out] md An array which the caller guarantees is long enough for
+     *                 \c sz blocks of \c bsz bytes.
+     */
+    virtual void readDOMD(
+      size_t offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      unsigned char* md) const;
+
+    /*! @brief Read part of a list of DOMDs. The default reads the whole DOMDs
+     *         and copies the part out.
+     *  @param[in] offset An array of the starting data-objects we are
+     *                    interested in
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of DOMDs to be read
+     *  @param[in] skip The first byte of each DOMD to read.
+     *  @param[in] bsz The number of bytes of each DOMD to read.
+     *  @param[out] md An array which the caller guarantees is long enough for
+     *                 \c sz blocks of \c bsz bytes.
+     */
+    virtual void readDOMD(
+      const size_t* offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      unsigned char* md) const;
+
+    /*! @brief Read part of a sequence of data-fields. The default reads the
+     *         whole data-fields and copies the part out.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-fields to be read in a row.
+     *  @param[in] skip The first byte of each data-field to read.
+     *  @param[in] bsz The number of bytes of each data-field to read.
+     *  @param[out] df An array which the caller guarantees is long enough for
+     *                 \c sz blocks of \c bsz bytes.
+     */
+    virtual void readDODF(
+      size_t offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      unsigned char* df) const;
+
+    /*! @brief Read part of a list of data-fields. The default reads the whole
+     *         data-fields and copies the part out.
+     *  @param[in] offset An array of the starting data-objects we are
+     *                    interested in
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-fields to be read
+     *  @param[in] skip The first byte of each data-field to read.
+     *  @param[in] bsz The number of bytes of each data-field to read.
+     *  @param[out] df An array which the caller guarantees is long enough for
+     *                 \c sz blocks of \c bsz bytes.
+     */
+    virtual void readDODF(
+      const size_t* offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      unsigned char* df) const;
+
+    /*! @brief Write part of a sequence of data-fields, leaving the rest of
+     *         each data-field as it is. The default reads the whole
+     *         data-fields, updates the part and writes them back, so it needs
+     *         a file which can be read.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-fields to be written in a row.
+     *  @param[in] skip The first byte of each data-field to write.
+     *  @param[in] bsz The number of bytes of each data-field to write.
+     *  @param[in] df An array of \c sz blocks of \c bsz bytes.
+     */
+    virtual void writeDODF(
+      size_t offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      const unsigned char* df) const;
+
+    /*! @brief Write part of a list of data-fields, leaving the rest of each
+     *         data-field as it is. The default reads the whole data-fields,
+     *         updates the part and writes them back, so it needs a file which
+     *         can be read.
+     *  @param[in] offset An array of the starting data-object we are interested
+     *                    in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-fields to be written.
+     *  @param[in] skip The first byte of each data-field to write.
+     *  @param[in] bsz The number of bytes of each data-field to write.
+     *  @param[in] df An array of \c sz blocks of \c bsz bytes.
+     */
+    virtual void writeDODF(
+      const size_t* offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      const unsigned char* df) const;
 };
 
 }  // namespace PIOL
@@ -19,17 +19,118 @@ namespace PIOL {
  */
 class ObjectSEGY : public ObjectInterface {
   public:
-    /*! @brief The SEG-Y options structure. Currently empty.
+    /*! @brief How the DOMD or DODF part of a run of data-objects is read.
+     */
+    enum class ReadStrategy : size_t {
+        /// Choose per call from the size of the holes and measured timings
+        Adaptive,
+        /// Always read through a strided view of the file
+        Strided,
+        /// Always read whole data-objects and extract the part needed
+        Whole
+    };
+
+    /*! @brief The SEG-Y options structure.
      */
     struct Opt {
         /// The Type of the class this structure is nested in
         typedef ObjectSEGY Type;
 
-        /*! @brief Default constructor to prevent intel warnings
-         */
-        Opt(void) {}
+        /// How the DOMD and DODF of contiguous data-objects are read
+        ReadStrategy strategy;
+
+        /// The largest hole in bytes between the wanted parts of neighbouring
+        /// data-objects for which whole data-objects are read. Adaptive reads
+        /// replace it with a value derived from timings.
+        size_t maxHole;
+
+        /// The size in bytes of the staging buffer used for whole reads
+        size_t wholeBufSz;
+
+        /// The constructor to set default options
+        Opt(void);
     };
 
+  private:
+    /// How the DOMD and DODF of contiguous data-objects are read
+    ReadStrategy strategy;
+
+    /// The largest hole for which whole data-objects are read
+    mutable size_t maxHole;
+
+    /// The size in bytes of the staging buffer used for whole reads
+    size_t wholeBufSz;
+
+    /// The measured time in nanoseconds per byte of a whole read,
+    /// or zero if it has not been measured yet
+    mutable double wholeCost;
+
+    /// The measured time in nanoseconds per block of a strided read,
+    /// or zero if it has not been measured yet
+    mutable double stridedCost;
+
+    /// The block size at which stridedCost was measured
+    mutable size_t stridedBsz;
+
+    /*! @brief Get the file offset of a data-object. The data-objects follow
+     *         the header object.
+     *  @param[in] i  The number of the data-object
+     *  @param[in] ns The number of elements per data-field
+     *  @return Return the offset in bytes.
+     */
+    size_t getDOLoc(size_t i, size_t ns) const;
+
+    /*! @brief Get the file offset of the data-field of a data-object.
+     *  @param[in] i  The number of the data-object
+     *  @param[in] ns The number of elements per data-field
+     *  @return Return the offset in bytes.
+     */
+    size_t getDODFLoc(size_t i, size_t ns) const;
+
+    /*! @brief Decide whether to read whole data-objects. The decision only
+     *         depends on state which is identical on every process.
+     *  @param[in] bsz The size of the part of each data-object wanted
+     *  @param[in] osz The size of a data-object
+     *  @return Return true if whole data-objects should be read.
+     */
+    bool useWhole(size_t bsz, size_t osz) const;
+
+    /*! @brief Read part of each of a run of contiguous data-objects,
+     *         choosing between a strided read and reading whole data-objects.
+     *  @param[in]  loc  The file offset of the first data-object
+     *  @param[in]  skip The offset of the wanted part within a data-object
+     *  @param[in]  bsz  The size of the part of each data-object wanted
+     *  @param[in]  osz  The size of a data-object
+     *  @param[in]  sz   The number of data-objects
+     *  @param[out] d    The output buffer (size \c bsz*sz)
+     */
+    void readPart(
+      size_t loc,
+      size_t skip,
+      size_t bsz,
+      size_t osz,
+      size_t sz,
+      unsigned char* d) const;
+
+    /*! @brief Read whole data-objects through a staging buffer and extract
+     *         part of each. The arguments are as for readPart.
+     *  @param[in]  loc  The file offset of the first data-object
+     *  @param[in]  skip The offset of the wanted part within a data-object
+     *  @param[in]  bsz  The size of the part of each data-object wanted
+     *  @param[in]  osz  The size of a data-object
+     *  @param[in]  sz   The number of data-objects
+     *  @param[out] d    The output buffer (size \c bsz*sz)
+     */
+    void readWhole(
+      size_t loc,
+      size_t skip,
+      size_t bsz,
+      size_t osz,
+      size_t sz,
+      unsigned char* d) const;
+
+  public:
+
     /*! @brief The ObjectSEGY class constructor.
      *  @param[in] piol_ This PIOL ptr is not modified but is used to
      *                   instantiate another shared_ptr.
@@ -58,15 +159,44 @@ class ObjectSEGY : public ObjectInterface {
       std::shared_ptr<DataInterface> data_,
       FileMode mode = FileMode::Read);
 
+    /*! @copydoc ObjectInterface::mapDO
+     *  @details The data-objects are laid out as in the file, so the DOMD of
+     *           the ith data-object starts at i*getDOSz(ns) bytes and its
+     *           DODF getMDSz() bytes after that.
+     */
+    const unsigned char* mapDO(size_t offset, size_t ns, size_t sz) const;
+
+    /*! @brief Get the current hole threshold for adaptive reads.
+     *  @return The largest hole in bytes for which whole data-objects are read
+     */
+    size_t getMaxHole(void) const;
+
+    std::shared_ptr<Request> ireadDO(
+      size_t offset, size_t ns, size_t sz, unsigned char* d) const;
+
+    std::shared_ptr<Request> iwriteDO(
+      size_t offset, size_t ns, size_t sz, const unsigned char* d) const;
+
+    bool writeDOIndependent(
+      size_t offset, size_t ns, size_t sz, const unsigned char* d) const;
+
     void readHO(unsigned char* ho) const;
 
     void writeHO(const unsigned char* ho) const;
 
+    /*! @copydoc ObjectInterface::readDOMD
+     *  @details Depending on the ReadStrategy, the headers are read through
+     *           a strided view or whole data-objects are read and the
+     *           headers extracted in memory.
+     */
     void readDOMD(size_t offset, size_t ns, size_t sz, unsigned char* md) const;
 
     void writeDOMD(
       size_t offset, size_t ns, size_t sz, const unsigned char* md) const;
 
+    /*! @copydoc ObjectInterface::readDODF
+     *  @details The read strategy is chosen as for readDOMD.
+     */
     void readDODF(size_t offset, size_t ns, size_t sz, unsigned char* df) const;
 
     void writeDODF(
@@ -95,11 +225,148 @@ class ObjectSEGY : public ObjectInterface {
     void readDODF(
       const size_t* offset, size_t ns, size_t sz, unsigned char* df) const;
 
+    /*! @brief Read part of a sequence of DOMDs. Only the part is
+     *         transferred, with the read strategy chosen as for whole DOMDs.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of DOMDs to be read in a row.
+     *  @param[in] skip The first byte of each DOMD to read.
+     *  @param[in] bsz The number of bytes of each DOMD to read.
+     *  @param[out] md An array which the caller guarantees is long enough for
+     *                 \c sz blocks of \c bsz bytes.
+     */
+    void readDOMD(
+      size_t offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      unsigned char* md) const;
+
+    /*! @brief Read part of a list of DOMDs. Only the part is transferred.
+     *  @param[in] offset An array of the starting data-objects we are
+     *                    interested in
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of DOMDs to be read
+     *  @param[in] skip The first byte of each DOMD to read.
+     *  @param[in] bsz The number of bytes of each DOMD to read.
+     *  @param[out] md An array which the caller guarantees is long enough for
+     *                 \c sz blocks of \c bsz bytes.
+     */
+    void readDOMD(
+      const size_t* offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      unsigned char* md) const;
+
+    /*! @brief Read part of a sequence of data-fields, such as a window of
+     *         samples of each trace. Only the part is transferred, with the
+     *         read strategy chosen as for whole data-fields.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-fields to be read in a row.
+     *  @param[in] skip The first byte of each data-field to read.
+     *  @param[in] bsz The number of bytes of each data-field to read.
+     *  @param[out] df An array which the caller guarantees is long enough for
+     *                 \c sz blocks of \c bsz bytes.
+     */
+    void readDODF(
+      size_t offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      unsigned char* df) const;
+
+    /*! @brief Read part of a list of data-fields. Only the part is
+     *         transferred.
+     *  @param[in] offset An array of the starting data-objects we are
+     *                    interested in
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-fields to be read
+     *  @param[in] skip The first byte of each data-field to read.
+     *  @param[in] bsz The number of bytes of each data-field to read.
+     *  @param[out] df An array which the caller guarantees is long enough for
+     *                 \c sz blocks of \c bsz bytes.
+     */
+    void readDODF(
+      const size_t* offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      unsigned char* df) const;
+
+    /*! @brief Write part of a sequence of data-fields through a strided
+     *         view. The rest of each data-field is not touched.
+     *  @param[in] offset The starting data-object we are interested in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-fields to be written in a row.
+     *  @param[in] skip The first byte of each data-field to write.
+     *  @param[in] bsz The number of bytes of each data-field to write.
+     *  @param[in] df An array of \c sz blocks of \c bsz bytes.
+     */
+    void writeDODF(
+      size_t offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      const unsigned char* df) const;
+
+    /*! @brief Write part of a list of data-fields. The rest of each
+     *         data-field is not touched.
+     *  @param[in] offset An array of the starting data-object we are interested
+     *                    in.
+     *  @param[in] ns The number of elements per data field.
+     *  @param[in] sz The number of data-fields to be written.
+     *  @param[in] skip The first byte of each data-field to write.
+     *  @param[in] bsz The number of bytes of each data-field to write.
+     *  @param[in] df An array of \c sz blocks of \c bsz bytes.
+     */
+    void writeDODF(
+      const size_t* offset,
+      size_t ns,
+      size_t sz,
+      size_t skip,
+      size_t bsz,
+      const unsigned char* df) const;
+
     void writeDODF(
       const size_t* offset,
       size_t ns,
       size_t sz,
       const unsigned char* df) const;
+
+    void readDO(
+      size_t offset,
+      size_t ns,
+      size_t sz,
+      unsigned char* md,
+      unsigned char* df) const;
+
+    void writeDO(
+      size_t offset,
+      size_t ns,
+      size_t sz,
+      const unsigned char* md,
+      const unsigned char* df) const;
+
+    void readDO(
+      const size_t* offset,
+      size_t ns,
+      size_t sz,
+      unsigned char* md,
+      unsigned char* df) const;
+
+    void writeDO(
+      const size_t* offset,
+      size_t ns,
+      size_t sz,
+      const unsigned char* md,
+      const unsigned char* df) const;
 };
 
 }  // namespace PIOL
@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief The Seismic Unix implementation of the Object layer interface
+/// @details Seismic Unix files are SEG-Y files without the file header, in
+///          the byte order of the host.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef EXSEISDAT_PIOL_OBJECTSU_HH
+#define EXSEISDAT_PIOL_OBJECTSU_HH
+
+#include "ExSeisDat/PIOL/ObjectSEGY.hh"
+
+#include <string>
+
+namespace exseis {
+namespace PIOL {
+
+/*! Check whether a file is named as a Seismic Unix file.
+ *  @param[in] name The name of the file.
+ *  @return Return true if the name ends in the extension ".su".
+ */
+bool isSUFile(const std::string& name);
+
+/*! @brief The Seismic Unix Obj class. The data-objects are laid out as in
+ *         SEG-Y, from the start of the file.
+ */
+class ObjectSU : public ObjectSEGY {
+  public:
+    /*! @brief The Seismic Unix options structure. The options are those of
+     *         ObjectSEGY.
+     */
+    struct Opt : public ObjectSEGY::Opt {
+        /// The Type of the class this structure is nested in
+        typedef ObjectSU Type;
+    };
+
+    /*! @brief The ObjectSU class constructor.
+     *  @param[in] piol_ This PIOL ptr is not modified but is used to
+     *                   instantiate another shared_ptr.
+     *  @param[in] name_ The name of the file associated with the instantiation.
+     *  @param[in] opt_  The ObjectSU options
+     *  @param[in] data_ Pointer to the Data layer object (polymorphic).
+     *  @param[in] mode  The file mode
+     */
+    ObjectSU(
+      std::shared_ptr<ExSeisPIOL> piol_,
+      std::string name_,
+      const Opt& opt_,
+      std::shared_ptr<DataInterface> data_,
+      FileMode mode = FileMode::Read);
+
+    /*! @brief The ObjectSU class constructor.
+     *  @param[in] piol_ This PIOL ptr is not modified but is used to
+     *                   instantiate another shared_ptr.
+     *  @param[in] name_ The name of the file associated with the instantiation.
+     *  @param[in] data_ Pointer to the Data layer object (polymorphic).
+     *  @param[in] mode  The file mode
+     */
+    ObjectSU(
+      std::shared_ptr<ExSeisPIOL> piol_,
+      std::string name_,
+      std::shared_ptr<DataInterface> data_,
+      FileMode mode = FileMode::Read);
+
+    /*! @copydoc ObjectInterface::getHOSz
+     *  @details Seismic Unix files have no header object, so this is zero.
+     */
+    size_t getHOSz(void) const;
+};
+
+}  // namespace PIOL
+}  // namespace exseis
+
+#endif  // EXSEISDAT_PIOL_OBJECTSU_HH
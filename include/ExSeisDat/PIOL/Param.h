@@ -33,6 +33,7 @@ typedef struct PIOL_Param PIOL_Param;
 #include "ExSeisDat/PIOL/Rule.hh"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -66,13 +67,73 @@ struct Param {
     /// The number of sets of trace parameters.
     size_t sz;
 
+    /// Whether the header fields are decoded on first access rather than
+    /// when they are read.
+    bool lazy;
+
+    /// Whether the arrays are column-major, holding the values of each
+    /// parameter for every set contiguously, rather than row-major.
+    bool columnar;
+
+    /// Whether floats and longs are held as they are in a SEG-Y header, which
+    /// takes half the memory. Each float is an unscaled 32-bit integer in
+    /// \c fc with one scalar per scalar group in \c fscal, and each long is a
+    /// 32-bit integer in \c ic. \c f and \c i are then empty. The choice is
+    /// taken from the rules.
+    bool compact;
+
+    /// For a compact structure, the unscaled float array.
+    std::vector<int32_t> fc;
+
+    /// For a compact structure, the scalar of each scalar group of floats.
+    std::vector<int16_t> fscal;
+
+    /// For a compact structure, the long array.
+    std::vector<int32_t> ic;
+
+    /// For a compact structure, the number of scalar groups of floats.
+    size_t nscal;
+
+    /// For a compact structure, the scalar group of each float column.
+    std::vector<size_t> fgroup;
+
+    /// For a lazy structure, the raw trace headers read into it. Each holds
+    /// the rule extent.
+    std::vector<unsigned char> raw;
+
+    /// For a lazy structure, whether \c raw holds the header of each set.
+    std::vector<unsigned char> rawSet;
+
+    /// Whether the headers held in \c c and \c raw are big-endian. They
+    /// keep the byte order of the file they were read from.
+    bool is_big_endian;
+
+    /// For a lazy structure, whether each float, long and short column (in
+    /// that order) is still held only in \c raw. A pending column is decoded
+    /// for every set with a raw header the first time it is accessed.
+    mutable std::vector<unsigned char> pending;
+
+    /// The number of pending columns.
+    mutable size_t npending;
+
+
+    /*! Allocate the basic space required to store the arrays and store the
+     *  rules.
+     *  @param[in] r_ The rules which describe the layout of the arrays.
+     *  @param[in] sz The number of sets of trace parameters.
+     *  @param[in] lazy Whether header fields are decoded on first access.
+     */
+    Param(std::shared_ptr<Rule> r_, size_t sz, bool lazy = false);
 
     /*! Allocate the basic space required to store the arrays and store the
      *  rules.
      *  @param[in] r_ The rules which describe the layout of the arrays.
      *  @param[in] sz The number of sets of trace parameters.
+     *  @param[in] lazy Whether header fields are decoded on first access.
+     *  @param[in] columnar Whether the arrays are column-major. The other
+     *                      constructors take this from the rules.
      */
-    Param(std::shared_ptr<Rule> r_, size_t sz);
+    Param(std::shared_ptr<Rule> r_, size_t sz, bool lazy, bool columnar);
 
     /*! Allocate the basic space required to store the arrays and store the
      *  rules. Default rules
@@ -84,6 +145,106 @@ struct Param {
      */
     ~Param();
 
+    /*! Get the position of a value in the array of its type.
+     *  @param[in] i    The set of trace parameters.
+     *  @param[in] num  The column of the value among those of its type.
+     *  @param[in] ncol The number of columns of the type.
+     *  @return Return the position.
+     */
+    size_t getPos(size_t i, size_t num, size_t ncol) const
+    {
+        return (columnar ? sz * num + i : ncol * i + num);
+    }
+
+    /*! Apply a SEG-Y scalar to an unscaled value, as
+     *  SEGY_utils::parse_scalar does.
+     *  @param[in] v    The unscaled value.
+     *  @param[in] scal The SEG-Y scalar.
+     *  @return Return the scaled value.
+     */
+    static exseis::utils::Floating_point scaleValue(int32_t v, int16_t scal)
+    {
+        const exseis::utils::Floating_point scale =
+          (scal > 0 ? exseis::utils::Floating_point(scal) :
+                      (scal < 0 ? 1 / exseis::utils::Floating_point(-scal) :
+                                  exseis::utils::Floating_point(1)));
+        return scale * static_cast<exseis::utils::Floating_point>(v);
+    }
+
+    /*! Get a float parameter, whatever the storage.
+     *  @param[in] j   The set of trace parameters.
+     *  @param[in] num The column of the value among the floats.
+     *  @return Return the value.
+     */
+    exseis::utils::Floating_point getFloat(size_t j, size_t num) const
+    {
+        if (!compact) {
+            return f[getPos(j, num, r->numFloat)];
+        }
+        return scaleValue(
+          fc[getPos(j, num, r->numFloat)],
+          fscal[getPos(j, fgroup[num], nscal)]);
+    }
+
+    /*! Set a float parameter, whatever the storage. For a compact structure
+     *  the scalar of the group is widened if the value needs it, and the
+     *  other floats of the group are rescaled, as when writing a header.
+     *  @param[in] j   The set of trace parameters.
+     *  @param[in] num The column of the value among the floats.
+     *  @param[in] v   The value.
+     */
+    void setFloat(size_t j, size_t num, exseis::utils::Floating_point v);
+
+    /*! Get a long parameter, whatever the storage.
+     *  @param[in] j   The set of trace parameters.
+     *  @param[in] num The column of the value among the longs.
+     *  @return Return the value.
+     */
+    exseis::utils::Integer getLong(size_t j, size_t num) const
+    {
+        return (
+          compact ? exseis::utils::Integer(ic[getPos(j, num, r->numLong)]) :
+                    i[getPos(j, num, r->numLong)]);
+    }
+
+    /*! Set a long parameter, whatever the storage. A compact structure keeps
+     *  the low 32 bits, as a header does.
+     *  @param[in] j   The set of trace parameters.
+     *  @param[in] num The column of the value among the longs.
+     *  @param[in] v   The value.
+     */
+    void setLong(size_t j, size_t num, exseis::utils::Integer v)
+    {
+        if (compact) {
+            ic[getPos(j, num, r->numLong)] = int32_t(v);
+        }
+        else {
+            i[getPos(j, num, r->numLong)] = v;
+        }
+    }
+
+    /*! Get the index in \c pending of a column.
+     *  @param[in] type The type of the column.
+     *  @param[in] num  The column among those of its type.
+     *  @return Return the index, or SIZE_MAX if columns of the type are never
+     *          pending.
+     */
+    size_t getColumn(RuleEntry::MdType type, size_t num) const;
+
+    /*! Decode a pending column of a lazy structure.
+     *  @param[in] m The parameter of the column.
+     *  @details The arrays are logically unchanged by decoding, which is why
+     *           it is allowed on a constant structure. It is not thread safe.
+     */
+    void decode(Meta m) const;
+
+    /*! Decode every pending column of a lazy structure. This must be called
+     *  before the arrays are accessed directly rather than through
+     *  param_utils, and before the structure is read by several threads at
+     *  once, as decoding on first access is not thread safe.
+     */
+    void decode(void) const;
+
     /*! Return the number of sets of trace parameters.
      *  @return Number of sets
      */
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief   A sidecar index of the decoded trace parameters of a file
+/// @details The index is a columnar binary file holding, for every trace of a
+///          data file, the decoded values of a set of trace parameters. It is
+///          keyed by the size and modification time of the data file, built in
+///          parallel the first time parameters are read which it does not
+///          hold, and afterwards lets a header scan read a contiguous column
+///          per parameter instead of every trace header.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef EXSEISDAT_PIOL_PARAMINDEX_HH
+#define EXSEISDAT_PIOL_PARAMINDEX_HH
+
+#include "ExSeisDat/PIOL/DataInterface.hh"
+#include "ExSeisDat/PIOL/ExSeisPIOL.hh"
+#include "ExSeisDat/PIOL/Meta.h"
+#include "ExSeisDat/PIOL/Param.h"
+#include "ExSeisDat/PIOL/RuleEntry.hh"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace exseis {
+namespace PIOL {
+
+class ReadInterface;
+
+/*! @brief A persistent columnar index of the trace parameters of a file.
+ *  @details All member functions are collective over the communicator of the
+ *           PIOL. The index is native to the machine which wrote it, an
+ *           index from a machine with a different byte order or different
+ *           parameter types is rebuilt.
+ */
+class ParamIndex {
+  public:
+    /*! @brief A column of the index: one trace parameter for every trace.
+     */
+    struct Column {
+        /// The parameter held in the column
+        Meta m;
+
+        /// The type of the parameter. Only Long, Short and Float are held.
+        RuleEntry::MdType type;
+
+        /// The location of the parameter in the trace header
+        size_t loc;
+
+        /// For floats, the location of the scalar in the trace header
+        size_t scalLoc;
+
+        /// The byte offset of the column in the index
+        size_t offset;
+    };
+
+  private:
+    /// The PIOL object.
+    std::shared_ptr<ExSeisPIOL> piol_;
+
+    /// The name of the index
+    std::string name_;
+
+    /// The index file, or null if it does not exist yet
+    std::shared_ptr<DataInterface> data_;
+
+    /// Whether \c data_ is open for writing
+    bool writable_;
+
+    /// The modification time of the data file, in nanoseconds since the
+    /// epoch. Zero when it is unknown, in which case the index is not used.
+    size_t mtime_;
+
+    /// The size of the data file
+    size_t fsz_;
+
+    /// The columns held in the index
+    std::vector<Column> col_;
+
+    /// Whether the index on disk matches the data file
+    bool valid_;
+
+    /*! Open the index for writing, creating it if needed. An index opened
+     *  read-only is closed and opened again.
+     */
+    void openWritable(void);
+
+    /*! Load the header of the index and check it against the data file.
+     *  @param[in] nt The number of traces in the data file.
+     */
+    void load(size_t nt);
+
+    /*! Check if every parameter of a rule can be read from the index.
+     *  @param[in] r The rules of the parameter structure, or nullptr if no
+     *               parameters are read.
+     *  @return Return 0 if the index holds every parameter, 1 if it would
+     *          once the missing parameters were added and 2 if it never can.
+     */
+    size_t covers(const Rule* r) const;
+
+    /*! Decode the given parameters from every trace of the data file and write
+     *  them as the new index.
+     *  @param[in] file The data file.
+     *  @param[in] col  The columns to build. Their offsets are set here.
+     */
+    void build(const ReadInterface& file, std::vector<Column> col);
+
+    /*! Add the parameters of a rule which every process needs to the index.
+     *  @param[in] file The data file.
+     *  @param[in] r    The local rules, or nullptr.
+     */
+    void extend(const ReadInterface& file, const Rule* r);
+
+    /*! Make the index usable for a read, building it if needed.
+     *  @param[in] file The data file.
+     *  @param[in] prm  The parameter structure to read into.
+     *  @return Return true if every process can read from the index.
+     */
+    bool prepare(const ReadInterface& file, const Param* prm);
+
+    /*! Read the parameters of a list of traces from the index.
+     *  @param[in]  sz     The number of traces.
+     *  @param[in]  offunc A function which given the ith trace of the local
+     *                     process, returns the associated trace offset.
+     *  @param[in]  contig Whether the traces are contiguous.
+     *  @param[out] prm    The parameter structure.
+     *  @param[in]  skip   Skip \c skip entries in the parameter structure.
+     */
+    void fetch(
+      size_t sz,
+      std::function<size_t(size_t)> offunc,
+      bool contig,
+      Param* prm,
+      size_t skip) const;
+
+  public:
+    /*! @brief Open the index of a data file.
+     *  @param[in] piol The PIOL object.
+     *  @param[in] name The name of the index.
+     *  @param[in] file The name of the data file.
+     *  @param[in] fsz  The size of the data file.
+     *  @param[in] nt   The number of traces in the data file.
+     */
+    ParamIndex(
+      std::shared_ptr<ExSeisPIOL> piol,
+      std::string name,
+      const std::string& file,
+      size_t fsz,
+      size_t nt);
+
+    /*! @brief Read the parameters of traces from offset to offset+sz.
+     *  @param[in]  file   The data file the index belongs to.
+     *  @param[in]  offset The starting trace number.
+     *  @param[in]  sz     The number of traces to process.
+     *  @param[out] prm    The parameter structure.
+     *  @param[in]  skip   Skip \c skip entries in the parameter structure.
+     *  @return Return false if the parameters can not be read from the
+     *          index on some process, in which case nothing was read.
+     */
+    bool readParam(
+      const ReadInterface& file,
+      size_t offset,
+      size_t sz,
+      Param* prm,
+      size_t skip = 0);
+
+    /*! @brief Read the parameters of the traces in a list.
+     *  @param[in]  file   The data file the index belongs to.
+     *  @param[in]  sz     The number of traces to process.
+     *  @param[in]  offset The trace numbers.
+     *  @param[out] prm    The parameter structure.
+     *  @param[in]  skip   Skip \c skip entries in the parameter structure.
+     *  @return Return false if the parameters can not be read from the
+     *          index on some process, in which case nothing was read.
+     */
+    bool readParamNonContiguous(
+      const ReadInterface& file,
+      size_t sz,
+      const size_t* offset,
+      Param* prm,
+      size_t skip = 0);
+
+    /*! @brief Check if the index matches the data file.
+     *  @return Return true if the index was built for the data file as it is.
+     */
+    bool isValid(void) const { return valid_; }
+
+    /*! @brief Get the columns held in the index.
+     *  @return Return the columns, or none if the index is not valid.
+     */
+    const std::vector<Column>& getColumns(void) const { return col_; }
+};
+
+}  // namespace PIOL
+}  // namespace exseis
+
+#endif  // EXSEISDAT_PIOL_PARAMINDEX_HH
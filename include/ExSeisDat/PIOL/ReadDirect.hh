@@ -68,7 +68,8 @@ class ReadDirect {
         }
     }
 
-    /*! Constructor without options.
+    /*! Constructor without options. The object layer is chosen by
+     *  makeDefaultObj from the name of the file.
      *  @param[in] piol This PIOL ptr is not modified but is used to instantiate
      *                  another shared_ptr.
      *  @param[in] name The name of the file associated with the instantiation.
@@ -179,6 +180,61 @@ class ReadDirect {
      */
     void readParamNonContiguous(
       size_t sz, const size_t* offset, Param* prm) const;
+
+    /*! @brief Read samples s0 to s0+n of the traces from offset to offset+sz.
+     *  @param[in]  offset The starting trace number.
+     *  @param[in]  sz     The number of traces to process
+     *  @param[in]  s0     The first sample of the window.
+     *  @param[in]  n      The number of samples in the window.
+     *  @param[out] trace  A contiguous array of the window of each trace
+     *                     (size sz*n*sizeof(exseis::utils::Trace_value))
+     *  @param[out] prm    The parameter structure
+     */
+    void readTraceWindow(
+      size_t offset,
+      size_t sz,
+      size_t s0,
+      size_t n,
+      exseis::utils::Trace_value* trace,
+      Param* prm = PIOL_PARAM_NULL) const;
+
+    /*! @brief Read samples s0 to s0+n of the traces specified by the offsets
+     *         in the passed offset array. The offsets should be in ascending
+     *         order, i.e. offset[i] < offset[i+1].
+     *  @param[in]  sz     The number of traces to process
+     *  @param[in]  offset An array of trace numbers to read.
+     *  @param[in]  s0     The first sample of the window.
+     *  @param[in]  n      The number of samples in the window.
+     *  @param[out] trace  A contiguous array of the window of each trace
+     *                     (size sz*n*sizeof(exseis::utils::Trace_value))
+     *  @param[out] prm    The parameter structure
+     */
+    void readTraceWindowNonContiguous(
+      size_t sz,
+      const size_t* offset,
+      size_t s0,
+      size_t n,
+      exseis::utils::Trace_value* trace,
+      Param* prm = PIOL_PARAM_NULL) const;
+
+    /*! @brief Read samples s0 to s0+n of the traces specified by the offsets
+     *         in the passed offset array. The offset array need not be in any
+     *         order.
+     *  @param[in]  sz     The number of traces to process
+     *  @param[in]  offset An array of trace numbers to read.
+     *  @param[in]  s0     The first sample of the window.
+     *  @param[in]  n      The number of samples in the window.
+     *  @param[out] trace  A contiguous array of the window of each trace
+     *                     (size sz*n*sizeof(exseis::utils::Trace_value))
+     *  @param[out] prm    The parameter structure
+     */
+    void readTraceWindowNonMonotonic(
+      size_t sz,
+      const size_t* offset,
+      size_t s0,
+      size_t n,
+      exseis::utils::Trace_value* trace,
+      Param* prm = PIOL_PARAM_NULL) const;
 };
 
 }  // namespace PIOL
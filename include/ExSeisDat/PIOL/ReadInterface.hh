@@ -10,6 +10,7 @@
 #include "ExSeisDat/PIOL/ExSeisPIOL.hh"
 #include "ExSeisDat/PIOL/ObjectInterface.hh"
 #include "ExSeisDat/PIOL/Param.h"
+#include "ExSeisDat/PIOL/ParamIndex.hh"
 
 #include <memory>
 
@@ -45,6 +46,18 @@ class ReadInterface {
     /// The increment between samples in a trace
     exseis::utils::Floating_point inc = 0;
 
+    /// The sidecar index of the trace parameters, or nullptr if the
+    /// parameters are always read from the trace headers.
+    std::shared_ptr<ParamIndex> index;
+
+    /*! @brief Check a window of samples lies within the traces, logging an
+     *         error if it does not.
+     *  @param[in] s0 The first sample of the window.
+     *  @param[in] n  The number of samples in the window.
+     *  @return Return true if samples s0 to s0+n exist in each trace.
+     */
+    bool checkWindow(size_t s0, size_t n) const;
+
   public:
     /*! @brief The constructor.
      *  @param[in] piol_ This PIOL ptr is not modified but is used to
@@ -97,6 +110,9 @@ class ReadInterface {
      *  @param[in] prm An array of the parameter structures
      *                 (size sizeof(Param)*sz)
      *  @param[in] skip When reading, skip the first "skip" entries of prm
+     *
+     *  @details The parameters are read from the sidecar index when there is
+     *           one which holds them.
      */
     void readParam(size_t offset, size_t sz, Param* prm, size_t skip = 0) const;
 
@@ -106,6 +122,9 @@ class ReadInterface {
      *  @param[in] offset An array of trace numbers to read.
      *  @param[out] prm A parameter structure
      *  @param[in] skip When reading, skip the first "skip" entries of prm
+     *
+     *  @details The parameters are read from the sidecar index when there is
+     *           one which holds them.
      */
     void readParamNonContiguous(
       size_t sz, const size_t* offset, Param* prm, size_t skip = 0) const;
@@ -125,6 +144,31 @@ class ReadInterface {
       Param* prm  = PIOL_PARAM_NULL,
       size_t skip = 0) const = 0;
 
+    /*! @brief Start reading the traces from offset to offset+sz without
+     *         blocking. The traces and parameters are converted to the host
+     *         format when the request completes. The default implementation
+     *         completes the read before returning.
+     *  @param[in] offset The starting trace number.
+     *  @param[in] sz The number of traces to process.
+     *  @param[out] trace The array of traces to fill from the file. It must
+     *                    not be accessed until the request has completed.
+     *  @param[out] prm A contiguous array of the parameter structures
+     *                  (size sizeof(Param)*sz). It must not be accessed until
+     *                  the request has completed.
+     *  @param[in] skip When reading, skip the first "skip" entries of prm
+     *  @return The request for the pending read.
+     *
+     *  @details No other I/O may be started on the same file until the
+     *           request has completed, as it may change the MPI-IO file view
+     *           the pending read depends on.
+     */
+    virtual std::shared_ptr<Request> ireadTrace(
+      size_t offset,
+      size_t sz,
+      exseis::utils::Trace_value* trace,
+      Param* prm  = PIOL_PARAM_NULL,
+      size_t skip = 0) const;
+
     /*! @brief Read the traces specified by the offsets in the passed offset
      *         array. Assumes Monotonic.
      *  @param[in] sz The number of traces to process
@@ -161,6 +205,78 @@ class ReadInterface {
       exseis::utils::Trace_value* trace,
       Param* prm  = PIOL_PARAM_NULL,
       size_t skip = 0) const = 0;
+
+    /*! @brief Read samples s0 to s0+n of the traces from offset to
+     *         offset+sz. The default implementation reads the whole traces
+     *         and copies the window out.
+     *  @param[in] offset The starting trace number.
+     *  @param[in] sz The number of traces to process.
+     *  @param[in] s0 The first sample of the window.
+     *  @param[in] n The number of samples in the window.
+     *  @param[out] trace A contiguous array of the window of each trace
+     *                    (size sz*n*sizeof(exseis::utils::Trace_value))
+     *  @param[out] prm A contiguous array of the parameter structures
+     *                  (size sizeof(Param)*sz)
+     *  @param[in] skip When reading, skip the first "skip" entries of prm
+     *
+     *  @details If the window does not lie within the traces an error is
+     *           logged and nothing is read, though the call is still made
+     *           collectively.
+     */
+    virtual void readTraceWindow(
+      size_t offset,
+      size_t sz,
+      size_t s0,
+      size_t n,
+      exseis::utils::Trace_value* trace,
+      Param* prm  = PIOL_PARAM_NULL,
+      size_t skip = 0) const;
+
+    /*! @brief Read samples s0 to s0+n of the traces specified by the offsets
+     *         in the passed offset array. Assumes Monotonic. The default
+     *         implementation reads the whole traces and copies the window
+     *         out.
+     *  @param[in] sz The number of traces to process
+     *  @param[in] offset An array of trace numbers to read (monotonic list).
+     *  @param[in] s0 The first sample of the window.
+     *  @param[in] n The number of samples in the window.
+     *  @param[out] trace A contiguous array of the window of each trace
+     *                    (size sz*n*sizeof(exseis::utils::Trace_value))
+     *  @param[out] prm A parameter structure
+     *  @param[in] skip When reading, skip the first "skip" entries of prm
+     */
+    virtual void readTraceWindowNonContiguous(
+      size_t sz,
+      const size_t* offset,
+      size_t s0,
+      size_t n,
+      exseis::utils::Trace_value* trace,
+      Param* prm  = PIOL_PARAM_NULL,
+      size_t skip = 0) const;
+
+    /*! @brief Read samples s0 to s0+n of the traces specified by the offsets
+     *         in the passed offset array. Does not assume monotonic.
+     *  @param[in] sz The number of traces to process
+     *  @param[in] offset An array of trace numbers to read
+     *                    (non-monotonic list).
+     *  @param[in] s0 The first sample of the window.
+     *  @param[in] n The number of samples in the window.
+     *  @param[out] trace A contiguous array of the window of each trace
+     *                    (size sz*n*sizeof(exseis::utils::Trace_value))
+     *  @param[out] prm A parameter structure
+     *  @param[in] skip When reading, skip the first "skip" entries of prm
+     *
+     *  @details The offsets are sorted and read once each with
+     *           readTraceWindowNonContiguous.
+     */
+    virtual void readTraceWindowNonMonotonic(
+      size_t sz,
+      const size_t* offset,
+      size_t s0,
+      size_t n,
+      exseis::utils::Trace_value* trace,
+      Param* prm  = PIOL_PARAM_NULL,
+      size_t skip = 0) const;
 };
 
 }  // namespace PIOL
@@ -9,6 +9,7 @@
 #include "ExSeisDat/PIOL/segy_utils.hh"
 
 #include <cstdint>
+#include <string>
 
 
 namespace exseis {
@@ -28,16 +29,26 @@ class ReadSEGY : public ReadInterface {
         /// standard definition)
         double incFactor;
 
+        /// The name of the sidecar index of the trace parameters. No index is
+        /// used if it is empty (the default).
+        std::string index;
+
         /*! Constructor which provides the default Rules
          */
         Opt(void);
     };
 
-  private:
+  protected:
     /// Type formats
     SEGY_utils::SEGYNumberFormat number_format =
       SEGY_utils::SEGYNumberFormat::IEEE;
 
+    /// Whether the file is big-endian. Little-endian SEG-Y files are marked
+    /// with the SEG-Y rev 2 byte order marker, and files without a file
+    /// header are in the byte order of the host.
+    bool is_big_endian = true;
+
+  private:
     /// The increment factor
     double incFactor;
 
@@ -77,6 +88,17 @@ class ReadSEGY : public ReadInterface {
       Param* prm  = PIOL_PARAM_NULL,
       size_t skip = 0) const;
 
+    /*! @copydoc ReadInterface::ireadTrace
+     *  @details The data-objects are read whole into a staging buffer and
+     *           decoded when the request completes.
+     */
+    std::shared_ptr<Request> ireadTrace(
+      size_t offset,
+      size_t sz,
+      exseis::utils::Trace_value* trace,
+      Param* prm  = PIOL_PARAM_NULL,
+      size_t skip = 0) const;
+
     void readTraceNonContiguous(
       size_t sz,
       const size_t* offset,
@@ -90,6 +112,33 @@ class ReadSEGY : public ReadInterface {
       exseis::utils::Trace_value* trace,
       Param* prm  = PIOL_PARAM_NULL,
       size_t skip = 0) const;
+
+    /*! @copydoc ReadInterface::readTraceWindow
+     *  @details Only the window of each trace is transferred, through a
+     *           strided view of the file. The parameters are read as by
+     *           readParam.
+     */
+    void readTraceWindow(
+      size_t offset,
+      size_t sz,
+      size_t s0,
+      size_t n,
+      exseis::utils::Trace_value* trace,
+      Param* prm  = PIOL_PARAM_NULL,
+      size_t skip = 0) const;
+
+    /*! @copydoc ReadInterface::readTraceWindowNonContiguous
+     *  @details Only the window of each trace is transferred. The parameters
+     *           are read as by readParamNonContiguous.
+     */
+    void readTraceWindowNonContiguous(
+      size_t sz,
+      const size_t* offset,
+      size_t s0,
+      size_t n,
+      exseis::utils::Trace_value* trace,
+      Param* prm  = PIOL_PARAM_NULL,
+      size_t skip = 0) const;
 };
 
 }  // namespace PIOL
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief   Handles for non-blocking I/O operations
+/// @details A non-blocking read or write returns a Request. The buffers passed
+///          to the operation must stay valid, and must not be accessed, until
+///          the request has completed. No other I/O may be started on the
+///          same file meanwhile, as it may change the file view the pending
+///          operation depends on.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef EXSEISDAT_PIOL_REQUEST_HH
+#define EXSEISDAT_PIOL_REQUEST_HH
+
+#include <functional>
+#include <memory>
+
+namespace exseis {
+namespace PIOL {
+
+/*! @brief The interface for a pending non-blocking operation.
+ */
+class Request {
+  public:
+    /*! @brief A virtual destructor to allow deletion.
+     */
+    virtual ~Request(void) = default;
+
+    /*! @brief Block until the operation has completed.
+     */
+    virtual void wait(void) = 0;
+
+    /*! @brief Check whether the operation has completed without blocking.
+     *  @return Return \c true if the operation has completed.
+     */
+    virtual bool test(void) = 0;
+};
+
+/*! @brief A request for an operation which completed before it was returned.
+ */
+class CompletedRequest : public Request {
+  public:
+    void wait(void) {}
+
+    bool test(void) { return true; }
+};
+
+/*! @brief A request which performs some extra work, such as decoding the data
+ *         which was read, once another request completes. The work is
+ *         performed exactly once, by whichever of wait(), test() or the
+ *         destructor first sees the operation complete.
+ */
+class ChainedRequest : public Request {
+  private:
+    /// The request for the underlying operation
+    std::shared_ptr<Request> req;
+
+    /// The work to perform when the underlying operation completes
+    std::function<void(void)> onComplete;
+
+    /// Whether the work has been performed
+    bool done;
+
+    /*! @brief Perform the completion work if it has not been done yet.
+     */
+    void complete(void);
+
+  public:
+    /*! @brief Wrap a request.
+     *  @param[in] req_        The request for the underlying operation
+     *  @param[in] onComplete_ The work to perform when it completes
+     */
+    ChainedRequest(
+      std::shared_ptr<Request> req_, std::function<void(void)> onComplete_);
+
+    /*! @brief Wait for the operation, so the completion work is never lost.
+     */
+    ~ChainedRequest(void);
+
+    void wait(void);
+
+    bool test(void);
+};
+
+}  // namespace PIOL
+}  // namespace exseis
+
+#endif  // EXSEISDAT_PIOL_REQUEST_HH
@@ -78,11 +78,25 @@ struct Rule {
 
         /// Flag marking if the full header buffer is processed.
         bool fullextent;
+
+        /// Flag marking if the compiled program is stale.
+        bool badprogram;
     };
 
     /// The StateFlags instance for the Rule instance.
     StateFlags flag;
 
+    /// Whether parameter structures using the rule are column-major unless
+    /// they say otherwise.
+    bool columnar = false;
+
+    /// Whether parameter structures using the rule hold floats and longs in
+    /// 32 bits, as in a SEG-Y header. See Param::compact. Floats read from a
+    /// header round-trip exactly, but a computed float is re-quantized
+    /// through SEGY_utils::find_scalar to the scalar of its group, so it may
+    /// not be read back exactly as it was set.
+    bool compact = false;
+
     /*! The type of the unordered map which stores all current rules.
      *  A map ensures there are no duplicates. */
     typedef std::unordered_map<Meta, RuleEntry*, EnumHash> RuleMap;
@@ -90,6 +104,46 @@ struct Rule {
     /// The map storing all the current rules.
     RuleMap translate;
 
+    /// The rules of \c translate indexed by their Meta value, so a rule can
+    /// be found without hashing. Entries without a rule are null.
+    std::vector<RuleEntry*> dense;
+
+    /*! A single step of a compiled rule: where one parameter lives in the
+     *  header extent and where it goes in the parameter structure.
+     */
+    struct Op {
+        /// The byte offset of the value from the start of the extent
+        size_t loc;
+
+        /// The type of the value. Only Long, Short and Float are compiled.
+        RuleEntry::MdType type;
+
+        /// The column of the value among the parameters of its type
+        size_t num;
+
+        /// For floats, the byte offset of the scalar from the start of the
+        /// extent
+        size_t scalLoc;
+
+        /// For floats, the index of the scalar in Program::scalLoc
+        size_t scal;
+    };
+
+    /*! The rule compiled into a flat list of header operations, so trace
+     *  headers can be read and written without walking the rule map.
+     */
+    struct Program {
+        /// The operations, sorted by byte offset
+        std::vector<Op> op;
+
+        /// The byte offsets of the distinct scalars shared by the floats,
+        /// sorted
+        std::vector<size_t> scalLoc;
+    };
+
+    /// The compiled program. It is rebuilt when flag.badprogram is set.
+    Program program;
+
     /*! The constructor for creating a Rule structure with
      *  default rules in place or no rules in place.
      *  @param[in] full Whether the extents are set to the default size or
@@ -183,6 +237,18 @@ struct Rule {
      */
     size_t extent(void);
 
+    /*! Return the byte offset of the metadata items within the SEG-Y trace
+     *  header, where a buffer of size extent() starts.
+     *  @return Return the offset.
+     */
+    size_t base(void);
+
+    /*! Get the rule compiled for reading and writing trace headers. It is
+     *  built on first use and again after the rules change.
+     *  @return Return the compiled program.
+     */
+    const Program& compile(void);
+
     /*! Estimate of the total memory used
      *  @return Return estimate in bytes.
      */
@@ -198,6 +264,12 @@ struct Rule {
      *  @return The associated rule entry.
      */
     RuleEntry* getEntry(Meta entry);
+
+    /*! Set the entry of \c dense for a particular meta entry.
+     *  @param[in] m     The meta entry.
+     *  @param[in] entry The associated rule entry, or null if it was removed.
+     */
+    void setEntry(Meta m, RuleEntry* entry);
 };
 
 }  // namespace PIOL
@@ -65,7 +65,8 @@ class WriteDirect {
         }
     }
 
-    /*! Constructor without options.
+    /*! Constructor without options. The object layer is chosen by
+     *  makeDefaultObj from the name of the file.
      *  @param[in] piol This PIOL ptr is not modified but is used to instantiate
      *                  another shared_ptr.
      *  @param[in] name The name of the file associated with the instantiation.
@@ -168,6 +169,47 @@ class WriteDirect {
      */
     void writeParamNonContiguous(
       size_t sz, const size_t* offset, const Param* prm);
+
+    /*! @brief Write samples s0 to s0+n of the traces from offset to
+     *         offset+sz. The other samples and the trace headers are left as
+     *         they are.
+     *  @param[in] offset The starting trace number.
+     *  @param[in] sz     The number of traces to process.
+     *  @param[in] s0     The first sample of the window.
+     *  @param[in] n      The number of samples in the window.
+     *  @param[in] trace  A contiguous array of the window of each trace
+     *                    (size sz*n*sizeof(exseis::utils::Trace_value))
+     */
+    void writeTraceWindow(
+      size_t offset,
+      size_t sz,
+      size_t s0,
+      size_t n,
+      const exseis::utils::Trace_value* trace);
+
+    /*! @brief Write samples s0 to s0+n of the traces specified by the
+     *         offsets in the passed offset array. The other samples and the
+     *         trace headers are left as they are.
+     *  @param[in] sz     The number of traces to process
+     *  @param[in] offset An array of trace numbers to write.
+     *  @param[in] s0     The first sample of the window.
+     *  @param[in] n      The number of samples in the window.
+     *  @param[in] trace  A contiguous array of the window of each trace
+     *                    (size sz*n*sizeof(exseis::utils::Trace_value))
+     */
+    void writeTraceWindowNonContiguous(
+      size_t sz,
+      const size_t* offset,
+      size_t s0,
+      size_t n,
+      const exseis::utils::Trace_value* trace);
+
+    /*! @brief Write out any traces held back by the file layer, such as those
+     *         in the write-behind buffer of a SEG-Y file. It is collective,
+     *         so every process of the PIOL communicator must call it, even
+     *         those with nothing held back.
+     */
+    void flush(void);
 };
 
 }  // namespace PIOL
@@ -128,6 +128,29 @@ class WriteInterface {
       const Param* prm = PIOL_PARAM_NULL,
       size_t skip      = 0) = 0;
 
+    /*! @brief Start writing the traces from offset to offset+sz without
+     *         blocking. The default implementation completes the write before
+     *         returning.
+     *  @param[in] offset The starting trace number.
+     *  @param[in] sz The number of traces to process.
+     *  @param[in] trace The array of traces to write to the file
+     *  @param[in] prm A contiguous array of the parameter structures
+     *                 (size sizeof(Param)*sz)
+     *  @param[in] skip When writing, skip the first "skip" entries of prm
+     *  @return The request for the pending write. The request must complete
+     *          before this object is destroyed.
+     *
+     *  @details No other I/O may be started on the same file until the
+     *           request has completed, as it may change the MPI-IO file view
+     *           the pending write depends on.
+     */
+    virtual std::shared_ptr<Request> iwriteTrace(
+      size_t offset,
+      size_t sz,
+      exseis::utils::Trace_value* trace,
+      const Param* prm = PIOL_PARAM_NULL,
+      size_t skip      = 0);
+
     /*! @brief Write the traces specified by the offsets in the passed offset
      *         array.
      *  @param[in] sz The number of traces to process
@@ -147,6 +170,49 @@ class WriteInterface {
       exseis::utils::Trace_value* trace,
       const Param* prm = PIOL_PARAM_NULL,
       size_t skip      = 0) = 0;
+
+    /*! @brief Write samples s0 to s0+n of the traces from offset to
+     *         offset+sz. The other samples and the trace headers are left as
+     *         they are. The default implementation logs an error, as the
+     *         file format does not support it.
+     *  @param[in] offset The starting trace number.
+     *  @param[in] sz The number of traces to process.
+     *  @param[in] s0 The first sample of the window.
+     *  @param[in] n The number of samples in the window.
+     *  @param[in] trace A contiguous array of the window of each trace
+     *                   (size sz*n*sizeof(exseis::utils::Trace_value))
+     */
+    virtual void writeTraceWindow(
+      size_t offset,
+      size_t sz,
+      size_t s0,
+      size_t n,
+      const exseis::utils::Trace_value* trace);
+
+    /*! @brief Write samples s0 to s0+n of the traces specified by the
+     *         offsets in the passed offset array. The other samples and the
+     *         trace headers are left as they are. The default implementation
+     *         logs an error, as the file format does not support it.
+     *  @param[in] sz The number of traces to process
+     *  @param[in] offset An array of trace numbers to write.
+     *  @param[in] s0 The first sample of the window.
+     *  @param[in] n The number of samples in the window.
+     *  @param[in] trace A contiguous array of the window of each trace
+     *                   (size sz*n*sizeof(exseis::utils::Trace_value))
+     */
+    virtual void writeTraceWindowNonContiguous(
+      size_t sz,
+      const size_t* offset,
+      size_t s0,
+      size_t n,
+      const exseis::utils::Trace_value* trace);
+
+    /*! @brief Write out any traces held back by the file layer. It is
+     *         collective over the processes of the PIOL communicator, so
+     *         every process must call it. The default implementation holds
+     *         nothing back and does nothing.
+     */
+    virtual void flush(void);
 };
 
 }  // namespace PIOL
@@ -8,6 +8,9 @@
 #include "ExSeisDat/PIOL/WriteInterface.hh"
 #include "ExSeisDat/PIOL/segy_utils.hh"
 
+#include <map>
+#include <vector>
+
 namespace exseis {
 namespace PIOL {
 
@@ -24,6 +27,26 @@ class WriteSEGY : public WriteInterface {
         /// standard definition)
         double incFactor;
 
+        /// The memory in bytes of the write-behind buffer. Whole traces are
+        /// held back and merged by trace number until the buffer of a
+        /// process is full, and that process then writes its runs without
+        /// the others. If the Data layer only writes collectively, the
+        /// traces are instead held until the next flush. Zero, the default,
+        /// writes every call straight through. Every process must use the
+        /// same value.
+        size_t writeBehindSz;
+
+        /// The number format the trace samples are written in. It defaults
+        /// to IEEE. IBM, TC4, TC2, TC1 and IEEE8 are also supported.
+        SEGY_utils::SEGYNumberFormat number_format;
+
+        /// Whether the file is written big-endian, as SEG-Y rev 1 requires
+        /// (the default). Little-endian files are marked with the SEG-Y rev 2
+        /// byte order marker, and their IEEE samples need no conversion on
+        /// little-endian hosts. Files without a file header are always
+        /// written in the byte order of the host.
+        bool is_big_endian;
+
         /*! Constructor which provides the default Rules
          */
         Opt(void);
@@ -53,6 +76,67 @@ class WriteSEGY : public WriteInterface {
     /// The increment factor
     double incFactor;
 
+    /// The memory in bytes of the write-behind buffer, or zero if disabled
+    size_t writeBehindSz;
+
+    /// The number format the trace samples are written in
+    SEGY_utils::SEGYNumberFormat number_format;
+
+    /// Whether the file is big-endian
+    bool is_big_endian;
+
+    /// Runs of encoded data-objects held back, keyed by their first trace
+    /// number. Runs never overlap or touch.
+    std::map<size_t, std::vector<unsigned char>> pending;
+
+    /// The number of bytes held in \c pending
+    size_t pendingSz = 0;
+
+    /*! @brief Hold back a run of encoded data-objects, merging it with the
+     *         runs it overlaps or touches. Newer data-objects replace older
+     *         ones.
+     *  @param[in] offset The trace number of the first data-object
+     *  @param[in] sz     The number of data-objects
+     *  @param[in] dobj   The encoded data-objects
+     */
+    void bufferDO(size_t offset, size_t sz, const unsigned char* dobj);
+
+    /*! @brief Write the runs held back by this process on its own, for as
+     *         long as the Data layer allows it. Runs which cannot be written
+     *         are kept for the next flush.
+     */
+    void writePending(void);
+
+    /*! @brief Encode whole traces into the write-behind buffer and write it
+     *         out once this process has filled it. No other process takes
+     *         part, so a full buffer costs no communication.
+     *  @param[in] sz     The number of traces
+     *  @param[in] offset The trace number of each trace
+     *  @param[in] trc    The traces
+     *  @param[in] prm    The parameters
+     *  @param[in] skip   Skip the first \c skip entries of \c prm
+     */
+    void bufferTrace(
+      size_t sz,
+      const size_t* offset,
+      const exseis::utils::Trace_value* trc,
+      const Param* prm,
+      size_t skip);
+
+    /*! @brief Check whether a write can be held back.
+     *  @param[in] trc The traces passed to the write
+     *  @param[in] prm The parameters passed to the write
+     *  @return Return true if the write-behind buffer is enabled and both
+     *          traces and parameters are written.
+     */
+    bool isBuffered(
+      const exseis::utils::Trace_value* trc, const Param* prm) const;
+
+    /*! Get the increment in the units of the file.
+     *  @return Return the increment
+     */
+    int16_t getInterval(void) const;
+
     /*! Calculate the number of traces currently stored (or implied to exist).
      *  @return Return the number of traces
      */
@@ -85,7 +169,8 @@ class WriteSEGY : public WriteInterface {
       std::string name_,
       std::shared_ptr<ObjectInterface> obj_);
 
-    /*! @brief Destructor. Processes any remaining flags
+    /*! @brief Destructor. Flushes the write-behind buffer and processes any
+     *         remaining flags
      */
     ~WriteSEGY(void);
 
@@ -104,12 +189,58 @@ class WriteSEGY : public WriteInterface {
       const Param* prm = PIOL_PARAM_NULL,
       size_t skip      = 0);
 
+    /*! @copydoc WriteInterface::iwriteTrace
+     *  @details The traces and parameters are encoded into whole data-objects
+     *           before this returns, so \c trace and \c prm can be reused
+     *           straight away. Without both traces and parameters the
+     *           data-objects cannot be written whole, so the write blocks.
+     *           With the write-behind buffer enabled the traces are held
+     *           back like any other write and the request is complete.
+     */
+    std::shared_ptr<Request> iwriteTrace(
+      size_t offset,
+      size_t sz,
+      exseis::utils::Trace_value* trace,
+      const Param* prm = PIOL_PARAM_NULL,
+      size_t skip      = 0);
+
     void writeTraceNonContiguous(
       size_t sz,
       const size_t* offset,
       exseis::utils::Trace_value* trace,
       const Param* prm = PIOL_PARAM_NULL,
       size_t skip      = 0);
+
+    /*! @copydoc WriteInterface::writeTraceWindow
+     *  @details Only the window of each trace is transferred, through a
+     *           strided view of the file. Traces held back by the
+     *           write-behind buffer are written first.
+     */
+    void writeTraceWindow(
+      size_t offset,
+      size_t sz,
+      size_t s0,
+      size_t n,
+      const exseis::utils::Trace_value* trace);
+
+    /*! @copydoc WriteInterface::writeTraceWindowNonContiguous
+     *  @details Only the window of each trace is transferred. Traces held
+     *           back by the write-behind buffer are written first.
+     */
+    void writeTraceWindowNonContiguous(
+      size_t sz,
+      const size_t* offset,
+      size_t s0,
+      size_t n,
+      const exseis::utils::Trace_value* trace);
+
+    /*! @copydoc WriteInterface::flush
+     *  @details Each process first writes its buffered runs on its own
+     *           where the Data layer allows it. Any traces left are written
+     *           with one list write made by every process, so adjacent
+     *           traces go out as large contiguous extents.
+     */
+    void flush(void);
 };
 
 }  // namespace PIOL
@@ -48,6 +48,26 @@ makeFile(std::shared_ptr<ExSeisPIOL> piol, const std::string& name)
       piol, name, makeDefaultObj(piol, name, FileMode::Write));
 }
 
+/*! Construct WriteSEGY objects with the given options and default object and
+ *  MPI-IO layers
+ * @tparam T The type of the file layer
+ * @param[in] piol The piol shared object
+ * @param[in] name The name of the file
+ * @param[in] opt  The file layer options
+ * @return Return a pointer of the respective file type.
+ */
+template<class T>
+std::unique_ptr<
+  typename std::enable_if<std::is_base_of<WriteInterface, T>::value, T>::type>
+makeFile(
+  std::shared_ptr<ExSeisPIOL> piol,
+  const std::string& name,
+  const typename T::Opt& opt)
+{
+    return std::make_unique<T>(
+      piol, name, opt, makeDefaultObj(piol, name, FileMode::Write));
+}
+
 }  // namespace PIOL
 }  // namespace exseis
 
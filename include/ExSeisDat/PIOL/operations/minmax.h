@@ -86,7 +86,7 @@ std::vector<CoordElem> getCoordMinMax(
         return false;
     };
 
-    T temp;
+    T temp{};
     if (!sz || !coord) {
         coord = &temp;
     }
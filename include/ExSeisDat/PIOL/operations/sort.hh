@@ -90,6 +90,10 @@ bool checkOrder(
  *  @param[in] type The sort type
  *  @return A std::function object with the correct comparison for
  *          the sort type.
+ *
+ *  @details Each call of the comparison looks up the columns it reads. The
+ *           sort functions recognise the comparison and look them up once
+ *           per sort instead.
  */
 CompareP getComp(SortType type);
 
@@ -12,41 +12,255 @@
 
 #include "ExSeisDat/PIOL/Param.h"
 
+#include <type_traits>
+
 namespace exseis {
 namespace PIOL {
 namespace param_utils {
 
 // Access
 
+/*! A handle to the column of a single meta entry in a parameter structure.
+ *  The rule lookup and type resolution are done once, when the handle is
+ *  bound, rather than on every access as with getPrm and setPrm.
+ *  @tparam T The type values are read as.
+ *  @tparam P The type of the parameter structure, \c const \c Param for a
+ *            read-only handle and \c Param for a writable one.
+ *
+ *  @details The handle holds a pointer into the parameter structure, so it
+ *           must not outlive it or be used after the structure is resized.
+ *           For a lazy structure, the column is decoded when it is bound.
+ *           Use ParamColumn and WritableParamColumn rather than this class.
+ */
+template<typename T, typename P>
+class BasicParamColumn {
+  public:
+    /// A pointer to a value of the column, const for a read-only handle.
+    template<typename U>
+    using Pointer =
+      typename std::conditional<std::is_const<P>::value, const U*, U*>::type;
+
+    /*! Bind a handle to the column of a meta entry.
+     *  @param[in] entry The meta entry.
+     *  @param[in] prm   The parameter structure.
+     */
+    BasicParamColumn(Meta entry, P* prm)
+    {
+        if (prm->npending != 0) {
+            prm->decode(entry);
+        }
+
+        Rule* r       = prm->r.get();
+        RuleEntry* id = r->getEntry(entry);
+        if (id == nullptr) {
+            return;
+        }
+
+        // The column starts at its value for the first set, whatever the
+        // layout.
+        type_    = id->type();
+        compact_ = prm->compact;
+        prm_     = prm;
+        num_     = id->num;
+        switch (type_) {
+            case RuleEntry::MdType::Float:
+                if (compact_) {
+                    base_ = prm->fc.data() + prm->getPos(0, num_, r->numFloat);
+                    scal_ = prm->fscal.data()
+                            + prm->getPos(0, prm->fgroup[num_], prm->nscal);
+                    scalStride_ = (prm->columnar ? 1 : prm->nscal);
+                }
+                else {
+                    base_ = prm->f.data() + prm->getPos(0, num_, r->numFloat);
+                }
+                stride_ = r->numFloat;
+                break;
+
+            case RuleEntry::MdType::Long:
+                if (compact_) {
+                    base_ = prm->ic.data() + prm->getPos(0, num_, r->numLong);
+                }
+                else {
+                    base_ = prm->i.data() + prm->getPos(0, num_, r->numLong);
+                }
+                stride_ = r->numLong;
+                break;
+
+            case RuleEntry::MdType::Short:
+                base_   = prm->s.data() + prm->getPos(0, num_, r->numShort);
+                stride_ = r->numShort;
+                break;
+
+            case RuleEntry::MdType::Index:
+                base_   = prm->t.data() + prm->getPos(0, num_, r->numIndex);
+                stride_ = r->numIndex;
+                break;
+
+            default:
+                break;
+        }
+
+        if (prm->columnar) {
+            stride_ = 1;
+        }
+    }
+
+    /*! Get the value of the column for a set of parameters.
+     *  @param[in] i The trace number.
+     *  @return Return the value, or zero if the rule has no such entry.
+     */
+    T operator[](size_t i) const
+    {
+        switch (type_) {
+            case RuleEntry::MdType::Float:
+                if (compact_) {
+                    return T(Param::scaleValue(
+                      static_cast<const int32_t*>(base_)[stride_ * i],
+                      scal_[scalStride_ * i]));
+                }
+                return T(static_cast<const exseis::utils::Floating_point*>(
+                  base_)[stride_ * i]);
+            case RuleEntry::MdType::Long:
+                if (compact_) {
+                    return T(static_cast<const int32_t*>(base_)[stride_ * i]);
+                }
+                return T(static_cast<const exseis::utils::Integer*>(
+                  base_)[stride_ * i]);
+            case RuleEntry::MdType::Short:
+                return T(static_cast<const int16_t*>(base_)[stride_ * i]);
+            case RuleEntry::MdType::Index:
+                return T(static_cast<const size_t*>(base_)[stride_ * i]);
+            default:
+                return T(0);
+        }
+    }
+
+    /*! Get the type the column is stored as.
+     *  @return Return the type. Copy is returned if the rule has no such
+     *          entry.
+     */
+    RuleEntry::MdType type() const { return type_; }
+
+    /*! Get a raw pointer to the value of the first set of parameters. The
+     *  value of set \c i is at <tt>data<U>()[stride() * i]</tt>.
+     *  @tparam U The type the column is stored as, i.e.
+     *            exseis::utils::Floating_point, exseis::utils::Integer,
+     *            int16_t or size_t for a Float, Long, Short or Index column.
+     *            For a compact structure, Float and Long columns are int32_t
+     *            and the floats are unscaled.
+     *  @return Return the pointer, or null if the rule has no such entry.
+     */
+    template<typename U>
+    Pointer<U> data() const
+    {
+        return static_cast<Pointer<U>>(base_);
+    }
+
+    /*! Get the distance between the values of consecutive sets of
+     *  parameters.
+     *  @return Return the stride in elements. It is one for a column-major
+     *          structure.
+     */
+    size_t stride() const { return stride_; }
+
+  protected:
+    /// The type the column is stored as.
+    RuleEntry::MdType type_ = RuleEntry::MdType::Copy;
+
+    /// Whether the structure is compact.
+    bool compact_ = false;
+
+    /// The parameter structure.
+    P* prm_ = nullptr;
+
+    /// The column of the entry among those of its type.
+    size_t num_ = 0;
+
+    /// The value of the first set of parameters.
+    Pointer<void> base_ = nullptr;
+
+    /// The distance between the values of consecutive sets of parameters.
+    size_t stride_ = 0;
+
+    /// For a compact float, the scalar of the first set of parameters.
+    const int16_t* scal_ = nullptr;
+
+    /// For a compact float, the distance between the scalars of consecutive
+    /// sets of parameters.
+    size_t scalStride_ = 0;
+};
+
+/*! A read-only handle to the column of a single meta entry.
+ *  @tparam T The type values are read as.
+ */
+template<typename T>
+using ParamColumn = BasicParamColumn<T, const Param>;
+
+/*! A handle to the column of a single meta entry which can also set values.
+ *  It can only be bound to a structure the caller may modify.
+ *  @tparam T The type values are read and written as.
+ */
+template<typename T>
+class WritableParamColumn : public BasicParamColumn<T, Param> {
+  public:
+    /*! Bind a handle to the column of a meta entry.
+     *  @param[in] entry The meta entry.
+     *  @param[in] prm   The parameter structure.
+     */
+    WritableParamColumn(Meta entry, Param* prm) :
+        BasicParamColumn<T, Param>(entry, prm)
+    {
+    }
+
+    /*! Set the value of the column for a set of parameters.
+     *  @param[in] i   The trace number.
+     *  @param[in] val The value.
+     */
+    void set(size_t i, T val)
+    {
+        const size_t pos = this->stride_ * i;
+        switch (this->type_) {
+            case RuleEntry::MdType::Float:
+                if (this->compact_) {
+                    this->prm_->setFloat(i, this->num_, val);
+                    break;
+                }
+                this->template data<exseis::utils::Floating_point>()[pos] =
+                  val;
+                break;
+            case RuleEntry::MdType::Long:
+                if (this->compact_) {
+                    this->template data<int32_t>()[pos] = int32_t(val);
+                    break;
+                }
+                this->template data<exseis::utils::Integer>()[pos] = val;
+                break;
+            case RuleEntry::MdType::Short:
+                this->template data<int16_t>()[pos] = val;
+                break;
+            case RuleEntry::MdType::Index:
+                this->template data<size_t>()[pos] = val;
+                break;
+            default:
+                break;
+        }
+    }
+};
+
 /*! Get the value associated with the particular entry.
  *  @tparam    T The type of the value
  *  @param[in] i The trace number
  *  @param[in] entry The meta entry to retrieve.
  *  @param[in] prm The parameter structure
  *  @return Return the value associated with the entry
+ *
+ *  @details For a lazy structure, the column is decoded on first access.
+ *           Bind a ParamColumn instead when accessing many values.
  */
 template<typename T>
 T getPrm(size_t i, Meta entry, const Param* prm)
 {
-    Rule* r       = prm->r.get();
-    RuleEntry* id = r->getEntry(entry);
-    switch (id->type()) {
-        case RuleEntry::MdType::Float:
-            return T(prm->f[r->numFloat * i + id->num]);
-            break;
-        case RuleEntry::MdType::Long:
-            return T(prm->i[r->numLong * i + id->num]);
-            break;
-        case RuleEntry::MdType::Short:
-            return T(prm->s[r->numShort * i + id->num]);
-            break;
-        case RuleEntry::MdType::Index:
-            return T(prm->t[r->numIndex * i + id->num]);
-            break;
-        default:
-            return T(0);
-            break;
-    }
+    return ParamColumn<T>(entry, prm)[i];
 }
 
 /*! Set the value associated with the particular entry.
@@ -61,28 +275,7 @@ T getPrm(size_t i, Meta entry, const Param* prm)
 template<typename T>
 void setPrm(size_t i, Meta entry, T ret, Param* prm)
 {
-    Rule* r       = prm->r.get();
-    RuleEntry* id = r->getEntry(entry);
-
-    switch (id->type()) {
-        case RuleEntry::MdType::Float:
-            prm->f[r->numFloat * i + id->num] = ret;
-            break;
-
-        case RuleEntry::MdType::Long:
-            prm->i[r->numLong * i + id->num] = ret;
-            break;
-
-        case RuleEntry::MdType::Short:
-            prm->s[r->numShort * i + id->num] = ret;
-            break;
-
-        case RuleEntry::MdType::Index:
-            prm->t[r->numIndex * i + id->num] = ret;
-
-        default:
-            break;
-    }
+    WritableParamColumn<T>(entry, prm).set(i, ret);
 }
 
 /*! Copy params from one parameter structure to another.
@@ -93,6 +286,67 @@ void setPrm(size_t i, Meta entry, T ret, Param* prm)
  */
 void cpyPrm(size_t j, const Param* src, size_t k, Param* dst);
 
+/*! Copy a range of sets of params from one parameter structure to another.
+ *  This is equivalent to calling cpyPrm for each set, but when both
+ *  structures share a rule, layout and storage the arrays are copied as
+ *  whole row ranges (or column ranges, for a column-major layout).
+ *  @param[in] j The first trace number of the source.
+ *  @param[in] src The source parameter structure.
+ *  @param[in] k The first trace number of the destination.
+ *  @param[out] dst The destination parameter structure.
+ *  @param[in] sz The number of sets to copy.
+ *
+ *  @details The source and destination ranges must not overlap.
+ */
+void cpyPrm(size_t j, const Param* src, size_t k, Param* dst, size_t sz);
+
+/*! Gather sets of params from one parameter structure into a contiguous
+ *  range of another, so that set k + n of the destination is set idx[n] of
+ *  the source.
+ *  @param[in] sz The number of sets to gather.
+ *  @param[in] idx The source trace number of each destination set.
+ *  @param[in] src The source parameter structure.
+ *  @param[in] k The first trace number of the destination.
+ *  @param[out] dst The destination parameter structure, which must not be
+ *                  the source.
+ */
+void permutePrm(
+  size_t sz, const size_t* idx, const Param* src, size_t k, Param* dst);
+
+/*! Permute the first sz sets of a parameter structure in place, so that
+ *  set n becomes the set which was at idx[n]. Each set is moved once, by
+ *  following the cycles of the permutation.
+ *  @param[in] sz The number of sets to permute.
+ *  @param[in] idx The permutation, which must hold each of 0 to sz-1 once.
+ *  @param[in,out] prm The parameter structure.
+ */
+void permutePrm(size_t sz, const size_t* idx, Param* prm);
+
+/*! Gather traces from one buffer into another, so that trace n of the
+ *  destination is trace idx[n] of the source.
+ *  @param[in] sz The number of traces to gather.
+ *  @param[in] idx The source trace of each destination trace.
+ *  @param[in] ns The number of samples per trace.
+ *  @param[in] src The source trace buffer.
+ *  @param[out] dst The destination trace buffer.
+ */
+void permuteTrc(
+  size_t sz,
+  const size_t* idx,
+  size_t ns,
+  const exseis::utils::Trace_value* src,
+  exseis::utils::Trace_value* dst);
+
+/*! Permute the first sz traces of a buffer in place, so that trace n
+ *  becomes the trace which was at idx[n].
+ *  @param[in] sz The number of traces to permute.
+ *  @param[in] idx The permutation, which must hold each of 0 to sz-1 once.
+ *  @param[in] ns The number of samples per trace.
+ *  @param[in,out] trc The trace buffer.
+ */
+void permuteTrc(
+  size_t sz, const size_t* idx, size_t ns, exseis::utils::Trace_value* trc);
+
 
 }  // namespace param_utils
 }  // namespace PIOL
@@ -40,8 +40,8 @@ enum class SEGYNumberFormat : int16_t {
     /// The IEEE format, big endian
     IEEE = 5,
 
-    /// Unused
-    NA1 = 6,
+    /// The IEEE double format, big endian (SEG-Y rev 2)
+    IEEE8 = 6,
 
     /// Unused
     NA2 = 7,
@@ -75,6 +75,10 @@ constexpr size_t Sort = 3229U - 1U;
 /// int16_t. The unit system, i.e SI or imperial.
 constexpr size_t Units = 3255U - 1U;
 
+/// int32_t. The byte order marker (SEG-Y rev 2). It holds 0x01020304 in the
+/// byte order of the file, or zero in older big-endian files.
+constexpr size_t ByteOrder = 3297U - 1U;
+
 /// int16_t. The SEG-Y Revision number
 constexpr size_t SEGYFormat = 3501U - 1U;
 
@@ -95,9 +99,35 @@ constexpr size_t Extensions = 3505U - 1U;
  *  @param[in] stride The stride to use between adjacent blocks in the input
  *                    buffer.
  *  @param[in] skip Skip the first "skip" entries when filling Param
+ *  @param[in] threads The number of threads to split the traces over
+ *  @param[in] is_big_endian Whether the headers are big-endian
+ *
+ *  @details A lazy parameter structure keeps the headers and decodes only
+ *           the columns which have already been accessed. The headers are
+ *           then only copied, on the calling thread. Copied and lazy
+ *           headers are kept in their own byte order, which is recorded in
+ *           \c prm.
  */
 void extractParam(
-  size_t sz, const unsigned char* md, Param* prm, size_t stride, size_t skip);
+  size_t sz,
+  const unsigned char* md,
+  Param* prm,
+  size_t stride,
+  size_t skip,
+  size_t threads     = 1,
+  bool is_big_endian = true);
+
+
+/*! @brief Decode a column of a lazy parameter structure from the raw trace
+ *         headers it holds.
+ *  @param[in] op The compiled operation of the column, from the rule of
+ *                \c prm.
+ *  @param[in,out] prm The parameter structure
+ *
+ *  @details The column is written, so no other thread may read \c prm
+ *           meanwhile.
+ */
+void extractColumn(const Rule::Op& op, Param* prm);
 
 
 /*! @brief Extract parameters from an unsigned char array into the parameter
@@ -109,9 +139,21 @@ void extractParam(
  *                    buffer.
  *  @param[in] skip Skip the first "skip" entries when extracting entries from
  *                  Param
+ *  @param[in] threads The number of threads to split the traces over
+ *  @param[in] is_big_endian Whether the headers are big-endian
+ *
+ *  @details Copied headers are written as they were read, and only the
+ *           fields described by the rules are encoded in the byte order
+ *           given.
  */
 void insertParam(
-  size_t sz, const Param* prm, unsigned char* md, size_t stride, size_t skip);
+  size_t sz,
+  const Param* prm,
+  unsigned char* md,
+  size_t stride,
+  size_t skip,
+  size_t threads     = 1,
+  bool is_big_endian = true);
 
 
 /*! @brief Convert a SEG-Y scale integer to a floating point type
@@ -151,6 +193,20 @@ exseis::utils::Floating_point parse_scalar(int16_t segy_scalar);
 int16_t find_scalar(exseis::utils::Floating_point val);
 
 
+/*! @brief Return the size in bytes of a trace sample in the given format.
+ *  @param[in] format The number format of the samples
+ *  @return The size of a sample in bytes. Formats which are not supported
+ *          are taken to be 4 byte IEEE.
+ */
+size_t getSampleSz(SEGYNumberFormat format);
+
+/*! @brief Check whether traces in the given format can be read and written.
+ *  @param[in] format The number format of the samples
+ *  @return Return true for IBM, IEEE, IEEE8, TC4, TC2 and TC1.
+ */
+bool isSupported(SEGYNumberFormat format);
+
+
 /*! @brief An enumeration containing important SEG-Y sizes
  */
 enum class Size : size_t {
@@ -258,6 +314,71 @@ size_t getNt(size_t fsz, size_t ns)
     return (fsz - getHOSz()) / getDOSz<T>(ns);
 }
 
+/*! @brief Return the size of the Data-Object Field object
+ *  @param[in] ns       The number of elements in the data-field.
+ *  @param[in] sampleSz The size of an element in bytes
+ *  @return Returns the size of the data-field in bytes
+ */
+inline size_t getDFSz(size_t ns, size_t sampleSz)
+{
+    return ns * sampleSz;
+}
+
+/*! @brief Return the size of the Data-Object.
+ *  @param[in] ns       The number of elements in the data-field.
+ *  @param[in] sampleSz The size of an element in bytes
+ *  @return Returns the DO size.
+ */
+inline size_t getDOSz(size_t ns, size_t sampleSz)
+{
+    return getMDSz() + getDFSz(ns, sampleSz);
+}
+
+/*! @brief Return the expected size of the file if there are nt data-objects and
+ *         ns elements in a data-field.
+ *  @param[in] nt       The number of data objects.
+ *  @param[in] ns       The number of elements in the data-field.
+ *  @param[in] sampleSz The size of an element in bytes
+ *  @return Returns the expected file size.
+ */
+inline size_t getFileSz(size_t nt, size_t ns, size_t sampleSz)
+{
+    return getHOSz() + nt * getDOSz(ns, sampleSz);
+}
+
+/*! @brief Return the offset location of a specific data object.
+ *  @param[in] i        The location of the ith data object will be returned.
+ *  @param[in] ns       The number of elements in the data-field.
+ *  @param[in] sampleSz The size of an element in bytes
+ *  @return Returns the location.
+ */
+inline size_t getDOLoc(size_t i, size_t ns, size_t sampleSz)
+{
+    return getFileSz(i, ns, sampleSz);
+}
+
+/*! @brief Return the offset location of a specific data-field
+ *  @param[in] i        The location of the ith data-field will be returned.
+ *  @param[in] ns       The number of elements in the data-field.
+ *  @param[in] sampleSz The size of an element in bytes
+ *  @return Returns the location.
+ */
+inline size_t getDODFLoc(size_t i, size_t ns, size_t sampleSz)
+{
+    return getFileSz(i, ns, sampleSz) + getMDSz();
+}
+
+/*! @brief Return the number of traces in a file given a file size
+ *  @param[in] fsz      the size of a file or expected size in bytes
+ *  @param[in] ns       The number of elements in the data-field.
+ *  @param[in] sampleSz The size of an element in bytes
+ *  @return Returns the number of traces.
+ */
+inline size_t getNt(size_t fsz, size_t ns, size_t sampleSz)
+{
+    return (fsz - getHOSz()) / getDOSz(ns, sampleSz);
+}
+
 
 }  // namespace SEGY_utils
 }  // namespace PIOL
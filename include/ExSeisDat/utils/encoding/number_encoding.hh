@@ -6,7 +6,9 @@
 #define EXSEISDAT_UTILS_ENCODING_NUMBER_ENCODING_HH
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 
 ///
@@ -214,6 +216,79 @@ inline std::array<unsigned char, sizeof(float)> to_big_endian(float src)
 }
 
 
+/// @brief Convert an array of bytes in little-endian order to a host integer
+///        type.
+///
+/// @tparam T The host integer type to convert to.
+///
+/// @param[in] src Data in little-endian order, so src[0] holds the least
+///                significant byte.
+///
+/// @return The integer in host-endianness.
+///
+template<typename T>
+T from_little_endian(std::array<unsigned char, sizeof(T)> src)
+{
+    static_assert(
+      std::is_integral<T>::value,
+      "from_little_endian only defined for integer types.");
+
+    using Bits = typename std::make_unsigned<T>::type;
+
+    Bits dst = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        dst |= Bits(Bits(src[i]) << (8 * i));
+    }
+
+    return static_cast<T>(dst);
+}
+
+
+/// @brief Convert a host-endian integer type to an `unsigned char` array in
+///        little-endian order.
+///
+/// @tparam T The type to convert to little-endian.
+///
+/// @param[in] src The value to convert from host-endian to little-endian.
+///
+/// @return An array containing the bytes of `src` in little-endian order, so
+///         dst[0] holds the least significant byte.
+///
+template<typename T>
+std::array<unsigned char, sizeof(T)> to_little_endian(T src)
+{
+    static_assert(
+      std::is_integral<T>::value,
+      "to_little_endian only defined for integer types.");
+
+    using Bits = typename std::make_unsigned<T>::type;
+
+    const Bits bits = static_cast<Bits>(src);
+
+    std::array<unsigned char, sizeof(T)> dst;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        dst[i] = (bits >> (8 * i)) & 0xFF;
+    }
+
+    return dst;
+}
+
+
+/// @brief Check the byte order of the host.
+///
+/// @return True if the host stores the least significant byte of an integer
+///         first.
+///
+inline bool is_little_endian_host()
+{
+    const uint16_t one  = 1;
+    unsigned char first = 0;
+    std::memcpy(&first, &one, 1);
+
+    return first == 1;
+}
+
+
 /// The \c Float_components class represents a floating point number in terms
 /// of its components: {sign, exponent, significand}.
 ///
@@ -276,6 +351,139 @@ float to_float(Float_components components);
 float from_IBM_to_float(
   std::array<unsigned char, 4> ibm_float_bytes, bool is_big_endian);
 
+
+/// Convert a native single-precision float to the nearest IBM
+/// single-precision floating point number.
+///
+/// @param[in] value         The native float.
+/// @param[in] is_big_endian True if the IBM float should be in big-endian
+///                          order.
+///
+/// @return The byte representation of the IBM float.
+///
+/// @details The IBM fraction is rounded half to even, so a float which is an
+///          IBM number is converted exactly, and \c from_IBM_to_float gives it
+///          back. Every float is in the range of the IBM format. Zero becomes
+///          the IBM zero with no sign bit, and infinities and NaNs become the
+///          IBM number of largest magnitude with the same sign.
+///
+std::array<unsigned char, 4> to_IBM_from_float(float value, bool is_big_endian);
+
+
+/// The instruction sets the bulk conversion routines can use, in increasing
+/// order of vector width.
+enum class Simd_level : int {
+    /// Plain C++, one value at a time
+    Scalar,
+
+    /// 128 bit SSE4.1 vectors
+    SSE4,
+
+    /// 256 bit AVX2 vectors
+    AVX2,
+
+    /// 512 bit AVX-512 (F and BW) vectors
+    AVX512
+};
+
+
+/// Get the instruction set used by the bulk conversion routines.
+///
+/// @returns The widest instruction set supported by both the build and the
+///          processor, unless \c set_simd_level has lowered it.
+///
+Simd_level simd_level();
+
+
+/// Limit the instruction set used by the bulk conversion routines. This is
+/// intended for testing and benchmarking, and is not thread safe.
+///
+/// @param[in] level The widest instruction set to use. It is lowered to the
+///                  widest one available if the processor does not support
+///                  it.
+///
+/// @returns The instruction set now in use.
+///
+Simd_level set_simd_level(Simd_level level);
+
+
+/// Convert an array of big-endian IEEE floats to native floats.
+///
+/// @param[in]  src The big-endian bytes (size 4 * \c n)
+/// @param[in]  n   The number of floats
+/// @param[out] dst The native floats (size \c n). It may be the same memory
+///                 as \c src, but must not otherwise overlap it.
+///
+void from_big_endian_n(const unsigned char* src, size_t n, float* dst);
+
+
+/// Convert an array of native floats to big-endian IEEE floats.
+///
+/// @param[in]  src The native floats (size \c n)
+/// @param[in]  n   The number of floats
+/// @param[out] dst The big-endian bytes (size 4 * \c n). It may be the same
+///                 memory as \c src, but must not otherwise overlap it.
+///
+void to_big_endian_n(const float* src, size_t n, unsigned char* dst);
+
+
+/// Convert an array of little-endian IEEE floats to native floats. On a
+/// little-endian host this is a copy, and nothing is done when \c src and
+/// \c dst are the same memory.
+///
+/// @param[in]  src The little-endian bytes (size 4 * \c n)
+/// @param[in]  n   The number of floats
+/// @param[out] dst The native floats (size \c n). It may be the same memory
+///                 as \c src, but must not otherwise overlap it.
+///
+void from_little_endian_n(const unsigned char* src, size_t n, float* dst);
+
+
+/// Convert an array of native floats to little-endian IEEE floats. On a
+/// little-endian host this is a copy, and nothing is done when \c src and
+/// \c dst are the same memory.
+///
+/// @param[in]  src The native floats (size \c n)
+/// @param[in]  n   The number of floats
+/// @param[out] dst The little-endian bytes (size 4 * \c n). It may be the
+///                 same memory as \c src, but must not otherwise overlap it.
+///
+void to_little_endian_n(const float* src, size_t n, unsigned char* dst);
+
+
+/// Convert an array of IBM single-precision floats to native floats. The
+/// result for each value is the same as from \c from_IBM_to_float.
+///
+/// @param[in]  src           The IBM floats (size 4 * \c n)
+/// @param[in]  n             The number of floats
+/// @param[out] dst           The native floats (size \c n). It may be the
+///                           same memory as \c src, but must not otherwise
+///                           overlap it.
+/// @param[in]  is_big_endian True if the IBM floats are in big-endian order.
+///
+/// @pre The native `float` type is IEEE 754 and denormals are not flushed to
+///      zero.
+///
+void from_IBM_to_float_n(
+  const unsigned char* src, size_t n, float* dst, bool is_big_endian);
+
+/// Convert an array of native floats to IBM single-precision floats. The
+/// result for each value is the same as from \c to_IBM_from_float.
+///
+/// @param[in]  src           The native floats (size \c n)
+/// @param[in]  n             The number of floats
+/// @param[out] dst           The IBM floats (size 4 * \c n). It may be the
+///                           same memory as \c src, but must not otherwise
+///                           overlap it.
+/// @param[in]  is_big_endian True if the IBM floats should be in big-endian
+///                           order.
+///
+/// @pre The native `float` type is IEEE 754, denormals are not flushed to
+///      zero and the floating point rounding mode is round to nearest.
+///
+void to_IBM_from_float_n(
+  const float* src, size_t n, unsigned char* dst, bool is_big_endian);
+
 }  // namespace number_encoding
 }  // namespace utils
 }  // namespace exseis
@@ -5,6 +5,8 @@
 #ifndef EXSEISDAT_UTILS_MPI_MPI_TYPE_HH
 #define EXSEISDAT_UTILS_MPI_MPI_TYPE_HH
 
+#include <mpi.h>
+
 namespace exseis {
 namespace utils {
 
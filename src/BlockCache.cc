@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of \c BlockCache
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExSeisDat/PIOL/BlockCache.hh"
+
+#include <algorithm>
+#include <iterator>
+#include <sys/stat.h>
+
+namespace exseis {
+namespace PIOL {
+
+BlockCache::Opt::Opt(void)
+{
+    blockSz = 256LU * 1024LU;
+    budget  = 256LU * 1024LU * 1024LU;
+}
+
+BlockCache::BlockCache(const BlockCache::Opt& opt) :
+    blockSz(std::max(opt.blockSz, 1LU)),
+    maxBlocks(opt.budget / std::max(opt.blockSz, 1LU)),
+    nextId(0),
+    hits(0),
+    misses(0),
+    saved(0)
+{
+}
+
+size_t BlockCache::fileId(const std::string& name)
+{
+    struct stat info;
+    if (stat(name.c_str(), &info) != 0) {
+        return nextId++;
+    }
+
+    const FileKey key(
+      size_t(info.st_dev), size_t(info.st_ino), size_t(info.st_size),
+      size_t(info.st_mtim.tv_sec) * 1000000000LU
+        + size_t(info.st_mtim.tv_nsec));
+
+    auto it = files.find(key);
+    if (it == files.end()) {
+        it = files.emplace(key, nextId++).first;
+    }
+    return it->second;
+}
+
+const unsigned char* BlockCache::find(const size_t file, const size_t block)
+{
+    auto it = index.find(Key(file, block));
+    if (it == index.end()) {
+        misses++;
+        return nullptr;
+    }
+
+    hits++;
+    lru.splice(lru.begin(), lru, it->second);
+    return it->second->d.data();
+}
+
+void BlockCache::insert(
+  const size_t file, const size_t block, const unsigned char* d)
+{
+    const Key key(file, block);
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        std::copy_n(d, blockSz, it->second->d.data());
+        lru.splice(lru.begin(), lru, it->second);
+        return;
+    }
+
+    if (maxBlocks == 0) {
+        return;
+    }
+
+    // Reuse the storage of the least recently used block when full
+    if (lru.size() >= maxBlocks) {
+        index.erase(lru.back().key);
+        lru.splice(lru.begin(), lru, std::prev(lru.end()));
+        lru.front().key = key;
+    }
+    else {
+        lru.push_front({key, std::vector<unsigned char>(blockSz)});
+    }
+
+    std::copy_n(d, blockSz, lru.front().d.data());
+    index[key] = lru.begin();
+}
+
+void BlockCache::erase(const size_t file, const size_t block)
+{
+    auto it = index.find(Key(file, block));
+    if (it != index.end()) {
+        lru.erase(it->second);
+        index.erase(it);
+    }
+}
+
+void BlockCache::eraseFile(const size_t file)
+{
+    auto it = index.lower_bound(Key(file, 0LU));
+    while (it != index.end() && it->first.first == file) {
+        lru.erase(it->second);
+        it = index.erase(it);
+    }
+}
+
+}  // namespace PIOL
+}  // namespace exseis
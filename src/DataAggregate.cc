@@ -0,0 +1,328 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of \c DataAggregate
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExSeisDat/PIOL/ExSeisPIOL.hh"
+
+#include "ExSeisDat/PIOL/DataAggregate.hh"
+#include "ExSeisDat/PIOL/DataMPIIO.hh"
+#include "ExSeisDat/utils/mpi/MPI_error_to_string.hh"
+#include "ExSeisDat/utils/mpi/MPI_type.hh"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace std::string_literals;
+
+namespace exseis {
+namespace PIOL {
+
+/////////////////////////////    Class functions    ////////////////////////////
+
+//////////////////////      Constructor & Destructor      //////////////////////
+DataAggregate::Opt::Opt(void)
+{
+    windowSz = 16LU * 1024LU * 1024LU;
+}
+
+DataAggregate::DataAggregate(
+  std::shared_ptr<ExSeisPIOL> piol,
+  std::string name,
+  const DataAggregate::Opt& opt,
+  FileMode mode) :
+    PIOL::DataInterface(piol, name),
+    base(std::make_shared<DataMPIIO>(piol, name, mode))
+{
+    Init(opt, mode);
+}
+
+DataAggregate::DataAggregate(
+  std::shared_ptr<ExSeisPIOL> piol,
+  std::string name,
+  const DataAggregate::Opt& opt,
+  std::shared_ptr<DataInterface> base_,
+  FileMode mode) :
+    PIOL::DataInterface(piol, name),
+    base(base_)
+{
+    Init(opt, mode);
+}
+
+DataAggregate::~DataAggregate(void)
+{
+    freeWindow();
+
+    if (aggComm != MPI_COMM_NULL) {
+        checkErr(MPI_Comm_free(&aggComm), "MPI_Comm_free");
+    }
+    if (nodeComm != MPI_COMM_NULL) {
+        checkErr(MPI_Comm_free(&nodeComm), "MPI_Comm_free");
+    }
+}
+
+void DataAggregate::Init(const DataAggregate::Opt& opt, FileMode mode)
+{
+    nodeComm  = MPI_COMM_NULL;
+    aggComm   = MPI_COMM_NULL;
+    nodeRank  = 0;
+    nodeSz    = 1;
+    aggregate = (mode != FileMode::Write);
+    win       = MPI_WIN_NULL;
+    window    = nullptr;
+    winSz     = 0;
+
+    MPI_Comm comm = piol_->comm->getComm();
+
+    int rank = 0;
+    checkErr(MPI_Comm_rank(comm, &rank), "MPI_Comm_rank");
+    checkErr(
+      MPI_Comm_split_type(
+        comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm),
+      "MPI_Comm_split_type");
+    checkErr(MPI_Comm_rank(nodeComm, &nodeRank), "MPI_Comm_rank");
+    checkErr(MPI_Comm_size(nodeComm, &nodeSz), "MPI_Comm_size");
+
+    // One aggregator per node, with the first process of each node chosen.
+    checkErr(
+      MPI_Comm_split(
+        comm, (isAggregator() ? 0 : MPI_UNDEFINED), rank, &aggComm),
+      "MPI_Comm_split");
+
+    if (!aggregate) {
+        return;
+    }
+
+    reserveWindow(opt.windowSz);
+}
+
+/////////////////////////       Member functions      //////////////////////////
+
+void DataAggregate::checkErr(const int err, const char* msg) const
+{
+    if (err != MPI_SUCCESS) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          msg + " error: "s + exseis::utils::MPI_error_to_string(err),
+          PIOL_VERBOSITY_NONE);
+    }
+}
+
+void DataAggregate::reserveWindow(const size_t sz) const
+{
+    if (sz <= winSz) {
+        return;
+    }
+    freeWindow();
+
+    // Only the aggregator contributes memory. The others use its segment.
+    void* local = nullptr;
+    checkErr(
+      MPI_Win_allocate_shared(
+        MPI_Aint(isAggregator() ? sz : 0LU), 1, MPI_INFO_NULL, nodeComm,
+        &local, &win),
+      "MPI_Win_allocate_shared");
+
+    MPI_Aint segSz = 0;
+    int unit       = 0;
+    void* seg      = nullptr;
+    checkErr(
+      MPI_Win_shared_query(win, 0, &segSz, &unit, &seg),
+      "MPI_Win_shared_query");
+    checkErr(
+      MPI_Win_lock_all(MPI_MODE_NOCHECK, win), "MPI_Win_lock_all");
+
+    window = static_cast<unsigned char*>(seg);
+    winSz  = sz;
+}
+
+void DataAggregate::freeWindow(void) const
+{
+    if (win != MPI_WIN_NULL) {
+        checkErr(MPI_Win_unlock_all(win), "MPI_Win_unlock_all");
+        checkErr(MPI_Win_free(&win), "MPI_Win_free");
+    }
+    window = nullptr;
+    winSz  = 0;
+}
+
+void DataAggregate::syncWindow(void) const
+{
+    checkErr(MPI_Win_sync(win), "MPI_Win_sync");
+    checkErr(MPI_Barrier(nodeComm), "MPI_Barrier");
+    checkErr(MPI_Win_sync(win), "MPI_Win_sync");
+}
+
+size_t DataAggregate::getFileSz() const
+{
+    return base->getFileSz();
+}
+
+void DataAggregate::setFileSz(size_t sz) const
+{
+    base->setFileSz(sz);
+}
+
+void DataAggregate::advise(AccessPattern pattern) const
+{
+    base->advise(pattern);
+}
+
+void DataAggregate::read(
+  const size_t offset, const size_t sz, unsigned char* d) const
+{
+    base->read(offset, sz, d);
+}
+
+void DataAggregate::read(
+  const size_t offset,
+  const size_t bsz,
+  const size_t osz,
+  const size_t nb,
+  unsigned char* d) const
+{
+    base->read(offset, bsz, osz, nb, d);
+}
+
+void DataAggregate::read(
+  const size_t bsz,
+  const size_t sz,
+  const size_t* offset,
+  unsigned char* d) const
+{
+    if (!aggregate) {
+        base->read(bsz, sz, offset, d);
+        return;
+    }
+
+    const auto type = exseis::utils::MPI_type<size_t>();
+
+    // Gather the size of every request and then the offsets on the
+    // aggregator.
+    std::array<size_t, 2> req = {{sz, bsz}};
+    std::vector<size_t> reqs(isAggregator() ? 2LU * size_t(nodeSz) : 0LU);
+    checkErr(
+      MPI_Gather(req.data(), 2, type, reqs.data(), 2, type, 0, nodeComm),
+      "MPI_Gather");
+
+    std::vector<int> cnt;
+    std::vector<int> disp;
+    std::vector<size_t> all;
+    if (isAggregator()) {
+        cnt.resize(nodeSz);
+        disp.resize(nodeSz);
+        for (int r = 0, total = 0; r < nodeSz; r++) {
+            cnt[r]  = int(reqs[2 * r]);
+            disp[r] = total;
+            total += cnt[r];
+        }
+        all.resize(size_t(disp.back() + cnt.back()));
+    }
+    checkErr(
+      MPI_Gatherv(
+        offset, int(sz), type, all.data(), cnt.data(), disp.data(), type, 0,
+        nodeComm),
+      "MPI_Gatherv");
+
+    // The plan is the block size, the number of rounds and the window size.
+    // The node reads blocks of the largest size any of its processes asks
+    // for, and each process copies the start of each of its blocks.
+    std::array<size_t, 3> plan = {{0LU, 0LU, winSz}};
+    if (isAggregator()) {
+        for (int r = 0; r < nodeSz; r++) {
+            if (reqs[2 * r] != 0) {
+                plan[0] = std::max(plan[0], reqs[2 * r + 1]);
+            }
+        }
+
+        // Blocks wanted by several processes are read once.
+        std::sort(all.begin(), all.end());
+        all.erase(std::unique(all.begin(), all.end()), all.end());
+
+        // A round holds its count, its offsets and its blocks.
+        plan[2] = std::max(winSz, 2LU * sizeof(size_t) + plan[0]);
+        const size_t per =
+          (plan[2] - sizeof(size_t)) / (sizeof(size_t) + plan[0]);
+        size_t rounds = (all.size() + per - 1LU) / per;
+
+        // Every aggregator makes the same number of collective reads.
+        checkErr(
+          MPI_Allreduce(MPI_IN_PLACE, &rounds, 1, type, MPI_MAX, aggComm),
+          "MPI_Allreduce");
+        plan[1] = rounds;
+    }
+    checkErr(MPI_Bcast(plan.data(), 3, type, 0, nodeComm), "MPI_Bcast");
+
+    reserveWindow(plan[2]);
+
+    const size_t blockSz = plan[0];
+    const size_t per = (winSz - sizeof(size_t)) / (sizeof(size_t) + blockSz);
+    size_t* head     = reinterpret_cast<size_t*>(window);
+    unsigned char* blocks = window + (1LU + per) * sizeof(size_t);
+
+    // Every process makes the same number of reads of the one file handle,
+    // so a collective layer stays matched, but only the aggregators ask for
+    // any blocks. Reading through the same handle that is written through
+    // keeps earlier writes visible.
+    for (size_t round = 0; round < plan[1]; round++) {
+        size_t count = 0;
+        if (isAggregator()) {
+            const size_t first = std::min(round * per, all.size());
+            count              = std::min(per, all.size() - first);
+            head[0]            = count;
+            std::copy_n(all.data() + first, count, &head[1]);
+            base->read(blockSz, count, all.data() + first, blocks);
+        }
+        else {
+            base->read(blockSz, 0LU, nullptr, blocks);
+        }
+        syncWindow();
+
+        const size_t* list = &head[1];
+        count              = head[0];
+        for (size_t i = 0; i < sz; i++) {
+            const size_t* it = std::lower_bound(list, list + count, offset[i]);
+            if (it != list + count && *it == offset[i]) {
+                std::copy_n(&blocks[(it - list) * blockSz], bsz, &d[i * bsz]);
+            }
+        }
+
+        // The aggregator must not overwrite blocks which are being copied.
+        syncWindow();
+    }
+}
+
+void DataAggregate::write(
+  const size_t offset, const size_t sz, const unsigned char* d) const
+{
+    base->write(offset, sz, d);
+}
+
+bool DataAggregate::writeIndependent(
+  const size_t offset, const size_t sz, const unsigned char* d) const
+{
+    return base->writeIndependent(offset, sz, d);
+}
+
+void DataAggregate::write(
+  const size_t offset,
+  const size_t bsz,
+  const size_t osz,
+  const size_t nb,
+  const unsigned char* d) const
+{
+    base->write(offset, bsz, osz, nb, d);
+}
+
+void DataAggregate::write(
+  const size_t bsz,
+  const size_t sz,
+  const size_t* offset,
+  const unsigned char* d) const
+{
+    base->write(bsz, sz, offset, d);
+}
+
+}  // namespace PIOL
+}  // namespace exseis
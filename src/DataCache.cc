@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of \c DataCache
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExSeisDat/PIOL/ExSeisPIOL.hh"
+
+#include "ExSeisDat/PIOL/DataCache.hh"
+#include "ExSeisDat/PIOL/DataMPIIO.hh"
+
+#include <algorithm>
+
+namespace exseis {
+namespace PIOL {
+
+/////////////////////////////    Class functions    ////////////////////////////
+
+//////////////////////      Constructor & Destructor      //////////////////////
+DataCache::Opt::Opt(void)
+{
+    cache = nullptr;
+}
+
+DataCache::DataCache(
+  std::shared_ptr<ExSeisPIOL> piol,
+  std::string name,
+  const DataCache::Opt& opt,
+  FileMode mode) :
+    DataCache(
+      piol,
+      name,
+      std::make_shared<DataMPIIO>(piol, name, opt.mpiio, mode),
+      (opt.cache != nullptr ?
+         opt.cache :
+         (piol->blockCache != nullptr ? piol->blockCache :
+                                        std::make_shared<BlockCache>())))
+{
+}
+
+DataCache::DataCache(
+  std::shared_ptr<ExSeisPIOL> piol,
+  std::string name,
+  std::shared_ptr<DataInterface> base_,
+  std::shared_ptr<BlockCache> cache_) :
+    PIOL::DataInterface(piol, name),
+    base(base_),
+    cache(cache_),
+    file(cache_->fileId(name)),
+    fsz(base_->getFileSz())
+{
+}
+
+/////////////////////////       Member functions      //////////////////////////
+
+size_t DataCache::getFileSz() const
+{
+    return base->getFileSz();
+}
+
+void DataCache::setFileSz(size_t sz) const
+{
+    invalidate(0LU);
+    fsz = sz;
+    base->setFileSz(sz);
+}
+
+void DataCache::advise(AccessPattern pattern) const
+{
+    base->advise(pattern);
+}
+
+const unsigned char* DataCache::map(size_t offset, size_t sz) const
+{
+    return base->map(offset, sz);
+}
+
+void DataCache::readRanges(
+  const size_t bsz,
+  const size_t sz,
+  const size_t* offset,
+  unsigned char* d) const
+{
+    const size_t blk = cache->getBlockSz();
+
+    std::vector<size_t> block;
+    if (bsz != 0) {
+        for (size_t i = 0; i < sz; i++) {
+            const size_t last = (offset[i] + bsz - 1LU) / blk;
+            for (size_t b = offset[i] / blk; b <= last; b++) {
+                block.push_back(b);
+            }
+        }
+    }
+    std::sort(block.begin(), block.end());
+    block.erase(std::unique(block.begin(), block.end()), block.end());
+
+    // A read which does not fit would only copy everything through the cache
+    // and evict it all again.
+    if (block.size() > cache->getMaxBlocks()) {
+        base->read(bsz, sz, offset, d);
+        return;
+    }
+
+    // Look every block up before anything is inserted, so the pointers into
+    // the cache stay valid until the copies are done.
+    std::vector<const unsigned char*> src(block.size());
+    std::vector<unsigned char> hit(block.size(), 0);
+    std::vector<size_t> missing;
+    for (size_t i = 0; i < block.size(); i++) {
+        src[i] = cache->find(file, block[i]);
+        if (src[i] == nullptr) {
+            missing.push_back(i);
+        }
+        else {
+            hit[i] = 1;
+        }
+    }
+
+    std::vector<size_t> moff(missing.size());
+    for (size_t j = 0; j < missing.size(); j++) {
+        moff[j] = block[missing[j]] * blk;
+    }
+
+    // Bytes past the end of the file are left as zero.
+    std::vector<unsigned char> buf(missing.size() * blk);
+    base->read(blk, missing.size(), moff.data(), buf.data());
+
+    for (size_t j = 0; j < missing.size(); j++) {
+        src[missing[j]] = &buf[j * blk];
+    }
+
+    size_t served = 0;
+    for (size_t r = 0; r < sz; r++) {
+        size_t pos       = offset[r];
+        const size_t end = offset[r] + bsz;
+        while (pos < end) {
+            const size_t i = size_t(
+              std::lower_bound(block.begin(), block.end(), pos / blk)
+              - block.begin());
+            const size_t inoff = pos % blk;
+            const size_t n     = std::min(blk - inoff, end - pos);
+
+            d = std::copy_n(&src[i][inoff], n, d);
+            pos += n;
+            served += (hit[i] != 0 ? n : 0LU);
+        }
+    }
+    cache->countSaved(served);
+
+    // Blocks which reach past the end of the file were read short, so they
+    // would serve zeros for data written later.
+    for (size_t j = 0; j < missing.size(); j++) {
+        if ((block[missing[j]] + 1LU) * blk <= fsz) {
+            cache->insert(file, block[missing[j]], &buf[j * blk]);
+        }
+    }
+}
+
+void DataCache::invalidate(const size_t end) const
+{
+    cache->eraseFile(file);
+    fsz = std::max(fsz, end);
+}
+
+void DataCache::read(
+  const size_t offset, const size_t sz, unsigned char* d) const
+{
+    readRanges(sz, 1LU, &offset, d);
+}
+
+void DataCache::read(
+  const size_t offset,
+  const size_t bsz,
+  const size_t osz,
+  const size_t nb,
+  unsigned char* d) const
+{
+    std::vector<size_t> off(nb);
+    for (size_t i = 0; i < nb; i++) {
+        off[i] = offset + i * osz;
+    }
+    readRanges(bsz, nb, off.data(), d);
+}
+
+void DataCache::read(
+  const size_t bsz,
+  const size_t sz,
+  const size_t* offset,
+  unsigned char* d) const
+{
+    readRanges(bsz, sz, offset, d);
+}
+
+void DataCache::write(
+  const size_t offset, const size_t sz, const unsigned char* d) const
+{
+    invalidate(sz != 0 ? offset + sz : 0LU);
+    base->write(offset, sz, d);
+}
+
+bool DataCache::writeIndependent(
+  const size_t offset, const size_t sz, const unsigned char* d) const
+{
+    if (!base->writeIndependent(offset, sz, d)) {
+        return false;
+    }
+    invalidate(sz != 0 ? offset + sz : 0LU);
+    return true;
+}
+
+void DataCache::write(
+  const size_t offset,
+  const size_t bsz,
+  const size_t osz,
+  const size_t nb,
+  const unsigned char* d) const
+{
+    invalidate(nb != 0 ? offset + (nb - 1LU) * osz + bsz : 0LU);
+    base->write(offset, bsz, osz, nb, d);
+}
+
+void DataCache::write(
+  const size_t bsz,
+  const size_t sz,
+  const size_t* offset,
+  const unsigned char* d) const
+{
+    size_t end = 0;
+    for (size_t i = 0; i < sz; i++) {
+        end = std::max(end, offset[i] + bsz);
+    }
+    invalidate(end);
+    base->write(bsz, sz, offset, d);
+}
+
+}  // namespace PIOL
+}  // namespace exseis
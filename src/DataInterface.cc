@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Default implementations for optional \c DataInterface features
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExSeisDat/PIOL/DataInterface.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace exseis {
+namespace PIOL {
+
+const unsigned char* DataInterface::map(size_t, size_t) const
+{
+    return nullptr;
+}
+
+void DataInterface::advise(AccessPattern) const {}
+
+std::shared_ptr<Request> DataInterface::iread(
+  size_t offset, size_t sz, unsigned char* d) const
+{
+    read(offset, sz, d);
+    return std::make_shared<CompletedRequest>();
+}
+
+std::shared_ptr<Request> DataInterface::iwrite(
+  size_t offset, size_t sz, const unsigned char* d) const
+{
+    write(offset, sz, d);
+    return std::make_shared<CompletedRequest>();
+}
+
+bool DataInterface::writeIndependent(
+  size_t, size_t, const unsigned char*) const
+{
+    return false;
+}
+
+/*! Split blocks between two arrays.
+ *  @param[in]  d    The blocks
+ *  @param[in]  bsz1 The size in bytes of the first part of a block
+ *  @param[in]  bsz2 The size in bytes of the second part of a block
+ *  @param[in]  nb   The number of blocks
+ *  @param[out] d1   The first parts
+ *  @param[out] d2   The second parts
+ */
+static void splitBlocks(
+  const unsigned char* d,
+  size_t bsz1,
+  size_t bsz2,
+  size_t nb,
+  unsigned char* d1,
+  unsigned char* d2)
+{
+    for (size_t i = 0; i < nb; i++) {
+        std::copy_n(&d[i * (bsz1 + bsz2)], bsz1, &d1[i * bsz1]);
+        std::copy_n(&d[i * (bsz1 + bsz2) + bsz1], bsz2, &d2[i * bsz2]);
+    }
+}
+
+/*! Join blocks from two arrays.
+ *  @param[in]  d1   The first parts
+ *  @param[in]  d2   The second parts
+ *  @param[in]  bsz1 The size in bytes of the first part of a block
+ *  @param[in]  bsz2 The size in bytes of the second part of a block
+ *  @param[in]  nb   The number of blocks
+ *  @param[out] d    The blocks
+ */
+static void joinBlocks(
+  const unsigned char* d1,
+  const unsigned char* d2,
+  size_t bsz1,
+  size_t bsz2,
+  size_t nb,
+  unsigned char* d)
+{
+    for (size_t i = 0; i < nb; i++) {
+        std::copy_n(&d1[i * bsz1], bsz1, &d[i * (bsz1 + bsz2)]);
+        std::copy_n(&d2[i * bsz2], bsz2, &d[i * (bsz1 + bsz2) + bsz1]);
+    }
+}
+
+void DataInterface::readSplit(
+  size_t offset,
+  size_t bsz1,
+  size_t bsz2,
+  size_t nb,
+  unsigned char* d1,
+  unsigned char* d2) const
+{
+    std::vector<unsigned char> d(nb * (bsz1 + bsz2));
+    read(offset, d.size(), d.data());
+    splitBlocks(d.data(), bsz1, bsz2, nb, d1, d2);
+}
+
+void DataInterface::readSplit(
+  size_t bsz1,
+  size_t bsz2,
+  size_t sz,
+  const size_t* offset,
+  unsigned char* d1,
+  unsigned char* d2) const
+{
+    std::vector<unsigned char> d(sz * (bsz1 + bsz2));
+    read(bsz1 + bsz2, sz, offset, d.data());
+    splitBlocks(d.data(), bsz1, bsz2, sz, d1, d2);
+}
+
+void DataInterface::writeSplit(
+  size_t offset,
+  size_t bsz1,
+  size_t bsz2,
+  size_t nb,
+  const unsigned char* d1,
+  const unsigned char* d2) const
+{
+    std::vector<unsigned char> d(nb * (bsz1 + bsz2));
+    joinBlocks(d1, d2, bsz1, bsz2, nb, d.data());
+    write(offset, d.size(), d.data());
+}
+
+void DataInterface::writeSplit(
+  size_t bsz1,
+  size_t bsz2,
+  size_t sz,
+  const size_t* offset,
+  const unsigned char* d1,
+  const unsigned char* d2) const
+{
+    std::vector<unsigned char> d(sz * (bsz1 + bsz2));
+    joinBlocks(d1, d2, bsz1, bsz2, sz, d.data());
+    write(bsz1 + bsz2, sz, offset, d.data());
+}
+
+}  // namespace PIOL
+}  // namespace exseis
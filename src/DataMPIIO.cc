@@ -11,8 +11,9 @@
 #include "ExSeisDat/utils/mpi/MPI_type.hh"
 
 #include <algorithm>
-#include <assert.h>
+#include <array>
 #include <string>
+#include <vector>
 
 using namespace std::string_literals;
 
@@ -21,83 +22,147 @@ namespace PIOL {
 
 /////////////////////////////       Non-Class      /////////////////////////////
 
-/*! Set a view on a file so that a read of blocks separated by (stride-block)
- *  bytes appears contiguous
- *  @param[in] file The MPI-IO file handle
- *  @param[in] info The info structure to use
- *  @param[in] offset The offset in bytes from the start of the file
+/*! Create a datatype which selects blocks separated by (stride-block) bytes,
+ *  so that a read of the blocks through a view appears contiguous. The
+ *  datatype holds one block with the extent of the stride, and the view
+ *  tiles it, so it serves any number of blocks.
  *  @param[in] block The block size in bytes
  *  @param[in] stride The stride size in bytes block start to block start
- *  @param[in] count The number of blocks
- *  @param[out] type The datatype which will have been used to create a view
+ *  @param[out] type The committed datatype
  *  @return Return an MPI error code.
  */
-int strideView(
-  MPI_File file,
-  MPI_Info info,
-  MPI_Offset offset,
-  int block,
-  MPI_Aint stride,
-  int count,
-  MPI_Datatype* type)
+int strideType(int block, MPI_Aint stride, MPI_Datatype* type)
 {
-    int err = MPI_Type_create_hvector(count, block, stride, MPI_CHAR, type);
+    MPI_Datatype blockType;
+    int err = MPI_Type_contiguous(block, MPI_CHAR, &blockType);
     if (err != MPI_SUCCESS) {
         return err;
     }
 
-    err = MPI_Type_commit(type);
+    err = MPI_Type_create_resized(blockType, 0, stride, type);
+    MPI_Type_free(&blockType);
     if (err != MPI_SUCCESS) {
         return err;
     }
 
-    return MPI_File_set_view(file, offset, MPI_CHAR, *type, "native", info);
+    return MPI_Type_commit(type);
 }
 
-/*! Set a view on a file so that a read of random traces appears contiguous
- *  @param[in] file The MPI-IO file handle
- *  @param[in] info The info structure to use
- *  @param[in] count The number of offsets
- *  @param[in] block The block size in bytes
+/*! Create a datatype which selects a list of extents, so that a read of the
+ *  extents through a view appears contiguous
+ *  @param[in] count The number of extents
+ *  @param[in] len An array of extent sizes in bytes of size count
  *  @param[in] offset An array of offsets in bytes from the start of the file of
  *                    size count
- *  @param[out] type The datatype which will have been used to create a view
+ *  @param[out] type The committed datatype
  *  @return Return an MPI error code.
  */
-int randBlockView(
-  MPI_File file,
-  MPI_Info info,
-  int count,
-  int block,
-  const MPI_Aint* offset,
-  MPI_Datatype* type)
+int extentType(
+  int count, const int* len, const MPI_Aint* offset, MPI_Datatype* type)
 {
-#ifndef HINDEXED_BLOCK_WORKS
-    std::vector<int> bl(count);
-    for (int i = 0; i < count; i++) {
-        bl[i] = block;
+    int err = MPI_Type_create_hindexed(count, len, offset, MPI_CHAR, type);
+    if (err != MPI_SUCCESS) {
+        return err;
     }
 
-    assert(
-      size_t(count)
-      < std::numeric_limits<int>::max() / (sizeof(int) + sizeof(MPI_Aint)));
+    return MPI_Type_commit(type);
+}
 
-    int err =
-      MPI_Type_create_hindexed(count, bl.data(), offset, MPI_CHAR, type);
-#else
-    int err =
-      MPI_Type_create_hindexed_block(count, block, offset, MPI_CHAR, type);
-#endif
+/*! Create a datatype which places blocks in two arrays in memory. The first
+ *  \c bsz1 bytes of block i are at \c d1 + i * \c bsz1 and the other
+ *  \c bsz2 bytes at \c d2 + i * \c bsz2. The displacements are absolute
+ *  addresses, so the datatype is used with MPI_BOTTOM.
+ *  @param[in] bsz1 The size in bytes of the first part of a block
+ *  @param[in] bsz2 The size in bytes of the second part of a block
+ *  @param[in] nb The number of blocks
+ *  @param[in] d1 The array of first parts
+ *  @param[in] d2 The array of second parts
+ *  @param[out] type The committed datatype
+ *  @return Return an MPI error code.
+ */
+int splitType(
+  size_t bsz1,
+  size_t bsz2,
+  size_t nb,
+  const unsigned char* d1,
+  const unsigned char* d2,
+  MPI_Datatype* type)
+{
+    MPI_Aint a1 = 0;
+    MPI_Aint a2 = 0;
+
+    int err = MPI_Get_address(d1, &a1);
+    if (err == MPI_SUCCESS) {
+        err = MPI_Get_address(d2, &a2);
+    }
     if (err != MPI_SUCCESS) {
         return err;
     }
 
-    err = MPI_Type_commit(type);
+    std::vector<int> len(2LU * nb);
+    std::vector<MPI_Aint> disp(2LU * nb);
+    for (size_t i = 0; i < nb; i++) {
+        len[2LU * i]        = int(bsz1);
+        disp[2LU * i]       = a1 + MPI_Aint(i * bsz1);
+        len[2LU * i + 1LU]  = int(bsz2);
+        disp[2LU * i + 1LU] = a2 + MPI_Aint(i * bsz2);
+    }
+
+    err = MPI_Type_create_hindexed(
+      int(2LU * nb), len.data(), disp.data(), MPI_CHAR, type);
     if (err != MPI_SUCCESS) {
         return err;
     }
 
-    return MPI_File_set_view(file, 0, MPI_BYTE, *type, "native", info);
+    return MPI_Type_commit(type);
+}
+
+/*! A contiguous region of a file covering one or more blocks of a list I/O
+ *  operation, including any holes between them.
+ */
+struct Extent {
+    /// The offset in bytes from the start of the file
+    size_t offset;
+
+    /// The size of the region in bytes
+    size_t sz;
+
+    /// The index of the first block in the region
+    size_t first;
+
+    /// The number of blocks in the region
+    size_t nb;
+};
+
+/*! Merge a list of blocks into extents. A block joins the previous extent if
+ *  it starts at or after the end of it and the hole between them is at most
+ *  \c hole bytes.
+ *  @param[in] bsz The block size in bytes
+ *  @param[in] sz The number of blocks
+ *  @param[in] offset The list of block offsets
+ *  @param[in] hole The largest hole in bytes which can be read over
+ *  @param[in] maxSz The largest extent to create in bytes
+ *  @return The list of extents, in the order of the blocks.
+ */
+std::vector<Extent> coalesce(
+  size_t bsz, size_t sz, const size_t* offset, size_t hole, size_t maxSz)
+{
+    std::vector<Extent> ext;
+    for (size_t i = 0; i < sz; i++) {
+        if (!ext.empty()) {
+            Extent& e        = ext.back();
+            const size_t end = e.offset + e.sz;
+            if (
+              offset[i] >= end && offset[i] - end <= hole
+              && offset[i] + bsz - e.offset <= maxSz) {
+                e.sz = offset[i] + bsz - e.offset;
+                e.nb++;
+                continue;
+            }
+        }
+        ext.push_back({offset[i], bsz, i, 1LU});
+    }
+    return ext;
 }
 
 /*! @brief This function exists to hide the const from the MPI_File_write_at
@@ -132,47 +197,110 @@ int mpiio_write_at_all(
     return MPI_File_write_at_all(f, o, d, s, da, st);
 }
 
-/*! Perform list-based I/O by setting a view then performing the I/O
- *  @param[in] fn A contiguous I/O function
- *  @param[in] file The MPI file handle
- *  @param[in] info The MPI info object
- *  @param[in] bsz The block size
- *  @param[in] chunk The number of blocks to read
- *  @param[in] offset The list of offsets in the file
- *  @param[in, out] d The I/O buffer
- *  @param[in] stat The MPI status object
- *  @return Return the MPI error status
+/*! @brief This function exists to hide the const from the MPI_File_iwrite_at
+ *         function signature
+ *  @param[in] f The MPI file handle
+ *  @param[in] o The offset in bytes from the current internal shared pointer
+ *  @param[in] d The array to read data output from
+ *  @param[in] s The amount of data to write to disk in terms of datatypes
+ *  @param[in] da The MPI datatype
+ *  @param[out] r The MPI request handle
+ *  @return Returns the associated MPI error code.
  */
-int iol(
-  MFp<MPI_Status> fn,
-  MPI_File file,
-  MPI_Info info,
-  int bsz,
-  int chunk,
-  const MPI_Aint* offset,
-  unsigned char* d,
-  MPI_Status* stat)
+int mpiio_iwrite_at(
+  MPI_File f, MPI_Offset o, void* d, int s, MPI_Datatype da, MPI_Request* r)
 {
-    // Set a view so that MPI_File_read... functions only see contiguous data.
-    MPI_Datatype type;
-    int err = randBlockView(file, info, chunk, bsz, offset, &type);
-    if (err != MPI_SUCCESS) {
-        return err;
+    return MPI_File_iwrite_at(f, o, d, s, da, r);
+}
+
+/*! @brief This function exists to hide the const from the
+ *         MPI_File_iwrite_at_all function signature
+ *  @param[in] f The MPI file handle
+ *  @param[in] o The offset in bytes from the current internal shared pointer
+ *  @param[in] d The array to read data output from
+ *  @param[in] s The amount of data to write to disk in terms of datatypes
+ *  @param[in] da The MPI datatype
+ *  @param[out] r The MPI request handle
+ *  @return Returns the associated MPI error code.
+ */
+int mpiio_iwrite_at_all(
+  MPI_File f, MPI_Offset o, void* d, int s, MPI_Datatype da, MPI_Request* r)
+{
+    return MPI_File_iwrite_at_all(f, o, d, s, da, r);
+}
+
+/*! @brief A set of pending MPI-IO requests. The requests are completed by the
+ *         destructor if they have not been already.
+ */
+class MPIIORequest : public Request {
+  private:
+    /// The PIOL object, kept alive for logging
+    std::shared_ptr<ExSeisPIOL> piol;
+
+    /// The name of the file, for logging
+    std::string name;
+
+    /// The pending MPI requests
+    std::vector<MPI_Request> reqs;
+
+    /*! @brief Log an MPI error.
+     *  @param[in] msg The message to be written
+     *  @param[in] err The MPI error code
+     */
+    void check(const std::string& msg, int err)
+    {
+        if (err != MPI_SUCCESS) {
+            piol->log->record(
+              name, Logger::Layer::Data, Logger::Status::Error,
+              msg + exseis::utils::MPI_error_to_string(err),
+              PIOL_VERBOSITY_NONE);
+        }
     }
 
-    fn(file, 0, d, chunk * bsz, MPI_CHAR, stat);
-    if (err != MPI_SUCCESS) {
-        return err;
+  public:
+    /*! @brief Take ownership of a set of MPI requests.
+     *  @param[in] piol_ The PIOL object
+     *  @param[in] name_ The name of the file
+     *  @param[in] reqs_ The pending MPI requests
+     */
+    MPIIORequest(
+      std::shared_ptr<ExSeisPIOL> piol_,
+      std::string name_,
+      std::vector<MPI_Request> reqs_) :
+        piol(std::move(piol_)),
+        name(std::move(name_)),
+        reqs(std::move(reqs_))
+    {
     }
 
-    // Reset the view.
-    err = MPI_File_set_view(file, 0, MPI_CHAR, MPI_CHAR, "native", info);
-    if (err != MPI_SUCCESS) {
-        return err;
+    ~MPIIORequest(void) { wait(); }
+
+    void wait(void)
+    {
+        if (!reqs.empty()) {
+            check(
+              "MPI_Waitall error: ",
+              MPI_Waitall(int(reqs.size()), reqs.data(), MPI_STATUSES_IGNORE));
+            reqs.clear();
+        }
     }
 
-    return MPI_Type_free(&type);
-}
+    bool test(void)
+    {
+        if (!reqs.empty()) {
+            int flag = 0;
+            check(
+              "MPI_Testall error: ",
+              MPI_Testall(
+                int(reqs.size()), reqs.data(), &flag, MPI_STATUSES_IGNORE));
+            if (!flag) {
+                return false;
+            }
+            reqs.clear();
+        }
+        return true;
+    }
+};
 
 /////////////////////////////    Class functions    ////////////////////////////
 
@@ -204,7 +332,9 @@ DataMPIIO::Opt::Opt(void)
 
     //    // ROMIO has this on by default. Annoying.
     //    MPI_Info_set(info, "panfs_concurrent_write", "false");
-    maxSize = exseis::utils::MPI_max_array_length<int32_t>();
+    maxSize     = exseis::utils::MPI_max_array_length<int32_t>();
+    maxHole     = 64LU * 1024LU;
+    typeCacheSz = 8LU;
 }
 
 DataMPIIO::Opt::~Opt(void)
@@ -266,6 +396,9 @@ DataMPIIO::~DataMPIIO(void)
               PIOL_VERBOSITY_NONE);
         }
     }
+    for (auto& entry : typeCache) {
+        MPI_Type_free(&entry.type);
+    }
     if (info != MPI_INFO_NULL) {
         int err = MPI_Info_free(&info);
 
@@ -281,9 +414,16 @@ DataMPIIO::~DataMPIIO(void)
 
 void DataMPIIO::Init(const DataMPIIO::Opt& opt, FileMode mode)
 {
-    coll    = opt.coll;
-    maxSize = opt.maxSize;
-    file    = MPI_FILE_NULL;
+    coll        = opt.coll;
+    maxSize     = opt.maxSize;
+    maxHole     = opt.maxHole;
+    typeCacheSz = std::max<size_t>(opt.typeCacheSz, 1LU);
+    typeHits    = 0;
+    typeMisses  = 0;
+    viewSkips   = 0;
+    viewType    = MPI_CHAR;
+    viewDisp    = 0;
+    file        = MPI_FILE_NULL;
 
     MPI_Aint lb  = 0;
     MPI_Aint esz = 0;
@@ -377,11 +517,115 @@ void DataMPIIO::setFileSz(size_t sz) const
     }
 }
 
+size_t DataMPIIO::getTypeCacheHits() const
+{
+    return typeHits;
+}
+
+size_t DataMPIIO::getTypeCacheMisses() const
+{
+    return typeMisses;
+}
+
+size_t DataMPIIO::getViewSetsSkipped() const
+{
+    return viewSkips;
+}
+
+MPI_Datatype DataMPIIO::getStrideType(size_t bsz, size_t osz) const
+{
+    const std::array<size_t, 2> key = {{bsz, osz}};
+
+    for (auto it = typeCache.begin(); it != typeCache.end(); it++) {
+        if (it->key == key) {
+            typeHits++;
+            typeCache.splice(typeCache.begin(), typeCache, it);
+            return typeCache.front().type;
+        }
+    }
+    typeMisses++;
+
+    if (typeCache.size() >= typeCacheSz) {
+        // The view keeps its own reference, but the handle may be reused.
+        if (typeCache.back().type == viewType) {
+            viewType = MPI_DATATYPE_NULL;
+        }
+        MPI_Type_free(&typeCache.back().type);
+        typeCache.pop_back();
+    }
+
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+    int err = strideType(int(bsz), MPI_Aint(osz), &type);
+    if (err != MPI_SUCCESS) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "Failed to create a strided datatype: "s
+            + exseis::utils::MPI_error_to_string(err),
+          PIOL_VERBOSITY_NONE);
+        return type;
+    }
+
+    typeCache.push_front({key, type});
+    return type;
+}
+
+void DataMPIIO::setView(MPI_Offset disp, MPI_Datatype type) const
+{
+    int err = MPI_File_set_view(file, disp, MPI_CHAR, type, "native", info);
+    if (err != MPI_SUCCESS) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "Failed to set a view: "s + exseis::utils::MPI_error_to_string(err),
+          PIOL_VERBOSITY_NONE);
+    }
+    viewDisp = disp;
+    viewType = type;
+}
+
+void DataMPIIO::reuseView(MPI_Offset disp, MPI_Datatype type) const
+{
+    // Every process leaves the default view together, so no agreement is
+    // needed to know that the view must be set.
+    if (viewType != MPI_CHAR || viewDisp != 0) {
+        size_t change = (disp != viewDisp || type != viewType);
+
+        // Setting a view is collective, so the view can only be kept if it
+        // can be kept on every process.
+        if (maxOverFile(change) == 0) {
+            viewSkips++;
+            return;
+        }
+    }
+
+    setView(disp, type);
+}
+
+void DataMPIIO::stridedView(
+  size_t offset, size_t bsz, size_t osz, size_t nb) const
+{
+    // A call without blocks, made only to match the collective calls of
+    // other processes, can use whatever strided view is already set.
+    if (nb == 0 && viewType != MPI_CHAR && viewType != MPI_DATATYPE_NULL) {
+        reuseView(viewDisp, viewType);
+        return;
+    }
+
+    reuseView(MPI_Offset(offset), getStrideType(bsz, osz));
+}
+
+void DataMPIIO::defaultView() const
+{
+    if (viewType != MPI_CHAR || viewDisp != 0) {
+        setView(0, MPI_CHAR);
+    }
+}
+
 void DataMPIIO::read(size_t offset, size_t sz, unsigned char* d) const
 {
+    defaultView();
     contigIO(
       (coll ? MPI_File_read_at_all : MPI_File_read_at), offset, sz, d,
-      " non-collective read Failure\n");
+      " non-collective read Failure\n", coll);
 }
 
 void DataMPIIO::readv(
@@ -397,21 +641,11 @@ void DataMPIIO::readv(
     }
 
     // Set a view so that MPI_File_read... functions only see contiguous data.
-    MPI_Datatype view;
-    int err = strideView(file, info, offset, bsz, osz, nb, &view);
-    if (err != MPI_SUCCESS) {
-        log_->record(
-          name_, Logger::Layer::Data, Logger::Status::Error,
-          "Failed to set a view for reading: "s
-            + exseis::utils::MPI_error_to_string(err),
-          PIOL_VERBOSITY_NONE);
-    }
-
-    read(0LU, nb * bsz, d);
+    stridedView(offset, bsz, osz, nb);
 
-    // Reset the view.
-    MPI_File_set_view(file, 0, MPI_CHAR, MPI_CHAR, "native", info);
-    MPI_Type_free(&view);
+    contigIO(
+      (coll ? MPI_File_read_at_all : MPI_File_read_at), 0LU, nb * bsz, d,
+      " strided read Failure\n", coll);
 }
 
 void DataMPIIO::read(
@@ -425,29 +659,57 @@ void DataMPIIO::read(
         return MPI_SUCCESS;
     };
 
+    // Setting a view is always collective.
     contigIO(
-      viewIO, offset, nb, d, "Failed to read data over the integer limit.", bsz,
-      osz);
+      viewIO, offset, nb, d, "Failed to read data over the integer limit.",
+      true, bsz, osz);
+
+    // Independent I/O cannot set a view, so it must be left as the default.
+    if (!coll) {
+        defaultView();
+    }
 }
 
 
+size_t DataMPIIO::extraCalls(size_t calls, bool collective) const
+{
+    if (!collective) {
+        return 0LU;
+    }
+
+    // A single MPI_Allreduce rather than gathering every process's count.
+    return maxOverFile(calls) - calls;
+}
+
+size_t DataMPIIO::maxOverFile(size_t val) const
+{
+    size_t result = 0;
+    int err       = MPI_Allreduce(
+      &val, &result, 1, exseis::utils::MPI_type<size_t>(), MPI_MAX, fcomm);
+    if (err != MPI_SUCCESS) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "MPI_Allreduce error: "s + exseis::utils::MPI_error_to_string(err),
+          PIOL_VERBOSITY_NONE);
+    }
+    return result;
+}
+
 void DataMPIIO::contigIO(
   MFp<MPI_Status> fn,
   size_t offset,
   size_t sz,
   unsigned char* d,
   std::string msg,
+  bool collective,
   size_t bsz,
   size_t osz) const
 {
     MPI_Status stat;
     size_t max = maxSize / osz;
-    auto vec   = piol_->comm->gather<size_t>(sz);
-
-    size_t remCall = *std::max_element(vec.begin(), vec.end());
 
-    remCall = (remCall / max + static_cast<size_t>(remCall % max > 0))
-              - (sz / max + static_cast<size_t>(sz % max > 0));
+    size_t remCall = extraCalls(
+      sz / max + static_cast<size_t>(sz % max > 0), collective);
 
     for (size_t i = 0; i < sz; i += max) {
         size_t chunk = std::min(sz - i, max);
@@ -476,6 +738,76 @@ void DataMPIIO::contigIO(
     }
 }
 
+std::shared_ptr<Request> DataMPIIO::icontigIO(
+  MFp<MPI_Request> fn,
+  size_t offset,
+  size_t sz,
+  unsigned char* d,
+  std::string msg) const
+{
+    std::vector<MPI_Request> reqs;
+
+    size_t remCall =
+      extraCalls(sz / maxSize + static_cast<size_t>(sz % maxSize > 0), coll);
+
+    for (size_t i = 0; i < sz; i += maxSize) {
+        size_t chunk = std::min(sz - i, maxSize);
+
+        MPI_Request req;
+        int err = fn(
+          file, MPI_Offset(offset + i), &d[i], chunk,
+          exseis::utils::MPI_type<unsigned char>(), &req);
+
+        if (err != MPI_SUCCESS) {
+            log_->record(
+              name_, Logger::Layer::Data, Logger::Status::Error,
+              msg + exseis::utils::MPI_error_to_string(err),
+              PIOL_VERBOSITY_NONE);
+        }
+        else {
+            reqs.push_back(req);
+        }
+    }
+
+    for (size_t i = 0; i < remCall; i++) {
+        MPI_Request req;
+        int err =
+          fn(file, 0, NULL, 0, exseis::utils::MPI_type<unsigned char>(), &req);
+
+        if (err != MPI_SUCCESS) {
+            log_->record(
+              name_, Logger::Layer::Data, Logger::Status::Error,
+              msg + exseis::utils::MPI_error_to_string(err),
+              PIOL_VERBOSITY_NONE);
+        }
+        else {
+            reqs.push_back(req);
+        }
+    }
+
+    return std::make_shared<MPIIORequest>(piol_, name_, std::move(reqs));
+}
+
+std::shared_ptr<Request> DataMPIIO::iread(
+  size_t offset, size_t sz, unsigned char* d) const
+{
+    defaultView();
+    return icontigIO(
+      (coll ? MPI_File_iread_at_all : MPI_File_iread_at), offset, sz, d,
+      "Non-blocking read failure: ");
+}
+
+std::shared_ptr<Request> DataMPIIO::iwrite(
+  size_t offset, size_t sz, const unsigned char* d) const
+{
+    defaultView();
+
+    /// @todo Remove const_cast
+    return icontigIO(
+      (coll ? mpiio_iwrite_at_all : mpiio_iwrite_at), offset, sz,
+      const_cast<unsigned char*>(d), "Non-blocking write failure: ");
+}
+
 // Perform I/O to acquire data corresponding to fixed-size blocks of data
 // located  according to a list of offsets.
 void DataMPIIO::listIO(
@@ -484,28 +816,64 @@ void DataMPIIO::listIO(
   size_t sz,
   const size_t* offset,
   unsigned char* d,
-  std::string msg) const
+  std::string msg,
+  size_t hole) const
 {
-    // TODO: More accurately determine a real limit for setting a view.
-    //       Is the problem strides that are too big?
-    size_t max     = maxSize / (bsz != 0 ? bsz * 2LU : 1LU);
-    size_t remCall = 0;
-    {
-        auto vec = piol_->comm->gather<size_t>(sz);
-        remCall  = *std::max_element(vec.begin(), vec.end());
-
-        remCall = remCall / max + static_cast<size_t>(remCall % max > 0)
-                  - ((sz / max) + static_cast<size_t>(sz % max > 0));
+    // Runs of blocks become single extents, so a nearly sorted list needs a
+    // handful of view entries rather than one per block.
+    const auto ext = coalesce(bsz, sz, offset, hole, maxSize);
+
+    // Group the extents into views of at most maxSize bytes.
+    std::vector<size_t> chunkStart;
+    for (size_t i = 0, bytes = 0; i < ext.size(); i++) {
+        if (chunkStart.empty() || bytes + ext[i].sz > maxSize) {
+            chunkStart.push_back(i);
+            bytes = 0;
+        }
+        bytes += ext[i].sz;
     }
+    chunkStart.push_back(ext.size());
+
+    // Setting a view is always collective, even if fn is not.
+    size_t remCall = extraCalls(chunkStart.size() - 1LU, true);
 
     MPI_Status stat;
-    for (size_t i = 0; i < sz; i += max) {
+    std::vector<int> len;
+    std::vector<MPI_Aint> off;
+    std::vector<unsigned char> sieve;
+    for (size_t c = 0; c + 1LU < chunkStart.size(); c++) {
+        const size_t first = chunkStart[c];
+        const size_t count = chunkStart[c + 1LU] - first;
+
+        len.resize(count);
+        off.resize(count);
+        size_t total = 0;
+        bool holes   = false;
+        for (size_t i = 0; i < count; i++) {
+            const Extent& e = ext[first + i];
+            len[i]          = int(e.sz);
+            off[i]          = MPI_Aint(e.offset);
+            total += e.sz;
+            holes = holes || (e.sz != e.nb * bsz);
+        }
 
-        size_t chunk = std::min(sz - i, max);
+        // Without holes, the extents map directly onto the I/O buffer.
+        unsigned char* buf = &d[ext[first].first * bsz];
+        if (holes) {
+            sieve.resize(total);
+            buf = sieve.data();
+        }
 
-        int err = iol(
-          fn, file, info, bsz, chunk,
-          reinterpret_cast<const MPI_Aint*>(&offset[i]), &d[i * bsz], &stat);
+        // Set a view so that MPI_File_read... functions only see contiguous
+        // data. The datatype holds the offsets, so it is never reused.
+        MPI_Datatype type;
+        int err = extentType(int(count), len.data(), off.data(), &type);
+        if (err == MPI_SUCCESS) {
+            setView(0, type);
+            err = fn(file, 0, buf, int(total), MPI_CHAR, &stat);
+            MPI_Type_free(&type);
+            viewType = MPI_DATATYPE_NULL;
+        }
 
         // Log and break on failure
         if (err != MPI_SUCCESS) {
@@ -516,36 +884,217 @@ void DataMPIIO::listIO(
 
             break;
         }
+
+        if (holes) {
+            const unsigned char* src = sieve.data();
+            for (size_t i = 0; i < count; i++) {
+                const Extent& e = ext[first + i];
+                for (size_t j = e.first; j < e.first + e.nb; j++) {
+                    std::copy_n(&src[offset[j] - e.offset], bsz, &d[j * bsz]);
+                }
+                src += e.sz;
+            }
+        }
     }
 
-    if (remCall != 0) {
-        for (size_t i = 0; i < remCall; i++) {
-            int err = iol(fn, file, info, 0, 0, nullptr, nullptr, &stat);
+    for (size_t i = 0; i < remCall; i++) {
+        MPI_Datatype type;
+        int err = extentType(0, nullptr, nullptr, &type);
+        if (err == MPI_SUCCESS) {
+            setView(0, type);
+            err = fn(file, 0, nullptr, 0, MPI_CHAR, &stat);
+            MPI_Type_free(&type);
+            viewType = MPI_DATATYPE_NULL;
+        }
+
+        if (err != MPI_SUCCESS) {
+            log_->record(
+              name_, Logger::Layer::Data, Logger::Status::Error,
+              msg + exseis::utils::MPI_error_to_string(err, &stat),
+              PIOL_VERBOSITY_NONE);
+        }
+    }
+
+    // A list view is never reused, and independent I/O cannot set a view,
+    // so the default is restored.
+    defaultView();
+}
 
-            if (err != MPI_SUCCESS) {
-                log_->record(
-                  name_, Logger::Layer::Data, Logger::Status::Error,
-                  msg + exseis::utils::MPI_error_to_string(err, &stat),
-                  PIOL_VERBOSITY_NONE);
+void DataMPIIO::splitIO(
+  MFp<MPI_Status> fn,
+  size_t start,
+  size_t bsz1,
+  size_t bsz2,
+  size_t sz,
+  const size_t* offset,
+  unsigned char* d1,
+  unsigned char* d2,
+  std::string msg) const
+{
+    const size_t bsz = bsz1 + bsz2;
+    const size_t per = std::max<size_t>(maxSize / std::max<size_t>(bsz, 1), 1);
+
+    // A list needs a view for each call, and setting a view is collective.
+    const bool list = (offset != nullptr);
+    size_t remCall =
+      extraCalls(sz / per + static_cast<size_t>(sz % per > 0), coll || list);
+
+    if (!list) {
+        defaultView();
+    }
+
+    MPI_Status stat;
+    for (size_t i = 0; i < sz; i += per) {
+        const size_t n = std::min(sz - i, per);
+
+        MPI_Datatype mtype;
+        int err =
+          splitType(bsz1, bsz2, n, &d1[i * bsz1], &d2[i * bsz2], &mtype);
+
+        if (err == MPI_SUCCESS && !list) {
+            err = fn(
+              file, MPI_Offset(start + i * bsz), MPI_BOTTOM, 1, mtype, &stat);
+        }
+        else if (err == MPI_SUCCESS) {
+            const auto ext = coalesce(bsz, n, &offset[i], 0LU, maxSize);
+
+            std::vector<int> len(ext.size());
+            std::vector<MPI_Aint> off(ext.size());
+            for (size_t j = 0; j < ext.size(); j++) {
+                len[j] = int(ext[j].sz);
+                off[j] = MPI_Aint(ext[j].offset);
+            }
+
+            MPI_Datatype ftype;
+            err = extentType(int(ext.size()), len.data(), off.data(), &ftype);
+            if (err == MPI_SUCCESS) {
+                setView(0, ftype);
+                err = fn(file, 0, MPI_BOTTOM, 1, mtype, &stat);
+                MPI_Type_free(&ftype);
+                viewType = MPI_DATATYPE_NULL;
             }
         }
+        MPI_Type_free(&mtype);
+
+        if (err != MPI_SUCCESS) {
+            log_->record(
+              name_, Logger::Layer::Data, Logger::Status::Error,
+              msg + exseis::utils::MPI_error_to_string(err, &stat),
+              PIOL_VERBOSITY_NONE);
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < remCall; i++) {
+        int err = MPI_SUCCESS;
+        if (list) {
+            MPI_Datatype ftype;
+            err = extentType(0, nullptr, nullptr, &ftype);
+            if (err == MPI_SUCCESS) {
+                setView(0, ftype);
+                err = fn(file, 0, nullptr, 0, MPI_CHAR, &stat);
+                MPI_Type_free(&ftype);
+                viewType = MPI_DATATYPE_NULL;
+            }
+        }
+        else {
+            err = fn(file, 0, nullptr, 0, MPI_CHAR, &stat);
+        }
+
+        if (err != MPI_SUCCESS) {
+            log_->record(
+              name_, Logger::Layer::Data, Logger::Status::Error,
+              msg + exseis::utils::MPI_error_to_string(err, &stat),
+              PIOL_VERBOSITY_NONE);
+        }
     }
+
+    // A list view is never reused, and independent I/O cannot set a view,
+    // so the default is restored.
+    if (list) {
+        defaultView();
+    }
+}
+
+void DataMPIIO::readSplit(
+  size_t offset,
+  size_t bsz1,
+  size_t bsz2,
+  size_t nb,
+  unsigned char* d1,
+  unsigned char* d2) const
+{
+    splitIO(
+      (coll ? MPI_File_read_at_all : MPI_File_read_at), offset, bsz1, bsz2,
+      nb, nullptr, d1, d2, "split read failure: ");
+}
+
+void DataMPIIO::readSplit(
+  size_t bsz1,
+  size_t bsz2,
+  size_t sz,
+  const size_t* offset,
+  unsigned char* d1,
+  unsigned char* d2) const
+{
+    // Independent reads sieve over holes, which needs the blocks staged.
+    if (!coll && maxHole != 0) {
+        DataInterface::readSplit(bsz1, bsz2, sz, offset, d1, d2);
+        return;
+    }
+
+    splitIO(
+      (coll ? MPI_File_read_at_all : MPI_File_read_at), 0LU, bsz1, bsz2, sz,
+      offset, d1, d2, "split list read failure: ");
+}
+
+void DataMPIIO::writeSplit(
+  size_t offset,
+  size_t bsz1,
+  size_t bsz2,
+  size_t nb,
+  const unsigned char* d1,
+  const unsigned char* d2) const
+{
+    /// @todo Remove const_cast
+    splitIO(
+      (coll ? mpiio_write_at_all : mpiio_write_at), offset, bsz1, bsz2, nb,
+      nullptr, const_cast<unsigned char*>(d1), const_cast<unsigned char*>(d2),
+      "split write failure: ");
+}
+
+void DataMPIIO::writeSplit(
+  size_t bsz1,
+  size_t bsz2,
+  size_t sz,
+  const size_t* offset,
+  const unsigned char* d1,
+  const unsigned char* d2) const
+{
+    /// @todo Remove const_cast
+    splitIO(
+      (coll ? mpiio_write_at_all : mpiio_write_at), 0LU, bsz1, bsz2, sz,
+      offset, const_cast<unsigned char*>(d1), const_cast<unsigned char*>(d2),
+      "split list write failure: ");
 }
 
 void DataMPIIO::read(
   size_t bsz, size_t sz, const size_t* offset, unsigned char* d) const
 {
+    // Collective buffering already reads across holes, and overlapping sieved
+    // extents from different processes would only add contention.
     listIO(
       (coll ? MPI_File_read_at_all : MPI_File_read_at), bsz, sz, offset, d,
-      "list read failure");
+      "list read failure", (coll ? 0LU : maxHole));
 }
 
 void DataMPIIO::write(
   size_t bsz, size_t sz, const size_t* offset, const unsigned char* d) const
 {
+    // Holes can only be skipped, not sieved, when writing.
     listIO(
       (coll ? mpiio_write_at_all : mpiio_write_at), bsz, sz, offset,
-      const_cast<unsigned char*>(d), "list write failure");
+      const_cast<unsigned char*>(d), "list write failure", 0LU);
 }
 
 void DataMPIIO::writev(
@@ -564,31 +1113,52 @@ void DataMPIIO::writev(
           "Write overflows MPI settings: " + msg, PIOL_VERBOSITY_NONE);
     }
 
-    // Set a view so that MPI_File_read... functions only see contiguous data.
-    MPI_Datatype view;
-    int err = strideView(file, info, offset, bsz, osz, nb, &view);
+    // Set a view so that MPI_File_write... functions only see contiguous data.
+    stridedView(offset, bsz, osz, nb);
 
-    if (err != MPI_SUCCESS) {
-        log_->record(
-          name_, Logger::Layer::Data, Logger::Status::Error,
-          "Failed to set a view for reading: "s
-            + exseis::utils::MPI_error_to_string(err),
-          PIOL_VERBOSITY_NONE);
-    }
-
-    write(0LU, nb * bsz, d);
-
-    // Reset the view.
-    MPI_File_set_view(file, 0, MPI_CHAR, MPI_CHAR, "native", info);
-    MPI_Type_free(&view);
+    /// @todo Remove const_cast
+    contigIO(
+      (coll ? mpiio_write_at_all : mpiio_write_at), 0LU, nb * bsz,
+      const_cast<unsigned char*>(d), "Strided write failure.", coll);
 }
 
 void DataMPIIO::write(size_t offset, size_t sz, const unsigned char* d) const
 {
+    defaultView();
+
     /// @todo Remove const_cast
     contigIO(
       (coll ? mpiio_write_at_all : mpiio_write_at), offset, sz,
-      const_cast<unsigned char*>(d), "Non-collective write failure.");
+      const_cast<unsigned char*>(d), "Non-collective write failure.", coll);
+}
+
+bool DataMPIIO::writeIndependent(
+  size_t offset, size_t sz, const unsigned char* d) const
+{
+    // Setting a view is collective, so another view cannot be left here.
+    if (viewType != MPI_CHAR || viewDisp != 0) {
+        return false;
+    }
+
+    MPI_Status stat;
+    for (size_t i = 0; i < sz; i += maxSize) {
+        const size_t chunk = std::min<size_t>(sz - i, maxSize);
+
+        /// @todo Remove const_cast
+        int err = MPI_File_write_at(
+          file, MPI_Offset(offset + i), const_cast<unsigned char*>(&d[i]),
+          int(chunk), MPI_CHAR, &stat);
+
+        if (err != MPI_SUCCESS) {
+            log_->record(
+              name_, Logger::Layer::Data, Logger::Status::Error,
+              "Independent write failure."
+                + exseis::utils::MPI_error_to_string(err, &stat),
+              PIOL_VERBOSITY_NONE);
+            break;
+        }
+    }
+    return true;
 }
 
 void DataMPIIO::write(
@@ -606,9 +1176,15 @@ void DataMPIIO::write(
     };
 
     /// @todo remove const_cast
+    // Setting a view is always collective.
     contigIO(
       viewIO, offset, nb, const_cast<unsigned char*>(d),
-      "Failed to read data over the integer limit.", bsz, osz);
+      "Failed to read data over the integer limit.", true, bsz, osz);
+
+    // Independent I/O cannot set a view, so it must be left as the default.
+    if (!coll) {
+        defaultView();
+    }
 }
 
 }  // namespace PIOL
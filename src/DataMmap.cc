@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of \c DataMmap
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExSeisDat/PIOL/ExSeisPIOL.hh"
+
+#include "ExSeisDat/PIOL/DataMmap.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std::string_literals;
+
+namespace exseis {
+namespace PIOL {
+
+/////////////////////////////       Non-Class      /////////////////////////////
+
+/*! Get the madvise flag for an access pattern
+ *  @param[in] pattern The generic access pattern.
+ *  @return The madvise flag associated with the input enum
+ */
+int getMadvise(AccessPattern pattern)
+{
+    switch (pattern) {
+        default:
+        case AccessPattern::Normal:
+            return MADV_NORMAL;
+
+        case AccessPattern::Sequential:
+            return MADV_SEQUENTIAL;
+
+        case AccessPattern::Random:
+            return MADV_RANDOM;
+    }
+}
+
+/////////////////////////////    Class functions    ////////////////////////////
+
+//////////////////////      Constructor & Destructor      //////////////////////
+DataMmap::Opt::Opt(void)
+{
+    populate = false;
+}
+
+DataMmap::DataMmap(
+  std::shared_ptr<ExSeisPIOL> piol,
+  std::string name,
+  const DataMmap::Opt& opt,
+  FileMode mode) :
+    PIOL::DataInterface(piol, name)
+{
+    Init(opt, mode);
+}
+
+DataMmap::DataMmap(
+  std::shared_ptr<ExSeisPIOL> piol, std::string name, FileMode mode) :
+    PIOL::DataInterface(piol, name)
+{
+    const DataMmap::Opt opt;
+    Init(opt, mode);
+}
+
+DataMmap::~DataMmap(void)
+{
+    if (base != nullptr) {
+        if (munmap(base, fsz) != 0) {
+            log_->record(
+              name_, Logger::Layer::Data, Logger::Status::Error,
+              "munmap error: "s + std::strerror(errno), PIOL_VERBOSITY_NONE);
+        }
+    }
+
+    if (fd != -1) {
+        if (close(fd) != 0) {
+            log_->record(
+              name_, Logger::Layer::Data, Logger::Status::Error,
+              "close error: "s + std::strerror(errno), PIOL_VERBOSITY_NONE);
+        }
+    }
+}
+
+void DataMmap::Init(const DataMmap::Opt& opt, FileMode mode)
+{
+    fd      = -1;
+    base    = nullptr;
+    fsz     = 0;
+    pattern = AccessPattern::Normal;
+
+    if (mode != FileMode::Read) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "DataMmap only supports FileMode::Read", PIOL_VERBOSITY_NONE);
+        return;
+    }
+
+    fd = open(name_.c_str(), O_RDONLY);
+    if (fd == -1) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "open error: "s + std::strerror(errno), PIOL_VERBOSITY_NONE);
+        return;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "fstat error: "s + std::strerror(errno), PIOL_VERBOSITY_NONE);
+        return;
+    }
+    fsz = size_t(info.st_size);
+
+    // A zero length mapping is not allowed, but there is nothing to read.
+    if (fsz == 0) {
+        return;
+    }
+
+    int flags = MAP_SHARED | (opt.populate ? MAP_POPULATE : 0);
+    void* ptr = mmap(nullptr, fsz, PROT_READ, flags, fd, 0);
+    if (ptr == MAP_FAILED) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "mmap error: "s + std::strerror(errno), PIOL_VERBOSITY_NONE);
+        return;
+    }
+    base = static_cast<unsigned char*>(ptr);
+}
+
+/////////////////////////       Member functions      //////////////////////////
+
+bool DataMmap::isFileNull() const
+{
+    return fd == -1;
+}
+
+size_t DataMmap::getFileSz() const
+{
+    return fsz;
+}
+
+void DataMmap::readOnly(const std::string& op) const
+{
+    log_->record(
+      name_, Logger::Layer::Data, Logger::Status::Error,
+      op + " called on a read-only memory-mapped file", PIOL_VERBOSITY_NONE);
+}
+
+void DataMmap::setFileSz(size_t) const
+{
+    readOnly("setFileSz");
+}
+
+const unsigned char* DataMmap::map(size_t offset, size_t sz) const
+{
+    if (base == nullptr || offset > fsz || sz > fsz - offset) {
+        return nullptr;
+    }
+    return base + offset;
+}
+
+void DataMmap::advise(AccessPattern pattern_) const
+{
+    if (base == nullptr || pattern_ == pattern) {
+        return;
+    }
+
+    if (madvise(base, fsz, getMadvise(pattern_)) != 0) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Warning,
+          "madvise error: "s + std::strerror(errno), PIOL_VERBOSITY_NONE);
+    }
+    pattern = pattern_;
+}
+
+void DataMmap::copyOut(size_t offset, size_t sz, unsigned char* d) const
+{
+    // Reading past the end of the file is allowed and leaves d untouched.
+    if (offset >= fsz) {
+        return;
+    }
+    std::copy_n(base + offset, std::min(sz, fsz - offset), d);
+}
+
+void DataMmap::read(size_t offset, size_t sz, unsigned char* d) const
+{
+    copyOut(offset, sz, d);
+}
+
+void DataMmap::read(
+  size_t offset, size_t bsz, size_t osz, size_t nb, unsigned char* d) const
+{
+    for (size_t i = 0; i < nb; i++) {
+        copyOut(offset + i * osz, bsz, &d[i * bsz]);
+    }
+}
+
+void DataMmap::read(
+  size_t bsz, size_t sz, const size_t* offset, unsigned char* d) const
+{
+    for (size_t i = 0; i < sz; i++) {
+        copyOut(offset[i], bsz, &d[i * bsz]);
+    }
+}
+
+void DataMmap::write(size_t, size_t sz, const unsigned char*) const
+{
+    if (sz != 0) {
+        readOnly("write");
+    }
+}
+
+void DataMmap::write(
+  size_t, size_t bsz, size_t, size_t nb, const unsigned char*) const
+{
+    if (bsz * nb != 0) {
+        readOnly("write");
+    }
+}
+
+void DataMmap::write(
+  size_t bsz, size_t sz, const size_t*, const unsigned char*) const
+{
+    if (bsz * sz != 0) {
+        readOnly("write");
+    }
+}
+
+}  // namespace PIOL
+}  // namespace exseis
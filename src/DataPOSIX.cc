@@ -0,0 +1,384 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of \c DataPOSIX
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExSeisDat/PIOL/ExSeisPIOL.hh"
+
+#include "ExSeisDat/PIOL/DataPOSIX.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std::string_literals;
+
+namespace exseis {
+namespace PIOL {
+
+/////////////////////////////       Non-Class      /////////////////////////////
+
+/*! Get a POSIX open flag
+ *  @param[in] mode The generic input mode.
+ *  @return The POSIX open flag associated with the input enum
+ */
+int getPOSIXMode(FileMode mode)
+{
+    switch (mode) {
+        default:
+        case FileMode::Read:
+            return O_RDONLY;
+
+        case FileMode::Write:
+            return O_CREAT | O_WRONLY;
+
+        case FileMode::ReadWrite:
+        case FileMode::Test:
+            return O_CREAT | O_RDWR;
+    }
+}
+
+/*! Read into a list of buffers from a contiguous region of a file, retrying on
+ *  short reads. Reading stops early, without error, at the end of the file.
+ *  @param[in] fd The file descriptor
+ *  @param[in] offset The offset in bytes from the start of the file
+ *  @param[in, out] iov The list of buffers. It is modified by the call.
+ *  @return Return 0 on success, otherwise the errno value of the failure.
+ */
+int preadvAll(int fd, size_t offset, std::vector<struct iovec>& iov)
+{
+    size_t i = 0;
+    while (i < iov.size()) {
+        int cnt = static_cast<int>(std::min<size_t>(iov.size() - i, IOV_MAX));
+
+        ssize_t n = preadv(fd, &iov[i], cnt, off_t(offset));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        if (n == 0) {
+            return 0;
+        }
+
+        offset += size_t(n);
+
+        // Skip the buffers which were filled and trim a partially filled one
+        size_t rem = size_t(n);
+        while (i < iov.size() && rem >= iov[i].iov_len) {
+            rem -= iov[i].iov_len;
+            i++;
+        }
+        if (rem != 0) {
+            iov[i].iov_base =
+              static_cast<unsigned char*>(iov[i].iov_base) + rem;
+            iov[i].iov_len -= rem;
+        }
+    }
+    return 0;
+}
+
+/*! Write a buffer to a contiguous region of a file, retrying on short writes.
+ *  @param[in] fd The file descriptor
+ *  @param[in] offset The offset in bytes from the start of the file
+ *  @param[in] sz The number of bytes to write
+ *  @param[in] d The buffer to write from
+ *  @return Return 0 on success, otherwise the errno value of the failure.
+ */
+int pwriteAll(int fd, size_t offset, size_t sz, const unsigned char* d)
+{
+    while (sz != 0) {
+        ssize_t n = pwrite(fd, d, sz, off_t(offset));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        offset += size_t(n);
+        d += n;
+        sz -= size_t(n);
+    }
+    return 0;
+}
+
+/*! Read blocks of data where the location of each block is given by a
+ *  function. Runs of blocks in increasing order separated by gaps of at most
+ *  \c maxHole bytes are read with a single preadv call, with the gaps read
+ *  into a scratch buffer.
+ *  @tparam Offset The type of the offset function
+ *  @param[in] fd The file descriptor
+ *  @param[in] bsz The block size in bytes
+ *  @param[in] sz The number of blocks
+ *  @param[in] offset A function returning the file offset of the ith block
+ *  @param[out] d The array to store the output in
+ *  @param[in] maxHole The largest gap in bytes which will be read over
+ *  @return Return 0 on success, otherwise the errno value of the failure.
+ */
+template<class Offset>
+int readRuns(
+  int fd,
+  size_t bsz,
+  size_t sz,
+  Offset offset,
+  unsigned char* d,
+  size_t maxHole)
+{
+    std::vector<unsigned char> hole;
+    std::vector<struct iovec> iov;
+
+    size_t i = 0;
+    while (i < sz) {
+        const size_t start = offset(i);
+        size_t end         = start + bsz;
+
+        iov.clear();
+        iov.push_back({&d[i * bsz], bsz});
+
+        for (i++; i < sz; i++) {
+            const size_t next = offset(i);
+            if (next < end || next - end > maxHole) {
+                break;
+            }
+
+            const size_t gap = next - end;
+            if (gap != 0) {
+                // Sized once so earlier iovecs into it stay valid
+                if (hole.empty()) {
+                    hole.resize(maxHole);
+                }
+                iov.push_back({hole.data(), gap});
+                iov.push_back({&d[i * bsz], bsz});
+            }
+            else {
+                // The destination buffer is contiguous too
+                iov.back().iov_len += bsz;
+            }
+            end = next + bsz;
+        }
+
+        int err = preadvAll(fd, start, iov);
+        if (err != 0) {
+            return err;
+        }
+    }
+    return 0;
+}
+
+/*! Write blocks of data where the location of each block is given by a
+ *  function. Runs of adjacent blocks are merged into a single pwrite call.
+ *  @tparam Offset The type of the offset function
+ *  @param[in] fd The file descriptor
+ *  @param[in] bsz The block size in bytes
+ *  @param[in] sz The number of blocks
+ *  @param[in] offset A function returning the file offset of the ith block
+ *  @param[in] d The array to read data output from
+ *  @return Return 0 on success, otherwise the errno value of the failure.
+ */
+template<class Offset>
+int writeRuns(
+  int fd, size_t bsz, size_t sz, Offset offset, const unsigned char* d)
+{
+    size_t i = 0;
+    while (i < sz) {
+        const size_t start = offset(i);
+        const size_t first = i;
+        for (i++; i < sz && offset(i) == start + (i - first) * bsz; i++) {
+        }
+
+        int err = pwriteAll(fd, start, (i - first) * bsz, &d[first * bsz]);
+        if (err != 0) {
+            return err;
+        }
+    }
+    return 0;
+}
+
+/////////////////////////////    Class functions    ////////////////////////////
+
+//////////////////////      Constructor & Destructor      //////////////////////
+DataPOSIX::Opt::Opt(void)
+{
+    maxHole = 64LU * 1024LU;
+}
+
+DataPOSIX::DataPOSIX(
+  std::shared_ptr<ExSeisPIOL> piol,
+  std::string name,
+  const DataPOSIX::Opt& opt,
+  FileMode mode) :
+    PIOL::DataInterface(piol, name)
+{
+    Init(opt, mode);
+}
+
+DataPOSIX::DataPOSIX(
+  std::shared_ptr<ExSeisPIOL> piol, std::string name, FileMode mode) :
+    PIOL::DataInterface(piol, name)
+{
+    const DataPOSIX::Opt opt;
+    Init(opt, mode);
+}
+
+DataPOSIX::~DataPOSIX(void)
+{
+    if (fd != -1) {
+        if (close(fd) != 0) {
+            log_->record(
+              name_, Logger::Layer::Data, Logger::Status::Error,
+              "close error: "s + std::strerror(errno), PIOL_VERBOSITY_NONE);
+        }
+    }
+
+    // Emulate MPI_MODE_DELETE_ON_CLOSE once every process is finished.
+    if (mode == FileMode::Test) {
+        piol_->comm->barrier();
+        if (piol_->comm->getRank() == 0) {
+            unlink(name_.c_str());
+        }
+    }
+}
+
+void DataPOSIX::Init(const DataPOSIX::Opt& opt, FileMode mode_)
+{
+    mode    = mode_;
+    maxHole = opt.maxHole;
+
+    fd = open(name_.c_str(), getPOSIXMode(mode), 0666);
+    if (fd == -1) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "open error: "s + std::strerror(errno), PIOL_VERBOSITY_NONE);
+    }
+}
+
+/////////////////////////       Member functions      //////////////////////////
+
+bool DataPOSIX::isFileNull() const
+{
+    return fd == -1;
+}
+
+size_t DataPOSIX::getFileSz() const
+{
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "fstat error: "s + std::strerror(errno), PIOL_VERBOSITY_NONE);
+        return 0LU;
+    }
+
+    return size_t(info.st_size);
+}
+
+void DataPOSIX::setFileSz(size_t sz) const
+{
+    if (ftruncate(fd, off_t(sz)) != 0) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "ftruncate error: "s + std::strerror(errno), PIOL_VERBOSITY_NONE);
+    }
+}
+
+void DataPOSIX::read(size_t offset, size_t sz, unsigned char* d) const
+{
+    if (sz == 0) {
+        return;
+    }
+
+    std::vector<struct iovec> iov = {{d, sz}};
+
+    int err = preadvAll(fd, offset, iov);
+    if (err != 0) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "pread error: "s + std::strerror(err), PIOL_VERBOSITY_NONE);
+    }
+}
+
+void DataPOSIX::read(
+  size_t offset, size_t bsz, size_t osz, size_t nb, unsigned char* d) const
+{
+    int err = readRuns(
+      fd, bsz, nb, [offset, osz](size_t i) { return offset + i * osz; }, d,
+      maxHole);
+
+    if (err != 0) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "Strided preadv error: "s + std::strerror(err), PIOL_VERBOSITY_NONE);
+    }
+}
+
+void DataPOSIX::read(
+  size_t bsz, size_t sz, const size_t* offset, unsigned char* d) const
+{
+    int err = readRuns(
+      fd, bsz, sz, [offset](size_t i) { return offset[i]; }, d, maxHole);
+
+    if (err != 0) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "List preadv error: "s + std::strerror(err), PIOL_VERBOSITY_NONE);
+    }
+}
+
+void DataPOSIX::write(size_t offset, size_t sz, const unsigned char* d) const
+{
+    int err = pwriteAll(fd, offset, sz, d);
+
+    if (err != 0) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "pwrite error: "s + std::strerror(err), PIOL_VERBOSITY_NONE);
+    }
+}
+
+bool DataPOSIX::writeIndependent(
+  size_t offset, size_t sz, const unsigned char* d) const
+{
+    write(offset, sz, d);
+    return true;
+}
+
+void DataPOSIX::write(
+  size_t offset,
+  size_t bsz,
+  size_t osz,
+  size_t nb,
+  const unsigned char* d) const
+{
+    int err = writeRuns(
+      fd, bsz, nb, [offset, osz](size_t i) { return offset + i * osz; }, d);
+
+    if (err != 0) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "Strided pwrite error: "s + std::strerror(err), PIOL_VERBOSITY_NONE);
+    }
+}
+
+void DataPOSIX::write(
+  size_t bsz, size_t sz, const size_t* offset, const unsigned char* d) const
+{
+    int err =
+      writeRuns(fd, bsz, sz, [offset](size_t i) { return offset[i]; }, d);
+
+    if (err != 0) {
+        log_->record(
+          name_, Logger::Layer::Data, Logger::Status::Error,
+          "List pwrite error: "s + std::strerror(err), PIOL_VERBOSITY_NONE);
+    }
+}
+
+}  // namespace PIOL
+}  // namespace exseis
@@ -8,6 +8,8 @@ ExSeisPIOL::ExSeisPIOL(
 {
     log  = std::make_unique<Logger>(maxLevel);
     comm = std::make_unique<CommunicatorMPI>(log.get(), copt);
+
+    numThreads = 1;
 }
 
 void ExSeisPIOL::isErr(const std::string& msg) const
@@ -42,12 +42,13 @@ std::shared_ptr<TraceBlock> Cache::getCache(
         for (auto& f : desc) {
             f->ifc->readParamNonContiguous(
               f->ilst.size(), f->ilst.data(), prm.get(), loff);
+            param_utils::WritableParamColumn<size_t> gtn(
+              PIOL_META_gtn, prm.get());
+            param_utils::WritableParamColumn<size_t> ltn(
+              PIOL_META_ltn, prm.get());
             for (size_t i = 0LU; i < f->ilst.size(); i++) {
-                param_utils::setPrm(
-                  loff + i, PIOL_META_gtn, off + loff + f->ilst[i], prm.get());
-                param_utils::setPrm(
-                  loff + i, PIOL_META_ltn, f->ilst[i] * desc.size() + c,
-                  prm.get());
+                gtn.set(loff + i, off + loff + f->ilst[i]);
+                ltn.set(loff + i, f->ilst[i] * desc.size() + c);
             }
             c++;
             loff += f->ilst.size();
@@ -104,9 +105,7 @@ std::vector<size_t> Cache::getOutputTrace(
         }
 
         std::vector<size_t> sortlist = getSortIndex(sz, final.data());
-        for (size_t j = 0LU; j < sz; j++) {
-            param_utils::cpyPrm(sortlist[j], iprm, j, prm);
-        }
+        param_utils::permutePrm(sz, sortlist.data(), iprm, 0LU, prm);
     }
 
     return final;
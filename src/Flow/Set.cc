@@ -30,6 +30,19 @@ typedef std::function<void(const TraceBlock* in, TraceBlock* out)> Mod;
 /// traces/parameters
 typedef std::function<std::vector<size_t>(TraceBlock* data)> InPlaceMod;
 
+/*! Open an output file which holds traces back until 64MiB are ready, so the
+ *  blocks and gathers of a Set are written with few large writes.
+ *  @param[in] piol The piol shared object
+ *  @param[in] name The name of the file
+ *  @return Return the file
+ */
+static std::unique_ptr<WriteInterface> makeOutput(
+  std::shared_ptr<ExSeisPIOL> piol, const std::string& name)
+{
+    WriteSEGY::Opt opt;
+    opt.writeBehindSz = 64LU * 1024LU * 1024LU;
+    return makeFile<WriteSEGY>(piol, name, opt);
+}
 
 Set::Set(
   std::shared_ptr<ExSeisPIOL> piol_,
@@ -193,7 +206,7 @@ std::vector<std::string> Set::startSingle(
 
         names.push_back(name);
 
-        std::unique_ptr<WriteInterface> out = makeFile<WriteSEGY>(piol, name);
+        std::unique_ptr<WriteInterface> out = makeOutput(piol, name);
         // TODO: Will need to delay ns call depending for operations that modify
         //       the number of samples per trace
         out->writeNs(ns);
@@ -234,11 +247,11 @@ std::vector<std::string> Set::startSingle(
                 bIn->ns  = ns;
                 bIn->inc = inc;
 
+                param_utils::permutePrm(
+                  rblock, sortlist.data(), &prm, 0LU, bIn->prm.get());
+                param_utils::permuteTrc(
+                  rblock, sortlist.data(), ns, trc.data(), bIn->trc.data());
                 for (size_t j = 0LU; j < rblock; j++) {
-                    param_utils::cpyPrm(sortlist[j], &prm, j, bIn->prm.get());
-                    for (size_t k = 0LU; k < ns; k++) {
-                        bIn->trc[j * ns + k] = trc[sortlist[j] * ns + k];
-                    }
                     sortlist[j] = f->olst[i + sortlist[j]];
                 }
 
@@ -322,7 +335,7 @@ std::string Set::startGather(
         gname = (fTemp != fEnd ? "gtemp.segy" : outfix + ".segy");
 
         // Use inputs as default values. These can be changed later
-        std::unique_ptr<WriteInterface> out = makeFile<WriteSEGY>(piol, gname);
+        std::unique_ptr<WriteInterface> out = makeOutput(piol, gname);
 
         size_t wOffset = 0LU;
         size_t iOffset = 0LU;
@@ -650,13 +663,15 @@ void Set::toAngle(
               }
           }
 
+          param_utils::WritableParamColumn<exseis::utils::Integer> il(
+            PIOL_META_il, out->prm.get());
+          param_utils::WritableParamColumn<exseis::utils::Integer> xl(
+            PIOL_META_xl, out->prm.get());
           for (size_t j = 0; j < state->oGSz; j++) {
               // TODO: Set the rest of the parameters
               // TODO: Check the get numbers
-              param_utils::setPrm(
-                j, PIOL_META_il, state->il[in->gNum], out->prm.get());
-              param_utils::setPrm(
-                j, PIOL_META_xl, state->xl[in->gNum], out->prm.get());
+              il.set(j, state->il[in->gNum]);
+              xl.set(j, state->xl[in->gNum]);
           }
       }));
 }
@@ -7,9 +7,15 @@
 /// @details
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "ExSeisDat/PIOL/DataCache.hh"
 #include "ExSeisDat/PIOL/DataInterface.hh"
 #include "ExSeisDat/PIOL/ObjectInterface.hh"
 #include "ExSeisDat/PIOL/ObjectSEGY.hh"
+#include "ExSeisDat/PIOL/ObjectSU.hh"
+#include "ExSeisDat/PIOL/segy_utils.hh"
+
+#include <algorithm>
+#include <vector>
 
 namespace exseis {
 namespace PIOL {
@@ -17,10 +23,22 @@ namespace PIOL {
 std::shared_ptr<ObjectInterface> makeDefaultObj(
   std::shared_ptr<ExSeisPIOL> piol, std::string name, FileMode mode)
 {
-    auto data = std::make_shared<DataMPIIO>(piol, name, mode);
+    std::shared_ptr<DataInterface> data =
+      std::make_shared<DataMPIIO>(piol, name, mode);
+    if (mode == FileMode::Read && piol->blockCache != nullptr) {
+        data = std::make_shared<DataCache>(piol, name, data, piol->blockCache);
+    }
+    if (isSUFile(name)) {
+        return std::make_shared<ObjectSU>(piol, name, data, mode);
+    }
     return std::make_shared<ObjectSEGY>(piol, name, data, mode);
 }
 
+size_t ObjectInterface::getHOSz(void) const
+{
+    return SEGY_utils::getHOSz();
+}
+
 size_t ObjectInterface::getFileSz(void) const
 {
     return data_->getFileSz();
@@ -31,5 +49,273 @@ void ObjectInterface::setFileSz(const size_t sz) const
     return data_->setFileSz(sz);
 }
 
+void ObjectInterface::advise(AccessPattern pattern) const
+{
+    if (data_ != nullptr) {
+        data_->advise(pattern);
+    }
+}
+
+const unsigned char* ObjectInterface::mapDO(size_t, size_t, size_t) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<Request> ObjectInterface::ireadDO(
+  size_t offset, size_t ns, size_t sz, unsigned char* d) const
+{
+    readDO(offset, ns, sz, d);
+    return std::make_shared<CompletedRequest>();
+}
+
+std::shared_ptr<Request> ObjectInterface::iwriteDO(
+  size_t offset, size_t ns, size_t sz, const unsigned char* d) const
+{
+    writeDO(offset, ns, sz, d);
+    return std::make_shared<CompletedRequest>();
+}
+
+bool ObjectInterface::writeDOIndependent(
+  size_t, size_t, size_t, const unsigned char*) const
+{
+    return false;
+}
+
+/*! Split whole data-objects into their metadata and data-fields.
+ *  @param[in]  dobj The data-objects
+ *  @param[in]  dfsz The size of a data-field in bytes
+ *  @param[in]  sz   The number of data-objects
+ *  @param[out] md   The metadata blocks
+ *  @param[out] df   The data-fields
+ */
+static void splitDO(
+  const unsigned char* dobj,
+  size_t dfsz,
+  size_t sz,
+  unsigned char* md,
+  unsigned char* df)
+{
+    const size_t mdsz = SEGY_utils::getMDSz();
+    for (size_t i = 0; i < sz; i++) {
+        std::copy_n(&dobj[i * (mdsz + dfsz)], mdsz, &md[i * mdsz]);
+        std::copy_n(&dobj[i * (mdsz + dfsz) + mdsz], dfsz, &df[i * dfsz]);
+    }
+}
+
+/*! Join metadata and data-fields into whole data-objects.
+ *  @param[in]  md   The metadata blocks
+ *  @param[in]  df   The data-fields
+ *  @param[in]  dfsz The size of a data-field in bytes
+ *  @param[in]  sz   The number of data-objects
+ *  @param[out] dobj The data-objects
+ */
+static void joinDO(
+  const unsigned char* md,
+  const unsigned char* df,
+  size_t dfsz,
+  size_t sz,
+  unsigned char* dobj)
+{
+    const size_t mdsz = SEGY_utils::getMDSz();
+    for (size_t i = 0; i < sz; i++) {
+        std::copy_n(&md[i * mdsz], mdsz, &dobj[i * (mdsz + dfsz)]);
+        std::copy_n(&df[i * dfsz], dfsz, &dobj[i * (mdsz + dfsz) + mdsz]);
+    }
+}
+
+void ObjectInterface::readDO(
+  size_t offset,
+  size_t ns,
+  size_t sz,
+  unsigned char* md,
+  unsigned char* df) const
+{
+    std::vector<unsigned char> dobj(sz * SEGY_utils::getDOSz(ns, sampleSz_));
+    readDO(offset, ns, sz, dobj.data());
+    splitDO(dobj.data(), SEGY_utils::getDFSz(ns, sampleSz_), sz, md, df);
+}
+
+void ObjectInterface::writeDO(
+  size_t offset,
+  size_t ns,
+  size_t sz,
+  const unsigned char* md,
+  const unsigned char* df) const
+{
+    std::vector<unsigned char> dobj(sz * SEGY_utils::getDOSz(ns, sampleSz_));
+    joinDO(md, df, SEGY_utils::getDFSz(ns, sampleSz_), sz, dobj.data());
+    writeDO(offset, ns, sz, dobj.data());
+}
+
+void ObjectInterface::readDO(
+  const size_t* offset,
+  size_t ns,
+  size_t sz,
+  unsigned char* md,
+  unsigned char* df) const
+{
+    std::vector<unsigned char> dobj(sz * SEGY_utils::getDOSz(ns, sampleSz_));
+    readDO(offset, ns, sz, dobj.data());
+    splitDO(dobj.data(), SEGY_utils::getDFSz(ns, sampleSz_), sz, md, df);
+}
+
+void ObjectInterface::writeDO(
+  const size_t* offset,
+  size_t ns,
+  size_t sz,
+  const unsigned char* md,
+  const unsigned char* df) const
+{
+    std::vector<unsigned char> dobj(sz * SEGY_utils::getDOSz(ns, sampleSz_));
+    joinDO(md, df, SEGY_utils::getDFSz(ns, sampleSz_), sz, dobj.data());
+    writeDO(offset, ns, sz, dobj.data());
+}
+
+/*! Copy part of each metadata block.
+ *  @param[in]  md   The metadata blocks
+ *  @param[in]  sz   The number of blocks
+ *  @param[in]  skip The first byte of the part
+ *  @param[in]  bsz  The size of the part in bytes
+ *  @param[out] part The parts
+ */
+static void partMD(
+  const unsigned char* md,
+  size_t sz,
+  size_t skip,
+  size_t bsz,
+  unsigned char* part)
+{
+    const size_t mdsz = SEGY_utils::getMDSz();
+    for (size_t i = 0; i < sz; i++) {
+        std::copy_n(&md[i * mdsz + skip], bsz, &part[i * bsz]);
+    }
+}
+
+void ObjectInterface::readDOMD(
+  size_t offset,
+  size_t ns,
+  size_t sz,
+  size_t skip,
+  size_t bsz,
+  unsigned char* md) const
+{
+    std::vector<unsigned char> whole(sz * SEGY_utils::getMDSz());
+    readDOMD(offset, ns, sz, whole.data());
+    partMD(whole.data(), sz, skip, bsz, md);
+}
+
+void ObjectInterface::readDOMD(
+  const size_t* offset,
+  size_t ns,
+  size_t sz,
+  size_t skip,
+  size_t bsz,
+  unsigned char* md) const
+{
+    std::vector<unsigned char> whole(sz * SEGY_utils::getMDSz());
+    readDOMD(offset, ns, sz, whole.data());
+    partMD(whole.data(), sz, skip, bsz, md);
+}
+
+/*! Copy part of each data-field.
+ *  @param[in]  df   The data-fields
+ *  @param[in]  dfsz The size of a data-field in bytes
+ *  @param[in]  sz   The number of data-fields
+ *  @param[in]  skip The first byte of the part
+ *  @param[in]  bsz  The size of the part in bytes
+ *  @param[out] part The parts
+ */
+static void partDF(
+  const unsigned char* df,
+  size_t dfsz,
+  size_t sz,
+  size_t skip,
+  size_t bsz,
+  unsigned char* part)
+{
+    for (size_t i = 0; i < sz; i++) {
+        std::copy_n(&df[i * dfsz + skip], bsz, &part[i * bsz]);
+    }
+}
+
+/*! Copy parts into each data-field.
+ *  @param[in]     part The parts
+ *  @param[in]     dfsz The size of a data-field in bytes
+ *  @param[in]     sz   The number of data-fields
+ *  @param[in]     skip The first byte of the part
+ *  @param[in]     bsz  The size of the part in bytes
+ *  @param[in,out] df   The data-fields
+ */
+static void mergeDF(
+  const unsigned char* part,
+  size_t dfsz,
+  size_t sz,
+  size_t skip,
+  size_t bsz,
+  unsigned char* df)
+{
+    for (size_t i = 0; i < sz; i++) {
+        std::copy_n(&part[i * bsz], bsz, &df[i * dfsz + skip]);
+    }
+}
+
+void ObjectInterface::readDODF(
+  size_t offset,
+  size_t ns,
+  size_t sz,
+  size_t skip,
+  size_t bsz,
+  unsigned char* df) const
+{
+    const size_t dfsz = SEGY_utils::getDFSz(ns, sampleSz_);
+    std::vector<unsigned char> whole(sz * dfsz);
+    readDODF(offset, ns, sz, whole.data());
+    partDF(whole.data(), dfsz, sz, skip, bsz, df);
+}
+
+void ObjectInterface::readDODF(
+  const size_t* offset,
+  size_t ns,
+  size_t sz,
+  size_t skip,
+  size_t bsz,
+  unsigned char* df) const
+{
+    const size_t dfsz = SEGY_utils::getDFSz(ns, sampleSz_);
+    std::vector<unsigned char> whole(sz * dfsz);
+    readDODF(offset, ns, sz, whole.data());
+    partDF(whole.data(), dfsz, sz, skip, bsz, df);
+}
+
+void ObjectInterface::writeDODF(
+  size_t offset,
+  size_t ns,
+  size_t sz,
+  size_t skip,
+  size_t bsz,
+  const unsigned char* df) const
+{
+    const size_t dfsz = SEGY_utils::getDFSz(ns, sampleSz_);
+    std::vector<unsigned char> whole(sz * dfsz);
+    readDODF(offset, ns, sz, whole.data());
+    mergeDF(df, dfsz, sz, skip, bsz, whole.data());
+    writeDODF(offset, ns, sz, whole.data());
+}
+
+void ObjectInterface::writeDODF(
+  const size_t* offset,
+  size_t ns,
+  size_t sz,
+  size_t skip,
+  size_t bsz,
+  const unsigned char* df) const
+{
+    const size_t dfsz = SEGY_utils::getDFSz(ns, sampleSz_);
+    std::vector<unsigned char> whole(sz * dfsz);
+    readDODF(offset, ns, sz, whole.data());
+    mergeDF(df, dfsz, sz, skip, bsz, whole.data());
+    writeDODF(offset, ns, sz, whole.data());
+}
+
 }  // namespace PIOL
 }  // namespace exseis
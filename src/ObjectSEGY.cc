@@ -10,17 +10,40 @@
 #include "ExSeisDat/PIOL/ObjectSEGY.hh"
 #include "ExSeisDat/PIOL/segy_utils.hh"
 
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
 namespace exseis {
 namespace PIOL {
 
+/////////////////////////////       Non-Class      /////////////////////////////
+
+/// The fewest blocks a read must cover for its timing to be used to tune the
+/// adaptive read strategy. Smaller reads are dominated by fixed costs.
+const size_t calibrationBlocks = 64LU;
+
 //////////////////////      Constructor & Destructor      //////////////////////
+ObjectSEGY::Opt::Opt(void)
+{
+    strategy   = ReadStrategy::Adaptive;
+    maxHole    = 4LU * 1024LU;
+    wholeBufSz = 16LU * 1024LU * 1024LU;
+}
+
 ObjectSEGY::ObjectSEGY(
   std::shared_ptr<ExSeisPIOL> piol_,
   std::string name_,
-  const ObjectSEGY::Opt&,
+  const ObjectSEGY::Opt& opt_,
   std::shared_ptr<DataInterface> data_,
   FileMode) :
-    ObjectInterface(piol_, name_, data_)
+    ObjectInterface(piol_, name_, data_),
+    strategy(opt_.strategy),
+    maxHole(opt_.maxHole),
+    wholeBufSz(opt_.wholeBufSz),
+    wholeCost(0),
+    stridedCost(0),
+    stridedBsz(0)
 {
 }
 
@@ -28,21 +51,193 @@ ObjectSEGY::ObjectSEGY(
   std::shared_ptr<ExSeisPIOL> piol_,
   std::string name_,
   std::shared_ptr<DataInterface> data_,
-  FileMode) :
-    ObjectInterface(piol_, name_, data_)
+  FileMode mode) :
+    ObjectSEGY(piol_, name_, ObjectSEGY::Opt(), data_, mode)
 {
 }
 
 //////////////////////////       Member functions      /////////////////////////
+size_t ObjectSEGY::getMaxHole(void) const
+{
+    return maxHole;
+}
+
+size_t ObjectSEGY::getDOLoc(const size_t i, const size_t ns) const
+{
+    return getHOSz() + i * SEGY_utils::getDOSz(ns, sampleSz_);
+}
+
+size_t ObjectSEGY::getDODFLoc(const size_t i, const size_t ns) const
+{
+    return getDOLoc(i, ns) + SEGY_utils::getMDSz();
+}
+
+bool ObjectSEGY::useWhole(const size_t bsz, const size_t osz) const
+{
+    // Nothing is wanted from each data-object, or nothing is skipped.
+    if (bsz == 0 || bsz == osz) {
+        return false;
+    }
+
+    switch (strategy) {
+        case ReadStrategy::Strided:
+            return false;
+
+        case ReadStrategy::Whole:
+            return true;
+
+        default:
+        case ReadStrategy::Adaptive:
+            break;
+    }
+
+    const size_t hole = osz - bsz;
+
+    // While the choice is close, try whichever approach has not been timed.
+    if (hole / 4LU <= maxHole && maxHole / 4LU <= hole) {
+        if (wholeCost == 0) {
+            return true;
+        }
+        if (stridedCost == 0) {
+            return false;
+        }
+    }
+    return hole <= maxHole;
+}
+
+void ObjectSEGY::readWhole(
+  const size_t loc,
+  const size_t skip,
+  const size_t bsz,
+  const size_t osz,
+  const size_t sz,
+  unsigned char* d) const
+{
+    const size_t chunk = std::max(1LU, wholeBufSz / osz);
+
+    // Every process makes the same number of data layer calls, as they may
+    // be collective.
+    const size_t nchunk = piol_->comm->max((sz + chunk - 1LU) / chunk);
+
+    std::vector<unsigned char> buf;
+    size_t i = 0;
+    for (size_t c = 0; c < nchunk; c++) {
+        const size_t n = std::min(chunk, sz - i);
+
+        const unsigned char* src = data_->map(loc + i * osz, n * osz);
+        if (src == nullptr) {
+            buf.resize(n * osz);
+            data_->read(loc + i * osz, n * osz, buf.data());
+            src = buf.data();
+        }
+
+        for (size_t j = 0; j < n; j++) {
+            std::copy_n(&src[j * osz + skip], bsz, &d[(i + j) * bsz]);
+        }
+        i += n;
+    }
+}
+
+void ObjectSEGY::readPart(
+  const size_t loc,
+  const size_t skip,
+  const size_t bsz,
+  const size_t osz,
+  const size_t sz,
+  unsigned char* d) const
+{
+    const bool whole = useWhole(bsz, osz);
+
+    // Only the first sizeable read with each approach is timed.
+    const bool timed = strategy == ReadStrategy::Adaptive && bsz != 0
+                       && bsz != osz && (whole ? wholeCost : stridedCost) == 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    if (whole) {
+        readWhole(loc, skip, bsz, osz, sz, d);
+    }
+    else {
+        data_->read(loc + skip, bsz, osz, sz, d);
+    }
+
+    if (!timed) {
+        return;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+
+    // The slowest process sets the pace. Agreeing on the timings keeps the
+    // choice of approach the same on every process.
+    const size_t nb = piol_->comm->max(sz);
+    const size_t t  = piol_->comm->max(size_t(elapsed.count()));
+    if (nb < calibrationBlocks || t == 0) {
+        return;
+    }
+
+    if (whole) {
+        wholeCost = double(t) / double(nb * osz);
+    }
+    else {
+        stridedCost = double(t) / double(nb);
+        stridedBsz  = bsz;
+    }
+
+    // A whole read pays for the hole, a strided read for each block. The
+    // approaches break even where the hole costs as much as a strided block.
+    if (wholeCost != 0 && stridedCost != 0) {
+        const double breakEven = stridedCost / wholeCost - double(stridedBsz);
+        maxHole                = (breakEven > 0 ? size_t(breakEven) : 0LU);
+    }
+}
+
+const unsigned char* ObjectSEGY::mapDO(
+  const size_t offset, const size_t ns, const size_t sz) const
+{
+    return data_->map(
+      getDOLoc(offset, ns), sz * SEGY_utils::getDOSz(ns, sampleSz_));
+}
+
+std::shared_ptr<Request> ObjectSEGY::ireadDO(
+  const size_t offset,
+  const size_t ns,
+  const size_t sz,
+  unsigned char* d) const
+{
+    return data_->iread(
+      getDOLoc(offset, ns), sz * SEGY_utils::getDOSz(ns, sampleSz_), d);
+}
+
+std::shared_ptr<Request> ObjectSEGY::iwriteDO(
+  const size_t offset,
+  const size_t ns,
+  const size_t sz,
+  const unsigned char* d) const
+{
+    return data_->iwrite(
+      getDOLoc(offset, ns), sz * SEGY_utils::getDOSz(ns, sampleSz_), d);
+}
+
+bool ObjectSEGY::writeDOIndependent(
+  const size_t offset,
+  const size_t ns,
+  const size_t sz,
+  const unsigned char* d) const
+{
+    return data_->writeIndependent(
+      getDOLoc(offset, ns), sz * SEGY_utils::getDOSz(ns, sampleSz_), d);
+}
+
 void ObjectSEGY::readHO(unsigned char* ho) const
 {
-    data_->read(0LU, SEGY_utils::getHOSz(), ho);
+    data_->read(0LU, getHOSz(), ho);
 }
 
 void ObjectSEGY::writeHO(const unsigned char* ho) const
 {
     if (ho != nullptr) {
-        data_->write(0LU, SEGY_utils::getHOSz(), ho);
+        data_->write(0LU, getHOSz(), ho);
     }
     else {
         data_->write(0LU, 0U, ho);
@@ -53,7 +248,7 @@ void ObjectSEGY::readDO(
   const size_t offset, const size_t ns, const size_t sz, unsigned char* d) const
 {
     data_->read(
-      SEGY_utils::getDOLoc(offset, ns), sz * SEGY_utils::getDOSz(ns), d);
+      getDOLoc(offset, ns), sz * SEGY_utils::getDOSz(ns, sampleSz_), d);
 }
 
 void ObjectSEGY::writeDO(
@@ -63,7 +258,7 @@ void ObjectSEGY::writeDO(
   const unsigned char* d) const
 {
     data_->write(
-      SEGY_utils::getDOLoc(offset, ns), sz * SEGY_utils::getDOSz(ns), d);
+      getDOLoc(offset, ns), sz * SEGY_utils::getDOSz(ns, sampleSz_), d);
 }
 
 void ObjectSEGY::readDOMD(
@@ -72,9 +267,22 @@ void ObjectSEGY::readDOMD(
   const size_t sz,
   unsigned char* md) const
 {
-    data_->read(
-      SEGY_utils::getDOLoc(offset, ns), SEGY_utils::getMDSz(),
-      SEGY_utils::getDOSz(ns), sz, md);
+    readPart(
+      getDOLoc(offset, ns), 0LU, SEGY_utils::getMDSz(),
+      SEGY_utils::getDOSz(ns, sampleSz_), sz, md);
+}
+
+void ObjectSEGY::readDOMD(
+  const size_t offset,
+  const size_t ns,
+  const size_t sz,
+  const size_t skip,
+  const size_t bsz,
+  unsigned char* md) const
+{
+    readPart(
+      getDOLoc(offset, ns), skip, bsz, SEGY_utils::getDOSz(ns, sampleSz_), sz,
+      md);
 }
 
 void ObjectSEGY::writeDOMD(
@@ -84,8 +292,8 @@ void ObjectSEGY::writeDOMD(
   const unsigned char* md) const
 {
     data_->write(
-      SEGY_utils::getDOLoc(offset, ns), SEGY_utils::getMDSz(),
-      SEGY_utils::getDOSz(ns), sz, md);
+      getDOLoc(offset, ns), SEGY_utils::getMDSz(),
+      SEGY_utils::getDOSz(ns, sampleSz_), sz, md);
 }
 
 void ObjectSEGY::readDODF(
@@ -94,9 +302,10 @@ void ObjectSEGY::readDODF(
   const size_t sz,
   unsigned char* df) const
 {
-    data_->read(
-      SEGY_utils::getDODFLoc(offset, ns), SEGY_utils::getDFSz(ns),
-      SEGY_utils::getDOSz(ns), sz, df);
+    readPart(
+      getDOLoc(offset, ns), SEGY_utils::getMDSz(),
+      SEGY_utils::getDFSz(ns, sampleSz_), SEGY_utils::getDOSz(ns, sampleSz_),
+      sz, df);
 }
 
 void ObjectSEGY::writeDODF(
@@ -106,8 +315,8 @@ void ObjectSEGY::writeDODF(
   const unsigned char* df) const
 {
     data_->write(
-      SEGY_utils::getDODFLoc(offset, ns), SEGY_utils::getDFSz(ns),
-      SEGY_utils::getDOSz(ns), sz, df);
+      getDODFLoc(offset, ns), SEGY_utils::getDFSz(ns, sampleSz_),
+      SEGY_utils::getDOSz(ns, sampleSz_), sz, df);
 }
 
 // TODO: Add optional validation in this layer?
@@ -120,10 +329,10 @@ void ObjectSEGY::readDO(
     std::vector<size_t> dooff(sz);
 
     for (size_t i = 0; i < sz; i++) {
-        dooff[i] = SEGY_utils::getDOLoc(offset[i], ns);
+        dooff[i] = getDOLoc(offset[i], ns);
     }
 
-    data_->read(SEGY_utils::getDOSz(ns), sz, dooff.data(), d);
+    data_->read(SEGY_utils::getDOSz(ns, sampleSz_), sz, dooff.data(), d);
 }
 
 void ObjectSEGY::writeDO(
@@ -135,10 +344,10 @@ void ObjectSEGY::writeDO(
     std::vector<size_t> dooff(sz);
 
     for (size_t i = 0; i < sz; i++) {
-        dooff[i] = SEGY_utils::getDOLoc(offset[i], ns);
+        dooff[i] = getDOLoc(offset[i], ns);
     }
 
-    data_->write(SEGY_utils::getDOSz(ns), sz, dooff.data(), d);
+    data_->write(SEGY_utils::getDOSz(ns, sampleSz_), sz, dooff.data(), d);
 }
 
 void ObjectSEGY::readDOMD(
@@ -150,12 +359,29 @@ void ObjectSEGY::readDOMD(
     std::vector<size_t> dooff(sz);
 
     for (size_t i = 0; i < sz; i++) {
-        dooff[i] = SEGY_utils::getDOLoc(offset[i], ns);
+        dooff[i] = getDOLoc(offset[i], ns);
     }
 
     data_->read(SEGY_utils::getMDSz(), sz, dooff.data(), md);
 }
 
+void ObjectSEGY::readDOMD(
+  const size_t* offset,
+  const size_t ns,
+  const size_t sz,
+  const size_t skip,
+  const size_t bsz,
+  unsigned char* md) const
+{
+    std::vector<size_t> dooff(sz);
+
+    for (size_t i = 0; i < sz; i++) {
+        dooff[i] = getDOLoc(offset[i], ns) + skip;
+    }
+
+    data_->read(bsz, sz, dooff.data(), md);
+}
+
 void ObjectSEGY::writeDOMD(
   const size_t* offset,
   const size_t ns,
@@ -165,7 +391,7 @@ void ObjectSEGY::writeDOMD(
     std::vector<size_t> dooff(sz);
 
     for (size_t i = 0; i < sz; i++) {
-        dooff[i] = SEGY_utils::getDOLoc(offset[i], ns);
+        dooff[i] = getDOLoc(offset[i], ns);
     }
 
     data_->write(SEGY_utils::getMDSz(), sz, dooff.data(), md);
@@ -184,10 +410,10 @@ void ObjectSEGY::readDODF(
     std::vector<size_t> dooff(sz);
 
     for (size_t i = 0; i < sz; i++) {
-        dooff[i] = SEGY_utils::getDODFLoc(offset[i], ns);
+        dooff[i] = getDODFLoc(offset[i], ns);
     }
 
-    data_->read(SEGY_utils::getDFSz(ns), sz, dooff.data(), df);
+    data_->read(SEGY_utils::getDFSz(ns, sampleSz_), sz, dooff.data(), df);
 }
 
 void ObjectSEGY::writeDODF(
@@ -203,10 +429,130 @@ void ObjectSEGY::writeDODF(
     std::vector<size_t> dooff(sz);
 
     for (size_t i = 0; i < sz; i++) {
-        dooff[i] = SEGY_utils::getDODFLoc(offset[i], ns);
+        dooff[i] = getDODFLoc(offset[i], ns);
+    }
+
+    data_->write(SEGY_utils::getDFSz(ns, sampleSz_), sz, dooff.data(), df);
+}
+
+void ObjectSEGY::readDODF(
+  const size_t offset,
+  const size_t ns,
+  const size_t sz,
+  const size_t skip,
+  const size_t bsz,
+  unsigned char* df) const
+{
+    readPart(
+      getDODFLoc(offset, ns), skip, bsz, SEGY_utils::getDOSz(ns, sampleSz_),
+      sz, df);
+}
+
+void ObjectSEGY::readDODF(
+  const size_t* offset,
+  const size_t ns,
+  const size_t sz,
+  const size_t skip,
+  const size_t bsz,
+  unsigned char* df) const
+{
+    std::vector<size_t> dooff(sz);
+
+    for (size_t i = 0; i < sz; i++) {
+        dooff[i] = getDODFLoc(offset[i], ns) + skip;
+    }
+
+    data_->read(bsz, sz, dooff.data(), df);
+}
+
+void ObjectSEGY::writeDODF(
+  const size_t offset,
+  const size_t ns,
+  const size_t sz,
+  const size_t skip,
+  const size_t bsz,
+  const unsigned char* df) const
+{
+    data_->write(
+      getDODFLoc(offset, ns) + skip, bsz,
+      SEGY_utils::getDOSz(ns, sampleSz_), sz, df);
+}
+
+void ObjectSEGY::writeDODF(
+  const size_t* offset,
+  const size_t ns,
+  const size_t sz,
+  const size_t skip,
+  const size_t bsz,
+  const unsigned char* df) const
+{
+    std::vector<size_t> dooff(sz);
+
+    for (size_t i = 0; i < sz; i++) {
+        dooff[i] = getDODFLoc(offset[i], ns) + skip;
+    }
+
+    data_->write(bsz, sz, dooff.data(), df);
+}
+
+void ObjectSEGY::readDO(
+  const size_t offset,
+  const size_t ns,
+  const size_t sz,
+  unsigned char* md,
+  unsigned char* df) const
+{
+    data_->readSplit(
+      getDOLoc(offset, ns), SEGY_utils::getMDSz(),
+      SEGY_utils::getDFSz(ns, sampleSz_), sz, md, df);
+}
+
+void ObjectSEGY::writeDO(
+  const size_t offset,
+  const size_t ns,
+  const size_t sz,
+  const unsigned char* md,
+  const unsigned char* df) const
+{
+    data_->writeSplit(
+      getDOLoc(offset, ns), SEGY_utils::getMDSz(),
+      SEGY_utils::getDFSz(ns, sampleSz_), sz, md, df);
+}
+
+void ObjectSEGY::readDO(
+  const size_t* offset,
+  const size_t ns,
+  const size_t sz,
+  unsigned char* md,
+  unsigned char* df) const
+{
+    std::vector<size_t> dooff(sz);
+
+    for (size_t i = 0; i < sz; i++) {
+        dooff[i] = getDOLoc(offset[i], ns);
+    }
+
+    data_->readSplit(
+      SEGY_utils::getMDSz(), SEGY_utils::getDFSz(ns, sampleSz_), sz,
+      dooff.data(), md, df);
+}
+
+void ObjectSEGY::writeDO(
+  const size_t* offset,
+  const size_t ns,
+  const size_t sz,
+  const unsigned char* md,
+  const unsigned char* df) const
+{
+    std::vector<size_t> dooff(sz);
+
+    for (size_t i = 0; i < sz; i++) {
+        dooff[i] = getDOLoc(offset[i], ns);
     }
 
-    data_->write(SEGY_utils::getDFSz(ns), sz, dooff.data(), df);
+    data_->writeSplit(
+      SEGY_utils::getMDSz(), SEGY_utils::getDFSz(ns, sampleSz_), sz,
+      dooff.data(), md, df);
 }
 
 }  // namespace PIOL
@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief
+/// @details ObjectSU functions
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExSeisDat/PIOL/ObjectSU.hh"
+
+namespace exseis {
+namespace PIOL {
+
+bool isSUFile(const std::string& name)
+{
+    const std::string ext = ".su";
+    return name.size() > ext.size()
+           && name.compare(name.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+//////////////////////      Constructor & Destructor      //////////////////////
+ObjectSU::ObjectSU(
+  std::shared_ptr<ExSeisPIOL> piol_,
+  std::string name_,
+  const ObjectSU::Opt& opt_,
+  std::shared_ptr<DataInterface> data_,
+  FileMode mode) :
+    ObjectSEGY(piol_, name_, opt_, data_, mode)
+{
+}
+
+ObjectSU::ObjectSU(
+  std::shared_ptr<ExSeisPIOL> piol_,
+  std::string name_,
+  std::shared_ptr<DataInterface> data_,
+  FileMode mode) :
+    ObjectSU(piol_, name_, ObjectSU::Opt(), data_, mode)
+{
+}
+
+//////////////////////////       Member functions      /////////////////////////
+size_t ObjectSU::getHOSz(void) const
+{
+    return 0LU;
+}
+
+}  // namespace PIOL
+}  // namespace exseis
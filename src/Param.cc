@@ -6,18 +6,66 @@
 #include "ExSeisDat/PIOL/Param.h"
 #include "ExSeisDat/PIOL/segy_utils.hh"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
 namespace exseis {
 namespace PIOL {
 
-Param::Param(std::shared_ptr<Rule> r_, const size_t sz_) : r(r_), sz(sz_)
+Param::Param(
+  std::shared_ptr<Rule> r_, const size_t sz_, const bool lazy_) :
+    Param::Param(r_, sz_, lazy_, r_->columnar)
 {
-    f.resize(sz * r->numFloat);
-    i.resize(sz * r->numLong);
+}
+
+Param::Param(
+  std::shared_ptr<Rule> r_,
+  const size_t sz_,
+  const bool lazy_,
+  const bool columnar_) :
+    r(r_),
+    sz(sz_),
+    lazy(lazy_),
+    columnar(columnar_),
+    compact(r_->compact),
+    nscal(0),
+    is_big_endian(true),
+    npending(0)
+{
+    if (compact) {
+        // The scalar groups are those the compiled rule writes.
+        const auto& program = r->compile();
+        nscal               = program.scalLoc.size();
+        fgroup.resize(r->numFloat);
+        for (const auto& op : program.op) {
+            if (op.type == RuleEntry::MdType::Float) {
+                fgroup[op.num] = op.scal;
+            }
+        }
+
+        fc.resize(sz * r->numFloat);
+        fscal.resize(sz * nscal);
+        ic.resize(sz * r->numLong);
+    }
+    else {
+        f.resize(sz * r->numFloat);
+        i.resize(sz * r->numLong);
+    }
     s.resize(sz * r->numShort);
     t.resize(sz * r->numIndex);
 
     // @todo: This must be file format agnostic
     c.resize(sz * (r->numCopy != 0 ? SEGY_utils::getMDSz() : 0));
+
+    if (lazy) {
+        raw.resize(sz * r->extent());
+        rawSet.resize(sz);
+
+        // Nothing has been accessed yet, so every column waits for a read.
+        npending = r->numFloat + r->numLong + r->numShort;
+        pending.assign(npending, 1);
+    }
 }
 
 Param::Param(const size_t sz_) :
@@ -27,14 +75,165 @@ Param::Param(const size_t sz_) :
 
 Param::~Param() = default;
 
+size_t Param::getColumn(const RuleEntry::MdType type, const size_t num) const
+{
+    switch (type) {
+        case RuleEntry::MdType::Float:
+            return num;
+        case RuleEntry::MdType::Long:
+            return r->numFloat + num;
+        case RuleEntry::MdType::Short:
+            return r->numFloat + r->numLong + num;
+        default:
+            return SIZE_MAX;
+    }
+}
+
+void Param::decode(const Meta m) const
+{
+    if (npending == 0) {
+        return;
+    }
+
+    RuleEntry* e = r->getEntry(m);
+    if (e == nullptr) {
+        return;
+    }
+
+    const size_t col = getColumn(e->type(), e->num);
+    if (col == SIZE_MAX || pending[col] == 0) {
+        return;
+    }
+
+    for (const auto& op : r->compile().op) {
+        if (op.type == e->type() && op.num == e->num) {
+            SEGY_utils::extractColumn(op, const_cast<Param*>(this));
+        }
+    }
+    pending[col] = 0;
+    npending--;
+}
+
+void Param::decode(void) const
+{
+    if (npending == 0) {
+        return;
+    }
+
+    for (const auto& op : r->compile().op) {
+        if (pending[getColumn(op.type, op.num)] != 0) {
+            SEGY_utils::extractColumn(op, const_cast<Param*>(this));
+        }
+    }
+    std::fill(pending.begin(), pending.end(), 0);
+    npending = 0;
+}
+
+void Param::setFloat(
+  const size_t j, const size_t num, const exseis::utils::Floating_point v)
+{
+    if (!compact) {
+        f[getPos(j, num, r->numFloat)] = v;
+        return;
+    }
+
+    // Combine the scalar the value needs with that of the group the same way
+    // SEGY_utils::insertParam does. An unset scalar is taken as one.
+    const size_t g      = fgroup[num];
+    int16_t& groupScal  = fscal[getPos(j, g, nscal)];
+    const int16_t scal1 = (groupScal != 0 ? groupScal : int16_t(1));
+    const int16_t scal2 = SEGY_utils::find_scalar(v);
+
+    const int16_t scal =
+      ((scal1 > 1 || scal2 > 1) ? std::max(scal1, scal2) :
+                                  std::min(scal1, scal2));
+
+    const exseis::utils::Floating_point gscale = scaleValue(1, scal);
+    if (scal != scal1) {
+        for (size_t k = 0; k < r->numFloat; k++) {
+            if (k != num && fgroup[k] == g) {
+                const size_t pos = getPos(j, k, r->numFloat);
+                fc[pos] =
+                  int32_t(std::lround(scaleValue(fc[pos], scal1) / gscale));
+            }
+        }
+    }
+
+    groupScal                       = scal;
+    fc[getPos(j, num, r->numFloat)] = int32_t(std::lround(v / gscale));
+}
+
 size_t Param::size(void) const
 {
     return sz;
 }
 
+/*! Compare the values of one type in two parameter structures, which may
+ *  have different layouts.
+ *  @tparam T The type of the values.
+ *  @param[in] a  The first parameter structure.
+ *  @param[in] av The values of \p a.
+ *  @param[in] b  The second parameter structure.
+ *  @param[in] bv The values of \p b.
+ *  @return Return true if the values are equal.
+ */
+template<typename T>
+static bool equalValues(
+  const Param& a,
+  const std::vector<T>& av,
+  const Param& b,
+  const std::vector<T>& bv)
+{
+    if (a.columnar == b.columnar) {
+        return av == bv;
+    }
+
+    if (av.size() != bv.size() || a.sz != b.sz) {
+        return false;
+    }
+
+    const size_t ncol = (a.sz != 0 ? av.size() / a.sz : 0);
+    for (size_t j = 0; j < a.sz; j++) {
+        for (size_t k = 0; k < ncol; k++) {
+            if (av[a.getPos(j, k, ncol)] != bv[b.getPos(j, k, ncol)]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 bool Param::operator==(struct Param& p) const
 {
-    return f == p.f && i == p.i && s == p.s && t == p.t && c == p.c;
+    decode();
+    p.decode();
+
+    // Compact floats and longs are compared by value.
+    if (compact || p.compact) {
+        if (
+          sz != p.sz || r->numFloat != p.r->numFloat
+          || r->numLong != p.r->numLong) {
+            return false;
+        }
+        for (size_t j = 0; j < sz; j++) {
+            for (size_t k = 0; k < r->numFloat; k++) {
+                if (getFloat(j, k) != p.getFloat(j, k)) {
+                    return false;
+                }
+            }
+            for (size_t k = 0; k < r->numLong; k++) {
+                if (getLong(j, k) != p.getLong(j, k)) {
+                    return false;
+                }
+            }
+        }
+        return equalValues(*this, s, p, p.s) && equalValues(*this, t, p, p.t)
+               && c == p.c;
+    }
+
+    return equalValues(*this, f, p, p.f) && equalValues(*this, i, p, p.i)
+           && equalValues(*this, s, p, p.s) && equalValues(*this, t, p, p.t)
+           && c == p.c;
 }
 
 size_t Param::memUsage(void) const
@@ -42,7 +241,12 @@ size_t Param::memUsage(void) const
     return f.capacity() * sizeof(exseis::utils::Floating_point)
            + i.capacity() * sizeof(exseis::utils::Integer)
            + s.capacity() * sizeof(int16_t) + t.capacity() * sizeof(size_t)
-           + c.capacity() * sizeof(unsigned char) + sizeof(Param)
+           + fc.capacity() * sizeof(int32_t)
+           + fscal.capacity() * sizeof(int16_t)
+           + ic.capacity() * sizeof(int32_t)
+           + fgroup.capacity() * sizeof(size_t)
+           + c.capacity() * sizeof(unsigned char) + raw.capacity()
+           + rawSet.capacity() + pending.capacity() + sizeof(Param)
            + r->memUsage();
 }
 
@@ -0,0 +1,548 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of \c ParamIndex
+/// @details The index starts with a header of size_t words: a magic number,
+///          the sizes of the parameter types, the size and modification time
+///          of the data file, the number of traces and the number of columns.
+///          A description of each column follows, then the columns, each
+///          aligned to a word.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExSeisDat/PIOL/ParamIndex.hh"
+
+#include "ExSeisDat/PIOL/DataMPIIO.hh"
+#include "ExSeisDat/PIOL/ReadInterface.hh"
+#include "ExSeisDat/PIOL/SEGYRuleEntry.hh"
+#include "ExSeisDat/PIOL/param_utils.hh"
+#include "ExSeisDat/utils/decomposition/block_decomposition.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sys/stat.h>
+
+namespace exseis {
+namespace PIOL {
+
+namespace {
+
+/// The magic number of an index. It also marks the byte order.
+const size_t index_magic = 0x0158444950534558LU;
+
+/// The sizes of the parameter types, which must match those of the index.
+const size_t index_types = sizeof(exseis::utils::Floating_point)
+                           | (sizeof(exseis::utils::Integer) << 8LU)
+                           | (sizeof(int16_t) << 16LU);
+
+/// The number of words in the header of an index
+const size_t header_words = 6;
+
+/// The number of words in the description of a column
+const size_t column_words = 5;
+
+/// The most traces a process decodes at once when building an index
+const size_t build_chunk = 65536;
+
+/*! Get the size of the values of a column.
+ *  @param[in] type The type of the column.
+ *  @return Return the size in bytes.
+ */
+size_t getValueSz(RuleEntry::MdType type)
+{
+    switch (type) {
+        case RuleEntry::MdType::Float:
+            return sizeof(exseis::utils::Floating_point);
+        case RuleEntry::MdType::Long:
+            return sizeof(exseis::utils::Integer);
+        default:
+            return sizeof(int16_t);
+    }
+}
+
+/*! Describe where a rule entry is read from as a column.
+ *  @param[in] m The parameter.
+ *  @param[in] e The rule entry of the parameter.
+ *  @return Return the column, without an offset.
+ */
+ParamIndex::Column describe(Meta m, RuleEntry* e)
+{
+    const size_t scalLoc =
+      (e->type() == RuleEntry::MdType::Float ?
+         static_cast<SEGYFloatRuleEntry*>(e)->scalLoc :
+         0LU);
+    return {m, e->type(), e->loc, scalLoc, 0LU};
+}
+
+/*! Check if a column holds the values of a rule entry.
+ *  @param[in] c The column.
+ *  @param[in] e The rule entry, or nullptr.
+ *  @return Return true if the column matches.
+ */
+bool matches(const ParamIndex::Column& c, RuleEntry* e)
+{
+    if (e == nullptr || e->type() != c.type) {
+        return false;
+    }
+    auto d = describe(c.m, e);
+    return d.loc == c.loc && d.scalLoc == c.scalLoc;
+}
+
+/*! Copy the values of a column between a parameter structure and a buffer.
+ *  @tparam T       The type of the values.
+ *  @param[in] prm  The parameter structure.
+ *  @param[in] vals The values of the column's type in the structure.
+ *  @param[in] num  The number of columns of the type in the structure.
+ *  @param[in] col  The column of the values within their type.
+ *  @param[in] skip The first entry of the structure.
+ *  @param[in] n    The number of values.
+ *  @param[in,out] buf  The buffer of packed values.
+ *  @param[in] pack Whether the values are copied into the buffer.
+ */
+template<typename T>
+void copyColumn(
+  const Param* prm,
+  std::vector<T>& vals,
+  size_t num,
+  size_t col,
+  size_t skip,
+  size_t n,
+  unsigned char* buf,
+  bool pack)
+{
+    // A column-major column is already packed.
+    if (prm->columnar && n != 0) {
+        T* v = &vals[prm->getPos(skip, col, num)];
+        if (pack) {
+            std::memcpy(buf, v, n * sizeof(T));
+        }
+        else {
+            std::memcpy(v, buf, n * sizeof(T));
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        T* v = &vals[prm->getPos(skip + i, col, num)];
+        if (pack) {
+            std::memcpy(&buf[i * sizeof(T)], v, sizeof(T));
+        }
+        else {
+            std::memcpy(v, &buf[i * sizeof(T)], sizeof(T));
+        }
+    }
+}
+
+/*! Copy the values of a parameter between a parameter structure and a
+ *  buffer.
+ *  @param[in] e    The rule entry of the parameter.
+ *  @param[in,out] prm  The parameter structure.
+ *  @param[in] skip The first entry of the structure.
+ *  @param[in] n    The number of values.
+ *  @param[in,out] buf  The buffer of packed values.
+ *  @param[in] pack Whether the values are copied into the buffer.
+ */
+void copyColumn(
+  RuleEntry* e,
+  Param* prm,
+  size_t skip,
+  size_t n,
+  unsigned char* buf,
+  bool pack)
+{
+    // The index holds full width values, so compact floats and longs are
+    // converted one at a time.
+    if (prm->compact && e->type() == RuleEntry::MdType::Float) {
+        for (size_t i = 0; i < n; i++) {
+            exseis::utils::Floating_point v;
+            if (pack) {
+                v = prm->getFloat(skip + i, e->num);
+                std::memcpy(&buf[i * sizeof(v)], &v, sizeof(v));
+            }
+            else {
+                std::memcpy(&v, &buf[i * sizeof(v)], sizeof(v));
+                prm->setFloat(skip + i, e->num, v);
+            }
+        }
+        return;
+    }
+    if (prm->compact && e->type() == RuleEntry::MdType::Long) {
+        for (size_t i = 0; i < n; i++) {
+            exseis::utils::Integer v;
+            if (pack) {
+                v = prm->getLong(skip + i, e->num);
+                std::memcpy(&buf[i * sizeof(v)], &v, sizeof(v));
+            }
+            else {
+                std::memcpy(&v, &buf[i * sizeof(v)], sizeof(v));
+                prm->setLong(skip + i, e->num, v);
+            }
+        }
+        return;
+    }
+
+    const Rule* r = prm->r.get();
+    switch (e->type()) {
+        case RuleEntry::MdType::Float:
+            copyColumn(prm, prm->f, r->numFloat, e->num, skip, n, buf, pack);
+            break;
+        case RuleEntry::MdType::Long:
+            copyColumn(prm, prm->i, r->numLong, e->num, skip, n, buf, pack);
+            break;
+        default:
+            copyColumn(prm, prm->s, r->numShort, e->num, skip, n, buf, pack);
+            break;
+    }
+}
+
+}  // namespace
+
+//////////////////////      Constructor & Destructor      //////////////////////
+ParamIndex::ParamIndex(
+  std::shared_ptr<ExSeisPIOL> piol,
+  std::string name,
+  const std::string& file,
+  const size_t fsz,
+  const size_t nt) :
+    piol_(piol),
+    name_(name),
+    data_(nullptr),
+    writable_(false),
+    mtime_(0),
+    fsz_(fsz),
+    valid_(false)
+{
+    // The modification time is taken once so every process agrees on it.
+    size_t mtime  = 0;
+    size_t exists = 0;
+    if (piol_->comm->getRank() == 0) {
+        struct stat st;
+        if (stat(file.c_str(), &st) == 0) {
+            mtime = size_t(st.st_mtim.tv_sec) * 1000000000LU
+                    + size_t(st.st_mtim.tv_nsec);
+        }
+        exists = (stat(name_.c_str(), &st) == 0 ? 1LU : 0LU);
+    }
+    mtime_ = piol_->comm->max(mtime);
+    exists = piol_->comm->max(exists);
+
+    if (mtime_ == 0) {
+        piol_->log->record(
+          name_, Logger::Layer::File, Logger::Status::Warning,
+          "The modification time of " + file
+            + " is unknown. The parameter index is not used.",
+          PIOL_VERBOSITY_NONE);
+        return;
+    }
+
+    // An index which is only fetched from is opened read-only, so a job which
+    // only reads needs no write access. It is reopened to build it.
+    if (exists != 0) {
+        data_ = std::make_shared<DataMPIIO>(piol_, name_, FileMode::Read);
+        load(nt);
+    }
+}
+
+/////////////////////////       Member functions      //////////////////////////
+
+void ParamIndex::openWritable(void)
+{
+    if (writable_) {
+        return;
+    }
+
+    // The read-only handle is closed before the file is opened again.
+    data_.reset();
+    data_     = std::make_shared<DataMPIIO>(piol_, name_, FileMode::ReadWrite);
+    writable_ = true;
+}
+
+void ParamIndex::load(const size_t nt)
+{
+    const size_t isz = data_->getFileSz();
+    if (isz < header_words * sizeof(size_t)) {
+        return;
+    }
+
+    std::vector<size_t> hdr(header_words);
+    data_->read(
+      0LU, hdr.size() * sizeof(size_t),
+      reinterpret_cast<unsigned char*>(hdr.data()));
+
+    const size_t ncol = hdr[5];
+    if (
+      hdr[0] != index_magic || hdr[1] != index_types || hdr[2] != fsz_
+      || hdr[3] != mtime_ || hdr[4] != nt
+      || ncol > isz / (column_words * sizeof(size_t))) {
+        return;
+    }
+
+    std::vector<size_t> desc(ncol * column_words);
+    data_->read(
+      header_words * sizeof(size_t), desc.size() * sizeof(size_t),
+      reinterpret_cast<unsigned char*>(desc.data()));
+
+    std::vector<Column> col(ncol);
+    for (size_t c = 0; c < ncol; c++) {
+        const size_t* d = &desc[c * column_words];
+        col[c] = {Meta(d[0]), RuleEntry::MdType(d[1]), d[2], d[3], d[4]};
+
+        if (col[c].offset + nt * getValueSz(col[c].type) > isz) {
+            return;
+        }
+    }
+
+    col_   = col;
+    valid_ = true;
+}
+
+size_t ParamIndex::covers(const Rule* r) const
+{
+    if (mtime_ == 0) {
+        return 2;
+    }
+    if (r == nullptr) {
+        return 0;
+    }
+
+    size_t state = 0;
+    for (const auto& t : r->translate) {
+        switch (t.second->type()) {
+            case RuleEntry::MdType::Index:
+                break;
+            case RuleEntry::MdType::Copy:
+                // Copies of whole headers are not held in the index.
+                return 2;
+            default: {
+                auto c = std::find_if(
+                  col_.begin(), col_.end(),
+                  [&t](const Column& c) { return c.m == t.first; });
+                if (c == col_.end() || !matches(*c, t.second)) {
+                    state = 1;
+                }
+            } break;
+        }
+    }
+    return state;
+}
+
+void ParamIndex::build(const ReadInterface& file, std::vector<Column> col)
+{
+    auto& comm      = piol_->comm;
+    const bool r0   = (comm->getRank() == 0);
+    const size_t nt = file.readNt();
+
+    openWritable();
+
+    // Invalidate the index on disk first so an index which was only partly
+    // rebuilt is never used.
+    valid_ = false;
+    col_.clear();
+    const size_t zero = 0;
+    data_->write(
+      0LU, (r0 ? sizeof(size_t) : 0LU),
+      reinterpret_cast<const unsigned char*>(&zero));
+
+    auto rule = std::make_shared<Rule>(false, false);
+    size_t pos = (header_words + column_words * col.size()) * sizeof(size_t);
+    for (auto& c : col) {
+        c.offset = pos;
+        pos += (nt * getValueSz(c.type) + sizeof(size_t) - 1LU)
+               / sizeof(size_t) * sizeof(size_t);
+
+        switch (c.type) {
+            case RuleEntry::MdType::Float:
+                rule->addSEGYFloat(c.m, Tr(c.loc), Tr(c.scalLoc));
+                break;
+            case RuleEntry::MdType::Long:
+                rule->addLong(c.m, Tr(c.loc));
+                break;
+            default:
+                rule->addShort(c.m, Tr(c.loc));
+                break;
+        }
+    }
+    data_->setFileSz(pos);
+
+    // Each process decodes a block of traces and writes its part of every
+    // column.
+    auto dec = exseis::utils::block_decomposition(
+      nt, comm->getNumRank(), comm->getRank());
+    const size_t rounds =
+      comm->max((dec.local_size + build_chunk - 1LU) / build_chunk);
+
+    std::vector<unsigned char> buf;
+    for (size_t round = 0; round < rounds; round++) {
+        const size_t off   = std::min(round * build_chunk, dec.local_size);
+        const size_t n     = std::min(build_chunk, dec.local_size - off);
+        const size_t start = dec.global_offset + off;
+
+        Param prm(rule, n);
+        file.readTrace(
+          start, n, const_cast<exseis::utils::Trace_value*>(TRACE_NULL), &prm);
+
+        for (const auto& c : col) {
+            const size_t vsz = getValueSz(c.type);
+            buf.resize(n * vsz);
+            copyColumn(rule->getEntry(c.m), &prm, 0LU, n, buf.data(), true);
+            data_->write(c.offset + start * vsz, n * vsz, buf.data());
+        }
+    }
+
+    // The header is written last, marking the index as complete.
+    std::vector<size_t> hdr = {index_magic, index_types, fsz_,
+                               mtime_,      nt,          col.size()};
+    for (const auto& c : col) {
+        hdr.insert(
+          hdr.end(), {size_t(c.m), size_t(c.type), c.loc, c.scalLoc, c.offset});
+    }
+    data_->write(
+      0LU, (r0 ? hdr.size() * sizeof(size_t) : 0LU),
+      reinterpret_cast<const unsigned char*>(hdr.data()));
+
+    col_   = col;
+    valid_ = true;
+}
+
+void ParamIndex::extend(const ReadInterface& file, const Rule* r)
+{
+    auto& comm = piol_->comm;
+
+    // Every process shares the parameters it wants, padded to the longest
+    // list.
+    std::vector<size_t> want;
+    if (r != nullptr) {
+        for (const auto& t : r->translate) {
+            const auto type = t.second->type();
+            if (
+              type == RuleEntry::MdType::Index
+              || type == RuleEntry::MdType::Copy) {
+                continue;
+            }
+            auto c = describe(t.first, t.second);
+            want.insert(
+              want.end(), {size_t(c.m), size_t(c.type), c.loc, c.scalLoc});
+        }
+    }
+    const size_t len = comm->max(want.size());
+    want.resize(len, std::numeric_limits<size_t>::max());
+    auto all = comm->gather(want);
+
+    // The columns already held are kept. A parameter wanted at two different
+    // locations is only held at the first.
+    std::vector<Column> col = col_;
+    for (size_t j = 0; j + 4LU <= all.size(); j += 4LU) {
+        if (all[j] == std::numeric_limits<size_t>::max()) {
+            continue;
+        }
+        const Meta m = Meta(all[j]);
+        auto c       = std::find_if(
+          col.begin(), col.end(), [m](const Column& c) { return c.m == m; });
+        if (c == col.end()) {
+            col.push_back(
+              {m, RuleEntry::MdType(all[j + 1]), all[j + 2], all[j + 3], 0LU});
+        }
+    }
+
+    build(file, col);
+}
+
+bool ParamIndex::prepare(const ReadInterface& file, const Param* prm)
+{
+    const Rule* r =
+      (prm != PIOL_PARAM_NULL && prm != nullptr ? prm->r.get() : nullptr);
+
+    size_t state = piol_->comm->max(covers(r));
+    if (state == 1) {
+        extend(file, r);
+        state = piol_->comm->max(covers(r));
+    }
+    return state == 0;
+}
+
+void ParamIndex::fetch(
+  const size_t sz,
+  std::function<size_t(size_t)> offunc,
+  const bool contig,
+  Param* prm,
+  const size_t skip) const
+{
+    const bool read = (prm != PIOL_PARAM_NULL && prm != nullptr);
+
+    // The columns are written directly.
+    if (read) {
+        prm->decode();
+    }
+
+    // Every process reads every column, if only to take part in the
+    // collective read.
+    std::vector<unsigned char> buf;
+    std::vector<size_t> offset;
+    for (const auto& c : col_) {
+        RuleEntry* e     = (read ? prm->r->getEntry(c.m) : nullptr);
+        const size_t n   = (matches(c, e) ? sz : 0LU);
+        const size_t vsz = getValueSz(c.type);
+
+        buf.resize(n * vsz);
+        if (contig) {
+            data_->read(
+              c.offset + (n ? offunc(0) : 0LU) * vsz, n * vsz, buf.data());
+        }
+        else {
+            offset.resize(n);
+            for (size_t i = 0; i < n; i++) {
+                offset[i] = c.offset + offunc(i) * vsz;
+            }
+            data_->read(vsz, n, offset.data(), buf.data());
+        }
+
+        if (n) {
+            copyColumn(e, prm, skip, n, buf.data(), false);
+        }
+    }
+
+    if (read) {
+        for (size_t i = 0; i < sz; i++) {
+            param_utils::setPrm(i + skip, PIOL_META_ltn, offunc(i), prm);
+        }
+    }
+}
+
+bool ParamIndex::readParam(
+  const ReadInterface& file,
+  const size_t offset,
+  const size_t sz,
+  Param* prm,
+  const size_t skip)
+{
+    if (!prepare(file, prm)) {
+        return false;
+    }
+
+    const size_t nt = file.readNt();
+    const size_t ntz =
+      (offset >= nt ? 0LU : (offset + sz > nt ? nt - offset : sz));
+    fetch(
+      ntz, [offset](size_t i) -> size_t { return offset + i; }, true, prm,
+      skip);
+    return true;
+}
+
+bool ParamIndex::readParamNonContiguous(
+  const ReadInterface& file,
+  const size_t sz,
+  const size_t* offset,
+  Param* prm,
+  const size_t skip)
+{
+    if (!prepare(file, prm)) {
+        return false;
+    }
+
+    fetch(
+      sz, [offset](size_t i) -> size_t { return offset[i]; }, false, prm,
+      skip);
+    return true;
+}
+
+}  // namespace PIOL
+}  // namespace exseis
@@ -5,9 +5,8 @@
 
 #include "ExSeisDat/PIOL/ReadDirect.hh"
 
-#include "ExSeisDat/PIOL/DataMPIIO.hh"
 #include "ExSeisDat/PIOL/ExSeisPIOL.hh"
-#include "ExSeisDat/PIOL/ObjectSEGY.hh"
+#include "ExSeisDat/PIOL/ObjectInterface.hh"
 #include "ExSeisDat/PIOL/ReadSEGY.hh"
 
 namespace exseis {
@@ -16,12 +15,8 @@ namespace PIOL {
 ReadDirect::ReadDirect(std::shared_ptr<ExSeisPIOL> piol, const std::string name)
 {
     const ReadSEGY::Opt f;
-    const ObjectSEGY::Opt o;
-    const DataMPIIO::Opt d;
-    auto data = std::make_shared<DataMPIIO>(piol, name, d, FileMode::Read);
-    auto obj =
-      std::make_shared<ObjectSEGY>(piol, name, o, data, FileMode::Read);
-    file = std::make_shared<ReadSEGY>(piol, name, f, obj);
+    auto obj = makeDefaultObj(piol, name, FileMode::Read);
+    file     = std::make_shared<ReadSEGY>(piol, name, f, obj);
 }
 
 ReadDirect::ReadDirect(std::shared_ptr<ReadInterface> file_) : file(file_) {}
@@ -87,5 +82,38 @@ void ReadDirect::readParamNonContiguous(
     file->readParamNonContiguous(sz, offset, prm);
 }
 
+void ReadDirect::readTraceWindow(
+  const size_t offset,
+  const size_t sz,
+  const size_t s0,
+  const size_t n,
+  exseis::utils::Trace_value* trace,
+  Param* prm) const
+{
+    file->readTraceWindow(offset, sz, s0, n, trace, prm);
+}
+
+void ReadDirect::readTraceWindowNonContiguous(
+  const size_t sz,
+  const size_t* offset,
+  const size_t s0,
+  const size_t n,
+  exseis::utils::Trace_value* trace,
+  Param* prm) const
+{
+    file->readTraceWindowNonContiguous(sz, offset, s0, n, trace, prm);
+}
+
+void ReadDirect::readTraceWindowNonMonotonic(
+  const size_t sz,
+  const size_t* offset,
+  const size_t s0,
+  const size_t n,
+  exseis::utils::Trace_value* trace,
+  Param* prm) const
+{
+    file->readTraceWindowNonMonotonic(sz, offset, s0, n, trace, prm);
+}
+
 }  // namespace PIOL
 }  // namespace exseis
@@ -9,6 +9,13 @@
 
 #include "ExSeisDat/PIOL/ReadInterface.hh"
 
+#include "ExSeisDat/PIOL/operations/sort.hh"
+#include "ExSeisDat/PIOL/param_utils.hh"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 namespace exseis {
 namespace PIOL {
 
@@ -18,6 +25,9 @@ const exseis::utils::Trace_value* TRACE_NULL = (exseis::utils::Trace_value*)1;
 void ReadInterface::readParam(
   const size_t offset, const size_t sz, Param* prm, const size_t skip) const
 {
+    if (index && index->readParam(*this, offset, sz, prm, skip)) {
+        return;
+    }
     readTrace(
       offset, sz, const_cast<exseis::utils::Trace_value*>(TRACE_NULL), prm,
       skip);
@@ -26,11 +36,141 @@ void ReadInterface::readParam(
 void ReadInterface::readParamNonContiguous(
   const size_t sz, const size_t* offsets, Param* prm, const size_t skip) const
 {
+    if (
+      index
+      && index->readParamNonContiguous(*this, sz, offsets, prm, skip)) {
+        return;
+    }
     readTraceNonContiguous(
       sz, offsets, const_cast<exseis::utils::Trace_value*>(TRACE_NULL), prm,
       skip);
 }
 
+std::shared_ptr<Request> ReadInterface::ireadTrace(
+  const size_t offset,
+  const size_t sz,
+  exseis::utils::Trace_value* trace,
+  Param* prm,
+  const size_t skip) const
+{
+    readTrace(offset, sz, trace, prm, skip);
+    return std::make_shared<CompletedRequest>();
+}
+
+bool ReadInterface::checkWindow(const size_t s0, const size_t n) const
+{
+    if (s0 + n > ns) {
+        piol->log->record(
+          name, Logger::Layer::File, Logger::Status::Error,
+          "The sample window " + std::to_string(s0) + " to "
+            + std::to_string(s0 + n) + " is not within traces of "
+            + std::to_string(ns) + " samples.",
+          PIOL_VERBOSITY_NONE);
+        return false;
+    }
+    return true;
+}
+
+/*! Copy a window of samples out of whole traces.
+ *  @param[in]  whole The whole traces.
+ *  @param[in]  ns    The number of samples per trace.
+ *  @param[in]  sz    The number of traces.
+ *  @param[in]  s0    The first sample of the window.
+ *  @param[in]  n     The number of samples in the window.
+ *  @param[out] trc   The windows.
+ */
+static void copyWindow(
+  const exseis::utils::Trace_value* whole,
+  const size_t ns,
+  const size_t sz,
+  const size_t s0,
+  const size_t n,
+  exseis::utils::Trace_value* trc)
+{
+    for (size_t i = 0; i < sz; i++) {
+        std::copy_n(&whole[i * ns + s0], n, &trc[i * n]);
+    }
+}
+
+void ReadInterface::readTraceWindow(
+  const size_t offset,
+  const size_t sz,
+  const size_t s0,
+  const size_t n,
+  exseis::utils::Trace_value* trace,
+  Param* prm,
+  const size_t skip) const
+{
+    const size_t wsz = (checkWindow(s0, n) ? sz : 0LU);
+
+    std::vector<exseis::utils::Trace_value> whole(wsz * ns);
+    readTrace(offset, wsz, whole.data(), prm, skip);
+    copyWindow(whole.data(), ns, wsz, s0, n, trace);
+}
+
+void ReadInterface::readTraceWindowNonContiguous(
+  const size_t sz,
+  const size_t* offset,
+  const size_t s0,
+  const size_t n,
+  exseis::utils::Trace_value* trace,
+  Param* prm,
+  const size_t skip) const
+{
+    const size_t wsz = (checkWindow(s0, n) ? sz : 0LU);
+
+    std::vector<exseis::utils::Trace_value> whole(wsz * ns);
+    readTraceNonContiguous(wsz, offset, whole.data(), prm, skip);
+    copyWindow(whole.data(), ns, wsz, s0, n, trace);
+}
+
+void ReadInterface::readTraceWindowNonMonotonic(
+  const size_t sz,
+  const size_t* offset,
+  const size_t s0,
+  const size_t n,
+  exseis::utils::Trace_value* trace,
+  Param* prm,
+  const size_t skip) const
+{
+    const bool read = (prm != PIOL_PARAM_NULL && prm != nullptr);
+
+    // Sort the offsets and read each trace once.
+    auto idx = getSortIndex(sz, offset);
+    std::vector<size_t> nodups;
+    for (size_t j = 0; j < sz; j++) {
+        if (j == 0 || offset[idx[j - 1]] != offset[idx[j]]) {
+            nodups.push_back(offset[idx[j]]);
+        }
+    }
+
+    auto sprm =
+      (read ? std::make_unique<Param>(prm->r, nodups.size()) : nullptr);
+    std::vector<exseis::utils::Trace_value> strc(n * nodups.size());
+
+    readTraceWindowNonContiguous(
+      nodups.size(), nodups.data(), s0, n, strc.data(),
+      (read ? sprm.get() : prm), 0LU);
+
+    if (s0 + n > ns) {
+        return;
+    }
+
+    // The trace read for each requested offset
+    std::vector<size_t> src(sz);
+    for (size_t k = 0, j = 0; j < sz; ++j) {
+        if (j != 0 && offset[idx[j - 1]] != offset[idx[j]]) {
+            k++;
+        }
+        src[idx[j]] = k;
+    }
+
+    if (read) {
+        param_utils::permutePrm(sz, src.data(), sprm.get(), skip, prm);
+    }
+    param_utils::permuteTrc(sz, src.data(), n, strc.data(), trace);
+}
+
 const std::string& ReadInterface::readText(void) const
 {
     return text;
@@ -10,6 +10,7 @@
 #include "ExSeisDat/PIOL/ReadSEGY.hh"
 
 #include "ExSeisDat/PIOL/ObjectInterface.hh"
+#include "ExSeisDat/PIOL/Tr.h"
 #include "ExSeisDat/PIOL/operations/sort.hh"
 #include "ExSeisDat/PIOL/param_utils.hh"
 #include "ExSeisDat/PIOL/segy_utils.hh"
@@ -17,13 +18,34 @@
 #include "ExSeisDat/utils/encoding/number_encoding.hh"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 
 using namespace exseis::utils;
 
 namespace exseis {
 namespace PIOL {
 
+/////////////////////////////       Non-Class      /////////////////////////////
+
+/*! Get a 2 byte integer from a header.
+ *  @param[in] buf           The header.
+ *  @param[in] loc           The offset of the integer in \c buf.
+ *  @param[in] is_big_endian Whether the integer is big-endian.
+ *  @return Return the integer.
+ */
+static int16_t getInt16(
+  const unsigned char* buf, const size_t loc, const bool is_big_endian)
+{
+    if (is_big_endian) {
+        return from_big_endian<int16_t>(buf[loc + 0], buf[loc + 1]);
+    }
+    return from_little_endian<int16_t>({{buf[loc + 0], buf[loc + 1]}});
+}
+
 //////////////////////      Constructor & Destructor      //////////////////////
 ReadSEGY::Opt::Opt(void)
 {
@@ -41,32 +63,69 @@ ReadSEGY::ReadSEGY(
 {
     using namespace SEGY_utils;
 
-    size_t hoSz = SEGY_utils::getHOSz();
+    size_t hoSz = obj->getHOSz();
     size_t fsz  = obj->getFileSz();
 
+    // Without a file header, the traces are in the byte order of the host,
+    // and the number of samples and the increment are taken from the header
+    // of the first trace.
+    if (hoSz == 0) {
+        is_big_endian = !is_little_endian_host();
+
+        if (fsz >= SEGY_utils::getMDSz()) {
+            auto md = std::vector<unsigned char>(SEGY_utils::getMDSz());
+            obj->readDOMD(0LU, 0LU, 1LU, md.data());
+
+            ns  = getInt16(md.data(), PIOL_TR_Ns - 1U, is_big_endian);
+            inc = incFactor
+                  * exseis::utils::Floating_point(
+                      getInt16(md.data(), PIOL_TR_Inc - 1U, is_big_endian));
+
+            obj->setSampleSz(SEGY_utils::getSampleSz(number_format));
+            nt = fsz / SEGY_utils::getDOSz(ns, obj->getSampleSz());
+        }
+    }
     // Read the global header data, if there is any.
-    if (fsz >= hoSz) {
+    else if (fsz >= hoSz) {
 
         // Read the header into header_buffer
         auto header_buffer = std::vector<unsigned char>(hoSz);
         obj->readHO(header_buffer.data());
 
+        // The byte order marker is only set in little-endian files.
+        const unsigned char* bom =
+          &header_buffer[SEGYFileHeaderByte::ByteOrder];
+        is_big_endian =
+          (from_little_endian<int32_t>({{bom[0], bom[1], bom[2], bom[3]}})
+           != 0x01020304);
+
         // Parse the number of samples, traces, the increment and the format
         // from header_buffer.
-        ns = from_big_endian<int16_t>(
-          header_buffer[SEGYFileHeaderByte::NumSample + 0],
-          header_buffer[SEGYFileHeaderByte::NumSample + 1]);
-
-        nt = SEGY_utils::getNt(fsz, ns);
+        ns = getInt16(
+          header_buffer.data(), SEGYFileHeaderByte::NumSample, is_big_endian);
 
         inc = incFactor
-              * exseis::utils::Floating_point(from_big_endian<int16_t>(
-                  header_buffer[SEGYFileHeaderByte::Interval + 0],
-                  header_buffer[SEGYFileHeaderByte::Interval + 1]));
+              * exseis::utils::Floating_point(getInt16(
+                  header_buffer.data(), SEGYFileHeaderByte::Interval,
+                  is_big_endian));
+
+        number_format = static_cast<SEGYNumberFormat>(getInt16(
+          header_buffer.data(), SEGYFileHeaderByte::Type, is_big_endian));
+
+        if (!SEGY_utils::isSupported(number_format)) {
+            piol->log->record(
+              name, Logger::Layer::File, Logger::Status::Warning,
+              "Unsupported SEG-Y number format "
+                + std::to_string(static_cast<int>(number_format))
+                + ". The traces are read as IEEE floats.",
+              PIOL_VERBOSITY_NONE);
+            number_format = SEGYNumberFormat::IEEE;
+        }
 
-        number_format = static_cast<SEGYNumberFormat>(from_big_endian<int16_t>(
-          header_buffer[SEGYFileHeaderByte::Type + 0],
-          header_buffer[SEGYFileHeaderByte::Type + 1]));
+        // The object layer sizes data-objects by the sample size.
+        obj->setSampleSz(SEGY_utils::getSampleSz(number_format));
+
+        nt = (fsz - hoSz) / SEGY_utils::getDOSz(ns, obj->getSampleSz());
 
         // Set this->text to the ASCII encoding of the text header data read
         // into header_buffer.
@@ -101,6 +160,10 @@ ReadSEGY::ReadSEGY(
               to_ASCII_from_EBCDIC);
         }
     }
+
+    if (!opt.index.empty()) {
+        index = std::make_shared<ParamIndex>(piol, opt.index, name, fsz, nt);
+    }
 }
 
 ReadSEGY::ReadSEGY(
@@ -116,11 +179,294 @@ size_t ReadSEGY::readNt(void) const
     return nt;
 }
 
+/*! Decode two's complement integer samples into native trace values.
+ *  @tparam     T             The integer type of the samples, of size 2 or 4.
+ *  @param[in]  df            The samples, as laid out in the file.
+ *  @param[in]  n             The number of samples.
+ *  @param[out] trc           The trace values.
+ *  @param[in]  is_big_endian Whether the samples are big-endian.
+ */
+template<typename T>
+void decodeInteger(
+  const unsigned char* df,
+  const size_t n,
+  exseis::utils::Trace_value* trc,
+  const bool is_big_endian)
+{
+    using Bits = typename std::make_unsigned<T>::type;
+
+    std::array<unsigned char, sizeof(T)> bytes;
+    for (size_t i = 0; i < n; i++) {
+        std::copy_n(&df[i * sizeof(T)], sizeof(T), bytes.begin());
+        trc[i] = exseis::utils::Trace_value(static_cast<T>(
+          is_big_endian ? from_big_endian<Bits>(bytes) :
+                          from_little_endian<Bits>(bytes)));
+    }
+}
+
+/*! Decode SEG-Y trace samples into native trace values. Little-endian IEEE
+ *  samples are copied, or left as they are if they were read in place.
+ *  @param[in]  df            The samples, as laid out in the file.
+ *  @param[in]  number_format The format of the trace data.
+ *  @param[in]  is_big_endian Whether the samples are big-endian.
+ *  @param[in]  n             The number of samples.
+ *  @param[out] trc           The trace values. They may be stored over \c df
+ *                            if the samples are 4 bytes.
+ */
+static void decodeDF(
+  const unsigned char* df,
+  const SEGY_utils::SEGYNumberFormat number_format,
+  const bool is_big_endian,
+  const size_t n,
+  exseis::utils::Trace_value* trc)
+{
+    static_assert(
+      std::is_same<exseis::utils::Trace_value, float>::value,
+      "The SEG-Y trace decoding expects float trace values.");
+
+    switch (number_format) {
+        case SEGY_utils::SEGYNumberFormat::IBM:
+            from_IBM_to_float_n(df, n, trc, is_big_endian);
+            break;
+        case SEGY_utils::SEGYNumberFormat::TC4:
+            decodeInteger<int32_t>(df, n, trc, is_big_endian);
+            break;
+        case SEGY_utils::SEGYNumberFormat::TC2:
+            decodeInteger<int16_t>(df, n, trc, is_big_endian);
+            break;
+        case SEGY_utils::SEGYNumberFormat::TC1:
+            for (size_t i = 0; i < n; i++) {
+                trc[i] = exseis::utils::Trace_value(int8_t(df[i]));
+            }
+            break;
+        case SEGY_utils::SEGYNumberFormat::IEEE8:
+            for (size_t i = 0; i < n; i++) {
+                std::array<unsigned char, 8> bytes;
+                std::copy_n(&df[8LU * i], 8LU, bytes.begin());
+
+                uint64_t bits = 0;
+                if (is_big_endian) {
+                    const uint64_t hi = from_big_endian<uint32_t>(
+                      bytes[0], bytes[1], bytes[2], bytes[3]);
+                    const uint64_t lo = from_big_endian<uint32_t>(
+                      bytes[4], bytes[5], bytes[6], bytes[7]);
+                    bits = (hi << 32) | lo;
+                }
+                else {
+                    bits = from_little_endian<uint64_t>(bytes);
+                }
+
+                double d = 0;
+                std::memcpy(&d, &bits, sizeof(double));
+                trc[i] = exseis::utils::Trace_value(d);
+            }
+            break;
+        default:
+            if (is_big_endian) {
+                from_big_endian_n(df, n, trc);
+            }
+            else {
+                from_little_endian_n(df, n, trc);
+            }
+            break;
+    }
+}
+
+/*! Decode the samples of several SEG-Y traces, split over threads.
+ *  @param[in]  buf           The first trace, as laid out in the file.
+ *  @param[in]  stride        The distance in bytes between adjacent traces
+ *                            in \c buf.
+ *  @param[in]  number_format The format of the trace data.
+ *  @param[in]  is_big_endian Whether the samples are big-endian.
+ *  @param[in]  ns            The number of samples per trace.
+ *  @param[in]  sz            The number of traces.
+ *  @param[out] trc           The trace values. They may be stored over
+ *                            \c buf if the samples are 4 bytes and
+ *                            \c stride is the size of a trace.
+ *  @param[in]  threads       The number of threads to use.
+ */
+static void decodeTraces(
+  const unsigned char* buf,
+  const size_t stride,
+  const SEGY_utils::SEGYNumberFormat number_format,
+  const bool is_big_endian,
+  const size_t ns,
+  const size_t sz,
+  exseis::utils::Trace_value* trc,
+  const size_t threads)
+{
+#pragma omp parallel for num_threads(int(threads)) \
+  if (threads > 1 && sz > 1) schedule(static)
+    for (size_t i = 0; i < sz; i++) {
+        decodeDF(
+          &buf[i * stride], number_format, is_big_endian, ns, &trc[i * ns]);
+    }
+}
+
+/*! Decode the trace and parameters of a single SEG-Y data-object.
+ *  @param[in] dobj          The data-object, as laid out in the file.
+ *  @param[in] number_format The format of the trace data.
+ *  @param[in] is_big_endian Whether the data-object is big-endian.
+ *  @param[in] ns            The number of samples per trace.
+ *  @param[in] i             The index of the trace within the read.
+ *  @param[in] ltn           The file trace number of the data-object.
+ *  @param[in] trc           Pointer to trace array, or TRACE_NULL.
+ *  @param[in] prm           Pointer to parameter structure.
+ *  @param[in] skip          Skip \c skip entries in the parameter structure
+ */
+void decodeDO(
+  const unsigned char* dobj,
+  const SEGY_utils::SEGYNumberFormat number_format,
+  const bool is_big_endian,
+  const size_t ns,
+  const size_t i,
+  const size_t ltn,
+  exseis::utils::Trace_value* trc,
+  Param* prm,
+  const size_t skip)
+{
+    using namespace SEGY_utils;
+
+    if (prm != PIOL_PARAM_NULL) {
+        extractParam(
+          1LU, dobj + prm->r->base(), prm, 0LU, skip + i, 1LU, is_big_endian);
+        param_utils::setPrm(i + skip, PIOL_META_ltn, ltn, prm);
+    }
+
+    if (trc != TRACE_NULL && trc != nullptr) {
+        const unsigned char* df       = dobj + SEGY_utils::getMDSz();
+        exseis::utils::Trace_value* t = &trc[i * ns];
+
+        decodeDF(df, number_format, is_big_endian, ns, t);
+    }
+}
+
+/*! Read SEG-Y traces and parameters straight from data-objects which the
+ *  object layer holds in memory, without staging them in a buffer.
+ *  @param[in] obj           The object-layer object.
+ *  @param[in] number_format The format of the trace data.
+ *  @param[in] is_big_endian Whether the file is big-endian.
+ *  @param[in] ns            The number of samples per trace.
+ *  @param[in] offunc        A function which given the ith trace of the local
+ *                           process, returns the associated trace offset.
+ *  @param[in] sz            The number of traces to read
+ *  @param[in] trc           Pointer to trace array.
+ *  @param[in] prm           Pointer to parameter structure.
+ *  @param[in] skip          Skip \c skip entries in the parameter structure
+ *  @return Return false if the data-objects are not available in memory, in
+ *          which case nothing was read.
+ */
+bool readTraceMapped(
+  ObjectInterface* obj,
+  const SEGY_utils::SEGYNumberFormat number_format,
+  const bool is_big_endian,
+  const size_t ns,
+  std::function<size_t(size_t)> offunc,
+  const size_t sz,
+  exseis::utils::Trace_value* trc,
+  Param* prm,
+  const size_t skip)
+{
+    if (sz == 0 || obj->mapDO(offunc(0), ns, 1) == nullptr) {
+        return false;
+    }
+
+    for (size_t i = 0; i < sz; i++) {
+        const unsigned char* dobj = obj->mapDO(offunc(i), ns, 1);
+        if (dobj != nullptr) {
+            decodeDO(
+              dobj, number_format, is_big_endian, ns, i, offunc(i), trc, prm,
+              skip);
+        }
+    }
+
+    return true;
+}
+
+/// Fields of the trace header further apart than this many bytes are read
+/// separately, rather than read through the gap between them.
+const size_t header_gap = 64LU;
+
+/*! Get the parts of the trace header which hold the parameters of a rule.
+ *  Fields which are close together share a part.
+ *  @param[in] r The rules.
+ *  @return Return the byte ranges of the parts, relative to the start of the
+ *          rule extent, in order.
+ */
+std::vector<std::pair<size_t, size_t>> getHeaderParts(Rule* r)
+{
+    const auto& program = r->compile();
+
+    std::vector<std::pair<size_t, size_t>> field;
+    for (const auto& op : program.op) {
+        const size_t len = (op.type == RuleEntry::MdType::Short ? 2LU : 4LU);
+        field.emplace_back(op.loc, op.loc + len);
+    }
+    for (const auto loc : program.scalLoc) {
+        field.emplace_back(loc, loc + 2LU);
+    }
+    std::sort(field.begin(), field.end());
+
+    std::vector<std::pair<size_t, size_t>> part;
+    for (const auto& f : field) {
+        if (part.empty() || f.first > part.back().second + header_gap) {
+            part.push_back(f);
+        }
+        else {
+            part.back().second = std::max(part.back().second, f.second);
+        }
+    }
+    return part;
+}
+
+/*! Read the parts of the trace headers which hold the parameters of a rule.
+ *  @tparam T           The type of offset (pointer or size_t)
+ *  @param[in]  obj     The object-layer object.
+ *  @param[in]  offset  The offset(s). If T == size_t * this is an array,
+ *                      otherwise its a single offset.
+ *  @param[in]  ns      The number of samples per trace.
+ *  @param[in]  sz      The number of traces to read
+ *  @param[in]  r       The rules, which must not copy the whole header.
+ *  @param[out] buf     The headers, each the size of the rule extent. Bytes
+ *                      between the parts are left as they were.
+ */
+template<typename T>
+void readHeaderParts(
+  ObjectInterface* obj,
+  const T offset,
+  const size_t ns,
+  const size_t sz,
+  Rule* r,
+  unsigned char* buf)
+{
+    const size_t extent = r->extent();
+    const size_t base   = r->base();
+    const auto part     = getHeaderParts(r);
+
+    // A single part spans the extent, so it is read in place.
+    if (part.size() <= 1LU) {
+        obj->readDOMD(offset, ns, sz, base, extent, buf);
+        return;
+    }
+
+    std::vector<unsigned char> pbuf;
+    for (const auto& p : part) {
+        const size_t len = p.second - p.first;
+        pbuf.resize(sz * len);
+        obj->readDOMD(offset, ns, sz, base + p.first, len, pbuf.data());
+
+        for (size_t i = 0; i < sz; i++) {
+            std::copy_n(&pbuf[i * len], len, &buf[i * extent + p.first]);
+        }
+    }
+}
+
 /*! Template function for reading SEG-Y traces and parameters, random and
  *  contiguous.
  *  @tparam T                The type of offset (pointer or size_t)
  *  @param[in] obj           The object-layer object.
  *  @param[in] number_format The format of the trace data.
+ *  @param[in] is_big_endian Whether the file is big-endian.
  *  @param[in] ns            The number of samples per trace.
  *  @param[in] offset        The offset(s). If T == size_t * this is an array,
  *                           otherwise its a single offset.
@@ -130,83 +476,146 @@ size_t ReadSEGY::readNt(void) const
  *  @param[in] trc           Pointer to trace array.
  *  @param[in] prm           Pointer to parameter structure.
  *  @param[in] skip          Skip \c skip entries in the parameter structure
+ *  @param[in] threads       The number of threads to convert with.
  */
 template<typename T>
 void readTraceT(
   ObjectInterface* obj,
   const SEGY_utils::SEGYNumberFormat number_format,
+  const bool is_big_endian,
   const size_t ns,
   const T offset,
   std::function<size_t(size_t)> offunc,
   const size_t sz,
   exseis::utils::Trace_value* trc,
   Param* prm,
-  const size_t skip)
+  const size_t skip,
+  const size_t threads)
 {
     using namespace SEGY_utils;
 
-    unsigned char* tbuf = reinterpret_cast<unsigned char*>(trc);
+    if (readTraceMapped(
+          obj, number_format, is_big_endian, ns, offunc, sz, trc, prm, skip)) {
+        return;
+    }
+
+    // Samples the size of a trace value are decoded where they were read in
+    // trc. Others are staged.
+    const size_t dfSz = SEGY_utils::getDFSz(ns, obj->getSampleSz());
+    const bool staged =
+      obj->getSampleSz() != sizeof(exseis::utils::Trace_value)
+      && trc != TRACE_NULL && trc != nullptr;
+
+    std::vector<unsigned char> talloc(staged ? dfSz * sz : 0LU);
+    unsigned char* tbuf =
+      (staged ? talloc.data() : reinterpret_cast<unsigned char*>(trc));
 
     if (prm == PIOL_PARAM_NULL) {
         obj->readDODF(offset, ns, sz, tbuf);
+
+        if (trc != TRACE_NULL && trc != nullptr) {
+            decodeTraces(
+              tbuf, dfSz, number_format, is_big_endian, ns, sz, trc, threads);
+        }
     }
     else {
-        const size_t blockSz =
-          (trc == TRACE_NULL ? SEGY_utils::getMDSz() : SEGY_utils::getDOSz(ns));
-
-        std::vector<unsigned char> alloc(blockSz * sz);
+        // Only the headers are staged. When only parameters are read, just
+        // the part of the header spanned by the rules is read, unless the
+        // whole header is copied.
+        Rule* r             = prm->r.get();
+        const size_t mdsz   = SEGY_utils::getMDSz();
+        const size_t extent = r->extent();
+        const bool part =
+          (trc == TRACE_NULL && r->numCopy == 0 && extent < mdsz);
+
+        std::vector<unsigned char> alloc((part ? extent : mdsz) * sz);
         unsigned char* buf = (sz ? alloc.data() : nullptr);
 
-        if (trc == TRACE_NULL) {
-            obj->readDOMD(offset, ns, sz, buf);
+        if (part) {
+            readHeaderParts(obj, offset, ns, sz, r, buf);
+            extractParam(sz, buf, prm, 0LU, skip, threads, is_big_endian);
         }
         else {
-            obj->readDO(offset, ns, sz, buf);
+            if (trc == TRACE_NULL) {
+                obj->readDOMD(offset, ns, sz, buf);
+            }
+            else {
+                obj->readDO(offset, ns, sz, buf, tbuf);
 
-            for (size_t i = 0; i < sz; i++) {
-                std::copy(
-                  &buf[i * SEGY_utils::getDOSz(ns) + SEGY_utils::getMDSz()],
-                  &buf[(i + 1) * SEGY_utils::getDOSz(ns)],
-                  &tbuf[i * SEGY_utils::getDFSz(ns)]);
+                decodeTraces(
+                  tbuf, dfSz, number_format, is_big_endian, ns, sz, trc,
+                  threads);
             }
-        }
 
-        extractParam(
-          sz, buf, prm, (trc != TRACE_NULL ? SEGY_utils::getDFSz(ns) : 0LU),
-          skip);
+            extractParam(
+              sz, (sz ? buf + r->base() : buf), prm, mdsz - extent, skip,
+              threads, is_big_endian);
+        }
 
         for (size_t i = 0; i < sz; i++) {
             param_utils::setPrm(i + skip, PIOL_META_ltn, offunc(i), prm);
         }
     }
+}
 
-    if (trc != TRACE_NULL && trc != nullptr) {
-
-        // Convert trace values from SEGY floating point format to host format
-        if (number_format == SEGYNumberFormat::IBM) {
-            for (size_t i = 0; i < ns * sz; i++) {
-                const exseis::utils::Floating_point be_trc_i = trc[i];
-
-                const unsigned char* be_trc_i_bytes =
-                  reinterpret_cast<const unsigned char*>(&be_trc_i);
-
-                std::array<unsigned char, 4> be_bytes_array = {
-                  {be_trc_i_bytes[0], be_trc_i_bytes[1], be_trc_i_bytes[2],
-                   be_trc_i_bytes[3]}};
+/*! Template function for reading a window of samples of SEG-Y traces,
+ *  random and contiguous.
+ *  @tparam T                The type of offset (pointer or size_t)
+ *  @param[in] obj           The object-layer object.
+ *  @param[in] number_format The format of the trace data.
+ *  @param[in] is_big_endian Whether the file is big-endian.
+ *  @param[in] ns            The number of samples per trace.
+ *  @param[in] offset        The offset(s). If T == size_t * this is an array,
+ *                           otherwise its a single offset.
+ *  @param[in] offunc        A function which given the ith trace of the local
+ *                           process, returns the associated trace offset.
+ *  @param[in] sz            The number of traces to read
+ *  @param[in] s0            The first sample of the window.
+ *  @param[in] n             The number of samples in the window.
+ *  @param[out] trc          The windows of the traces.
+ *  @param[in] threads       The number of threads to convert with.
+ */
+template<typename T>
+void readWindowT(
+  ObjectInterface* obj,
+  const SEGY_utils::SEGYNumberFormat number_format,
+  const bool is_big_endian,
+  const size_t ns,
+  const T offset,
+  std::function<size_t(size_t)> offunc,
+  const size_t sz,
+  const size_t s0,
+  const size_t n,
+  exseis::utils::Trace_value* trc,
+  const size_t threads)
+{
+    const size_t sampleSz = obj->getSampleSz();
+    const size_t skip     = s0 * sampleSz;
+    const size_t wSz      = n * sampleSz;
 
-                trc[i] = from_IBM_to_float(be_bytes_array, true);
-            }
-        }
-        else {
-            for (size_t i = 0; i < ns * sz; i++) {
-                trc[i] = from_big_endian<exseis::utils::Trace_value>(
-                  tbuf[i * sizeof(exseis::utils::Trace_value) + 0],
-                  tbuf[i * sizeof(exseis::utils::Trace_value) + 1],
-                  tbuf[i * sizeof(exseis::utils::Trace_value) + 2],
-                  tbuf[i * sizeof(exseis::utils::Trace_value) + 3]);
+    if (sz != 0 && obj->mapDO(offunc(0), ns, 1) != nullptr) {
+        for (size_t i = 0; i < sz; i++) {
+            const unsigned char* dobj = obj->mapDO(offunc(i), ns, 1);
+            if (dobj != nullptr) {
+                decodeDF(
+                  dobj + SEGY_utils::getMDSz() + skip, number_format,
+                  is_big_endian, n, &trc[i * n]);
             }
         }
+        return;
     }
+
+    // As for whole traces, samples the size of a trace value are decoded
+    // where they were read.
+    const bool staged = sampleSz != sizeof(exseis::utils::Trace_value);
+
+    std::vector<unsigned char> talloc(staged ? wSz * sz : 0LU);
+    unsigned char* tbuf =
+      (staged ? talloc.data() : reinterpret_cast<unsigned char*>(trc));
+
+    obj->readDODF(offset, ns, sz, skip, wSz, tbuf);
+    decodeTraces(
+      tbuf, wSz, number_format, is_big_endian, n, sz, trc, threads);
 }
 
 void ReadSEGY::readTrace(
@@ -223,9 +632,48 @@ void ReadSEGY::readTrace(
           name, Logger::Layer::File, Logger::Status::Warning,
           "readParam() was called for a zero byte read", PIOL_VERBOSITY_NONE);
     }
+    obj->advise(AccessPattern::Sequential);
     readTraceT(
-      obj.get(), number_format, ns, offset,
-      [offset](size_t i) -> size_t { return offset + i; }, ntz, trc, prm, skip);
+      obj.get(), number_format, is_big_endian, ns, offset,
+      [offset](size_t i) -> size_t { return offset + i; }, ntz, trc, prm, skip,
+      piol->numThreads);
+}
+
+std::shared_ptr<Request> ReadSEGY::ireadTrace(
+  const size_t offset,
+  const size_t sz,
+  exseis::utils::Trace_value* trc,
+  Param* prm,
+  const size_t skip) const
+{
+    size_t ntz = ((sz == 0) ? sz : (offset + sz > nt ? nt - offset : sz));
+    if (offset >= nt && sz != 0) {
+        // Nothing to be read.
+        piol->log->record(
+          name, Logger::Layer::File, Logger::Status::Warning,
+          "ireadTrace() was called for a zero byte read", PIOL_VERBOSITY_NONE);
+    }
+    obj->advise(AccessPattern::Sequential);
+
+    // Whole data-objects are staged so the read is a single contiguous
+    // request. Decoding is deferred until the request completes.
+    const size_t doSz = SEGY_utils::getDOSz(ns, obj->getSampleSz());
+    auto buf = std::make_shared<std::vector<unsigned char>>(ntz * doSz);
+
+    auto req = obj->ireadDO(offset, ns, ntz, (ntz ? buf->data() : nullptr));
+
+    const auto format = number_format;
+    const bool big    = is_big_endian;
+    const size_t lns  = ns;
+    return std::make_shared<ChainedRequest>(
+      std::move(req),
+      [buf, format, big, lns, doSz, offset, ntz, trc, prm, skip]() {
+          for (size_t i = 0; i < ntz; i++) {
+              decodeDO(
+                &(*buf)[i * doSz], format, big, lns, i, offset + i, trc, prm,
+                skip);
+          }
+      });
 }
 
 void ReadSEGY::readTraceNonContiguous(
@@ -235,9 +683,11 @@ void ReadSEGY::readTraceNonContiguous(
   Param* prm,
   const size_t skip) const
 {
+    obj->advise(AccessPattern::Random);
     readTraceT(
-      obj.get(), number_format, ns, offset,
-      [offset](size_t i) -> size_t { return offset[i]; }, sz, trc, prm, skip);
+      obj.get(), number_format, is_big_endian, ns, offset,
+      [offset](size_t i) -> size_t { return offset[i]; }, sz, trc, prm, skip,
+      piol->numThreads);
 }
 
 void ReadSEGY::readTraceNonMonotonic(
@@ -265,27 +715,76 @@ void ReadSEGY::readTraceNonMonotonic(
       nodups.size(), nodups.data(), (trc != TRACE_NULL ? strc.data() : trc),
       (prm != PIOL_PARAM_NULL ? &sprm : prm), 0LU);
 
-    if (prm != PIOL_PARAM_NULL) {
-        for (size_t n = 0, j = 0; j < sz; ++j) {
-            if (j != 0 && offset[idx[j - 1]] != offset[idx[j]]) {
-                n++;
-            }
-
-            param_utils::cpyPrm(n, &sprm, skip + idx[j], prm);
+    // The trace read for each requested offset
+    std::vector<size_t> src(sz);
+    for (size_t n = 0, j = 0; j < sz; ++j) {
+        if (j != 0 && offset[idx[j - 1]] != offset[idx[j]]) {
+            n++;
         }
+        src[idx[j]] = n;
+    }
+
+    if (prm != PIOL_PARAM_NULL) {
+        param_utils::permutePrm(sz, src.data(), &sprm, skip, prm);
     }
 
     if (trc != TRACE_NULL) {
-        for (size_t n = 0, j = 0; j < sz; ++j) {
-            if (j != 0 && offset[idx[j - 1]] != offset[idx[j]]) {
-                n++;
-            }
+        param_utils::permuteTrc(sz, src.data(), ns, strc.data(), trc);
+    }
+}
 
-            for (size_t k = 0; k < ns; k++) {
-                trc[idx[j] * ns + k] = strc[n * ns + k];
-            }
-        }
+void ReadSEGY::readTraceWindow(
+  const size_t offset,
+  const size_t sz,
+  const size_t s0,
+  const size_t n,
+  exseis::utils::Trace_value* trc,
+  Param* prm,
+  const size_t skip) const
+{
+    size_t ntz = ((sz == 0) ? sz : (offset + sz > nt ? nt - offset : sz));
+    if (offset >= nt && sz != 0) {
+        // Nothing to be read.
+        piol->log->record(
+          name, Logger::Layer::File, Logger::Status::Warning,
+          "readTraceWindow() was called for a zero byte read",
+          PIOL_VERBOSITY_NONE);
+    }
+    if (!checkWindow(s0, n)) {
+        ntz = 0;
+    }
+
+    if (prm != PIOL_PARAM_NULL) {
+        readParam(offset, ntz, prm, skip);
     }
+
+    obj->advise(AccessPattern::Sequential);
+    readWindowT(
+      obj.get(), number_format, is_big_endian, ns, offset,
+      [offset](size_t i) -> size_t { return offset + i; }, ntz, s0, n, trc,
+      piol->numThreads);
+}
+
+void ReadSEGY::readTraceWindowNonContiguous(
+  const size_t sz,
+  const size_t* offset,
+  const size_t s0,
+  const size_t n,
+  exseis::utils::Trace_value* trc,
+  Param* prm,
+  const size_t skip) const
+{
+    const size_t wsz = (checkWindow(s0, n) ? sz : 0LU);
+
+    if (prm != PIOL_PARAM_NULL) {
+        readParamNonContiguous(wsz, offset, prm, skip);
+    }
+
+    obj->advise(AccessPattern::Random);
+    readWindowT(
+      obj.get(), number_format, is_big_endian, ns, offset,
+      [offset](size_t i) -> size_t { return offset[i]; }, wsz, s0, n, trc,
+      piol->numThreads);
 }
 
 }  // namespace PIOL
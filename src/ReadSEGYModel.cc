@@ -26,7 +26,8 @@ ReadSEGYModel::ReadSEGYModel(
     ReadSEGY(piol_, name_, opt, obj_)
 {
     std::vector<size_t> vlist = {0LU, 1LU, ReadSEGY::readNt() - 1LU};
-    Param prm(vlist.size());
+    // Only the inline and crossline numbers are decoded.
+    Param prm(std::make_shared<Rule>(true, true), vlist.size(), true);
     readParamNonContiguous(vlist.size(), vlist.data(), &prm);
 
     exseis::utils::Integer il_start =
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of \c ChainedRequest
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExSeisDat/PIOL/Request.hh"
+
+namespace exseis {
+namespace PIOL {
+
+ChainedRequest::ChainedRequest(
+  std::shared_ptr<Request> req_, std::function<void(void)> onComplete_) :
+    req(std::move(req_)),
+    onComplete(std::move(onComplete_)),
+    done(false)
+{
+}
+
+ChainedRequest::~ChainedRequest(void)
+{
+    wait();
+}
+
+void ChainedRequest::complete(void)
+{
+    if (!done) {
+        done = true;
+        if (onComplete) {
+            onComplete();
+        }
+    }
+}
+
+void ChainedRequest::wait(void)
+{
+    if (!done) {
+        req->wait();
+        complete();
+    }
+}
+
+bool ChainedRequest::test(void)
+{
+    if (!done && req->test()) {
+        complete();
+    }
+    return done;
+}
+
+}  // namespace PIOL
+}  // namespace exseis
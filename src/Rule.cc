@@ -6,6 +6,8 @@
 #include "ExSeisDat/PIOL/Rule.hh"
 #include "ExSeisDat/PIOL/SEGYRuleEntry.hh"
 
+#include <algorithm>
+
 namespace exseis {
 namespace PIOL {
 
@@ -24,7 +26,11 @@ static std::vector<Meta> extra_metas{
 
 Rule::Rule(RuleMap translate_, bool full) : translate(translate_)
 {
+    flag.badprogram = true;
+
     for (const auto& t : translate) {
+        setEntry(t.first, t.second);
+
         switch (t.second->type()) {
             case RuleEntry::MdType::Long:
                 numLong++;
@@ -63,6 +69,7 @@ Rule::Rule(
 
     // TODO: Change this when extents are flexible
     flag.fullextent = full;
+    flag.badprogram = true;
     addIndex(PIOL_META_gtn);
     addIndex(PIOL_META_ltn);
 
@@ -255,6 +262,71 @@ size_t Rule::extent(void)
     return end - start;
 }
 
+size_t Rule::base(void)
+{
+    // The locations are 1-based SEG-Y byte positions, as is start unless the
+    // extent is the whole header.
+    extent();
+    return (start == 0LU ? 0LU : start - 1LU);
+}
+
+const Rule::Program& Rule::compile(void)
+{
+    if (!flag.badprogram) {
+        return program;
+    }
+
+    // The offsets are relative to the start of the extent.
+    const size_t base = this->base();
+
+    program.op.clear();
+    program.scalLoc.clear();
+
+    for (const auto& t : translate) {
+        RuleEntry* e = t.second;
+        switch (e->type()) {
+            case RuleEntry::MdType::Float:
+                program.scalLoc.push_back(
+                  static_cast<SEGYFloatRuleEntry*>(e)->scalLoc - base
+                  - 1LU);
+                program.op.push_back(
+                  {e->loc - base - 1LU, e->type(), e->num,
+                   program.scalLoc.back(), 0LU});
+                break;
+
+            case RuleEntry::MdType::Long:
+            case RuleEntry::MdType::Short:
+                program.op.push_back(
+                  {e->loc - base - 1LU, e->type(), e->num, 0LU, 0LU});
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    std::sort(program.scalLoc.begin(), program.scalLoc.end());
+    program.scalLoc.erase(
+      std::unique(program.scalLoc.begin(), program.scalLoc.end()),
+      program.scalLoc.end());
+
+    std::sort(
+      program.op.begin(), program.op.end(),
+      [](const Op& a, const Op& b) { return a.loc < b.loc; });
+
+    for (auto& o : program.op) {
+        if (o.type == RuleEntry::MdType::Float) {
+            o.scal = size_t(
+              std::lower_bound(
+                program.scalLoc.begin(), program.scalLoc.end(), o.scalLoc)
+              - program.scalLoc.begin());
+        }
+    }
+
+    flag.badprogram = false;
+    return program;
+}
+
 // TODO: These can be optimised to stop the double lookup if required.
 void Rule::addLong(Meta m, Tr loc)
 {
@@ -264,8 +336,10 @@ void Rule::addLong(Meta m, Tr loc)
     }
 
     translate[m] = new SEGYLongRuleEntry(numLong++, loc);
+    setEntry(m, translate[m]);
 
-    flag.badextent = (!flag.fullextent);
+    flag.badextent  = (!flag.fullextent);
+    flag.badprogram = true;
 }
 
 void Rule::addShort(Meta m, Tr loc)
@@ -276,8 +350,10 @@ void Rule::addShort(Meta m, Tr loc)
     }
 
     translate[m] = new SEGYShortRuleEntry(numShort++, loc);
+    setEntry(m, translate[m]);
 
-    flag.badextent = (!flag.fullextent);
+    flag.badextent  = (!flag.fullextent);
+    flag.badprogram = true;
 }
 
 void Rule::addSEGYFloat(Meta m, Tr loc, Tr scalLoc)
@@ -288,8 +364,10 @@ void Rule::addSEGYFloat(Meta m, Tr loc, Tr scalLoc)
     }
 
     translate[m] = new SEGYFloatRuleEntry(numFloat++, loc, scalLoc);
+    setEntry(m, translate[m]);
 
-    flag.badextent = (!flag.fullextent);
+    flag.badextent  = (!flag.fullextent);
+    flag.badprogram = true;
 }
 
 void Rule::addIndex(Meta m)
@@ -300,12 +378,14 @@ void Rule::addIndex(Meta m)
     }
 
     translate[m] = new SEGYIndexRuleEntry(numIndex++);
+    setEntry(m, translate[m]);
 }
 
 void Rule::addCopy(void)
 {
     if (numCopy == 0) {
         translate[PIOL_META_COPY] = new SEGYCopyRuleEntry();
+        setEntry(PIOL_META_COPY, translate[PIOL_META_COPY]);
         numCopy++;
     }
 }
@@ -345,19 +425,31 @@ void Rule::rmRule(Meta m)
         delete entry;
 
         translate.erase(m);
+        setEntry(m, nullptr);
         for (auto t : translate) {
             if (t.second->type() == type && t.second->num > num) {
                 t.second->num--;
             }
         }
 
-        flag.badextent = (!flag.fullextent);
+        flag.badextent  = (!flag.fullextent);
+        flag.badprogram = true;
     }
 }
 
 RuleEntry* Rule::getEntry(Meta entry)
 {
-    return translate[entry];
+    const auto m = static_cast<size_t>(entry);
+    return (m < dense.size() ? dense[m] : nullptr);
+}
+
+void Rule::setEntry(Meta m, RuleEntry* entry)
+{
+    const auto i = static_cast<size_t>(m);
+    if (i >= dense.size()) {
+        dense.resize(i + 1LU, nullptr);
+    }
+    dense[i] = entry;
 }
 
 size_t Rule::memUsage(void) const
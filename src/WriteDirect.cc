@@ -5,8 +5,7 @@
 
 #include "ExSeisDat/PIOL/WriteDirect.hh"
 
-#include "ExSeisDat/PIOL/DataMPIIO.hh"
-#include "ExSeisDat/PIOL/ObjectSEGY.hh"
+#include "ExSeisDat/PIOL/ObjectInterface.hh"
 #include "ExSeisDat/PIOL/WriteSEGY.hh"
 
 namespace exseis {
@@ -16,15 +15,8 @@ WriteDirect::WriteDirect(
   std::shared_ptr<ExSeisPIOL> piol, const std::string name)
 {
     const WriteSEGY::Opt f;
-    const ObjectSEGY::Opt o;
-    const DataMPIIO::Opt d;
-
-    auto data = std::make_shared<DataMPIIO>(piol, name, d, FileMode::Write);
-
-    auto obj =
-      std::make_shared<ObjectSEGY>(piol, name, o, data, FileMode::Write);
-
-    file = std::make_shared<WriteSEGY>(piol, name, f, obj);
+    auto obj = makeDefaultObj(piol, name, FileMode::Write);
+    file     = std::make_shared<WriteSEGY>(piol, name, f, obj);
 }
 
 WriteDirect::WriteDirect(std::shared_ptr<WriteInterface> file_) : file(file_) {}
@@ -62,6 +54,31 @@ void WriteDirect::writeParamNonContiguous(
     file->writeParamNonContiguous(sz, offset, prm);
 }
 
+void WriteDirect::writeTraceWindow(
+  const size_t offset,
+  const size_t sz,
+  const size_t s0,
+  const size_t n,
+  const exseis::utils::Trace_value* trace)
+{
+    file->writeTraceWindow(offset, sz, s0, n, trace);
+}
+
+void WriteDirect::writeTraceWindowNonContiguous(
+  const size_t sz,
+  const size_t* offset,
+  const size_t s0,
+  const size_t n,
+  const exseis::utils::Trace_value* trace)
+{
+    file->writeTraceWindowNonContiguous(sz, offset, s0, n, trace);
+}
+
+void WriteDirect::flush(void)
+{
+    file->flush();
+}
+
 void WriteDirect::writeText(const std::string text_)
 {
     file->writeText(text_);
@@ -24,5 +24,44 @@ void WriteInterface::writeParamNonContiguous(
       skip);
 }
 
+std::shared_ptr<Request> WriteInterface::iwriteTrace(
+  const size_t offset,
+  const size_t sz,
+  exseis::utils::Trace_value* trace,
+  const Param* prm,
+  const size_t skip)
+{
+    writeTrace(offset, sz, trace, prm, skip);
+    return std::make_shared<CompletedRequest>();
+}
+
+void WriteInterface::writeTraceWindow(
+  const size_t,
+  const size_t,
+  const size_t,
+  const size_t,
+  const exseis::utils::Trace_value*)
+{
+    piol->log->record(
+      name, Logger::Layer::File, Logger::Status::Error,
+      "Writing a window of samples is not supported for this file.",
+      PIOL_VERBOSITY_NONE);
+}
+
+void WriteInterface::writeTraceWindowNonContiguous(
+  const size_t,
+  const size_t*,
+  const size_t,
+  const size_t,
+  const exseis::utils::Trace_value*)
+{
+    piol->log->record(
+      name, Logger::Layer::File, Logger::Status::Error,
+      "Writing a window of samples is not supported for this file.",
+      PIOL_VERBOSITY_NONE);
+}
+
+void WriteInterface::flush(void) {}
+
 }  // namespace PIOL
 }  // namespace exseis
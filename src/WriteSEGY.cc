@@ -10,11 +10,17 @@
 #include "ExSeisDat/PIOL/WriteSEGY.hh"
 
 #include "ExSeisDat/PIOL/ObjectInterface.hh"
+#include "ExSeisDat/PIOL/Tr.h"
 #include "ExSeisDat/PIOL/segy_utils.hh"
 #include "ExSeisDat/utils/encoding/number_encoding.hh"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <iterator>
 #include <limits>
+#include <numeric>
+#include <type_traits>
 
 using namespace exseis::utils;
 using namespace exseis::PIOL::SEGY_utils;
@@ -22,12 +28,34 @@ using namespace exseis::PIOL::SEGY_utils;
 namespace exseis {
 namespace PIOL {
 
+/////////////////////////////       Non-Class      /////////////////////////////
+
+/*! Set a 2 byte integer in a header.
+ *  @param[out] buf           The header.
+ *  @param[in]  loc           The offset of the integer in \c buf.
+ *  @param[in]  value         The integer.
+ *  @param[in]  is_big_endian Whether the integer is big-endian.
+ */
+static void setInt16(
+  unsigned char* buf,
+  const size_t loc,
+  const int16_t value,
+  const bool is_big_endian)
+{
+    const auto bytes =
+      (is_big_endian ? to_big_endian(value) : to_little_endian(value));
+    std::copy(std::begin(bytes), std::end(bytes), &buf[loc]);
+}
+
 //////////////////////      Constructor & Destructor      //////////////////////
 
 WriteSEGY::Opt::Opt(void)
 {
     const double microsecond = 1e-6;
     incFactor                = 1 * microsecond;
+    writeBehindSz            = 0;
+    number_format            = SEGYNumberFormat::IEEE;
+    is_big_endian            = true;
 }
 
 WriteSEGY::WriteSEGY(
@@ -36,10 +64,31 @@ WriteSEGY::WriteSEGY(
   const WriteSEGY::Opt& opt,
   std::shared_ptr<ObjectInterface> obj_) :
     WriteInterface(piol_, name_, obj_),
-    incFactor(opt.incFactor)
+    incFactor(opt.incFactor),
+    writeBehindSz(opt.writeBehindSz),
+    number_format(opt.number_format),
+    is_big_endian(opt.is_big_endian)
 {
     memset(&state, 0, sizeof(Flags));
     state.writeHO = true;
+
+    if (!SEGY_utils::isSupported(number_format)) {
+        piol->log->record(
+          name, Logger::Layer::File, Logger::Status::Error,
+          "Unsupported SEG-Y number format "
+            + std::to_string(static_cast<int>(number_format))
+            + " requested for writing",
+          PIOL_VERBOSITY_NONE);
+        number_format = SEGYNumberFormat::IEEE;
+    }
+
+    // The object layer sizes data-objects by the sample size.
+    obj->setSampleSz(SEGY_utils::getSampleSz(number_format));
+
+    // Without a file header there is no byte order marker.
+    if (obj->getHOSz() == 0) {
+        is_big_endian = !is_little_endian_host();
+    }
 }
 
 WriteSEGY::WriteSEGY(
@@ -54,13 +103,16 @@ WriteSEGY::~WriteSEGY(void)
 {
     // TODO: On error this can be a source of a deadlock
     if (!piol->log->isErr()) {
+        flush();
         calcNt();
 
         if (state.resize) {
-            obj->setFileSz(SEGY_utils::getFileSz(nt, ns));
+            obj->setFileSz(
+              obj->getHOSz()
+              + nt * SEGY_utils::getDOSz(ns, obj->getSampleSz()));
         }
 
-        if (state.writeHO) {
+        if (state.writeHO && obj->getHOSz() != 0) {
             // Write file header on rank 0.
             if (piol->comm->getRank() == 0) {
                 // The buffer to build the header in
@@ -71,47 +123,47 @@ WriteSEGY::~WriteSEGY(void)
                   std::begin(text), std::end(text), std::begin(header_buffer));
 
                 // Write ns, the number format, and the interval
-                const auto be_ns = to_big_endian<int16_t>(ns);
-                std::copy(
-                  std::begin(be_ns), std::end(be_ns),
-                  &header_buffer[SEGYFileHeaderByte::NumSample]);
+                setInt16(
+                  header_buffer.data(), SEGYFileHeaderByte::NumSample,
+                  static_cast<int16_t>(ns), is_big_endian);
 
-                const auto be_format = to_big_endian<int16_t>(
-                  static_cast<int16_t>(SEGYNumberFormat::IEEE));
-                std::copy(
-                  std::begin(be_format), std::end(be_format),
-                  &header_buffer[SEGYFileHeaderByte::Type]);
+                setInt16(
+                  header_buffer.data(), SEGYFileHeaderByte::Type,
+                  static_cast<int16_t>(number_format), is_big_endian);
 
-                const auto be_interval =
-                  to_big_endian<int16_t>(std::lround(inc / incFactor));
-                std::copy(
-                  std::begin(be_interval), std::end(be_interval),
-                  &header_buffer[SEGYFileHeaderByte::Interval]);
+                setInt16(
+                  header_buffer.data(), SEGYFileHeaderByte::Interval,
+                  getInterval(), is_big_endian);
 
                 // Currently these are hard-coded entries:
                 // The unit system.
-                const auto be_units = to_big_endian<int16_t>(0x0001);
-                std::copy(
-                  std::begin(be_units), std::end(be_units),
-                  &header_buffer[SEGYFileHeaderByte::Units]);
-
-                // The version of the SEGY format.
-                const auto be_segy_format = to_big_endian<int16_t>(0x0100);
-                std::copy(
-                  std::begin(be_segy_format), std::end(be_segy_format),
-                  &header_buffer[SEGYFileHeaderByte::SEGYFormat]);
+                setInt16(
+                  header_buffer.data(), SEGYFileHeaderByte::Units, 0x0001,
+                  is_big_endian);
+
+                // The version of the SEGY format. The byte order marker of
+                // little-endian files was introduced in rev 2.
+                setInt16(
+                  header_buffer.data(), SEGYFileHeaderByte::SEGYFormat,
+                  (is_big_endian ? 0x0100 : 0x0200), is_big_endian);
+
+                if (!is_big_endian) {
+                    const auto le_marker =
+                      to_little_endian<int32_t>(0x01020304);
+                    std::copy(
+                      std::begin(le_marker), std::end(le_marker),
+                      &header_buffer[SEGYFileHeaderByte::ByteOrder]);
+                }
 
                 // We always deal with fixed traces at present.
-                const auto be_fixed_trace = to_big_endian<int16_t>(0x0001);
-                std::copy(
-                  std::begin(be_fixed_trace), std::end(be_fixed_trace),
-                  &header_buffer[SEGYFileHeaderByte::FixedTrace]);
+                setInt16(
+                  header_buffer.data(), SEGYFileHeaderByte::FixedTrace,
+                  0x0001, is_big_endian);
 
                 // We do not support text extensions at present.
-                const auto be_extensions = to_big_endian<int16_t>(0x0000);
-                std::copy(
-                  std::begin(be_extensions), std::end(be_extensions),
-                  &header_buffer[SEGYFileHeaderByte::Extensions]);
+                setInt16(
+                  header_buffer.data(), SEGYFileHeaderByte::Extensions,
+                  0x0000, is_big_endian);
 
                 // Write the header from the buffer
                 obj->writeHO(header_buffer.data());
@@ -125,6 +177,11 @@ WriteSEGY::~WriteSEGY(void)
 
 //////////////////////////       Member functions      /////////////////////////
 
+int16_t WriteSEGY::getInterval(void) const
+{
+    return static_cast<int16_t>(std::lround(inc / incFactor));
+}
+
 size_t WriteSEGY::calcNt(void)
 {
     if (state.stalent) {
@@ -153,6 +210,10 @@ void WriteSEGY::writeNs(const size_t ns_)
         return;
     }
 
+    // The buffered data-objects are sized for the old ns. Flushing is
+    // collective, so every process flushes whether or not ns changes.
+    flush();
+
     if (ns != ns_) {
         ns            = ns_;
         state.resize  = true;
@@ -186,10 +247,212 @@ void WriteSEGY::writeInc(const exseis::utils::Floating_point inc_)
     }
 }
 
+/*! Encode trace values as two's complement integer samples. The values are
+ *  rounded to the nearest integer and clamped to the range of \c T. NaNs
+ *  become zero.
+ *  @tparam     T             The integer type of the samples
+ *  @param[in]  trc           The trace values.
+ *  @param[in]  n             The number of samples.
+ *  @param[in]  is_big_endian Whether the samples are big-endian.
+ *  @param[out] df            The samples, as laid out in the file.
+ */
+template<typename T>
+static void encodeInteger(
+  const exseis::utils::Trace_value* trc,
+  const size_t n,
+  const bool is_big_endian,
+  unsigned char* df)
+{
+    const auto lo = exseis::utils::Trace_value(std::numeric_limits<T>::min());
+    const auto hi = exseis::utils::Trace_value(std::numeric_limits<T>::max());
+
+    for (size_t i = 0; i < n; i++) {
+        T value = 0;
+        if (trc[i] <= lo) {
+            value = std::numeric_limits<T>::min();
+        }
+        else if (trc[i] >= hi) {
+            value = std::numeric_limits<T>::max();
+        }
+        else if (!std::isnan(trc[i])) {
+            value = static_cast<T>(std::lrint(trc[i]));
+        }
+
+        const auto bytes =
+          (is_big_endian ? to_big_endian<T>(value) :
+                           to_little_endian<T>(value));
+        std::copy(std::begin(bytes), std::end(bytes), &df[i * sizeof(T)]);
+    }
+}
+
+/*! Encode trace values as SEG-Y samples. Little-endian IEEE samples are
+ *  copied.
+ *  @param[in]  trc           The trace values.
+ *  @param[in]  n             The number of samples.
+ *  @param[in]  number_format The format of the trace data.
+ *  @param[in]  is_big_endian Whether the samples are big-endian.
+ *  @param[out] df            The samples, as laid out in the file.
+ */
+static void encodeDF(
+  const exseis::utils::Trace_value* trc,
+  const size_t n,
+  const SEGYNumberFormat number_format,
+  const bool is_big_endian,
+  unsigned char* df)
+{
+    switch (number_format) {
+        case SEGYNumberFormat::IBM:
+            to_IBM_from_float_n(trc, n, df, is_big_endian);
+            break;
+        case SEGYNumberFormat::TC4:
+            encodeInteger<int32_t>(trc, n, is_big_endian, df);
+            break;
+        case SEGYNumberFormat::TC2:
+            encodeInteger<int16_t>(trc, n, is_big_endian, df);
+            break;
+        case SEGYNumberFormat::TC1:
+            encodeInteger<int8_t>(trc, n, is_big_endian, df);
+            break;
+        case SEGYNumberFormat::IEEE8:
+            for (size_t i = 0; i < n; i++) {
+                const double d = trc[i];
+                uint64_t bits  = 0;
+                std::memcpy(&bits, &d, sizeof(double));
+
+                const auto bytes =
+                  (is_big_endian ? to_big_endian<uint64_t>(bits) :
+                                   to_little_endian<uint64_t>(bits));
+                std::copy(std::begin(bytes), std::end(bytes), &df[8LU * i]);
+            }
+            break;
+        default:
+            if (is_big_endian) {
+                to_big_endian_n(trc, n, df);
+            }
+            else {
+                to_little_endian_n(trc, n, df);
+            }
+            break;
+    }
+}
+
+/*! Encode the samples of several traces as SEG-Y samples, split over
+ *  threads.
+ *  @param[in]  trc           The trace values.
+ *  @param[in]  ns            The number of samples per trace.
+ *  @param[in]  sz            The number of traces.
+ *  @param[in]  number_format The format of the trace data.
+ *  @param[in]  is_big_endian Whether the samples are big-endian.
+ *  @param[out] buf           Where the samples of the first trace go.
+ *  @param[in]  stride        The distance in bytes between adjacent traces
+ *                            in \c buf.
+ *  @param[in]  threads       The number of threads to use.
+ */
+static void encodeTraces(
+  const exseis::utils::Trace_value* trc,
+  const size_t ns,
+  const size_t sz,
+  const SEGYNumberFormat number_format,
+  const bool is_big_endian,
+  unsigned char* buf,
+  const size_t stride,
+  const size_t threads)
+{
+#pragma omp parallel for num_threads(int(threads)) \
+  if (threads > 1 && sz > 1) schedule(static)
+    for (size_t i = 0; i < sz; i++) {
+        encodeDF(
+          &trc[i * ns], ns, number_format, is_big_endian, &buf[i * stride]);
+    }
+}
+
+/*! Put trace headers in the layout of the file. Without a file header, the
+ *  number of samples and the increment are set in each trace header.
+ *  @param[in]     obj           The object-layer object.
+ *  @param[in]     is_big_endian Whether the file is big-endian.
+ *  @param[in]     ns            The number of samples per trace.
+ *  @param[in]     interval      The increment in the units of the file.
+ *  @param[in]     sz            The number of headers.
+ *  @param[in,out] md            The headers.
+ *  @param[in]     stride        The stride between adjacent headers, after
+ *                               each header.
+ */
+static void finishMD(
+  const ObjectInterface* obj,
+  const bool is_big_endian,
+  const size_t ns,
+  const int16_t interval,
+  const size_t sz,
+  unsigned char* md,
+  const size_t stride)
+{
+    const size_t mdsz = SEGY_utils::getMDSz();
+
+    if (obj->getHOSz() == 0) {
+        const auto ns_bytes =
+          (is_big_endian ? to_big_endian(static_cast<int16_t>(ns)) :
+                           to_little_endian(static_cast<int16_t>(ns)));
+        const auto interval_bytes =
+          (is_big_endian ? to_big_endian(interval) :
+                           to_little_endian(interval));
+
+        for (size_t i = 0; i < sz; i++) {
+            unsigned char* hdr = &md[(mdsz + stride) * i];
+            std::copy(
+              std::begin(ns_bytes), std::end(ns_bytes),
+              &hdr[PIOL_TR_Ns - 1U]);
+            std::copy(
+              std::begin(interval_bytes), std::end(interval_bytes),
+              &hdr[PIOL_TR_Inc - 1U]);
+        }
+    }
+}
+
+/*! Encode traces and parameters into whole data-objects.
+ *  @param[in]  obj           The object-layer object.
+ *  @param[in]  ns            The number of samples per trace
+ *  @param[in]  sz            The number of traces
+ *  @param[in]  number_format The format of the trace data
+ *  @param[in]  is_big_endian Whether the file is big-endian.
+ *  @param[in]  interval      The increment in the units of the file.
+ *  @param[in]  trc           The traces
+ *  @param[in]  prm           The parameters
+ *  @param[in]  skip          Skip the first \c skip entries of \c prm
+ *  @param[out] dobj          The data-objects (size \c sz * the data-object
+ *                            size)
+ *  @param[in]  threads       The number of threads to encode with
+ */
+static void encodeDO(
+  const ObjectInterface* obj,
+  const size_t ns,
+  const size_t sz,
+  const SEGYNumberFormat number_format,
+  const bool is_big_endian,
+  const int16_t interval,
+  const exseis::utils::Trace_value* trc,
+  const Param* prm,
+  const size_t skip,
+  unsigned char* dobj,
+  const size_t threads)
+{
+    const size_t sampleSz = SEGY_utils::getSampleSz(number_format);
+    const size_t dfSz     = SEGY_utils::getDFSz(ns, sampleSz);
+
+    SEGY_utils::insertParam(sz, prm, dobj, dfSz, skip, threads, is_big_endian);
+    finishMD(obj, is_big_endian, ns, interval, sz, dobj, dfSz);
+
+    encodeTraces(
+      trc, ns, sz, number_format, is_big_endian, &dobj[SEGY_utils::getMDSz()],
+      SEGY_utils::getDOSz(ns, sampleSz), threads);
+}
+
 /*! Template function for writing SEG-Y traces and parameters, random and
  *  contiguous.
  *  @tparam T The type of offset (pointer or size_t)
  *  @param[in] obj The object-layer object.
+ *  @param[in] number_format The format of the trace data.
+ *  @param[in] is_big_endian Whether the file is big-endian.
+ *  @param[in] interval The increment in the units of the file.
  *  @param[in] ns The number of samples per trace.
  *  @param[in] offset The offset(s). If T == size_t * this is an array,
  *                    otherwise its a single offset.
@@ -197,91 +460,110 @@ void WriteSEGY::writeInc(const exseis::utils::Floating_point inc_)
  *  @param[in] trc Pointer to trace array.
  *  @param[in] prm Pointer to parameter structure.
  *  @param[in] skip Skip \c skip entries in the parameter structure
+ *  @param[in] threads The number of threads to convert with.
  */
 template<typename T>
 void writeTraceT(
   ObjectInterface* obj,
+  const SEGYNumberFormat number_format,
+  const bool is_big_endian,
+  const int16_t interval,
   const size_t ns,
   T offset,
   const size_t sz,
   exseis::utils::Trace_value* trc,
   const Param* prm,
-  const size_t skip)
+  const size_t skip,
+  const size_t threads)
 {
-    unsigned char* tbuf = reinterpret_cast<unsigned char*>(trc);
-
-
-    // Convert from host-endianness to SEGY endianness for writing
-
-    if (trc != TRACE_NULL && trc != nullptr) {
-        for (size_t i = 0; i < ns * sz; i++) {
-            const auto be_trc_i_bytes =
-              to_big_endian<exseis::utils::Trace_value>(trc[i]);
-
-            unsigned char* trc_i_bytes =
-              reinterpret_cast<unsigned char*>(&trc[i]);
-
-            std::copy(
-              std::begin(be_trc_i_bytes), std::end(be_trc_i_bytes),
-              trc_i_bytes);
-        }
-    }
+    static_assert(
+      std::is_same<exseis::utils::Trace_value, float>::value,
+      "The SEG-Y trace encoding expects float trace values.");
 
+    const size_t dfSz = SEGY_utils::getDFSz(ns, obj->getSampleSz());
 
+    // The samples are converted to SEG-Y endianness straight into the write
+    // buffer, leaving trc untouched.
     if (prm == PIOL_PARAM_NULL) {
+        std::vector<unsigned char> alloc;
+        unsigned char* tbuf = nullptr;
+        if (trc != TRACE_NULL && trc != nullptr) {
+            alloc.resize(dfSz * sz);
+            tbuf = (sz ? alloc.data() : nullptr);
+            encodeTraces(
+              trc, ns, sz, number_format, is_big_endian, tbuf, dfSz, threads);
+        }
         obj->writeDODF(offset, ns, sz, tbuf);
     }
     else {
-        const size_t blockSz =
-          (trc == TRACE_NULL ? SEGY_utils::getMDSz() : SEGY_utils::getDOSz(ns));
-
-        std::vector<unsigned char> alloc(blockSz * sz);
+        std::vector<unsigned char> alloc(SEGY_utils::getMDSz() * sz);
         unsigned char* buf = (sz ? alloc.data() : nullptr);
 
         SEGY_utils::insertParam(
-          sz, prm, buf, blockSz - SEGY_utils::getMDSz(), skip);
+          sz, prm, buf, 0LU, skip, threads, is_big_endian);
+        finishMD(obj, is_big_endian, ns, interval, sz, buf, 0LU);
 
         if (trc == TRACE_NULL) {
             obj->writeDOMD(offset, ns, sz, buf);
         }
         else {
-            for (size_t i = 0; i < sz; i++) {
-                std::copy(
-                  &tbuf[i * SEGY_utils::getDFSz(ns)],
-                  &tbuf[(i + 1) * SEGY_utils::getDFSz(ns)],
-                  &buf[i * SEGY_utils::getDOSz(ns) + SEGY_utils::getMDSz()]);
-            }
+            // The headers and samples are joined in the file, not in memory.
+            std::vector<unsigned char> dalloc(dfSz * sz);
+            unsigned char* tbuf = (sz ? dalloc.data() : nullptr);
+
+            encodeTraces(
+              trc, ns, sz, number_format, is_big_endian, tbuf, dfSz, threads);
 
-            obj->writeDO(offset, ns, sz, buf);
+            obj->writeDO(offset, ns, sz, buf, tbuf);
         }
     }
+}
 
 
-    // Convert back from SEGY endianness to native endianness, as it was
-    // before calling this routine
-
-    if (trc != TRACE_NULL && trc != nullptr) {
-        for (size_t i = 0; i < ns * sz; i++) {
-            const exseis::utils::Trace_value be_trc_i = trc[i];
-
-            const unsigned char* be_trc_i_bytes =
-              reinterpret_cast<const unsigned char*>(&be_trc_i);
+void WriteSEGY::writeTrace(
+  const size_t offset,
+  const size_t sz,
+  exseis::utils::Trace_value* trc,
+  const Param* prm,
+  const size_t skip)
+{
+    if (!nsSet) {
+        piol->log->record(
+          name, Logger::Layer::File, Logger::Status::Error,
+          "The number of samples per trace (ns) has not been set. The output is probably erroneous.",
+          PIOL_VERBOSITY_NONE);
+    }
 
-            trc[i] = from_big_endian<exseis::utils::Trace_value>(
-              be_trc_i_bytes[0], be_trc_i_bytes[1], be_trc_i_bytes[2],
-              be_trc_i_bytes[3]);
-        }
+    if (isBuffered(trc, prm)) {
+        std::vector<size_t> list(sz);
+        std::iota(list.begin(), list.end(), offset);
+        bufferTrace(sz, list.data(), trc, prm, skip);
     }
+    else {
+        // Part writes are not buffered and must land after what is.
+        flush();
+        writeTraceT(
+          obj.get(), number_format, is_big_endian, getInterval(), ns, offset,
+          sz, trc, prm, skip, piol->numThreads);
+    }
+    state.stalent = true;
+    nt            = std::max(offset + sz, nt);
 }
 
-
-void WriteSEGY::writeTrace(
+std::shared_ptr<Request> WriteSEGY::iwriteTrace(
   const size_t offset,
   const size_t sz,
   exseis::utils::Trace_value* trc,
   const Param* prm,
   const size_t skip)
 {
+    if (
+      prm == PIOL_PARAM_NULL || trc == TRACE_NULL || trc == nullptr
+      || isBuffered(trc, prm)) {
+        writeTrace(offset, sz, trc, prm, skip);
+        return std::make_shared<CompletedRequest>();
+    }
+
     if (!nsSet) {
         piol->log->record(
           name, Logger::Layer::File, Logger::Status::Error,
@@ -289,9 +571,22 @@ void WriteSEGY::writeTrace(
           PIOL_VERBOSITY_NONE);
     }
 
-    writeTraceT(obj.get(), ns, offset, sz, trc, prm, skip);
+    // Encode into a buffer owned by the request, leaving trc untouched.
+    const size_t doSz = SEGY_utils::getDOSz(ns, obj->getSampleSz());
+    auto buf = std::make_shared<std::vector<unsigned char>>(sz * doSz);
+
+    unsigned char* dobj = (sz ? buf->data() : nullptr);
+
+    encodeDO(
+      obj.get(), ns, sz, number_format, is_big_endian, getInterval(), trc, prm,
+      skip, dobj, piol->numThreads);
+
+    auto req = obj->iwriteDO(offset, ns, sz, dobj);
+
     state.stalent = true;
     nt            = std::max(offset + sz, nt);
+
+    return std::make_shared<ChainedRequest>(std::move(req), [buf]() {});
 }
 
 void WriteSEGY::writeTraceNonContiguous(
@@ -308,12 +603,275 @@ void WriteSEGY::writeTraceNonContiguous(
           PIOL_VERBOSITY_NONE);
     }
 
-    writeTraceT(obj.get(), ns, offset, sz, trc, prm, skip);
+    if (isBuffered(trc, prm)) {
+        bufferTrace(sz, offset, trc, prm, skip);
+    }
+    else {
+        flush();
+        writeTraceT(
+          obj.get(), number_format, is_big_endian, getInterval(), ns, offset,
+          sz, trc, prm, skip, piol->numThreads);
+    }
     state.stalent = true;
     if (sz != 0) {
         nt = std::max(offset[sz - 1LU] + 1LU, nt);
     }
 }
 
+/*! Template function for writing a window of samples of SEG-Y traces,
+ *  random and contiguous.
+ *  @tparam T The type of offset (pointer or size_t)
+ *  @param[in] obj The object-layer object.
+ *  @param[in] number_format The format of the trace data.
+ *  @param[in] is_big_endian Whether the file is big-endian.
+ *  @param[in] ns The number of samples per trace.
+ *  @param[in] offset The offset(s). If T == size_t * this is an array,
+ *                    otherwise its a single offset.
+ *  @param[in] sz The number of traces to write
+ *  @param[in] s0 The first sample of the window.
+ *  @param[in] n The number of samples in the window.
+ *  @param[in] trc The windows of the traces.
+ *  @param[in] threads The number of threads to convert with.
+ */
+template<typename T>
+void writeWindowT(
+  ObjectInterface* obj,
+  const SEGYNumberFormat number_format,
+  const bool is_big_endian,
+  const size_t ns,
+  T offset,
+  const size_t sz,
+  const size_t s0,
+  const size_t n,
+  const exseis::utils::Trace_value* trc,
+  const size_t threads)
+{
+    const size_t sampleSz = obj->getSampleSz();
+
+    std::vector<unsigned char> alloc(n * sampleSz * sz);
+    unsigned char* tbuf = (sz ? alloc.data() : nullptr);
+    encodeTraces(
+      trc, n, sz, number_format, is_big_endian, tbuf, n * sampleSz, threads);
+
+    obj->writeDODF(offset, ns, sz, s0 * sampleSz, n * sampleSz, tbuf);
+}
+
+/*! Check a window of samples lies within the traces, logging an error if it
+ *  does not.
+ *  @param[in] piol The PIOL object.
+ *  @param[in] name The name of the file.
+ *  @param[in] ns   The number of samples per trace.
+ *  @param[in] s0   The first sample of the window.
+ *  @param[in] n    The number of samples in the window.
+ *  @return Return true if samples s0 to s0+n exist in each trace.
+ */
+static bool checkWindow(
+  ExSeisPIOL* piol,
+  const std::string& name,
+  const size_t ns,
+  const size_t s0,
+  const size_t n)
+{
+    if (s0 + n > ns) {
+        piol->log->record(
+          name, Logger::Layer::File, Logger::Status::Error,
+          "The sample window " + std::to_string(s0) + " to "
+            + std::to_string(s0 + n) + " is not within traces of "
+            + std::to_string(ns) + " samples.",
+          PIOL_VERBOSITY_NONE);
+        return false;
+    }
+    return true;
+}
+
+void WriteSEGY::writeTraceWindow(
+  const size_t offset,
+  const size_t sz,
+  const size_t s0,
+  const size_t n,
+  const exseis::utils::Trace_value* trc)
+{
+    if (!nsSet) {
+        piol->log->record(
+          name, Logger::Layer::File, Logger::Status::Error,
+          "The number of samples per trace (ns) has not been set. The output is probably erroneous.",
+          PIOL_VERBOSITY_NONE);
+    }
+    const size_t wsz = (checkWindow(piol.get(), name, ns, s0, n) ? sz : 0LU);
+
+    // The window must land after any whole traces held back.
+    flush();
+    writeWindowT(
+      obj.get(), number_format, is_big_endian, ns, offset, wsz, s0, n, trc,
+      piol->numThreads);
+
+    state.stalent = true;
+    if (wsz != 0) {
+        nt = std::max(offset + wsz, nt);
+    }
+}
+
+void WriteSEGY::writeTraceWindowNonContiguous(
+  const size_t sz,
+  const size_t* offset,
+  const size_t s0,
+  const size_t n,
+  const exseis::utils::Trace_value* trc)
+{
+    if (!nsSet) {
+        piol->log->record(
+          name, Logger::Layer::File, Logger::Status::Error,
+          "The number of samples per trace (ns) has not been set. The output is probably erroneous.",
+          PIOL_VERBOSITY_NONE);
+    }
+    const size_t wsz = (checkWindow(piol.get(), name, ns, s0, n) ? sz : 0LU);
+
+    flush();
+    writeWindowT(
+      obj.get(), number_format, is_big_endian, ns, offset, wsz, s0, n, trc,
+      piol->numThreads);
+
+    state.stalent = true;
+    if (wsz != 0) {
+        nt = std::max(offset[wsz - 1LU] + 1LU, nt);
+    }
+}
+
+bool WriteSEGY::isBuffered(
+  const exseis::utils::Trace_value* trc, const Param* prm) const
+{
+    return writeBehindSz != 0 && trc != TRACE_NULL && prm != PIOL_PARAM_NULL;
+}
+
+void WriteSEGY::bufferDO(
+  const size_t offset, const size_t sz, const unsigned char* dobj)
+{
+    if (sz == 0) {
+        return;
+    }
+
+    const size_t doSz = SEGY_utils::getDOSz(ns, obj->getSampleSz());
+    const size_t end  = offset + sz;
+
+    // Grow the run starting at or before offset if it reaches offset,
+    // otherwise start a new run.
+    auto run = pending.upper_bound(offset);
+    if (run != pending.begin()) {
+        auto prev = std::prev(run);
+        if (prev->first + prev->second.size() / doSz >= offset) {
+            run = prev;
+        }
+    }
+    if (run == pending.end() || run->first > offset) {
+        run = pending.emplace_hint(run, offset, std::vector<unsigned char>());
+    }
+
+    auto& buf        = run->second;
+    const size_t old = buf.size();
+    size_t runEnd    = run->first + old / doSz;
+
+    // Absorb the later runs which start inside or right after the new range.
+    auto next = std::next(run);
+    while (next != pending.end() && next->first <= std::max(end, runEnd)) {
+        const size_t nextEnd = next->first + next->second.size() / doSz;
+        if (nextEnd > runEnd) {
+            buf.resize((nextEnd - run->first) * doSz);
+            runEnd = nextEnd;
+        }
+        std::copy(
+          next->second.begin(), next->second.end(),
+          &buf[(next->first - run->first) * doSz]);
+        pendingSz -= next->second.size();
+        next = pending.erase(next);
+    }
+
+    if (end > runEnd) {
+        buf.resize((end - run->first) * doSz);
+    }
+    std::copy_n(dobj, sz * doSz, &buf[(offset - run->first) * doSz]);
+    pendingSz += buf.size() - old;
+}
+
+void WriteSEGY::bufferTrace(
+  const size_t sz,
+  const size_t* offset,
+  const exseis::utils::Trace_value* trc,
+  const Param* prm,
+  const size_t skip)
+{
+    const size_t doSz = SEGY_utils::getDOSz(ns, obj->getSampleSz());
+
+    std::vector<unsigned char> dobj(sz * doSz);
+    if (sz != 0) {
+        encodeDO(
+          obj.get(), ns, sz, number_format, is_big_endian, getInterval(), trc,
+          prm, skip, dobj.data(), piol->numThreads);
+    }
+
+    // Each run of consecutive trace numbers is held back in one piece.
+    for (size_t i = 0; i < sz;) {
+        size_t j = i + 1LU;
+        while (j < sz && offset[j] == offset[j - 1LU] + 1LU) {
+            j++;
+        }
+        bufferDO(offset[i], j - i, &dobj[i * doSz]);
+        i = j;
+    }
+
+    if (pendingSz >= writeBehindSz) {
+        writePending();
+    }
+}
+
+void WriteSEGY::writePending(void)
+{
+    const size_t doSz = SEGY_utils::getDOSz(ns, obj->getSampleSz());
+
+    auto run = pending.begin();
+    while (run != pending.end()
+           && obj->writeDOIndependent(
+                run->first, ns, run->second.size() / doSz,
+                run->second.data())) {
+        pendingSz -= run->second.size();
+        run = pending.erase(run);
+    }
+}
+
+void WriteSEGY::flush(void)
+{
+    if (writeBehindSz == 0) {
+        return;
+    }
+
+    writePending();
+
+    // Only the traces which could not be written independently are left.
+    if (piol->comm->max(pendingSz) == 0) {
+        return;
+    }
+
+    const size_t doSz = SEGY_utils::getDOSz(ns, obj->getSampleSz());
+
+    std::vector<size_t> offset;
+    offset.reserve(pendingSz / doSz);
+    std::vector<unsigned char> buf;
+    buf.reserve(pendingSz);
+
+    for (auto& run : pending) {
+        const size_t sz = run.second.size() / doSz;
+        for (size_t i = 0; i < sz; i++) {
+            offset.push_back(run.first + i);
+        }
+        buf.insert(buf.end(), run.second.begin(), run.second.end());
+        std::vector<unsigned char>().swap(run.second);
+    }
+    pending.clear();
+    pendingSz = 0;
+
+    // Every process makes the write, with or without traces of its own.
+    obj->writeDO(
+      offset.data(), ns, offset.size(), (buf.empty() ? nullptr : buf.data()));
+}
+
 }  // namespace PIOL
 }  // namespace exseis
@@ -31,17 +31,18 @@ static utils::Distributed_vector<Gather_info> getGathers(
     size_t numRank = piol->comm->getNumRank();
     std::vector<Gather_info> lline;
 
-    exseis::utils::Integer ill =
-      param_utils::getPrm<exseis::utils::Integer>(0LU, PIOL_META_il, prm);
-    exseis::utils::Integer xll =
-      param_utils::getPrm<exseis::utils::Integer>(0LU, PIOL_META_xl, prm);
+    const param_utils::ParamColumn<exseis::utils::Integer> ilc(
+      PIOL_META_il, prm);
+    const param_utils::ParamColumn<exseis::utils::Integer> xlc(
+      PIOL_META_xl, prm);
+
+    exseis::utils::Integer ill = ilc[0LU];
+    exseis::utils::Integer xll = xlc[0LU];
     lline.push_back({1LU, ill, xll});
 
     for (size_t i = 1; i < prm->size(); i++) {
-        exseis::utils::Integer il =
-          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_il, prm);
-        exseis::utils::Integer xl =
-          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_xl, prm);
+        exseis::utils::Integer il = ilc[i];
+        exseis::utils::Integer xl = xlc[i];
 
         if (il != ill || xl != xll) {
             lline.push_back({0LU, il, xl});
@@ -9,6 +9,8 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <numeric>
+#include <vector>
 
 namespace exseis {
 namespace PIOL {
@@ -22,22 +24,22 @@ void getMinMax(
   const Param* prm,
   CoordElem* minmax)
 {
-    std::vector<Param> vprm;
-    // TODO: Just add the two meta options to the rules with defaults?
-    for (size_t i = 0; i < lnt; i++) {
-        vprm.emplace_back(prm->r, 1LU);
-        param_utils::cpyPrm(i, prm, 0, &vprm.back());
-    }
+    // Binding the columns decodes them before any value is read.
+    const param_utils::ParamColumn<exseis::utils::Floating_point> c1(m1, prm);
+    const param_utils::ParamColumn<exseis::utils::Floating_point> c2(m2, prm);
 
-    getMinMax<Param>(
-      piol, offset, lnt, vprm.data(),
-      [m1](const Param& a) -> exseis::utils::Floating_point {
-          return param_utils::getPrm<exseis::utils::Floating_point>(
-            0LU, m1, &a);
+    // Search the trace numbers rather than copies of each set of parameters.
+    // A rank without traces is still asked for the value of one.
+    std::vector<size_t> idx(lnt);
+    std::iota(idx.begin(), idx.end(), 0LU);
+
+    getMinMax<size_t>(
+      piol, offset, lnt, idx.data(),
+      [&c1, lnt](const size_t& i) -> exseis::utils::Floating_point {
+          return (i < lnt ? c1[i] : 0);
       },
-      [m2](const Param& a) -> exseis::utils::Floating_point {
-          return param_utils::getPrm<exseis::utils::Floating_point>(
-            0LU, m2, &a);
+      [&c2, lnt](const size_t& i) -> exseis::utils::Floating_point {
+          return (i < lnt ? c2[i] : 0);
       },
       minmax);
 }
@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief
+/// @details MPI datatypes over the arrays of a parameter structure, for the
+///          library's own transfers of Param ranges.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef EXSEISDAT_SRC_PARAM_MPI_HH
+#define EXSEISDAT_SRC_PARAM_MPI_HH
+
+#include "ExSeisDat/PIOL/Param.h"
+
+#include <mpi.h>
+
+namespace exseis {
+namespace PIOL {
+namespace param_utils {
+
+/*! Create an MPI datatype describing a range of sets of a parameter
+ *  structure, covering every array it holds, including the SEG-Y copy
+ *  buffer. The datatype uses absolute addresses, so a single element of it
+ *  is sent or received with MPI_BOTTOM as the buffer, without staging the
+ *  sets in a separate structure.
+ *  @param[in] prm The parameter structure.
+ *  @param[in] j The first set of the range.
+ *  @param[in] sz The number of sets in the range.
+ *  @param[out] type The committed datatype. It must be freed with
+ *                   MPI_Type_free once the transfers using it finish.
+ *  @return Return MPI_SUCCESS, or the error code of the MPI call which
+ *          failed.
+ *
+ *  @details Structures with the same rule, layout and storage give matching
+ *           datatypes for ranges of the same size, whatever their number of
+ *           sets. The datatype holds the addresses of the arrays, so the
+ *           structure must not be resized while it is in use. Each array is
+ *           described by its element type, with blocks of at most INT_MAX
+ *           elements, so ranges of any size can be described.
+ */
+int createMPIType(Param* prm, size_t j, size_t sz, MPI_Datatype* type);
+
+}  // namespace param_utils
+}  // namespace PIOL
+}  // namespace exseis
+
+#endif  // EXSEISDAT_SRC_PARAM_MPI_HH
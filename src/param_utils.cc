@@ -5,44 +5,243 @@
 
 #include "ExSeisDat/PIOL/param_utils.hh"
 #include "ExSeisDat/PIOL/segy_utils.hh"
+#include "ExSeisDat/utils/mpi/MPI_type.hh"
+
+#include "param_mpi.hh"
+
+#include <algorithm>
+#include <climits>
+#include <type_traits>
 
 namespace exseis {
 namespace PIOL {
 namespace param_utils {
 
-void cpyPrm(const size_t j, const Param* src, const size_t k, Param* dst)
+namespace {
+
+/*! Check whether the arrays of two parameter structures line up, so sets can
+ *  be moved between them as raw array ranges.
+ *  @param[in] src The source parameter structure.
+ *  @param[in] dst The destination parameter structure.
+ *  @return Return true if the structures share rule, layout and storage.
+ */
+bool sameLayout(const Param* src, const Param* dst)
 {
-    if (
-      src == PIOL_PARAM_NULL || src == nullptr || dst == PIOL_PARAM_NULL
-      || dst == nullptr) {
+    return src->r == dst->r && src->columnar == dst->columnar
+           && src->compact == dst->compact;
+}
+
+/*! Copy a range of sets of one array of a parameter structure to another
+ *  with the same layout.
+ *  @tparam T The type of the array.
+ *  @param[in] j The first set of the source.
+ *  @param[in] src The source parameter structure.
+ *  @param[in] sv The source array.
+ *  @param[in] k The first set of the destination.
+ *  @param[in] dst The destination parameter structure.
+ *  @param[out] dv The destination array.
+ *  @param[in] ncol The number of columns of the array.
+ *  @param[in] sz The number of sets to copy.
+ *  @param[in] columnar Whether the array is column-major.
+ */
+template<typename T>
+void copyRange(
+  size_t j,
+  const Param* src,
+  const std::vector<T>& sv,
+  size_t k,
+  const Param* dst,
+  std::vector<T>& dv,
+  size_t ncol,
+  size_t sz,
+  bool columnar)
+{
+    if (ncol == 0 || sz == 0) {
         return;
     }
 
-    Rule* srule = src->r.get();
-    Rule* drule = dst->r.get();
+    if (!columnar) {
+        std::copy_n(&sv[j * ncol], sz * ncol, &dv[k * ncol]);
+        return;
+    }
 
-    if (srule->numCopy != 0) {
-        SEGY_utils::extractParam(
-          1LU, &src->c[j * SEGY_utils::getMDSz()], dst, 0LU, k);
+    for (size_t c = 0; c < ncol; c++) {
+        std::copy_n(&sv[src->sz * c + j], sz, &dv[dst->sz * c + k]);
+    }
+}
+
+/*! Gather sets of one array of a parameter structure into another with the
+ *  same layout.
+ *  @tparam T The type of the array.
+ *  @param[in] sz The number of sets to gather.
+ *  @param[in] idx The source set of each destination set.
+ *  @param[in] src The source parameter structure.
+ *  @param[in] sv The source array.
+ *  @param[in] k The first set of the destination.
+ *  @param[in] dst The destination parameter structure.
+ *  @param[out] dv The destination array.
+ *  @param[in] ncol The number of columns of the array.
+ *  @param[in] columnar Whether the array is column-major.
+ */
+template<typename T>
+void gatherRange(
+  size_t sz,
+  const size_t* idx,
+  const Param* src,
+  const std::vector<T>& sv,
+  size_t k,
+  const Param* dst,
+  std::vector<T>& dv,
+  size_t ncol,
+  bool columnar)
+{
+    if (ncol == 0) {
+        return;
     }
 
+    if (!columnar) {
+        for (size_t n = 0; n < sz; n++) {
+            std::copy_n(&sv[idx[n] * ncol], ncol, &dv[(k + n) * ncol]);
+        }
+        return;
+    }
+
+    for (size_t c = 0; c < ncol; c++) {
+        const T* scol = &sv[src->sz * c];
+        T* dcol       = &dv[dst->sz * c + k];
+        for (size_t n = 0; n < sz; n++) {
+            dcol[n] = scol[idx[n]];
+        }
+    }
+}
+
+/*! Permute fixed-width rows in place by following the cycles of the
+ *  permutation, so each row is moved once and only one row is buffered.
+ *  @tparam T The type of the rows.
+ *  @param[in] sz The number of rows.
+ *  @param[in] idx The old position of the row which ends up at each position.
+ *  @param[in] width The number of values in a row.
+ *  @param[in,out] v The rows.
+ */
+template<typename T>
+void permuteRows(size_t sz, const size_t* idx, size_t width, T* v)
+{
+    if (width == 0) {
+        return;
+    }
+
+    std::vector<unsigned char> done(sz, 0);
+    std::vector<T> tmp(width);
+
+    for (size_t n = 0; n < sz; n++) {
+        if (done[n] != 0 || idx[n] == n) {
+            continue;
+        }
+
+        std::copy_n(&v[n * width], width, tmp.data());
+        size_t cur = n;
+        while (idx[cur] != n) {
+            std::copy_n(&v[idx[cur] * width], width, &v[cur * width]);
+            done[cur] = 1;
+            cur       = idx[cur];
+        }
+        std::copy_n(tmp.data(), width, &v[cur * width]);
+        done[cur] = 1;
+    }
+}
+
+/*! Permute the sets of one array of a parameter structure in place.
+ *  @tparam T The type of the array.
+ *  @param[in] sz The number of sets.
+ *  @param[in] idx The old set which ends up at each set.
+ *  @param[in] prm The parameter structure.
+ *  @param[in,out] v The array.
+ *  @param[in] ncol The number of columns of the array.
+ *  @param[in] columnar Whether the array is column-major.
+ */
+template<typename T>
+void permuteArray(
+  size_t sz,
+  const size_t* idx,
+  const Param* prm,
+  std::vector<T>& v,
+  size_t ncol,
+  bool columnar)
+{
+    if (ncol == 0) {
+        return;
+    }
+
+    if (!columnar) {
+        permuteRows(sz, idx, ncol, v.data());
+        return;
+    }
+
+    for (size_t c = 0; c < ncol; c++) {
+        permuteRows(sz, idx, 1LU, &v[prm->sz * c]);
+    }
+}
+
+/*! Copy the fields of one set between parameter structures which do not
+ *  share a layout. The structures must already be decoded.
+ *  @param[in] j The set of the source.
+ *  @param[in] src The source parameter structure.
+ *  @param[in] k The set of the destination.
+ *  @param[out] dst The destination parameter structure.
+ */
+void copySet(const size_t j, const Param* src, const size_t k, Param* dst)
+{
+    Rule* srule = src->r.get();
+    Rule* drule = dst->r.get();
+
     if (srule == drule) {
         Rule* r = srule;
 
-        for (size_t i = 0; i < r->numFloat; i++) {
-            dst->f[k * r->numFloat + i] = src->f[j * r->numFloat + i];
+        if (src->compact != dst->compact) {
+            for (size_t i = 0; i < r->numFloat; i++) {
+                dst->setFloat(k, i, src->getFloat(j, i));
+            }
+
+            for (size_t i = 0; i < r->numLong; i++) {
+                dst->setLong(k, i, src->getLong(j, i));
+            }
+        }
+        else if (src->compact) {
+            for (size_t i = 0; i < r->numFloat; i++) {
+                dst->fc[dst->getPos(k, i, r->numFloat)] =
+                  src->fc[src->getPos(j, i, r->numFloat)];
+            }
+
+            for (size_t i = 0; i < src->nscal; i++) {
+                dst->fscal[dst->getPos(k, i, dst->nscal)] =
+                  src->fscal[src->getPos(j, i, src->nscal)];
+            }
+
+            for (size_t i = 0; i < r->numLong; i++) {
+                dst->ic[dst->getPos(k, i, r->numLong)] =
+                  src->ic[src->getPos(j, i, r->numLong)];
+            }
         }
+        else {
+            for (size_t i = 0; i < r->numFloat; i++) {
+                dst->f[dst->getPos(k, i, r->numFloat)] =
+                  src->f[src->getPos(j, i, r->numFloat)];
+            }
 
-        for (size_t i = 0; i < r->numLong; i++) {
-            dst->i[k * r->numLong + i] = src->i[j * r->numLong + i];
+            for (size_t i = 0; i < r->numLong; i++) {
+                dst->i[dst->getPos(k, i, r->numLong)] =
+                  src->i[src->getPos(j, i, r->numLong)];
+            }
         }
 
         for (size_t i = 0; i < r->numShort; i++) {
-            dst->s[k * r->numShort + i] = src->s[j * r->numShort + i];
+            dst->s[dst->getPos(k, i, r->numShort)] =
+              src->s[src->getPos(j, i, r->numShort)];
         }
 
         for (size_t i = 0; i < r->numIndex; i++) {
-            dst->t[k * r->numIndex + i] = src->t[j * r->numIndex + i];
+            dst->t[dst->getPos(k, i, r->numIndex)] =
+              src->t[src->getPos(j, i, r->numIndex)];
         }
     }
     else {
@@ -61,23 +260,25 @@ void cpyPrm(const size_t j, const Param* src, const size_t k, Param* dst)
                 if (dent->type() == sent->type()) {
                     switch (m.second->type()) {
                         case RuleEntry::MdType::Float:
-                            dst->f[drule->numFloat * k + dent->num] =
-                              src->f[srule->numFloat * j + sent->num];
+                            dst->setFloat(
+                              k, dent->num, src->getFloat(j, sent->num));
                             break;
 
                         case RuleEntry::MdType::Long:
-                            dst->i[drule->numLong * k + dent->num] =
-                              src->i[srule->numLong * j + sent->num];
+                            dst->setLong(
+                              k, dent->num, src->getLong(j, sent->num));
                             break;
 
                         case RuleEntry::MdType::Short:
-                            dst->s[drule->numShort * k + dent->num] =
-                              src->s[srule->numShort * j + sent->num];
+                            dst->s[dst->getPos(k, dent->num, drule->numShort)] =
+                              src->s[src->getPos(
+                                j, sent->num, srule->numShort)];
                             break;
 
                         case RuleEntry::MdType::Index:
-                            dst->t[drule->numIndex * k + dent->num] =
-                              src->t[srule->numIndex * j + sent->num];
+                            dst->t[dst->getPos(k, dent->num, drule->numIndex)] =
+                              src->t[src->getPos(
+                                j, sent->num, srule->numIndex)];
 
                         default:
                             break;
@@ -88,6 +289,255 @@ void cpyPrm(const size_t j, const Param* src, const size_t k, Param* dst)
     }
 }
 
+/*! Copy whole array ranges between parameter structures with the same
+ *  layout.
+ *  @param[in] j The first set of the source.
+ *  @param[in] src The source parameter structure.
+ *  @param[in] k The first set of the destination.
+ *  @param[out] dst The destination parameter structure.
+ *  @param[in] sz The number of sets to copy.
+ */
+void copySets(
+  const size_t j, const Param* src, const size_t k, Param* dst, const size_t sz)
+{
+    const Rule* r       = src->r.get();
+    const bool columnar = src->columnar;
+
+    if (src->compact) {
+        copyRange(j, src, src->fc, k, dst, dst->fc, r->numFloat, sz, columnar);
+        copyRange(
+          j, src, src->fscal, k, dst, dst->fscal, src->nscal, sz, columnar);
+        copyRange(j, src, src->ic, k, dst, dst->ic, r->numLong, sz, columnar);
+    }
+    else {
+        copyRange(j, src, src->f, k, dst, dst->f, r->numFloat, sz, columnar);
+        copyRange(j, src, src->i, k, dst, dst->i, r->numLong, sz, columnar);
+    }
+    copyRange(j, src, src->s, k, dst, dst->s, r->numShort, sz, columnar);
+    copyRange(j, src, src->t, k, dst, dst->t, r->numIndex, sz, columnar);
+    copyRange(
+      j, src, src->c, k, dst, dst->c,
+      (r->numCopy != 0 ? SEGY_utils::getMDSz() : 0LU), sz, false);
+
+    // Copied headers keep the byte order they were read in.
+    if (r->numCopy != 0) {
+        dst->is_big_endian = src->is_big_endian;
+    }
+}
+
+}  // namespace
+
+void cpyPrm(const size_t j, const Param* src, const size_t k, Param* dst)
+{
+    cpyPrm(j, src, k, dst, 1LU);
+}
+
+void cpyPrm(
+  const size_t j, const Param* src, const size_t k, Param* dst, const size_t sz)
+{
+    if (
+      src == PIOL_PARAM_NULL || src == nullptr || dst == PIOL_PARAM_NULL
+      || dst == nullptr || sz == 0) {
+        return;
+    }
+
+    src->decode();
+    dst->decode();
+
+    if (sameLayout(src, dst)) {
+        copySets(j, src, k, dst, sz);
+        return;
+    }
+
+    if (src->r->numCopy != 0) {
+        SEGY_utils::extractParam(
+          sz, &src->c[j * SEGY_utils::getMDSz()], dst, 0LU, k, 1LU,
+          src->is_big_endian);
+
+        if (dst->r->numCopy != 0) {
+            copyRange(
+              j, src, src->c, k, dst, dst->c, SEGY_utils::getMDSz(), sz, false);
+        }
+    }
+
+    for (size_t n = 0; n < sz; n++) {
+        copySet(j + n, src, k + n, dst);
+    }
+}
+
+void permutePrm(
+  const size_t sz,
+  const size_t* idx,
+  const Param* src,
+  const size_t k,
+  Param* dst)
+{
+    if (
+      src == PIOL_PARAM_NULL || src == nullptr || dst == PIOL_PARAM_NULL
+      || dst == nullptr || sz == 0) {
+        return;
+    }
+
+    src->decode();
+    dst->decode();
+
+    if (!sameLayout(src, dst)) {
+        for (size_t n = 0; n < sz; n++) {
+            if (src->r->numCopy != 0) {
+                SEGY_utils::extractParam(
+                  1LU, &src->c[idx[n] * SEGY_utils::getMDSz()], dst, 0LU,
+                  k + n, 1LU, src->is_big_endian);
+            }
+            copySet(idx[n], src, k + n, dst);
+        }
+
+        if (src->r->numCopy != 0 && dst->r->numCopy != 0) {
+            gatherRange(
+              sz, idx, src, src->c, k, dst, dst->c, SEGY_utils::getMDSz(),
+              false);
+        }
+        return;
+    }
+
+    const Rule* r       = src->r.get();
+    const bool columnar = src->columnar;
+
+    if (src->compact) {
+        gatherRange(
+          sz, idx, src, src->fc, k, dst, dst->fc, r->numFloat, columnar);
+        gatherRange(
+          sz, idx, src, src->fscal, k, dst, dst->fscal, src->nscal, columnar);
+        gatherRange(
+          sz, idx, src, src->ic, k, dst, dst->ic, r->numLong, columnar);
+    }
+    else {
+        gatherRange(
+          sz, idx, src, src->f, k, dst, dst->f, r->numFloat, columnar);
+        gatherRange(
+          sz, idx, src, src->i, k, dst, dst->i, r->numLong, columnar);
+    }
+    gatherRange(sz, idx, src, src->s, k, dst, dst->s, r->numShort, columnar);
+    gatherRange(sz, idx, src, src->t, k, dst, dst->t, r->numIndex, columnar);
+    gatherRange(
+      sz, idx, src, src->c, k, dst, dst->c,
+      (r->numCopy != 0 ? SEGY_utils::getMDSz() : 0LU), false);
+
+    if (r->numCopy != 0) {
+        dst->is_big_endian = src->is_big_endian;
+    }
+}
+
+void permutePrm(const size_t sz, const size_t* idx, Param* prm)
+{
+    if (prm == PIOL_PARAM_NULL || prm == nullptr || sz == 0) {
+        return;
+    }
+
+    prm->decode();
+
+    const Rule* r       = prm->r.get();
+    const bool columnar = prm->columnar;
+
+    if (prm->compact) {
+        permuteArray(sz, idx, prm, prm->fc, r->numFloat, columnar);
+        permuteArray(sz, idx, prm, prm->fscal, prm->nscal, columnar);
+        permuteArray(sz, idx, prm, prm->ic, r->numLong, columnar);
+    }
+    else {
+        permuteArray(sz, idx, prm, prm->f, r->numFloat, columnar);
+        permuteArray(sz, idx, prm, prm->i, r->numLong, columnar);
+    }
+    permuteArray(sz, idx, prm, prm->s, r->numShort, columnar);
+    permuteArray(sz, idx, prm, prm->t, r->numIndex, columnar);
+    permuteArray(
+      sz, idx, prm, prm->c, (r->numCopy != 0 ? SEGY_utils::getMDSz() : 0LU),
+      false);
+}
+
+void permuteTrc(
+  const size_t sz,
+  const size_t* idx,
+  const size_t ns,
+  const exseis::utils::Trace_value* src,
+  exseis::utils::Trace_value* dst)
+{
+    for (size_t n = 0; n < sz; n++) {
+        std::copy_n(&src[idx[n] * ns], ns, &dst[n * ns]);
+    }
+}
+
+void permuteTrc(
+  const size_t sz,
+  const size_t* idx,
+  const size_t ns,
+  exseis::utils::Trace_value* trc)
+{
+    permuteRows(sz, idx, ns, trc);
+}
+
+int createMPIType(
+  Param* prm, const size_t j, const size_t sz, MPI_Datatype* type)
+{
+    prm->decode();
+
+    std::vector<MPI_Aint> disp;
+    std::vector<int> len;
+    std::vector<MPI_Datatype> types;
+    int err = MPI_SUCCESS;
+
+    // Add the blocks holding a range of sets of one array, counted in
+    // elements of the array. A block too long for an int count is split.
+    auto add = [&](auto& v, size_t ncol, bool columnar) {
+        using T              = typename std::decay<decltype(v[0])>::type;
+        const MPI_Datatype t = exseis::utils::MPI_type<T>();
+        if (ncol == 0 || sz == 0) {
+            return;
+        }
+
+        const size_t nblock  = (columnar ? ncol : 1LU);
+        const size_t blocksz = (columnar ? sz : sz * ncol);
+        for (size_t c = 0; c < nblock && err == MPI_SUCCESS; c++) {
+            const T* first = &v[columnar ? prm->sz * c + j : j * ncol];
+            for (size_t k = 0; k < blocksz && err == MPI_SUCCESS;
+                 k += INT_MAX) {
+                MPI_Aint addr;
+                err = MPI_Get_address(first + k, &addr);
+                disp.push_back(addr);
+                len.push_back(
+                  static_cast<int>(std::min<size_t>(blocksz - k, INT_MAX)));
+                types.push_back(t);
+            }
+        }
+    };
+
+    const Rule* r = prm->r.get();
+    if (prm->compact) {
+        add(prm->fc, r->numFloat, prm->columnar);
+        add(prm->fscal, prm->nscal, prm->columnar);
+        add(prm->ic, r->numLong, prm->columnar);
+    }
+    else {
+        add(prm->f, r->numFloat, prm->columnar);
+        add(prm->i, r->numLong, prm->columnar);
+    }
+    add(prm->s, r->numShort, prm->columnar);
+    add(prm->t, r->numIndex, prm->columnar);
+    add(prm->c, (r->numCopy != 0 ? SEGY_utils::getMDSz() : 0LU), false);
+
+    if (err != MPI_SUCCESS) {
+        return err;
+    }
+
+    err = MPI_Type_create_struct(
+      static_cast<int>(len.size()), len.data(), disp.data(), types.data(),
+      type);
+    if (err != MPI_SUCCESS) {
+        return err;
+    }
+
+    return MPI_Type_commit(type);
+}
+
 }  // namespace param_utils
 }  // namespace PIOL
 }  // namespace exseis
@@ -7,21 +7,180 @@
 #include "ExSeisDat/PIOL/segy_utils.hh"
 #include "ExSeisDat/utils/encoding/number_encoding.hh"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 using namespace exseis::utils;
 
 namespace exseis {
 namespace PIOL {
 namespace SEGY_utils {
 
+/*! Decode a trace header field held in the byte order of the file. A field
+ *  in the byte order of the host is copied.
+ *  @tparam T The integer type of the field
+ *  @param[in] src           The bytes of the field
+ *  @param[in] is_big_endian Whether the field is big-endian
+ *  @return Return the value of the field.
+ */
+template<typename T>
+static T getField(const unsigned char* src, const bool is_big_endian)
+{
+    if (is_big_endian != is_little_endian_host()) {
+        T dst;
+        std::memcpy(&dst, src, sizeof(T));
+        return dst;
+    }
+
+    std::array<unsigned char, sizeof(T)> bytes;
+    std::copy_n(src, sizeof(T), bytes.begin());
+    return (
+      is_big_endian ? from_big_endian<T>(bytes) : from_little_endian<T>(bytes));
+}
+
+/*! Encode a trace header field in the byte order of the file. A field in the
+ *  byte order of the host is copied.
+ *  @tparam T The integer type of the field
+ *  @param[in]  src           The value of the field
+ *  @param[in]  is_big_endian Whether the field is big-endian
+ *  @param[out] dst           The bytes of the field
+ */
+template<typename T>
+static void setField(const T src, const bool is_big_endian, unsigned char* dst)
+{
+    if (is_big_endian != is_little_endian_host()) {
+        std::memcpy(dst, &src, sizeof(T));
+        return;
+    }
+
+    const auto bytes =
+      (is_big_endian ? to_big_endian(src) : to_little_endian(src));
+    std::copy(std::begin(bytes), std::end(bytes), dst);
+}
+
+/*! Insert the parameters of one trace into its header.
+ *  @param[in]  r             The rule of the parameter structure
+ *  @param[in]  program       The compiled rule
+ *  @param[in]  prm           The parameter structure
+ *  @param[in]  j             The index of the trace in \c prm
+ *  @param[in]  is_big_endian Whether the header is big-endian
+ *  @param[out] md            The header, holding the rule extent
+ *  @param      scal          Space for one scalar per scalar group
+ */
+static void insertTrace(
+  const Rule& r,
+  const Rule::Program& program,
+  const Param* prm,
+  const size_t j,
+  const bool is_big_endian,
+  unsigned char* md,
+  int16_t* scal)
+{
+    // A compact structure holds the values as they are written.
+    if (prm->compact) {
+        for (const auto& op : program.op) {
+            switch (op.type) {
+                case RuleEntry::MdType::Float:
+                    setField(
+                      prm->fscal[prm->getPos(j, op.scal, prm->nscal)],
+                      is_big_endian, &md[op.scalLoc]);
+                    setField(
+                      prm->fc[prm->getPos(j, op.num, r.numFloat)],
+                      is_big_endian, &md[op.loc]);
+                    break;
+
+                case RuleEntry::MdType::Short:
+                    setField(
+                      prm->s[prm->getPos(j, op.num, r.numShort)],
+                      is_big_endian, &md[op.loc]);
+                    break;
+
+                case RuleEntry::MdType::Long:
+                    setField(
+                      prm->ic[prm->getPos(j, op.num, r.numLong)],
+                      is_big_endian, &md[op.loc]);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+        return;
+    }
+
+    std::fill(scal, scal + program.scalLoc.size(), int16_t(1));
+
+    for (const auto& op : program.op) {
+        switch (op.type) {
+            case RuleEntry::MdType::Float: {
+                const int16_t scal1 = scal[op.scal];
+                const int16_t scal2 =
+                  find_scalar(prm->f[prm->getPos(j, op.num, r.numFloat)]);
+
+                // if the scale is bigger than 1 that means we need to use
+                // the largest to ensure conservation of the most
+                // significant  digit otherwise we choose the scale that
+                // preserves the  most digits after the decimal place.
+                scal[op.scal] =
+                  ((scal1 > 1 || scal2 > 1) ? std::max(scal1, scal2) :
+                                              std::min(scal1, scal2));
+
+            } break;
+
+            case RuleEntry::MdType::Short:
+                setField(
+                  prm->s[prm->getPos(j, op.num, r.numShort)], is_big_endian,
+                  &md[op.loc]);
+                break;
+
+            case RuleEntry::MdType::Long:
+                setField(
+                  int32_t(prm->i[prm->getPos(j, op.num, r.numLong)]),
+                  is_big_endian, &md[op.loc]);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    // Finish off the floats. Floats are inherently annoying in SEG-Y
+    for (size_t k = 0; k < program.scalLoc.size(); k++) {
+        setField(scal[k], is_big_endian, &md[program.scalLoc[k]]);
+    }
+
+    for (const auto& op : program.op) {
+        if (op.type != RuleEntry::MdType::Float) {
+            continue;
+        }
+
+        exseis::utils::Floating_point gscale = parse_scalar(scal[op.scal]);
+
+        setField(
+          int32_t(
+            std::lround(prm->f[prm->getPos(j, op.num, r.numFloat)] / gscale)),
+          is_big_endian, &md[op.loc]);
+    }
+}
+
 void insertParam(
-  size_t sz, const Param* prm, unsigned char* buf, size_t stride, size_t skip)
+  size_t sz,
+  const Param* prm,
+  unsigned char* buf,
+  size_t stride,
+  size_t skip,
+  size_t threads,
+  bool is_big_endian)
 {
     if (prm == nullptr || sz == 0) {
         return;
     }
 
-    auto r       = prm->r;
-    size_t start = r->start;
+    auto r = prm->r;
+
+    // Every field is written, so none can be left undecoded.
+    prm->decode();
 
     if (r->numCopy != 0) {
         if (stride == 0) {
@@ -39,93 +198,216 @@ void insertParam(
         }
     }
 
-    for (size_t i = 0; i < sz; i++) {
-        unsigned char* md = &buf[(r->extent() + stride) * i];
+    // The rule must be compiled before the threads share it.
+    const auto& program = r->compile();
+    const size_t extent = r->extent();
 
-// Compiler defects
-#if defined(__INTEL_COMPILER) || __GNUC__ < 6
-        std::unordered_map<Tr, int16_t, EnumHash> scal;
-#else
-        std::unordered_map<Tr, int16_t> scal;
-#endif
+#pragma omp parallel num_threads(int(threads)) if (threads > 1 && sz > 1)
+    {
+        // The scalar chosen for each group of floats sharing one
+        std::vector<int16_t> scal(program.scalLoc.size());
 
-        std::vector<const SEGYFloatRuleEntry*> rule;
+#pragma omp for schedule(static)
+        for (size_t i = 0; i < sz; i++) {
+            insertTrace(
+              *r, program, prm, i + skip, is_big_endian,
+              &buf[(extent + stride) * i], scal.data());
+        }
+    }
+}
 
-        for (const auto v : r->translate) {
+/*! Extract one parameter of one trace from its header.
+ *  @param[in]  r             The rule of the parameter structure
+ *  @param[in]  op            The compiled operation of the parameter
+ *  @param[in]  md            The header, holding the rule extent
+ *  @param[in]  is_big_endian Whether the header is big-endian
+ *  @param[in]  scale         For floats, the scale of the value
+ *  @param[out] prm           The parameter structure
+ *  @param[in]  j             The index of the trace in \c prm
+ */
+static void extractValue(
+  const Rule& r,
+  const Rule::Op& op,
+  const unsigned char* md,
+  const bool is_big_endian,
+  const exseis::utils::Floating_point scale,
+  Param* prm,
+  const size_t j)
+{
+    const unsigned char* v = &md[op.loc];
+
+    // A compact structure keeps the values unscaled, with the scalar.
+    if (prm->compact) {
+        switch (op.type) {
+            case RuleEntry::MdType::Float:
+                prm->fc[prm->getPos(j, op.num, r.numFloat)] =
+                  getField<int32_t>(v, is_big_endian);
+                prm->fscal[prm->getPos(j, op.scal, prm->nscal)] =
+                  getField<int16_t>(&md[op.scalLoc], is_big_endian);
+                break;
+
+            case RuleEntry::MdType::Short:
+                prm->s[prm->getPos(j, op.num, r.numShort)] =
+                  getField<int16_t>(v, is_big_endian);
+                break;
+
+            case RuleEntry::MdType::Long:
+                prm->ic[prm->getPos(j, op.num, r.numLong)] =
+                  getField<int32_t>(v, is_big_endian);
+                break;
+
+            default:
+                break;
+        }
+        return;
+    }
 
-            const auto t     = v.second;
-            const size_t loc = t->loc - start - 1LU;
+    switch (op.type) {
+        case RuleEntry::MdType::Float: {
 
-            switch (t->type()) {
+            const auto unscaled_value = getField<int32_t>(v, is_big_endian);
 
-                case RuleEntry::MdType::Float: {
+            prm->f[prm->getPos(j, op.num, r.numFloat)] =
+              scale
+              * static_cast<exseis::utils::Floating_point>(unscaled_value);
+        } break;
 
-                    rule.push_back(dynamic_cast<SEGYFloatRuleEntry*>(t));
+        case RuleEntry::MdType::Short:
 
-                    auto tr = static_cast<Tr>(rule.back()->scalLoc);
+            prm->s[prm->getPos(j, op.num, r.numShort)] =
+              getField<int16_t>(v, is_big_endian);
 
-                    const int16_t scal1 =
-                      (scal.find(tr) != scal.end() ? scal[tr] : 1);
-                    const int16_t scal2 =
-                      find_scalar(prm->f[(i + skip) * r->numFloat + t->num]);
+            break;
 
-                    // if the scale is bigger than 1 that means we need to use
-                    // the largest to ensure conservation of the most
-                    // significant  digit otherwise we choose the scale that
-                    // preserves the  most digits after the decimal place.
-                    scal[tr] =
-                      ((scal1 > 1 || scal2 > 1) ? std::max(scal1, scal2) :
-                                                  std::min(scal1, scal2));
+        case RuleEntry::MdType::Long:
 
-                } break;
+            prm->i[prm->getPos(j, op.num, r.numLong)] =
+              getField<int32_t>(v, is_big_endian);
 
-                case RuleEntry::MdType::Short: {
+            break;
 
-                    const auto be_short =
-                      to_big_endian(prm->s[(i + skip) * r->numShort + t->num]);
+        default:
+            break;
+    }
+}
 
-                    std::copy(
-                      std::begin(be_short), std::end(be_short), &md[loc]);
+/*! Get the scale of a float parameter from its header.
+ *  @param[in] op            The compiled operation of the parameter
+ *  @param[in] md            The header, holding the rule extent
+ *  @param[in] is_big_endian Whether the header is big-endian
+ *  @return Return the scale.
+ */
+static exseis::utils::Floating_point extractScale(
+  const Rule::Op& op, const unsigned char* md, const bool is_big_endian)
+{
+    return parse_scalar(getField<int16_t>(&md[op.scalLoc], is_big_endian));
+}
 
-                } break;
+/*! Extract the parameters of one trace from its header.
+ *  @param[in]  r             The rule of the parameter structure
+ *  @param[in]  program       The compiled rule
+ *  @param[in]  md            The header, holding the rule extent
+ *  @param[in]  is_big_endian Whether the header is big-endian
+ *  @param[out] prm           The parameter structure
+ *  @param[in]  j             The index of the trace in \c prm
+ *  @param      scale         Space for one scale per scalar group
+ */
+static void extractTrace(
+  const Rule& r,
+  const Rule::Program& program,
+  const unsigned char* md,
+  const bool is_big_endian,
+  Param* prm,
+  const size_t j,
+  exseis::utils::Floating_point* scale)
+{
+    for (size_t k = 0; k < program.scalLoc.size(); k++) {
+        scale[k] = parse_scalar(
+          getField<int16_t>(&md[program.scalLoc[k]], is_big_endian));
+    }
 
-                case RuleEntry::MdType::Long: {
+    // Run through the compiled rule and extract data
+    for (const auto& op : program.op) {
+        const exseis::utils::Floating_point opScale =
+          (op.type == RuleEntry::MdType::Float ? scale[op.scal] : 1);
+        extractValue(r, op, md, is_big_endian, opScale, prm, j);
+    }
+}
 
-                    const auto be_long = to_big_endian<int32_t>(
-                      int32_t(prm->i[(i + skip) * r->numLong + t->num]));
+/*! Store the raw headers of traces in a lazy parameter structure. Columns
+ *  which have already been decoded are decoded for the new traces too.
+ *  @param[in]  sz      The number of traces
+ *  @param[in]  buf     The headers, each holding the rule extent
+ *  @param[out] prm     The parameter structure
+ *  @param[in]  stride  The stride between adjacent headers in \c buf, after
+ *                      the extent
+ *  @param[in]  skip    Skip the first \c skip entries of \c prm
+ */
+static void extractRaw(
+  const size_t sz,
+  const unsigned char* buf,
+  Param* prm,
+  const size_t stride,
+  const size_t skip)
+{
+    Rule* r             = prm->r.get();
+    const auto& program = r->compile();
+    const size_t extent = r->extent();
 
-                    std::copy(std::begin(be_long), std::end(be_long), &md[loc]);
+    for (size_t i = 0; i < sz; i++) {
+        std::copy_n(
+          &buf[(extent + stride) * i], extent, &prm->raw[(i + skip) * extent]);
+        prm->rawSet[i + skip] = 1;
+    }
 
-                } break;
+    const size_t ncol = r->numFloat + r->numLong + r->numShort;
+    if (prm->npending == ncol) {
+        return;
+    }
 
-                default:
-                    break;
-            }
+    for (const auto& op : program.op) {
+        if (prm->pending[prm->getColumn(op.type, op.num)] != 0) {
+            continue;
         }
 
-        // Finish off the floats. Floats are inherently annoying in SEG-Y
-        for (const auto& s : scal) {
-            const auto be = to_big_endian(s.second);
-
-            std::copy(
-              std::begin(be), std::end(be), &md[size_t(s.first) - start - 1LU]);
+        for (size_t i = 0; i < sz; i++) {
+            const unsigned char* md = &buf[(extent + stride) * i];
+            const exseis::utils::Floating_point scale =
+              (op.type == RuleEntry::MdType::Float ?
+                 extractScale(op, md, prm->is_big_endian) :
+                 1);
+            extractValue(*r, op, md, prm->is_big_endian, scale, prm, i + skip);
         }
+    }
+}
 
-        for (size_t j = 0; j < rule.size(); j++) {
-            exseis::utils::Floating_point gscale =
-              parse_scalar(scal[static_cast<Tr>(rule[j]->scalLoc)]);
-
-            const auto be = to_big_endian(int32_t(std::lround(
-              prm->f[(i + skip) * r->numFloat + rule[j]->num] / gscale)));
+void extractColumn(const Rule::Op& op, Param* prm)
+{
+    Rule* r             = prm->r.get();
+    const size_t extent = r->extent();
 
-            std::copy(
-              std::begin(be), std::end(be), &md[rule[j]->loc - start - 1LU]);
+    for (size_t j = 0; j < prm->sz; j++) {
+        if (prm->rawSet[j] == 0) {
+            continue;
         }
+
+        const unsigned char* md = &prm->raw[j * extent];
+        const exseis::utils::Floating_point scale =
+          (op.type == RuleEntry::MdType::Float ?
+             extractScale(op, md, prm->is_big_endian) :
+             1);
+        extractValue(*r, op, md, prm->is_big_endian, scale, prm, j);
     }
 }
 
 void extractParam(
-  size_t sz, const unsigned char* buf, Param* prm, size_t stride, size_t skip)
+  size_t sz,
+  const unsigned char* buf,
+  Param* prm,
+  size_t stride,
+  size_t skip,
+  size_t threads,
+  bool is_big_endian)
 {
     if (prm == nullptr || sz == 0) {
         return;
@@ -133,6 +415,11 @@ void extractParam(
 
     Rule* r = prm->r.get();
 
+    // Copied and raw headers keep the byte order they were read in.
+    if (r->numCopy != 0 || prm->lazy) {
+        prm->is_big_endian = is_big_endian;
+    }
+
     if (r->numCopy != 0) {
         if (stride == 0) {
             std::copy(
@@ -149,55 +436,26 @@ void extractParam(
         }
     }
 
-    for (size_t i = 0; i < sz; i++) {
-
-        const unsigned char* md = &buf[(r->extent() + stride) * i];
-
-        // Loop through each rule and extract data
-        for (const auto v : r->translate) {
-
-            const auto t = v.second;
-            size_t loc   = t->loc - r->start - 1LU;
-
-            switch (t->type()) {
-                case RuleEntry::MdType::Float: {
-
-                    const size_t scalar_offset =
-                      dynamic_cast<SEGYFloatRuleEntry*>(t)->scalLoc - r->start
-                      - 1LU;
-
-                    const auto parsed_scalar =
-                      parse_scalar(from_big_endian<int16_t>(
-                        md[scalar_offset + 0], md[scalar_offset + 1]));
-
-                    const auto unscaled_value = from_big_endian<int32_t>(
-                      md[loc + 0], md[loc + 1], md[loc + 2], md[loc + 3]);
-
-
-                    typedef decltype(prm->f)::value_type F_type;
-
-                    prm->f[(i + skip) * r->numFloat + t->num] =
-                      parsed_scalar * static_cast<const F_type>(unscaled_value);
-                } break;
-
-                case RuleEntry::MdType::Short:
-
-                    prm->s[(i + skip) * r->numShort + t->num] =
-                      from_big_endian<int16_t>(md[loc + 0], md[loc + 1]);
-
-                    break;
-
-                case RuleEntry::MdType::Long:
-
-                    prm->i[(i + skip) * r->numLong + t->num] =
-                      from_big_endian<int32_t>(
-                        md[loc + 0], md[loc + 1], md[loc + 2], md[loc + 3]);
-
-                    break;
+    if (prm->lazy) {
+        extractRaw(sz, buf, prm, stride, skip);
+        return;
+    }
 
-                default:
-                    break;
-            }
+    // The rule must be compiled before the threads share it.
+    const auto& program = r->compile();
+    const size_t extent = r->extent();
+
+#pragma omp parallel num_threads(int(threads)) if (threads > 1 && sz > 1)
+    {
+        // The scale of each group of floats sharing a scalar
+        std::vector<exseis::utils::Floating_point> scale(
+          program.scalLoc.size());
+
+#pragma omp for schedule(static)
+        for (size_t i = 0; i < sz; i++) {
+            extractTrace(
+              *r, program, &buf[(extent + stride) * i], is_big_endian, prm,
+              i + skip, scale.data());
         }
     }
 }  // namespace SEGY_utils
@@ -274,6 +532,35 @@ int16_t find_scalar(exseis::utils::Floating_point val)
     }
 }
 
+size_t getSampleSz(SEGYNumberFormat format)
+{
+    switch (format) {
+        case SEGYNumberFormat::IEEE8:
+            return 8LU;
+        case SEGYNumberFormat::TC2:
+            return 2LU;
+        case SEGYNumberFormat::TC1:
+            return 1LU;
+        default:
+            return 4LU;
+    }
+}
+
+bool isSupported(SEGYNumberFormat format)
+{
+    switch (format) {
+        case SEGYNumberFormat::IBM:
+        case SEGYNumberFormat::TC4:
+        case SEGYNumberFormat::TC2:
+        case SEGYNumberFormat::IEEE:
+        case SEGYNumberFormat::IEEE8:
+        case SEGYNumberFormat::TC1:
+            return true;
+        default:
+            return false;
+    }
+}
+
 }  // namespace SEGY_utils
 }  // namespace PIOL
 }  // namespace exseis
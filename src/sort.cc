@@ -16,7 +16,11 @@
 #include "ExSeisDat/utils/mpi/MPI_error_to_string.hh"
 #include "ExSeisDat/utils/typedefs.h"
 
+#include "param_mpi.hh"
+
 #include <algorithm>
+#include <array>
+#include <functional>
 #include <numeric>
 #include <string>
 #include <vector>
@@ -52,56 +56,99 @@ inline exseis::utils::Floating_point off(
     return (sx - rx) * (sx - rx) + (sy - ry) * (sy - ry);
 }
 
+/// A column of floating point parameters
+using FloatColumn = param_utils::ParamColumn<exseis::utils::Floating_point>;
+
+/// A column of integer parameters
+using IntColumn = param_utils::ParamColumn<exseis::utils::Integer>;
+
+/// A column of parameters read as unsigned values
+using SizeColumn = param_utils::ParamColumn<size_t>;
+
+/// The columns read by the comparisons of the sort types, bound once for a
+/// parameter structure rather than on every comparison.
+struct SortColumns {
+    /*! Bind the columns of a parameter structure.
+     *  @param[in] prm The parameter structure
+     */
+    explicit SortColumns(const Param* prm) :
+        xSrc(PIOL_META_xSrc, prm),
+        ySrc(PIOL_META_ySrc, prm),
+        xRcv(PIOL_META_xRcv, prm),
+        yRcv(PIOL_META_yRcv, prm),
+        offset(PIOL_META_Offset, prm),
+        il(PIOL_META_il, prm),
+        xl(PIOL_META_xl, prm),
+        ltn(PIOL_META_ltn, prm)
+    {
+    }
+
+    /// The source x coordinate
+    FloatColumn xSrc;
+
+    /// The source y coordinate
+    FloatColumn ySrc;
+
+    /// The receiver x coordinate
+    FloatColumn xRcv;
+
+    /// The receiver y coordinate
+    FloatColumn yRcv;
+
+    /// The offset read from the header
+    SizeColumn offset;
+
+    /// The inline number
+    IntColumn il;
+
+    /// The crossline number
+    IntColumn xl;
+
+    /// The local trace number, which breaks ties
+    IntColumn ltn;
+};
+
+/// A less-than comparison of two sets of parameters through bound columns.
+typedef bool (*BoundCompare)(const SortColumns& c, size_t i, size_t j);
+
 /*! For sorting by Src X, Src Y, Rcv X, Rcv Y.
- *  @param[in] prm The parameter structure
- *  @param[in] i   Structure to access 0th parameter of associated Param struct.
- *  @param[in] j   Structure to access 0th parameter of associated Param struct.
- *  @return Return true if entry \c i of \p prm is less than entry \c j in terms
- *          of the sort.
+ *  @param[in] c The bound columns of the parameter structure
+ *  @param[in] i The index of the first set of parameters.
+ *  @param[in] j The index of the second set of parameters.
+ *  @return Return true if entry \c i is less than entry \c j in terms of the
+ *          sort.
  */
-static bool lessSrcRcv(const Param* prm, const size_t i, const size_t j)
+static bool lessSrcRcv(const SortColumns& c, const size_t i, const size_t j)
 {
-    auto e1sx = param_utils::getPrm<exseis::utils::Floating_point>(
-      i, PIOL_META_xSrc, prm);
-    auto e2sx = param_utils::getPrm<exseis::utils::Floating_point>(
-      j, PIOL_META_xSrc, prm);
+    auto e1sx = c.xSrc[i];
+    auto e2sx = c.xSrc[j];
 
     if (e1sx < e2sx) {
         return true;
     }
     else if (e1sx == e2sx) {
-        auto e1sy = param_utils::getPrm<exseis::utils::Floating_point>(
-          i, PIOL_META_ySrc, prm);
-        auto e2sy = param_utils::getPrm<exseis::utils::Floating_point>(
-          j, PIOL_META_ySrc, prm);
+        auto e1sy = c.ySrc[i];
+        auto e2sy = c.ySrc[j];
 
         if (e1sy < e2sy) {
             return true;
         }
         else if (e1sy == e2sy) {
-            auto e1rx = param_utils::getPrm<exseis::utils::Floating_point>(
-              i, PIOL_META_xRcv, prm);
-            auto e2rx = param_utils::getPrm<exseis::utils::Floating_point>(
-              j, PIOL_META_xRcv, prm);
+            auto e1rx = c.xRcv[i];
+            auto e2rx = c.xRcv[j];
 
             if (e1rx < e2rx) {
                 return true;
             }
             else if (e1rx == e2rx) {
-                auto e1ry = param_utils::getPrm<exseis::utils::Floating_point>(
-                  i, PIOL_META_yRcv, prm);
-                auto e2ry = param_utils::getPrm<exseis::utils::Floating_point>(
-                  j, PIOL_META_yRcv, prm);
+                auto e1ry = c.yRcv[i];
+                auto e2ry = c.yRcv[j];
 
                 if (e1ry < e2ry) {
                     return true;
                 }
                 else if (e1ry == e2ry) {
-                    return (
-                      param_utils::getPrm<exseis::utils::Integer>(
-                        i, PIOL_META_ltn, prm)
-                      < param_utils::getPrm<exseis::utils::Integer>(
-                          j, PIOL_META_ltn, prm));
+                    return (c.ltn[i] < c.ltn[j]);
                 }
             }
         }
@@ -113,58 +160,35 @@ static bool lessSrcRcv(const Param* prm, const size_t i, const size_t j)
 /*! For sorting by Src X, Src Y and Offset.
  *  @tparam    CalcOff If true, calculate the offset, otherwise read the offset
  *                     from the header
- *  @param[in] prm     The parameter structure
- *  @param[in] i       Structure to access 0th parameter of associated Param
- *                     struct.
- *  @param[in] j       Structure to access 0th parameter of associated Param
- *                     struct.
- *  @return Return true if entry \c i of \p prm is less than entry \c j in terms
- *          of the sort.
+ *  @param[in] c       The bound columns of the parameter structure
+ *  @param[in] i       The index of the first set of parameters.
+ *  @param[in] j       The index of the second set of parameters.
+ *  @return Return true if entry \c i is less than entry \c j in terms of the
+ *          sort.
  */
 template<bool CalcOff>
-static bool lessSrcOff(const Param* prm, const size_t i, const size_t j)
+static bool lessSrcOff(const SortColumns& c, const size_t i, const size_t j)
 {
-    auto e1sx = param_utils::getPrm<exseis::utils::Floating_point>(
-      i, PIOL_META_xSrc, prm);
-    auto e2sx = param_utils::getPrm<exseis::utils::Floating_point>(
-      j, PIOL_META_xSrc, prm);
+    auto e1sx = c.xSrc[i];
+    auto e2sx = c.xSrc[j];
 
     if (e1sx < e2sx) {
         return true;
     }
     else if (e1sx == e2sx) {
-        auto e1sy = param_utils::getPrm<exseis::utils::Floating_point>(
-          i, PIOL_META_ySrc, prm);
-        auto e2sy = param_utils::getPrm<exseis::utils::Floating_point>(
-          j, PIOL_META_ySrc, prm);
+        auto e1sy = c.ySrc[i];
+        auto e2sy = c.ySrc[j];
 
         if (e1sy < e2sy) {
             return true;
         }
         else if (e1sy == e2sy) {
-            auto e1rx = param_utils::getPrm<exseis::utils::Floating_point>(
-              i, PIOL_META_xRcv, prm);
-            auto e1ry = param_utils::getPrm<exseis::utils::Floating_point>(
-              i, PIOL_META_yRcv, prm);
             auto off1 =
-              (CalcOff ? off(e1sx, e1sy, e1rx, e1ry) :
-                         param_utils::getPrm<size_t>(i, PIOL_META_Offset, prm));
-
-            auto e2rx = param_utils::getPrm<exseis::utils::Floating_point>(
-              j, PIOL_META_xRcv, prm);
-            auto e2ry = param_utils::getPrm<exseis::utils::Floating_point>(
-              j, PIOL_META_yRcv, prm);
+              (CalcOff ? off(e1sx, e1sy, c.xRcv[i], c.yRcv[i]) : c.offset[i]);
             auto off2 =
-              (CalcOff ? off(e2sx, e2sy, e2rx, e2ry) :
-                         param_utils::getPrm<size_t>(j, PIOL_META_Offset, prm));
+              (CalcOff ? off(e2sx, e2sy, c.xRcv[j], c.yRcv[j]) : c.offset[j]);
 
-            return (
-              off1 < off2
-              || (off1 == off2
-                  && param_utils::getPrm<exseis::utils::Integer>(
-                       i, PIOL_META_ltn, prm)
-                       < param_utils::getPrm<exseis::utils::Integer>(
-                           j, PIOL_META_ltn, prm)));
+            return (off1 < off2 || (off1 == off2 && c.ltn[i] < c.ltn[j]));
         }
     }
     return false;
@@ -173,123 +197,85 @@ static bool lessSrcOff(const Param* prm, const size_t i, const size_t j)
 /*! For sorting by Rcv X, Rcv Y and Offset.
  *  @tparam    CalcOff If true, calculate the offset, otherwise read the offset
  *                     from the header
- *  @param[in] prm     The parameter structure
- *  @param[in] i       Structure to access 0th parameter of associated Param
- *                     struct.
- *  @param[in] j       Structure to access 0th parameter of associated Param
- *                     struct.
- *  @return Return true if entry \c i of \p prm is less than entry \c j in terms
- *          of the sort.
+ *  @param[in] c       The bound columns of the parameter structure
+ *  @param[in] i       The index of the first set of parameters.
+ *  @param[in] j       The index of the second set of parameters.
+ *  @return Return true if entry \c i is less than entry \c j in terms of the
+ *          sort.
  */
 template<bool CalcOff>
-static bool lessRcvOff(const Param* prm, const size_t i, const size_t j)
+static bool lessRcvOff(const SortColumns& c, const size_t i, const size_t j)
 {
-    auto e1rx = param_utils::getPrm<exseis::utils::Floating_point>(
-      i, PIOL_META_xRcv, prm);
-    auto e2rx = param_utils::getPrm<exseis::utils::Floating_point>(
-      j, PIOL_META_xRcv, prm);
+    auto e1rx = c.xRcv[i];
+    auto e2rx = c.xRcv[j];
 
     if (e1rx < e2rx) {
         return true;
     }
     else if (e1rx == e2rx) {
-        auto e1ry = param_utils::getPrm<exseis::utils::Floating_point>(
-          i, PIOL_META_yRcv, prm);
-        auto e2ry = param_utils::getPrm<exseis::utils::Floating_point>(
-          j, PIOL_META_yRcv, prm);
+        auto e1ry = c.yRcv[i];
+        auto e2ry = c.yRcv[j];
 
         if (e1ry < e2ry) {
             return true;
         }
         else if (e1ry == e2ry) {
-            auto e1sx = param_utils::getPrm<exseis::utils::Floating_point>(
-              i, PIOL_META_xSrc, prm);
-            auto e1sy = param_utils::getPrm<exseis::utils::Floating_point>(
-              i, PIOL_META_ySrc, prm);
             auto off1 =
-              (CalcOff ? off(e1sx, e1sy, e1rx, e1ry) :
-                         param_utils::getPrm<size_t>(i, PIOL_META_Offset, prm));
-
-            auto e2sx = param_utils::getPrm<exseis::utils::Floating_point>(
-              j, PIOL_META_xSrc, prm);
-            auto e2sy = param_utils::getPrm<exseis::utils::Floating_point>(
-              j, PIOL_META_ySrc, prm);
+              (CalcOff ? off(c.xSrc[i], c.ySrc[i], e1rx, e1ry) : c.offset[i]);
             auto off2 =
-              (CalcOff ? off(e2sx, e2sy, e2rx, e2ry) :
-                         param_utils::getPrm<size_t>(j, PIOL_META_Offset, prm));
+              (CalcOff ? off(c.xSrc[j], c.ySrc[j], e2rx, e2ry) : c.offset[j]);
 
-            return (
-              off1 < off2
-              || (off1 == off2
-                  && param_utils::getPrm<exseis::utils::Integer>(
-                       i, PIOL_META_ltn, prm)
-                       < param_utils::getPrm<exseis::utils::Integer>(
-                           j, PIOL_META_ltn, prm)));
+            return (off1 < off2 || (off1 == off2 && c.ltn[i] < c.ltn[j]));
         }
     }
     return false;
 }
 
+/*! Calculate the offset of a set of parameters, or read it from the header.
+ *  @tparam    CalcOff If true, calculate the offset, otherwise read the offset
+ *                     from the header
+ *  @param[in] c       The bound columns of the parameter structure
+ *  @param[in] i       The index of the set of parameters.
+ *  @return Return the offset, squared if it is calculated.
+ */
+template<bool CalcOff>
+static exseis::utils::Floating_point offsetOf(
+  const SortColumns& c, const size_t i)
+{
+    return (
+      CalcOff ? off(c.xSrc[i], c.ySrc[i], c.xRcv[i], c.yRcv[i]) :
+                c.offset[i]);
+}
+
 /*! For sorting by Inline, Crossline and Offset.
  *  @tparam CalcOff If true, calculate the offset, otherwise read the offset
  *                  from the header
- *  @param[in] prm The parameter structure
- *  @param[in] i   Structure to access 0th parameter of associated Param struct.
- *  @param[in] j   Structure to access 0th parameter of associated Param struct.
- *  @return Return true if entry \c i of \p prm is less than entry \c j in terms
- *          of the sort.
+ *  @param[in] c The bound columns of the parameter structure
+ *  @param[in] i The index of the first set of parameters.
+ *  @param[in] j The index of the second set of parameters.
+ *  @return Return true if entry \c i is less than entry \c j in terms of the
+ *          sort.
  */
 template<bool CalcOff>
-static bool lessLineOff(const Param* prm, const size_t i, const size_t j)
+static bool lessLineOff(const SortColumns& c, const size_t i, const size_t j)
 {
-    auto e1il =
-      param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_il, prm);
-    auto e2il =
-      param_utils::getPrm<exseis::utils::Integer>(j, PIOL_META_il, prm);
+    auto e1il = c.il[i];
+    auto e2il = c.il[j];
 
     if (e1il < e2il) {
         return true;
     }
     else if (e1il == e2il) {
-        auto e1xl =
-          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_xl, prm);
-        auto e2xl =
-          param_utils::getPrm<exseis::utils::Integer>(j, PIOL_META_xl, prm);
+        auto e1xl = c.xl[i];
+        auto e2xl = c.xl[j];
         if (e1xl < e2xl) {
             return true;
         }
         else if (e1xl == e2xl) {
-            auto e1sx = param_utils::getPrm<exseis::utils::Floating_point>(
-              i, PIOL_META_xSrc, prm);
-            auto e1sy = param_utils::getPrm<exseis::utils::Floating_point>(
-              i, PIOL_META_ySrc, prm);
-            auto e1rx = param_utils::getPrm<exseis::utils::Floating_point>(
-              i, PIOL_META_xRcv, prm);
-            auto e1ry = param_utils::getPrm<exseis::utils::Floating_point>(
-              i, PIOL_META_yRcv, prm);
-
-            auto e2sx = param_utils::getPrm<exseis::utils::Floating_point>(
-              j, PIOL_META_xSrc, prm);
-            auto e2sy = param_utils::getPrm<exseis::utils::Floating_point>(
-              j, PIOL_META_ySrc, prm);
-            auto e2rx = param_utils::getPrm<exseis::utils::Floating_point>(
-              j, PIOL_META_xRcv, prm);
-            auto e2ry = param_utils::getPrm<exseis::utils::Floating_point>(
-              j, PIOL_META_yRcv, prm);
+            auto off1 = offsetOf<CalcOff>(c, i);
+            auto off2 = offsetOf<CalcOff>(c, j);
 
-            auto off1 =
-              (CalcOff ? off(e1sx, e1sy, e1rx, e1ry) :
-                         param_utils::getPrm<size_t>(i, PIOL_META_Offset, prm));
-            auto off2 =
-              (CalcOff ? off(e2sx, e2sy, e2rx, e2ry) :
-                         param_utils::getPrm<size_t>(j, PIOL_META_Offset, prm));
-            return (
-              off1 < off2
-              || (off1 == off2
-                  && param_utils::getPrm<exseis::utils::Integer>(
-                       i, PIOL_META_ltn, prm)
-                       < param_utils::getPrm<exseis::utils::Integer>(
-                           j, PIOL_META_ltn, prm)));
+            return (off1 < off2 || (off1 == off2 && c.ltn[i] < c.ltn[j]));
         }
     }
     return false;
@@ -298,101 +284,118 @@ static bool lessLineOff(const Param* prm, const size_t i, const size_t j)
 /*! For sorting by Offset, Inline and Crossline.
  *  @tparam    CalcOff If true, calculate the offset, otherwise read the offset
  *                     from the header
- *  @param[in] prm     The parameter structure
- *  @param[in] i       Structure to access 0th parameter of associated Param
- *                     struct.
- *  @param[in] j       Structure to access 0th parameter of associated Param
- *                     struct.
- *  @return Return true if entry \c i of \p prm is less than entry \c j in terms
- *          of the sort.
+ *  @param[in] c       The bound columns of the parameter structure
+ *  @param[in] i       The index of the first set of parameters.
+ *  @param[in] j       The index of the second set of parameters.
+ *  @return Return true if entry \c i is less than entry \c j in terms of the
+ *          sort.
  */
 template<bool CalcOff>
-static bool lessOffLine(const Param* prm, const size_t i, const size_t j)
+static bool lessOffLine(const SortColumns& c, const size_t i, const size_t j)
 {
-    auto e1sx = param_utils::getPrm<exseis::utils::Floating_point>(
-      i, PIOL_META_xSrc, prm);
-    auto e1sy = param_utils::getPrm<exseis::utils::Floating_point>(
-      i, PIOL_META_ySrc, prm);
-    auto e1rx = param_utils::getPrm<exseis::utils::Floating_point>(
-      i, PIOL_META_xRcv, prm);
-    auto e1ry = param_utils::getPrm<exseis::utils::Floating_point>(
-      i, PIOL_META_yRcv, prm);
-    auto off1 =
-      (CalcOff ? off(e1sx, e1sy, e1rx, e1ry) :
-                 param_utils::getPrm<size_t>(i, PIOL_META_Offset, prm));
-
-    auto e2sx = param_utils::getPrm<exseis::utils::Floating_point>(
-      j, PIOL_META_xSrc, prm);
-    auto e2sy = param_utils::getPrm<exseis::utils::Floating_point>(
-      j, PIOL_META_ySrc, prm);
-    auto e2rx = param_utils::getPrm<exseis::utils::Floating_point>(
-      j, PIOL_META_xRcv, prm);
-    auto e2ry = param_utils::getPrm<exseis::utils::Floating_point>(
-      j, PIOL_META_yRcv, prm);
-    auto off2 =
-      (CalcOff ? off(e2sx, e2sy, e2rx, e2ry) :
-                 param_utils::getPrm<size_t>(j, PIOL_META_Offset, prm));
+    auto off1 = offsetOf<CalcOff>(c, i);
+    auto off2 = offsetOf<CalcOff>(c, j);
 
     if (off1 < off2) {
         return true;
     }
     else if (off1 == off2) {
-        auto e1il =
-          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_il, prm);
-        auto e2il =
-          param_utils::getPrm<exseis::utils::Integer>(j, PIOL_META_il, prm);
+        auto e1il = c.il[i];
+        auto e2il = c.il[j];
         if (e1il < e2il) {
             return true;
         }
         else if (e1il == e2il) {
-            auto e1xl =
-              param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_xl, prm);
-            auto e2xl =
-              param_utils::getPrm<exseis::utils::Integer>(j, PIOL_META_xl, prm);
-            return (
-              e1xl < e2xl
-              || (e1xl == e2xl
-                  && param_utils::getPrm<exseis::utils::Integer>(
-                       i, PIOL_META_ltn, prm)
-                       < param_utils::getPrm<exseis::utils::Integer>(
-                           j, PIOL_META_ltn, prm)));
+            auto e1xl = c.xl[i];
+            auto e2xl = c.xl[j];
+
+            return (e1xl < e2xl || (e1xl == e2xl && c.ltn[i] < c.ltn[j]));
         }
     }
     return false;
 }
 
+/// A less-than comparison of two sets of parameters of a structure, as
+/// returned by getComp.
+typedef bool (*ParamCompare)(const Param* prm, size_t i, size_t j);
+
+/*! Compare two sets of parameters, binding the columns for the one
+ *  comparison. The sorts recognise these wrappers and bind the columns once
+ *  instead.
+ *  @tparam    Less The comparison through bound columns.
+ *  @param[in] prm  The parameter structure
+ *  @param[in] i    The index of the first set of parameters.
+ *  @param[in] j    The index of the second set of parameters.
+ *  @return Return true if entry \c i of \p prm is less than entry \c j in terms
+ *          of the sort.
+ */
+template<BoundCompare Less>
+static bool lessParam(const Param* prm, const size_t i, const size_t j)
+{
+    return Less(SortColumns(prm), i, j);
+}
+
+/// A sort type with its comparison, as returned by getComp and as it is used
+/// on bound columns.
+struct SortComparison {
+    /// The sort type
+    SortType type;
+
+    /// The comparison returned by getComp
+    ParamCompare wrapped;
+
+    /// The comparison through bound columns
+    BoundCompare bound;
+};
+
+/// The comparison of each sort type. The first is used for unknown types.
+static const std::array<SortComparison, 9> comparisons = {
+  {{PIOL_SORTTYPE_SrcRcv, lessParam<lessSrcRcv>, lessSrcRcv},
+   {PIOL_SORTTYPE_SrcOff, lessParam<lessSrcOff<true>>, lessSrcOff<true>},
+   {PIOL_SORTTYPE_SrcROff, lessParam<lessSrcOff<false>>, lessSrcOff<false>},
+   {PIOL_SORTTYPE_RcvOff, lessParam<lessRcvOff<true>>, lessRcvOff<true>},
+   {PIOL_SORTTYPE_RcvROff, lessParam<lessRcvOff<false>>, lessRcvOff<false>},
+   {PIOL_SORTTYPE_LineOff, lessParam<lessLineOff<true>>, lessLineOff<true>},
+   {PIOL_SORTTYPE_LineROff, lessParam<lessLineOff<false>>,
+    lessLineOff<false>},
+   {PIOL_SORTTYPE_OffLine, lessParam<lessOffLine<true>>, lessOffLine<true>},
+   {PIOL_SORTTYPE_ROffLine, lessParam<lessOffLine<false>>,
+    lessOffLine<false>}}};
+
 CompareP getComp(SortType type)
 {
-    switch (type) {
-        default:
-        case PIOL_SORTTYPE_SrcRcv:
-            return lessSrcRcv;
-            break;
-        case PIOL_SORTTYPE_SrcOff:
-            return lessSrcOff<true>;
-            break;
-        case PIOL_SORTTYPE_SrcROff:
-            return lessSrcOff<false>;
-            break;
-        case PIOL_SORTTYPE_RcvOff:
-            return lessRcvOff<true>;
-            break;
-        case PIOL_SORTTYPE_RcvROff:
-            return lessRcvOff<false>;
-            break;
-        case PIOL_SORTTYPE_LineOff:
-            return lessLineOff<true>;
-            break;
-        case PIOL_SORTTYPE_LineROff:
-            return lessLineOff<false>;
-            break;
-        case PIOL_SORTTYPE_OffLine:
-            return lessOffLine<true>;
-            break;
-        case PIOL_SORTTYPE_ROffLine:
-            return lessOffLine<false>;
-            break;
+    for (const auto& c : comparisons) {
+        if (c.type == type) {
+            return c.wrapped;
+        }
     }
+    return comparisons[0].wrapped;
+}
+
+/*! Bind a comparison to a parameter structure. The columns read by a
+ *  comparison returned by getComp are bound once here, rather than on every
+ *  comparison.
+ *  @param[in] comp The comparison
+ *  @param[in] prm  The parameter structure. Its arrays must not be
+ *                  reallocated while the comparison is used.
+ *  @return Return a less-than comparison of two indices of \p prm.
+ */
+static std::function<bool(size_t, size_t)> bindComp(
+  const CompareP& comp, const Param* prm)
+{
+    const ParamCompare* wrapped = comp.target<ParamCompare>();
+    if (wrapped != nullptr) {
+        for (const auto& c : comparisons) {
+            if (c.wrapped == *wrapped) {
+                const BoundCompare bound = c.bound;
+                const SortColumns cols(prm);
+                return [bound, cols](size_t i, size_t j) -> bool {
+                    return bound(cols, i, j);
+                };
+            }
+        }
+    }
+    return [comp, prm](size_t i, size_t j) -> bool { return comp(prm, i, j); };
 }
 
 std::vector<size_t> sort(ExSeisPIOL* piol, SortType type, Param* prm)
@@ -405,13 +408,13 @@ bool checkOrder(
   exseis::utils::Contiguous_decomposition dec,
   SortType type)
 {
-    auto comp = getComp(type);
     Param prm(dec.local_size);
 
     src->readParam(dec.global_offset, dec.local_size, &prm);
 
+    const auto less = bindComp(getComp(type), &prm);
     for (size_t i = 1; i < dec.local_size; i++) {
-        if (!comp(&prm, i - 1, i)) {
+        if (!less(i - 1, i)) {
             return false;
         }
     }
@@ -693,23 +696,33 @@ std::vector<size_t> sort(ExSeisPIOL* piol, std::vector<size_t> list)
     return list;
 }
 
-/*! Send objects from the current processes to the process one rank higher if
- *  such a process exists. Objects are taken from the end of a vector.
- *  Receiving processes put the objects at the start of their vector.
+/*! Exchange a range of sets of a parameter structure with the neighbouring
+ *  processes. Each direction is a single message described by a derived
+ *  datatype over the arrays of prm itself, so nothing is staged in a
+ *  separate structure. The ranges sent and received must not overlap.
  *  @param[in]     piol     The PIOL object.
- *  @param[in]     regionSz The size of data to send/receive.
+ *  @param[in]     regionSz The number of sets to send/receive.
+ *  @param[in]     soff     The first set to send.
+ *  @param[in]     roff     The first set to receive into.
+ *  @param[in]     right    Whether sets are sent to the process one rank
+ *                          higher, rather than one rank lower.
  *  @param[in,out] prm      The parameter structure to send/receive
  */
-void sendRight(ExSeisPIOL* piol, size_t regionSz, Param* prm)
+void exchangePrm(
+  ExSeisPIOL* piol,
+  size_t regionSz,
+  size_t soff,
+  size_t roff,
+  bool right,
+  Param* prm)
 {
-    Param sprm(prm->r, regionSz);
-    Param rprm(prm->r, regionSz);
+    const std::string name = (right ? "Sort right"s : "Sort left"s);
+    const size_t rank      = piol->comm->getRank();
+    const size_t numRank   = piol->comm->getNumRank();
+    const int tag          = (right ? 0 : 1);
 
-    size_t rank = piol->comm->getRank();
-    std::vector<MPI_Request> rsnd(4);
-    std::vector<MPI_Request> rrcv(4);
-
-    // Lambda for wrapping an MPI call with logging.
+    // Lambda for wrapping an MPI call with logging. The wrapped call returns
+    // whether the MPI call succeeded.
     auto log_on_error = [&piol](auto mpi_function, std::string function_name) {
         return [=](auto&&... args) {
             int err = mpi_function(std::forward<decltype(args)>(args)...);
@@ -721,64 +734,62 @@ void sendRight(ExSeisPIOL* piol, size_t regionSz, Param* prm)
                     + exseis::utils::MPI_error_to_string(err),
                   PIOL_VERBOSITY_NONE);
             }
+            return err == MPI_SUCCESS;
         };
     };
 
-    if (rank != 0) {
-        /// @todo Replace this with type deducing implementation
-
-        log_on_error(
-          MPI_Irecv, "Sort right exseis::utils::Floating_point MPI_Irecv")(
-          rprm.f.data(), rprm.f.size() * sizeof(exseis::utils::Floating_point),
-          MPI_CHAR, rank - 1, 0, MPI_COMM_WORLD, &rrcv[0]);
+    const bool send = (right ? rank != numRank - 1 : rank != 0);
+    const bool recv = (right ? rank != 0 : rank != numRank - 1);
+    const int dest  = static_cast<int>(right ? rank + 1 : rank - 1);
+    const int src   = static_cast<int>(right ? rank - 1 : rank + 1);
 
-        log_on_error(MPI_Irecv, "Sort right exseis::utils::Integer MPI_Irecv")(
-          rprm.i.data(), rprm.i.size() * sizeof(exseis::utils::Integer),
-          MPI_CHAR, rank - 1, 0, MPI_COMM_WORLD, &rrcv[1]);
+    std::vector<MPI_Request> rsnd(1, MPI_REQUEST_NULL);
+    std::vector<MPI_Request> rrcv(1, MPI_REQUEST_NULL);
+    MPI_Datatype stype = MPI_DATATYPE_NULL;
+    MPI_Datatype rtype = MPI_DATATYPE_NULL;
 
-        log_on_error(MPI_Irecv, "Sort right short MPI_Irecv")(
-          rprm.s.data(), rprm.s.size() * sizeof(short), MPI_CHAR, rank - 1, 0,
-          MPI_COMM_WORLD, &rrcv[2]);
-
-        log_on_error(MPI_Irecv, "Sort right size_t MPI_Irecv")(
-          rprm.t.data(), rprm.t.size() * sizeof(size_t), MPI_CHAR, rank - 1, 0,
-          MPI_COMM_WORLD, &rrcv[3]);
+    // A message is only posted with a datatype which was built. The error
+    // is logged, so the sort fails when the log is checked.
+    if (recv
+        && log_on_error(param_utils::createMPIType, name + " createMPIType")(
+             prm, roff, regionSz, &rtype)) {
+        log_on_error(MPI_Irecv, name + " Param MPI_Irecv")(
+          MPI_BOTTOM, 1, rtype, src, tag, MPI_COMM_WORLD, &rrcv[0]);
     }
 
-    if (rank != piol->comm->getNumRank() - 1) {
-        for (size_t i = 0; i < regionSz; i++) {
-            param_utils::cpyPrm(i + prm->size() - regionSz, prm, i, &sprm);
-        }
-
-        /// @todo Replace this with type deducing implementation
-
-        log_on_error(
-          MPI_Isend, "Sort right exseis::utils::Floating_point MPI_Isend")(
-          sprm.f.data(), sprm.f.size() * sizeof(exseis::utils::Floating_point),
-          MPI_CHAR, rank + 1, 0, MPI_COMM_WORLD, &rsnd[0]);
-
-        log_on_error(MPI_Isend, "Sort right exseis::utils::Integer MPI_Isend")(
-          sprm.i.data(), sprm.i.size() * sizeof(exseis::utils::Integer),
-          MPI_CHAR, rank + 1, 0, MPI_COMM_WORLD, &rsnd[1]);
-
-        log_on_error(MPI_Isend, "Sort right short MPI_Isend")(
-          sprm.s.data(), sprm.s.size() * sizeof(short), MPI_CHAR, rank + 1, 0,
-          MPI_COMM_WORLD, &rsnd[2]);
-
-        log_on_error(MPI_Isend, "Sort right size_t MPI_Isend")(
-          sprm.t.data(), sprm.t.size() * sizeof(size_t), MPI_CHAR, rank + 1, 0,
-          MPI_COMM_WORLD, &rsnd[3]);
+    if (send
+        && log_on_error(param_utils::createMPIType, name + " createMPIType")(
+             prm, soff, regionSz, &stype)) {
+        log_on_error(MPI_Isend, name + " Param MPI_Isend")(
+          MPI_BOTTOM, 1, stype, dest, tag, MPI_COMM_WORLD, &rsnd[0]);
     }
 
-    Wait(piol, rsnd, rrcv);
+    if (right) {
+        Wait(piol, rsnd, rrcv);
+    }
+    else {
+        Wait(piol, rrcv, rsnd);
+    }
 
-    if (rank != 0) {
-        for (size_t i = 0; i < regionSz; i++) {
-            param_utils::cpyPrm(i, &rprm, i, prm);
+    for (auto* type : {&stype, &rtype}) {
+        if (*type != MPI_DATATYPE_NULL) {
+            log_on_error(MPI_Type_free, name + " MPI_Type_free")(type);
         }
     }
 }
 
+/*! Send objects from the current processes to the process one rank higher if
+ *  such a process exists. Objects are taken from the end of a vector.
+ *  Receiving processes put the objects at the start of their vector.
+ *  @param[in]     piol     The PIOL object.
+ *  @param[in]     regionSz The size of data to send/receive.
+ *  @param[in,out] prm      The parameter structure to send/receive
+ */
+void sendRight(ExSeisPIOL* piol, size_t regionSz, Param* prm)
+{
+    exchangePrm(piol, regionSz, prm->size() - regionSz, 0LU, true, prm);
+}
+
 /*! Send objects from the current processes to the process one rank lower if
  *  such a process exists. Objects are taken from the start of a vector.
  *  Receiving processes put the objects at the end of their vector.
@@ -788,77 +799,7 @@ void sendRight(ExSeisPIOL* piol, size_t regionSz, Param* prm)
  */
 void sendLeft(ExSeisPIOL* piol, size_t regionSz, Param* prm)
 {
-    Param sprm(prm->r, regionSz);
-    Param rprm(prm->r, regionSz);
-
-    size_t rank = piol->comm->getRank();
-    std::vector<MPI_Request> rsnd(4);
-    std::vector<MPI_Request> rrcv(4);
-
-    // Lambda for wrapping an MPI call with logging.
-    auto log_on_error = [&piol](auto mpi_function, std::string function_name) {
-        return [=](auto&&... args) {
-            int err = mpi_function(std::forward<decltype(args)>(args)...);
-
-            if (err != MPI_SUCCESS) {
-                piol->log->record(
-                  "", Logger::Layer::Ops, Logger::Status::Error,
-                  function_name + " error: "s
-                    + exseis::utils::MPI_error_to_string(err),
-                  PIOL_VERBOSITY_NONE);
-            }
-        };
-    };
-
-    if (rank != 0) {
-        for (size_t i = 0; i < regionSz; i++) {
-            param_utils::cpyPrm(i, prm, i, &sprm);
-        }
-
-        log_on_error(
-          MPI_Isend, "Sort left exseis::utils::Floating_point MPI_Isend")(
-          sprm.f.data(), sprm.f.size() * sizeof(exseis::utils::Floating_point),
-          MPI_CHAR, rank - 1, 1, MPI_COMM_WORLD, &rsnd[0]);
-
-        log_on_error(MPI_Isend, "Sort left exseis::utils::Integer MPI_Isend")(
-          sprm.i.data(), sprm.i.size() * sizeof(exseis::utils::Integer),
-          MPI_CHAR, rank - 1, 1, MPI_COMM_WORLD, &rsnd[1]);
-
-        log_on_error(MPI_Isend, "Sort left short MPI_Isend")(
-          sprm.s.data(), sprm.s.size() * sizeof(short), MPI_CHAR, rank - 1, 1,
-          MPI_COMM_WORLD, &rsnd[2]);
-
-        log_on_error(MPI_Isend, "Sort left size_t MPI_Isend")(
-          sprm.t.data(), sprm.t.size() * sizeof(size_t), MPI_CHAR, rank - 1, 1,
-          MPI_COMM_WORLD, &rsnd[3]);
-    }
-
-    if (rank != piol->comm->getNumRank() - 1) {
-        log_on_error(
-          MPI_Irecv, "Sort left exseis::utils::Floating_point MPI_Irecv")(
-          rprm.f.data(), rprm.f.size() * sizeof(exseis::utils::Floating_point),
-          MPI_CHAR, rank + 1, 1, MPI_COMM_WORLD, &rrcv[0]);
-
-        log_on_error(MPI_Irecv, "Sort left exseis::utils::Integer MPI_Irecv")(
-          rprm.i.data(), rprm.i.size() * sizeof(exseis::utils::Integer),
-          MPI_CHAR, rank + 1, 1, MPI_COMM_WORLD, &rrcv[1]);
-
-        log_on_error(MPI_Irecv, "Sort left short MPI_Irecv")(
-          rprm.s.data(), rprm.s.size() * sizeof(short), MPI_CHAR, rank + 1, 1,
-          MPI_COMM_WORLD, &rrcv[2]);
-
-        log_on_error(MPI_Irecv, "Sort left size_t MPI_Irecv")(
-          rprm.t.data(), rprm.t.size() * sizeof(size_t), MPI_CHAR, rank + 1, 1,
-          MPI_COMM_WORLD, &rrcv[3]);
-    }
-
-    Wait(piol, rrcv, rsnd);
-
-    if (rank != piol->comm->getNumRank() - 1) {
-        for (size_t i = 0; i < regionSz; i++) {
-            param_utils::cpyPrm(i, &rprm, i + prm->size() - regionSz, prm);
-        }
-    }
+    exchangePrm(piol, regionSz, 0LU, prm->size() - regionSz, false, prm);
 }
 
 /// Sort the parameter structure across all processes
@@ -874,19 +815,19 @@ void sortP(ExSeisPIOL* piol, Param* prm, CompareP comp = nullptr)
     size_t edge1    = (rank != 0 ? regionSz : 0LU);
     size_t edge2    = (rank != numRank - 1 ? regionSz : 0LU);
 
+    // The comparison may read any column, so none is left to be decoded
+    // while sorting.
+    prm->decode();
+
     std::vector<size_t> t1(lnt);
     std::iota(t1.begin(), t1.end(), 0LU);
-    std::sort(t1.begin(), t1.end(), [prm, comp](size_t& a, size_t& b) -> bool {
-        return comp(prm, a, b);
-    });
+    std::sort(t1.begin(), t1.end(), bindComp(comp, prm));
 
-    Param temp1(prm->r, lnt + edge2);
-    Param temp2(temp1.r, temp1.size());
-    Param temp3(prm->r, temp1.size());
+    Param temp1(prm->r, lnt + edge2, false, prm->columnar);
+    Param temp2(temp1.r, temp1.size(), false, prm->columnar);
+    Param temp3(prm->r, temp1.size(), false, prm->columnar);
 
-    for (size_t i = 0; i < lnt; i++) {
-        param_utils::cpyPrm(t1[i], prm, i, &temp1);
-    }
+    param_utils::permutePrm(lnt, t1.data(), prm, 0LU, &temp1);
 
     // Infinite loop if there is more than one process, otherwise no loop
     while (numRank > 1) {
@@ -896,19 +837,10 @@ void sortP(ExSeisPIOL* piol, Param* prm, CompareP comp = nullptr)
         {
             std::vector<size_t> t1(temp1.size() - edge1);
             std::iota(t1.begin(), t1.end(), edge1);
-            std::sort(
-              t1.begin(), t1.end(),
-              [&temp1, comp](size_t& a, size_t& b) -> bool {
-                  return comp(&temp1, a, b);
-              });
+            std::sort(t1.begin(), t1.end(), bindComp(comp, &temp1));
 
-            for (size_t i = 0; i < t1.size(); i++) {
-                param_utils::cpyPrm(t1[i], &temp1, i, &temp3);
-            }
-
-            for (size_t i = 0; i < t1.size(); i++) {
-                param_utils::cpyPrm(i, &temp3, i + edge1, &temp1);
-            }
+            param_utils::permutePrm(t1.size(), t1.data(), &temp1, 0LU, &temp3);
+            param_utils::cpyPrm(0LU, &temp3, edge1, &temp1, t1.size());
         }
 
         sendRight(piol, regionSz, &temp1);
@@ -916,30 +848,17 @@ void sortP(ExSeisPIOL* piol, Param* prm, CompareP comp = nullptr)
         {
             std::vector<size_t> t1(temp1.size() - edge2);
             std::iota(t1.begin(), t1.end(), 0);
-            std::sort(
-              t1.begin(), t1.end(),
-              [&temp1, comp](size_t& a, size_t& b) -> bool {
-                  return comp(&temp1, a, b);
-              });
+            std::sort(t1.begin(), t1.end(), bindComp(comp, &temp1));
 
-            for (size_t i = 0; i < t1.size(); i++) {
-                param_utils::cpyPrm(t1[i], &temp1, i, &temp3);
-            }
-
-            for (size_t i = 0; i < t1.size(); i++) {
-                param_utils::cpyPrm(i, &temp3, i, &temp1);
-            }
+            param_utils::permutePrm(t1.size(), t1.data(), &temp1);
         }
 
+        const IntColumn gtn1(PIOL_META_gtn, &temp1);
+        const IntColumn gtn2(PIOL_META_gtn, &temp2);
+
         int reduced = 0;
         for (size_t j = 0; j < lnt && reduced == 0; j++) {
-            const auto param1 = param_utils::getPrm<exseis::utils::Integer>(
-              j, PIOL_META_gtn, &temp1);
-
-            const auto param2 = param_utils::getPrm<exseis::utils::Integer>(
-              j, PIOL_META_gtn, &temp2);
-
-            if (param1 != param2) {
+            if (gtn1[j] != gtn2[j]) {
                 reduced++;
             }
         }
@@ -961,9 +880,7 @@ void sortP(ExSeisPIOL* piol, Param* prm, CompareP comp = nullptr)
         }
     }
 
-    for (size_t i = 0; i < lnt; i++) {
-        param_utils::cpyPrm(i, &temp1, i, prm);
-    }
+    param_utils::cpyPrm(0LU, &temp1, 0LU, prm, lnt);
 }
 
 std::vector<size_t> sort(
@@ -971,9 +888,11 @@ std::vector<size_t> sort(
 {
     sortP(piol, prm, comp);
 
+    const SizeColumn gtn(PIOL_META_gtn, prm);
+
     std::vector<size_t> list(prm->size());
     for (size_t i = 0; i < prm->size(); i++) {
-        list[i] = param_utils::getPrm<size_t>(i, PIOL_META_gtn, prm);
+        list[i] = gtn[i];
     }
 
     return (FileOrder ? sort(piol, list) : list);
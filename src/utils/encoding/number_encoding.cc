@@ -70,13 +70,13 @@ Float_components from_IBM(
     //
     // In the IBM format, the leading 1 of the fraction is moved as far right as
     // possible. However, since it is using a base 16 exponent, up to 3 leading
-    // bits of the fraction can be zero.
+    // bits of the fraction can be zero, or more for unnormalized numbers.
     // We therefore, need to shift it left by 8 bits, plus those leading zeros.
     //
-    // We use a sneaky trick here: we use the 3 rightmost bits of the IBM
-    // fraction as a lookup for a table listing the offsets. Interpreted as an
-    // integer, these have the values:
-    //  000 -> 0  ---> needs offset of 3
+    // For normalized numbers we use the 3 leftmost bits of the IBM fraction as
+    // a lookup for a table listing the offsets. Interpreted as an integer,
+    // these have the values:
+    //  000 -> 0  ---> needs offset of 3 (or more)
     //  001 -> 1  ---> needs offset of 2
     //  010 -> 2  ---> needs offset of 1
     //  011 -> 3  ---> needs offset of 1
@@ -84,7 +84,10 @@ Float_components from_IBM(
     //
     const uint32_t offsets[]         = {3, 2, 1, 1, 0, 0, 0, 0};
     const uint32_t leading_frac_bits = frac >> 21;
-    const int32_t shift              = offsets[leading_frac_bits];
+    int32_t shift                    = offsets[leading_frac_bits];
+    while (((frac << shift) & 0x00800000) == 0) {
+        shift++;
+    }
 
     const uint32_t shifted_frac = frac << (8 + shift);
 
@@ -106,6 +109,13 @@ Float_components from_IBM(
 /// @returns The result of \c value >> \c shift, with round-half-even applied.
 static uint32_t rshift_with_rounding(uint32_t value, uint32_t shift)
 {
+    // Everything is shifted out, and at most half is truncated.
+    if (shift > 32) {
+        return 0;
+    }
+    if (shift == 32) {
+        return (value > 0x80000000 ? 1 : 0);
+    }
 
     // Get the part of the `value` that will be truncated. This will be the
     // last `shift` bits
@@ -169,6 +179,15 @@ float to_float(Float_components components)
     int32_t exp   = components.exponent;
     uint32_t frac = components.significand;
 
+    // A zero significand is zero, whatever the exponent.
+    if (frac == 0) {
+        const uint32_t int_zero = sign << 31;
+
+        float zero = 0;
+        std::memcpy(&zero, &int_zero, sizeof(float));
+        return zero;
+    }
+
 
     // An IEEE number is of the form
     // SCCC CCCC CQQQ QQQQ QQQQ QQQQ QQQQ QQQQ
@@ -235,8 +254,12 @@ float to_float(Float_components components)
         exp  = 0xFF;
     }
 
-    // Drop bit 24 of frac
-    frac = frac & 0x7FFFFF;
+    // Drop the implicit leading 1 of normal numbers. A denormalized number
+    // which rounded up to 0b1.000... keeps it, so adding it to the exponent
+    // below gives the smallest normal number.
+    if (exp != 0) {
+        frac = frac & 0x7FFFFF;
+    }
 
     // Make sure we've only got 8 bits for the exponent!
     exp = exp & 0xFF;
@@ -251,7 +274,7 @@ float to_float(Float_components components)
     exp <<= 23;
 
 
-    const uint32_t int_float = sign | exp | frac;
+    const uint32_t int_float = sign | (uint32_t(exp) + frac);
 
     float rval = 0;
     std::memcpy(&rval, &int_float, sizeof(float));
@@ -273,6 +296,74 @@ float from_IBM_to_float(
     return to_float(ibm_components);
 }
 
+
+std::array<unsigned char, 4> to_IBM_from_float(float value, bool is_big_endian)
+{
+    static_assert(
+      sizeof(float) == sizeof(uint32_t),
+      "to_IBM_from_float expects float and uint32_t to have the same size!");
+
+    uint32_t ieee_bits = 0;
+    std::memcpy(&ieee_bits, &value, sizeof(float));
+
+    const uint32_t sign = ieee_bits & 0x80000000;
+    const uint32_t abs  = ieee_bits & 0x7FFFFFFF;
+
+    const uint32_t ibm_bits = [=]() -> uint32_t {
+        // Zero, and the infinities and NaNs, which IBM can't represent.
+        if (abs == 0) {
+            return 0;
+        }
+        if (abs >= 0x7F800000) {
+            return sign | 0x7FFFFFFF;
+        }
+
+        // Write the number as significand * 2^exp, with the leading 1 of the
+        // significand at bit 23. Denormalized numbers are shifted up to put
+        // it there.
+        uint32_t significand = abs & 0x007FFFFF;
+        int32_t exp          = int32_t(abs >> 23) - 127 - 23;
+        if ((abs >> 23) == 0) {
+            exp = -126 - 23;
+            while ((significand & 0x00800000) == 0) {
+                significand <<= 1;
+                exp--;
+            }
+        }
+        else {
+            significand |= 0x00800000;
+        }
+
+        // The IBM number is frac * 16^(biased - 64 - 6), where frac is the
+        // 24 bit fraction. In powers of 2 the IBM exponent is therefore
+        // 4 * biased - 280, and must be a multiple of 4, so the significand
+        // is shifted right by up to 3 bits to round exp up to one.
+        //
+        // For floats, exp + 280 is in [108, 384], so the biased exponent
+        // is always within the 7 bits available.
+        const uint32_t biased_exp = uint32_t(exp + 280);
+        const uint32_t shift      = (4 - biased_exp % 4) % 4;
+
+        //
+        // The shifted significand is at most 2^(24 - shift), so rounding it
+        // up never carries out of the 24 bit fraction.
+        const uint32_t frac =
+          (shift == 0 ? significand : rshift_with_rounding(significand, shift));
+        const uint32_t ibm_exp = (biased_exp + shift) / 4;
+
+        return sign | (ibm_exp << 24) | frac;
+    }();
+
+    if (is_big_endian == true) {
+        return to_big_endian<uint32_t>(ibm_bits);
+    }
+
+    return {{static_cast<unsigned char>(ibm_bits >> 0),
+             static_cast<unsigned char>(ibm_bits >> 8),
+             static_cast<unsigned char>(ibm_bits >> 16),
+             static_cast<unsigned char>(ibm_bits >> 24)}};
+}
+
 }  // namespace number_encoding
 }  // namespace utils
 }  // namespace exseis
@@ -0,0 +1,703 @@
+////////////////////////////////////////////////////////////////////////////////
+///  @file
+///  @brief Bulk conversion of trace samples between big or little-endian
+///         IEEE, IBM and native floats, in both directions.
+///  @details Each routine has a scalar version and, on x86-64 with GCC or
+///           Clang, SSE4.1, AVX2 and AVX-512 versions built with function
+///           target attributes. The widest version the processor supports is
+///           chosen the first time one of the routines is called.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExSeisDat/utils/encoding/number_encoding.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EXSEISDAT_NUMBER_ENCODING_X86
+#include <immintrin.h>
+#endif
+
+namespace exseis {
+namespace utils {
+inline namespace number_encoding {
+
+namespace {
+
+/////////////////////////////////    Scalar    /////////////////////////////////
+
+/// Reverse the bytes of each 4 byte value.
+/// @param[in]  src The values
+/// @param[in]  n   The number of values
+/// @param[out] dst The reversed values
+void bswap32_scalar(const unsigned char* src, size_t n, unsigned char* dst)
+{
+    for (size_t i = 0; i < n; i++) {
+        const unsigned char b[4] = {src[4 * i + 0], src[4 * i + 1],
+                                    src[4 * i + 2], src[4 * i + 3]};
+        dst[4 * i + 0]           = b[3];
+        dst[4 * i + 1]           = b[2];
+        dst[4 * i + 2]           = b[1];
+        dst[4 * i + 3]           = b[0];
+    }
+}
+
+/// Convert IBM floats one at a time with \c from_IBM_to_float.
+/// @param[in]  src           The IBM floats
+/// @param[in]  n             The number of values
+/// @param[out] dst           The native floats
+/// @param[in]  is_big_endian True if the IBM floats are in big-endian order.
+void ibm_scalar(
+  const unsigned char* src, size_t n, float* dst, bool is_big_endian)
+{
+    for (size_t i = 0; i < n; i++) {
+        const float f = from_IBM_to_float(
+          {{src[4 * i + 0], src[4 * i + 1], src[4 * i + 2], src[4 * i + 3]}},
+          is_big_endian);
+        std::memcpy(&dst[i], &f, sizeof(float));
+    }
+}
+
+/// Convert native floats to IBM one at a time with \c to_IBM_from_float.
+/// @param[in]  src           The native floats
+/// @param[in]  n             The number of values
+/// @param[out] dst           The IBM floats
+/// @param[in]  is_big_endian True if the IBM floats should be in big-endian
+///                           order.
+void ibm_from_scalar(
+  const float* src, size_t n, unsigned char* dst, bool is_big_endian)
+{
+    for (size_t i = 0; i < n; i++) {
+        const auto b = to_IBM_from_float(src[i], is_big_endian);
+        std::copy(std::begin(b), std::end(b), &dst[4 * i]);
+    }
+}
+
+#ifdef EXSEISDAT_NUMBER_ENCODING_X86
+
+//////////////////////////////////    SSE4    //////////////////////////////////
+
+// The IBM kernels convert the 24 bit fraction to a float, which is exact, and
+// then add the power of two of the IBM exponent straight onto the IEEE
+// exponent. Results which are denormalized are scaled to a normal number
+// first and then multiplied by 2^-126, so the hardware rounds them just once.
+// The bit constants are:
+//  0x00FFFFFF the IBM fraction,
+//  0x7F800000 IEEE infinity,
+//  0x00800000 the IEEE float 2^-126,
+// and 4 * (e - 64) - 24 = 4 * e - 280 is the IBM exponent for an integer
+// fraction.
+//
+// The inverse kernels scale denormalized floats by 2^24 to normal numbers.
+// The IEEE exponent then gives the IBM exponent and the right shift of the
+// significand, from 0 to 3 bits, which makes the power of 2 a multiple of 4.
+// The significand, as a float with 23 - shift fraction bits above the binary
+// point, is converted to an integer, which rounds it half to even in the
+// default rounding mode. With IEEE bias 127, 127 + 23 = 150 and
+// 280 - 150 = 130.
+
+/// Reverse the bytes of each 4 byte value.
+/// @param[in]  src The values
+/// @param[in]  n   The number of values
+/// @param[out] dst The reversed values
+__attribute__((target("sse4.1"))) void bswap32_sse4(
+  const unsigned char* src, size_t n, unsigned char* dst)
+{
+    const __m128i rev =
+      _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i v =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[4 * i]));
+        _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(&dst[4 * i]), _mm_shuffle_epi8(v, rev));
+    }
+    bswap32_scalar(&src[4 * i], n - i, &dst[4 * i]);
+}
+
+/// Convert four IBM floats in native byte order to IEEE.
+/// @param[in] x The IBM floats
+/// @return The IEEE floats
+__attribute__((target("sse4.1"))) __m128i ibm_sse4(__m128i x)
+{
+    const __m128i frac = _mm_and_si128(x, _mm_set1_epi32(0x00FFFFFF));
+    const __m128i sign = _mm_andnot_si128(_mm_set1_epi32(0x7FFFFFFF), x);
+    const __m128i k    = _mm_sub_epi32(
+      _mm_slli_epi32(
+        _mm_and_si128(_mm_srli_epi32(x, 24), _mm_set1_epi32(0x7F)), 2),
+      _mm_set1_epi32(280));
+
+    const __m128i f   = _mm_castps_si128(_mm_cvtepi32_ps(frac));
+    const __m128i exp = _mm_add_epi32(_mm_srli_epi32(f, 23), k);
+
+    __m128i r = _mm_add_epi32(f, _mm_slli_epi32(k, 23));
+
+    const __m128 denorm = _mm_mul_ps(
+      _mm_castsi128_ps(_mm_add_epi32(
+        f, _mm_slli_epi32(_mm_add_epi32(k, _mm_set1_epi32(126)), 23))),
+      _mm_castsi128_ps(_mm_set1_epi32(0x00800000)));
+    r = _mm_blendv_epi8(
+      r, _mm_castps_si128(denorm), _mm_cmplt_epi32(exp, _mm_set1_epi32(1)));
+    r = _mm_andnot_si128(_mm_cmplt_epi32(exp, _mm_set1_epi32(-30)), r);
+    r = _mm_blendv_epi8(
+      r, _mm_set1_epi32(0x7F800000), _mm_cmpgt_epi32(exp, _mm_set1_epi32(254)));
+
+    r = _mm_or_si128(r, sign);
+    return _mm_andnot_si128(_mm_cmpeq_epi32(frac, _mm_setzero_si128()), r);
+}
+
+/// Convert IBM floats to native floats.
+/// @param[in]  src           The IBM floats
+/// @param[in]  n             The number of values
+/// @param[out] dst           The native floats
+/// @param[in]  is_big_endian True if the IBM floats are in big-endian order.
+__attribute__((target("sse4.1"))) void ibm_sse4(
+  const unsigned char* src, size_t n, float* dst, bool is_big_endian)
+{
+    const __m128i rev =
+      _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[4 * i]));
+        if (is_big_endian) {
+            v = _mm_shuffle_epi8(v, rev);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[i]), ibm_sse4(v));
+    }
+    ibm_scalar(&src[4 * i], n - i, &dst[i], is_big_endian);
+}
+
+/// Convert four native floats to IBM floats in native byte order.
+/// @param[in] x The IEEE floats
+/// @return The IBM floats
+__attribute__((target("sse4.1"))) __m128i ibm_from_sse4(__m128i x)
+{
+    const __m128i sign = _mm_andnot_si128(_mm_set1_epi32(0x7FFFFFFF), x);
+    const __m128i a    = _mm_and_si128(x, _mm_set1_epi32(0x7FFFFFFF));
+
+    const __m128i den = _mm_cmplt_epi32(a, _mm_set1_epi32(0x00800000));
+    const __m128i n   = _mm_blendv_epi8(
+      a,
+      _mm_castps_si128(
+        _mm_mul_ps(_mm_castsi128_ps(a), _mm_set1_ps(16777216.0f))),
+      den);
+
+    const __m128i biased = _mm_sub_epi32(
+      _mm_add_epi32(_mm_srli_epi32(n, 23), _mm_set1_epi32(130)),
+      _mm_and_si128(den, _mm_set1_epi32(24)));
+    const __m128i shift = _mm_and_si128(
+      _mm_sub_epi32(_mm_setzero_si128(), biased), _mm_set1_epi32(3));
+
+    const __m128i frac = _mm_cvtps_epi32(_mm_castsi128_ps(_mm_or_si128(
+      _mm_slli_epi32(_mm_sub_epi32(_mm_set1_epi32(150), shift), 23),
+      _mm_and_si128(n, _mm_set1_epi32(0x007FFFFF)))));
+    const __m128i exp = _mm_srli_epi32(_mm_add_epi32(biased, shift), 2);
+
+    __m128i r = _mm_or_si128(_mm_slli_epi32(exp, 24), frac);
+    r         = _mm_blendv_epi8(
+      r, _mm_set1_epi32(0x7FFFFFFF),
+      _mm_cmpgt_epi32(a, _mm_set1_epi32(0x7F7FFFFF)));
+
+    r = _mm_or_si128(r, sign);
+    return _mm_andnot_si128(_mm_cmpeq_epi32(a, _mm_setzero_si128()), r);
+}
+
+/// Convert native floats to IBM floats.
+/// @param[in]  src           The native floats
+/// @param[in]  n             The number of values
+/// @param[out] dst           The IBM floats
+/// @param[in]  is_big_endian True if the IBM floats should be in big-endian
+///                           order.
+__attribute__((target("sse4.1"))) void ibm_from_sse4(
+  const float* src, size_t n, unsigned char* dst, bool is_big_endian)
+{
+    const __m128i rev =
+      _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = ibm_from_sse4(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i])));
+        if (is_big_endian) {
+            v = _mm_shuffle_epi8(v, rev);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[4 * i]), v);
+    }
+    ibm_from_scalar(&src[i], n - i, &dst[4 * i], is_big_endian);
+}
+
+//////////////////////////////////    AVX2    //////////////////////////////////
+
+/// Reverse the bytes of each 4 byte value.
+/// @param[in]  src The values
+/// @param[in]  n   The number of values
+/// @param[out] dst The reversed values
+__attribute__((target("avx2"))) void bswap32_avx2(
+  const unsigned char* src, size_t n, unsigned char* dst)
+{
+    const __m256i rev = _mm256_setr_epi8(
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5,
+      4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[4 * i]));
+        _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(&dst[4 * i]), _mm256_shuffle_epi8(v, rev));
+    }
+    bswap32_scalar(&src[4 * i], n - i, &dst[4 * i]);
+}
+
+/// Convert eight IBM floats in native byte order to IEEE.
+/// @param[in] x The IBM floats
+/// @return The IEEE floats
+__attribute__((target("avx2"))) __m256i ibm_avx2(__m256i x)
+{
+    const __m256i frac = _mm256_and_si256(x, _mm256_set1_epi32(0x00FFFFFF));
+    const __m256i sign = _mm256_andnot_si256(_mm256_set1_epi32(0x7FFFFFFF), x);
+    const __m256i k    = _mm256_sub_epi32(
+      _mm256_slli_epi32(
+        _mm256_and_si256(_mm256_srli_epi32(x, 24), _mm256_set1_epi32(0x7F)),
+        2),
+      _mm256_set1_epi32(280));
+
+    const __m256i f   = _mm256_castps_si256(_mm256_cvtepi32_ps(frac));
+    const __m256i exp = _mm256_add_epi32(_mm256_srli_epi32(f, 23), k);
+
+    __m256i r = _mm256_add_epi32(f, _mm256_slli_epi32(k, 23));
+
+    const __m256 denorm = _mm256_mul_ps(
+      _mm256_castsi256_ps(_mm256_add_epi32(
+        f,
+        _mm256_slli_epi32(_mm256_add_epi32(k, _mm256_set1_epi32(126)), 23))),
+      _mm256_castsi256_ps(_mm256_set1_epi32(0x00800000)));
+    r = _mm256_blendv_epi8(
+      r, _mm256_castps_si256(denorm),
+      _mm256_cmpgt_epi32(_mm256_set1_epi32(1), exp));
+    r = _mm256_andnot_si256(
+      _mm256_cmpgt_epi32(_mm256_set1_epi32(-30), exp), r);
+    r = _mm256_blendv_epi8(
+      r, _mm256_set1_epi32(0x7F800000),
+      _mm256_cmpgt_epi32(exp, _mm256_set1_epi32(254)));
+
+    r = _mm256_or_si256(r, sign);
+    return _mm256_andnot_si256(
+      _mm256_cmpeq_epi32(frac, _mm256_setzero_si256()), r);
+}
+
+/// Convert IBM floats to native floats.
+/// @param[in]  src           The IBM floats
+/// @param[in]  n             The number of values
+/// @param[out] dst           The native floats
+/// @param[in]  is_big_endian True if the IBM floats are in big-endian order.
+__attribute__((target("avx2"))) void ibm_avx2(
+  const unsigned char* src, size_t n, float* dst, bool is_big_endian)
+{
+    const __m256i rev = _mm256_setr_epi8(
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5,
+      4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[4 * i]));
+        if (is_big_endian) {
+            v = _mm256_shuffle_epi8(v, rev);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dst[i]), ibm_avx2(v));
+    }
+    ibm_sse4(&src[4 * i], n - i, &dst[i], is_big_endian);
+}
+
+/// Convert eight native floats to IBM floats in native byte order.
+/// @param[in] x The IEEE floats
+/// @return The IBM floats
+__attribute__((target("avx2"))) __m256i ibm_from_avx2(__m256i x)
+{
+    const __m256i sign = _mm256_andnot_si256(_mm256_set1_epi32(0x7FFFFFFF), x);
+    const __m256i a    = _mm256_and_si256(x, _mm256_set1_epi32(0x7FFFFFFF));
+
+    const __m256i den = _mm256_cmpgt_epi32(_mm256_set1_epi32(0x00800000), a);
+    const __m256i n   = _mm256_blendv_epi8(
+      a,
+      _mm256_castps_si256(
+        _mm256_mul_ps(_mm256_castsi256_ps(a), _mm256_set1_ps(16777216.0f))),
+      den);
+
+    const __m256i biased = _mm256_sub_epi32(
+      _mm256_add_epi32(_mm256_srli_epi32(n, 23), _mm256_set1_epi32(130)),
+      _mm256_and_si256(den, _mm256_set1_epi32(24)));
+    const __m256i shift = _mm256_and_si256(
+      _mm256_sub_epi32(_mm256_setzero_si256(), biased), _mm256_set1_epi32(3));
+
+    const __m256i frac = _mm256_cvtps_epi32(_mm256_castsi256_ps(_mm256_or_si256(
+      _mm256_slli_epi32(_mm256_sub_epi32(_mm256_set1_epi32(150), shift), 23),
+      _mm256_and_si256(n, _mm256_set1_epi32(0x007FFFFF)))));
+    const __m256i exp = _mm256_srli_epi32(_mm256_add_epi32(biased, shift), 2);
+
+    __m256i r = _mm256_or_si256(_mm256_slli_epi32(exp, 24), frac);
+    r         = _mm256_blendv_epi8(
+      r, _mm256_set1_epi32(0x7FFFFFFF),
+      _mm256_cmpgt_epi32(a, _mm256_set1_epi32(0x7F7FFFFF)));
+
+    r = _mm256_or_si256(r, sign);
+    return _mm256_andnot_si256(
+      _mm256_cmpeq_epi32(a, _mm256_setzero_si256()), r);
+}
+
+/// Convert native floats to IBM floats.
+/// @param[in]  src           The native floats
+/// @param[in]  n             The number of values
+/// @param[out] dst           The IBM floats
+/// @param[in]  is_big_endian True if the IBM floats should be in big-endian
+///                           order.
+__attribute__((target("avx2"))) void ibm_from_avx2(
+  const float* src, size_t n, unsigned char* dst, bool is_big_endian)
+{
+    const __m256i rev = _mm256_setr_epi8(
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5,
+      4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = ibm_from_avx2(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i])));
+        if (is_big_endian) {
+            v = _mm256_shuffle_epi8(v, rev);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dst[4 * i]), v);
+    }
+    ibm_from_sse4(&src[i], n - i, &dst[4 * i], is_big_endian);
+}
+
+/////////////////////////////////    AVX-512    ////////////////////////////////
+
+/// Reverse the bytes of each 4 byte value.
+/// @param[in]  src The values
+/// @param[in]  n   The number of values
+/// @param[out] dst The reversed values
+__attribute__((target("avx512f,avx512bw"))) void bswap32_avx512(
+  const unsigned char* src, size_t n, unsigned char* dst)
+{
+    const __m512i rev = _mm512_broadcast_i32x4(
+      _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512i v = _mm512_loadu_si512(&src[4 * i]);
+        _mm512_storeu_si512(&dst[4 * i], _mm512_shuffle_epi8(v, rev));
+    }
+
+    // The tail is done with a masked load and store.
+    const __mmask16 tail = __mmask16((1U << (n - i)) - 1U);
+    const __m512i v      = _mm512_maskz_loadu_epi32(tail, &src[4 * i]);
+    _mm512_mask_storeu_epi32(&dst[4 * i], tail, _mm512_shuffle_epi8(v, rev));
+}
+
+/// Convert sixteen IBM floats in native byte order to IEEE.
+/// @param[in] x The IBM floats
+/// @return The IEEE floats
+__attribute__((target("avx512f,avx512bw"))) __m512i ibm_avx512(__m512i x)
+{
+    const __m512i frac = _mm512_and_si512(x, _mm512_set1_epi32(0x00FFFFFF));
+    const __m512i sign = _mm512_andnot_si512(_mm512_set1_epi32(0x7FFFFFFF), x);
+    const __m512i k    = _mm512_sub_epi32(
+      _mm512_slli_epi32(
+        _mm512_and_si512(_mm512_srli_epi32(x, 24), _mm512_set1_epi32(0x7F)),
+        2),
+      _mm512_set1_epi32(280));
+
+    const __m512i f   = _mm512_castps_si512(_mm512_cvtepi32_ps(frac));
+    const __m512i exp = _mm512_add_epi32(_mm512_srli_epi32(f, 23), k);
+
+    __m512i r = _mm512_add_epi32(f, _mm512_slli_epi32(k, 23));
+
+    const __m512 denorm = _mm512_mul_ps(
+      _mm512_castsi512_ps(_mm512_add_epi32(
+        f,
+        _mm512_slli_epi32(_mm512_add_epi32(k, _mm512_set1_epi32(126)), 23))),
+      _mm512_castsi512_ps(_mm512_set1_epi32(0x00800000)));
+    r = _mm512_mask_blend_epi32(
+      _mm512_cmplt_epi32_mask(exp, _mm512_set1_epi32(1)), r,
+      _mm512_castps_si512(denorm));
+    r = _mm512_maskz_mov_epi32(
+      _mm512_cmpge_epi32_mask(exp, _mm512_set1_epi32(-30)), r);
+    r = _mm512_mask_blend_epi32(
+      _mm512_cmpgt_epi32_mask(exp, _mm512_set1_epi32(254)), r,
+      _mm512_set1_epi32(0x7F800000));
+
+    r = _mm512_or_si512(r, sign);
+    return _mm512_maskz_mov_epi32(_mm512_test_epi32_mask(frac, frac), r);
+}
+
+/// Convert IBM floats to native floats.
+/// @param[in]  src           The IBM floats
+/// @param[in]  n             The number of values
+/// @param[out] dst           The native floats
+/// @param[in]  is_big_endian True if the IBM floats are in big-endian order.
+__attribute__((target("avx512f,avx512bw"))) void ibm_avx512(
+  const unsigned char* src, size_t n, float* dst, bool is_big_endian)
+{
+    const __m512i rev = _mm512_broadcast_i32x4(
+      _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+
+    for (size_t i = 0; i < n; i += 16) {
+        const __mmask16 mask =
+          (n - i >= 16 ? __mmask16(0xFFFF) : __mmask16((1U << (n - i)) - 1U));
+
+        __m512i v = _mm512_maskz_loadu_epi32(mask, &src[4 * i]);
+        if (is_big_endian) {
+            v = _mm512_shuffle_epi8(v, rev);
+        }
+        _mm512_mask_storeu_epi32(&dst[i], mask, ibm_avx512(v));
+    }
+}
+
+/// Convert sixteen native floats to IBM floats in native byte order.
+/// @param[in] x The IEEE floats
+/// @return The IBM floats
+__attribute__((target("avx512f,avx512bw"))) __m512i ibm_from_avx512(__m512i x)
+{
+    const __m512i sign = _mm512_andnot_si512(_mm512_set1_epi32(0x7FFFFFFF), x);
+    const __m512i a    = _mm512_and_si512(x, _mm512_set1_epi32(0x7FFFFFFF));
+
+    const __mmask16 den =
+      _mm512_cmplt_epi32_mask(a, _mm512_set1_epi32(0x00800000));
+    const __m512i n = _mm512_mask_blend_epi32(
+      den, a,
+      _mm512_castps_si512(
+        _mm512_mul_ps(_mm512_castsi512_ps(a), _mm512_set1_ps(16777216.0f))));
+
+    __m512i biased =
+      _mm512_add_epi32(_mm512_srli_epi32(n, 23), _mm512_set1_epi32(130));
+    biased = _mm512_mask_sub_epi32(biased, den, biased, _mm512_set1_epi32(24));
+    const __m512i shift = _mm512_and_si512(
+      _mm512_sub_epi32(_mm512_setzero_si512(), biased), _mm512_set1_epi32(3));
+
+    const __m512i frac = _mm512_cvtps_epi32(_mm512_castsi512_ps(_mm512_or_si512(
+      _mm512_slli_epi32(_mm512_sub_epi32(_mm512_set1_epi32(150), shift), 23),
+      _mm512_and_si512(n, _mm512_set1_epi32(0x007FFFFF)))));
+    const __m512i exp = _mm512_srli_epi32(_mm512_add_epi32(biased, shift), 2);
+
+    __m512i r = _mm512_or_si512(_mm512_slli_epi32(exp, 24), frac);
+    r         = _mm512_mask_blend_epi32(
+      _mm512_cmpgt_epi32_mask(a, _mm512_set1_epi32(0x7F7FFFFF)), r,
+      _mm512_set1_epi32(0x7FFFFFFF));
+
+    r = _mm512_or_si512(r, sign);
+    return _mm512_maskz_mov_epi32(_mm512_test_epi32_mask(a, a), r);
+}
+
+/// Convert native floats to IBM floats.
+/// @param[in]  src           The native floats
+/// @param[in]  n             The number of values
+/// @param[out] dst           The IBM floats
+/// @param[in]  is_big_endian True if the IBM floats should be in big-endian
+///                           order.
+__attribute__((target("avx512f,avx512bw"))) void ibm_from_avx512(
+  const float* src, size_t n, unsigned char* dst, bool is_big_endian)
+{
+    const __m512i rev = _mm512_broadcast_i32x4(
+      _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+
+    for (size_t i = 0; i < n; i += 16) {
+        const __mmask16 mask =
+          (n - i >= 16 ? __mmask16(0xFFFF) : __mmask16((1U << (n - i)) - 1U));
+
+        __m512i v = ibm_from_avx512(_mm512_maskz_loadu_epi32(mask, &src[i]));
+        if (is_big_endian) {
+            v = _mm512_shuffle_epi8(v, rev);
+        }
+        _mm512_mask_storeu_epi32(&dst[4 * i], mask, v);
+    }
+}
+
+#endif  // EXSEISDAT_NUMBER_ENCODING_X86
+
+//////////////////////////////////  Dispatch  //////////////////////////////////
+
+/// The widest instruction set supported by the build and the processor.
+/// @return The instruction set
+Simd_level detect_simd_level()
+{
+#ifdef EXSEISDAT_NUMBER_ENCODING_X86
+    __builtin_cpu_init();
+    if (
+      __builtin_cpu_supports("avx512f")
+      && __builtin_cpu_supports("avx512bw")) {
+        return Simd_level::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return Simd_level::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return Simd_level::SSE4;
+    }
+#endif
+    return Simd_level::Scalar;
+}
+
+/// The instruction set in use. It is found on first use.
+/// @return A reference to the instruction set
+Simd_level& current_simd_level()
+{
+    static Simd_level level = detect_simd_level();
+    return level;
+}
+
+}  // namespace
+
+
+Simd_level simd_level()
+{
+    return current_simd_level();
+}
+
+Simd_level set_simd_level(Simd_level level)
+{
+    current_simd_level() = std::min(level, detect_simd_level());
+    return current_simd_level();
+}
+
+/// Reverse the bytes of each 4 byte value with the widest instruction set.
+/// @param[in]  src The values
+/// @param[in]  n   The number of values
+/// @param[out] dst The reversed values
+static void bswap32_n(const unsigned char* src, size_t n, unsigned char* dst)
+{
+    switch (current_simd_level()) {
+#ifdef EXSEISDAT_NUMBER_ENCODING_X86
+        case Simd_level::AVX512:
+            bswap32_avx512(src, n, dst);
+            return;
+        case Simd_level::AVX2:
+            bswap32_avx2(src, n, dst);
+            return;
+        case Simd_level::SSE4:
+            bswap32_sse4(src, n, dst);
+            return;
+#endif
+        default:
+            bswap32_scalar(src, n, dst);
+            return;
+    }
+}
+
+/// Put big-endian 4 byte values in host order. On a big-endian host they are
+/// copied, unless \c src and \c dst are the same memory.
+/// @param[in]  src The values
+/// @param[in]  n   The number of values
+/// @param[out] dst The values in host order
+static void from_big_endian32_n(
+  const unsigned char* src, size_t n, unsigned char* dst)
+{
+    if (is_little_endian_host()) {
+        bswap32_n(src, n, dst);
+    }
+    else if (src != dst) {
+        std::memcpy(dst, src, 4 * n);
+    }
+}
+
+void from_big_endian_n(const unsigned char* src, size_t n, float* dst)
+{
+    static_assert(
+      sizeof(float) == sizeof(uint32_t),
+      "from_big_endian_n expects float and uint32_t to have the same size!");
+
+    from_big_endian32_n(src, n, reinterpret_cast<unsigned char*>(dst));
+}
+
+void to_big_endian_n(const float* src, size_t n, unsigned char* dst)
+{
+    static_assert(
+      sizeof(float) == sizeof(uint32_t),
+      "to_big_endian_n expects float and uint32_t to have the same size!");
+
+    from_big_endian32_n(reinterpret_cast<const unsigned char*>(src), n, dst);
+}
+
+/// Put little-endian 4 byte values in host order. On a little-endian host
+/// they are copied, unless \c src and \c dst are the same memory.
+/// @param[in]  src The values
+/// @param[in]  n   The number of values
+/// @param[out] dst The values in host order
+static void from_little_endian32_n(
+  const unsigned char* src, size_t n, unsigned char* dst)
+{
+    if (!is_little_endian_host()) {
+        bswap32_n(src, n, dst);
+    }
+    else if (src != dst) {
+        std::memcpy(dst, src, 4 * n);
+    }
+}
+
+void from_little_endian_n(const unsigned char* src, size_t n, float* dst)
+{
+    static_assert(
+      sizeof(float) == sizeof(uint32_t),
+      "from_little_endian_n expects float and uint32_t to have the same size!");
+
+    from_little_endian32_n(src, n, reinterpret_cast<unsigned char*>(dst));
+}
+
+void to_little_endian_n(const float* src, size_t n, unsigned char* dst)
+{
+    static_assert(
+      sizeof(float) == sizeof(uint32_t),
+      "to_little_endian_n expects float and uint32_t to have the same size!");
+
+    from_little_endian32_n(
+      reinterpret_cast<const unsigned char*>(src), n, dst);
+}
+
+void from_IBM_to_float_n(
+  const unsigned char* src, size_t n, float* dst, bool is_big_endian)
+{
+    switch (current_simd_level()) {
+#ifdef EXSEISDAT_NUMBER_ENCODING_X86
+        case Simd_level::AVX512:
+            ibm_avx512(src, n, dst, is_big_endian);
+            return;
+        case Simd_level::AVX2:
+            ibm_avx2(src, n, dst, is_big_endian);
+            return;
+        case Simd_level::SSE4:
+            ibm_sse4(src, n, dst, is_big_endian);
+            return;
+#endif
+        default:
+            ibm_scalar(src, n, dst, is_big_endian);
+            return;
+    }
+}
+
+void to_IBM_from_float_n(
+  const float* src, size_t n, unsigned char* dst, bool is_big_endian)
+{
+    switch (current_simd_level()) {
+#ifdef EXSEISDAT_NUMBER_ENCODING_X86
+        case Simd_level::AVX512:
+            ibm_from_avx512(src, n, dst, is_big_endian);
+            return;
+        case Simd_level::AVX2:
+            ibm_from_avx2(src, n, dst, is_big_endian);
+            return;
+        case Simd_level::SSE4:
+            ibm_from_sse4(src, n, dst, is_big_endian);
+            return;
+#endif
+        default:
+            ibm_from_scalar(src, n, dst, is_big_endian);
+            return;
+    }
+}
+
+}  // namespace number_encoding
+}  // namespace utils
+}  // namespace exseis
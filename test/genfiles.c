@@ -128,7 +128,7 @@ void makeSEGY(const char* filename, size_t ns, size_t nt, size_t maxBlock)
 
         // Sample data format code (5 = 4-byte IEEE)
         unsigned char format = 5;
-        fseek(file, 3225U - 1, SEEK_SET);
+        fseek(file, 3226U - 1, SEEK_SET);
         fwrite(&format, sizeof(unsigned char), 1U, file);
 
         // Number of samples per data trace
@@ -0,0 +1,139 @@
+#include "datampiiotest.hh"
+
+#include "ExSeisDat/PIOL/DataAggregate.hh"
+#include "ExSeisDat/PIOL/ObjectSEGY.hh"
+#include "ExSeisDat/PIOL/ReadDirect.hh"
+#include "ExSeisDat/PIOL/ReadSEGY.hh"
+
+// The aggregating data layer is checked with the same read/write patterns used
+// for the MPI-IO data layer. Every process of a node shares the reads of the
+// node's aggregator.
+class AggregateTest : public MPIIOTest {
+  protected:
+    DataAggregate::Opt aggopt;
+
+    template<bool WRITE = false>
+    void makeAggregate(std::string name)
+    {
+        if (data != nullptr) {
+            data.reset();
+        }
+
+        FileMode mode = (WRITE ? FileMode::Test : FileMode::Read);
+        data = std::make_shared<DataAggregate>(piol, name, aggopt, mode);
+    }
+};
+
+TEST_F(AggregateTest, Constructor)
+{
+    makeAggregate(zeroFile);
+    piol->isErr();
+
+    auto agg = std::dynamic_pointer_cast<DataAggregate>(data);
+    ASSERT_NE(nullptr, agg) << "Aggregate data cast failed";
+    EXPECT_EQ(static_cast<size_t>(0), data->getFileSz());
+    EXPECT_LE(1U, piol->comm->sum(agg->isAggregator() ? 1U : 0U));
+}
+
+TEST_F(AggregateTest, ReadBlocksSSS)
+{
+    makeAggregate(smallSEGYFile);
+    readSmallBlocks<true>(400U, 261U);
+    readBigBlocks<true>(400U, 261U);
+    piol->isErr();
+}
+
+TEST_F(AggregateTest, ReadListZero)
+{
+    makeAggregate(smallSEGYFile);
+    readList(0, 0, NULL);
+    piol->isErr();
+}
+
+TEST_F(AggregateTest, ReadListSmall)
+{
+    makeAggregate(smallSEGYFile);
+    auto vec = getRandomVec(200U, 400U, 1337);
+    readList(200U, 261U, vec.data());
+    piol->isErr();
+}
+
+TEST_F(AggregateTest, ReadListRounds)
+{
+    // A tiny window needs a round per block
+    aggopt.windowSz = 1U;
+    makeAggregate(smallSEGYFile);
+    auto vec = getRandomVec(50U, 400U, 1337 + piol->comm->getRank());
+    readList(50U, 261U, vec.data());
+    piol->isErr();
+}
+
+TEST_F(AggregateTest, ReadListUneven)
+{
+    // Processes read different numbers of blocks, some none at all.
+    makeAggregate(largeSEGYFile);
+    const size_t rank = piol->comm->getRank();
+    auto vec          = getRandomVec(100U * rank, 2000U, 1337 + rank);
+    readList(vec.size(), 1000U, vec.data());
+    piol->isErr();
+}
+
+TEST_F(AggregateTest, ReadListMixedBlockSz)
+{
+    // Processes of a node read different lengths from the start of each
+    // data-field, so the node reads blocks of the largest length.
+    makeAggregate(largeSEGYFile);
+    const size_t rank = piol->comm->getRank();
+    const size_t ns   = 1000U;
+    const size_t rns  = ns - 100U * (rank % 3U);
+    const size_t bsz  = SEGY_utils::getDFSz(rns);
+    auto vec          = getRandomVec(100U, 2000U, 1337 + rank);
+
+    std::vector<size_t> boffset(vec.size());
+    for (size_t i = 0; i < vec.size(); i++) {
+        boffset[i] = SEGY_utils::getDODFLoc<float>(vec[i], ns);
+    }
+    std::vector<unsigned char> d(bsz * vec.size());
+    data->read(bsz, vec.size(), boffset.data(), d.data());
+    piol->isErr();
+
+    for (size_t i = 0; i < vec.size(); i++) {
+        for (size_t k = 0; k < rns; k++) {
+            const float f = vec[i] + k;
+            uint32_t n    = 0;
+            std::memcpy(&n, &f, sizeof(uint32_t));
+            ASSERT_EQ(
+              n, from_big_endian<uint32_t>(
+                   d[bsz * i + 4 * k + 0], d[bsz * i + 4 * k + 1],
+                   d[bsz * i + 4 * k + 2], d[bsz * i + 4 * k + 3]))
+              << i << " " << k;
+        }
+    }
+}
+
+TEST_F(AggregateTest, FileReadTraceNonContiguous)
+{
+    // The aggregating layer is selected through the data options
+    ReadDirect file(
+      piol, largeSEGYFile, aggopt, ObjectSEGY::Opt(), ReadSEGY::Opt());
+    piol->isErr();
+
+    const size_t ns = file.readNs();
+    auto vec        = getRandomVec(100U, 2000U, 1337 + piol->comm->getRank());
+    std::vector<exseis::utils::Trace_value> trc(vec.size() * ns);
+    file.readTraceNonContiguous(vec.size(), vec.data(), trc.data());
+    piol->isErr();
+
+    for (size_t i = 0; i < vec.size(); i++) {
+        for (size_t k = 0; k < ns; k++) {
+            ASSERT_EQ(float(vec[i] + k), trc[i * ns + k]) << i << " " << k;
+        }
+    }
+}
+
+TEST_F(AggregateTest, WriteListSmall)
+{
+    makeAggregate<true>(tempFile);
+    writeList(400U, 261U);
+    piol->isErr();
+}
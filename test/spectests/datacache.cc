@@ -0,0 +1,249 @@
+#include "datampiiotest.hh"
+
+#include "ExSeisDat/PIOL/DataCache.hh"
+#include "ExSeisDat/PIOL/ObjectInterface.hh"
+
+// The caching data layer is checked with the same read/write patterns used for
+// the MPI-IO data layer, with an MPI-IO layer underneath.
+class CacheTest : public MPIIOTest {
+  protected:
+    BlockCache::Opt cacheopt;
+    std::shared_ptr<BlockCache> cache = nullptr;
+
+    template<bool WRITE = false>
+    void makeCache(std::string name)
+    {
+        if (cache == nullptr) {
+            cache = std::make_shared<BlockCache>(cacheopt);
+        }
+
+        makeMPIIO<WRITE>(name);
+        data = std::make_shared<DataCache>(piol, name, data, cache);
+    }
+};
+
+TEST_F(CacheTest, Constructor)
+{
+    makeCache(zeroFile);
+    piol->isErr();
+
+    EXPECT_EQ(zeroFile, data->name());
+    EXPECT_EQ(static_cast<size_t>(0), data->getFileSz());
+    EXPECT_EQ(cache, std::dynamic_pointer_cast<DataCache>(data)->getCache());
+}
+
+TEST_F(CacheTest, ReadContigSSS)
+{
+    // The blocks divide the file exactly, so none of them is short
+    cacheopt.blockSz = 1200U;
+    makeCache(smallSEGYFile);
+    readSmallBlocks<false>(400U, 261U);
+    const size_t misses = cache->getMisses();
+    EXPECT_EQ(0U, cache->getHits());
+
+    // The second pass is served from memory
+    readSmallBlocks<false>(400U, 261U);
+    EXPECT_EQ(misses, cache->getMisses());
+    EXPECT_EQ(misses, cache->getHits());
+    EXPECT_EQ(400U * SEGY_utils::getDOSz(261U), cache->getBytesSaved());
+    piol->isErr();
+}
+
+TEST_F(CacheTest, ReadContigEnd)
+{
+    makeCache(smallSEGYFile);
+    readSmallBlocks<false>(400U * 1024U, 261U, 200U);
+    piol->isErr();
+}
+
+TEST_F(CacheTest, ReadShortBlock)
+{
+    // The last block runs past the end of the file, so it is not kept
+    cacheopt.blockSz = 4096U;
+    makeCache(smallSEGYFile);
+    std::vector<unsigned char> d(100U);
+    data->read(data->getFileSz() - 100U, 100U, d.data());
+    EXPECT_EQ(0U, cache->size());
+
+    data->read(0U, 100U, d.data());
+    data->read(0U, 100U, d.data());
+    EXPECT_EQ(1U, cache->size());
+    EXPECT_EQ(100U, cache->getBytesSaved());
+    piol->isErr();
+}
+
+TEST_F(CacheTest, ReadLargerThanCache)
+{
+    // A read spanning more blocks than fit goes straight through
+    cacheopt.blockSz = 1000U;
+    cacheopt.budget  = 10000U;
+    makeCache(smallSEGYFile);
+    readSmallBlocks<false>(400U, 261U);
+    EXPECT_EQ(0U, cache->size());
+    EXPECT_EQ(0U, cache->getMisses());
+    piol->isErr();
+}
+
+TEST_F(CacheTest, ReadBlocksSSS)
+{
+    // Every block holds the start of a trace header and none is short
+    cacheopt.blockSz = 4310U;
+    makeCache(smallSEGYFile);
+    readSmallBlocks<true>(400U, 261U);
+    const size_t misses = cache->getMisses();
+
+    // The data-fields lie in the blocks already read for the headers
+    readBigBlocks<true>(400U, 261U);
+    readSmallBlocks<true>(400U, 261U);
+    EXPECT_EQ(misses, cache->getMisses());
+    EXPECT_LT(0U, cache->getHits());
+    piol->isErr();
+}
+
+TEST_F(CacheTest, ReadBlocksEnd)
+{
+    makeCache(smallSEGYFile);
+    readSmallBlocks<true>(400U * 1024U, 261U, 200U);
+    piol->isErr();
+}
+
+TEST_F(CacheTest, ReadBlocksSmallBudget)
+{
+    // Only two blocks fit, so each read evicts the oldest block
+    cacheopt.blockSz = 1000U;
+    cacheopt.budget  = 2000U;
+    makeCache(smallSEGYFile);
+    for (size_t i = 0; i < 10U; i++) {
+        readSmallBlocks<true>(1U, 261U, i);
+    }
+    EXPECT_EQ(2U, cache->size());
+    EXPECT_EQ(0U, cache->getHits());
+    readSmallBlocks<true>(1U, 261U, 9U);
+    EXPECT_LT(0U, cache->getHits());
+    piol->isErr();
+}
+
+TEST_F(CacheTest, ReadListSmall)
+{
+    cacheopt.blockSz = 512U;
+    makeCache(smallSEGYFile);
+    auto vec = getRandomVec(200U, 400U, 1337);
+    readList(200U, 261U, vec.data());
+    readList(200U, 261U, vec.data());
+    EXPECT_LT(0U, cache->getHits());
+    piol->isErr();
+}
+
+TEST_F(CacheTest, SharedBetweenFiles)
+{
+    cacheopt.blockSz = 1200U;
+    makeCache(smallSEGYFile);
+    readSmallBlocks<false>(400U, 261U);
+    const size_t misses = cache->getMisses();
+
+    // A later data layer on the same file uses the blocks of the first
+    makeCache(smallSEGYFile);
+    readSmallBlocks<false>(400U, 261U);
+    EXPECT_EQ(misses, cache->getMisses());
+    EXPECT_EQ(misses, cache->getHits());
+    piol->isErr();
+}
+
+TEST_F(CacheTest, DefaultObject)
+{
+    // Files opened for reading with the default layers use the PIOL cache
+    piol->blockCache = std::make_shared<BlockCache>(cacheopt);
+    auto obj = makeDefaultObj(piol, smallSEGYFile, FileMode::Read);
+
+    std::vector<unsigned char> md(400U * SEGY_utils::getMDSz());
+    obj->readDOMD(size_t(0), 261U, 400U, md.data());
+    EXPECT_EQ(0U, piol->blockCache->getHits());
+    obj->readDOMD(size_t(0), 261U, 400U, md.data());
+    EXPECT_LT(0U, piol->blockCache->getHits());
+    piol->isErr();
+}
+
+TEST_F(CacheTest, RewrittenFile)
+{
+    // The test file is removed once its last writable layer is closed
+    makeMPIIO<true>(tempFile);
+    auto file = data;
+    writeSmallBlocks<false>(400U, 261U);
+    makeCache(tempFile);
+    readSmallBlocks<false>(400U, 261U);
+    EXPECT_LT(0U, cache->size());
+
+    // The file is rewritten behind the cache, so reopening it must not use
+    // the blocks of the old contents.
+    data = file;
+    data->setFileSz(0U);
+    writeSmallBlocks<false>(300U, 261U, 1U);
+
+    makeCache(tempFile);
+    readSmallBlocks<false>(300U, 261U, 1U);
+    EXPECT_EQ(0U, cache->getHits());
+    piol->isErr();
+}
+
+TEST_F(CacheTest, WriteDropsFileBlocks)
+{
+    cacheopt.blockSz = 1200U;
+    makeCache<true>(tempFile);
+    writeSmallBlocks<false>(400U, 261U);
+    readSmallBlocks<false>(400U, 261U);
+    EXPECT_LT(0U, cache->size());
+
+    // Any write drops every block of the file, not just those it touches
+    std::vector<unsigned char> d(1U);
+    data->write(0U, 1U, d.data());
+    EXPECT_EQ(0U, cache->size());
+    piol->isErr();
+}
+
+TEST_F(CacheTest, Options)
+{
+    // The MPI-IO options are passed through to the layer underneath
+    DataCache::Opt opt;
+    opt.cache      = std::make_shared<BlockCache>(cacheopt);
+    opt.mpiio.coll = false;
+    data           = std::make_shared<DataCache>(piol, smallSEGYFile, opt);
+    readSmallBlocks<false>(400U, 261U);
+    EXPECT_EQ(nullptr, data->map(0U, 100U));
+    piol->isErr();
+}
+
+TEST_F(CacheTest, WriteContigSSS)
+{
+    makeCache<true>(tempFile);
+    writeSmallBlocks<false>(400U, 261U);
+    piol->isErr();
+}
+
+TEST_F(CacheTest, WriteBlocksSSS)
+{
+    cacheopt.blockSz = 4096U;
+    makeCache<true>(tempFile);
+    writeSmallBlocks<true>(400U, 261U);
+    writeBigBlocks<true>(400U, 261U);
+
+    // Writing over cached blocks drops them, so the new data is read back
+    writeSmallBlocks<true>(400U, 261U, 1U);
+    writeBigBlocks<true>(400U, 261U, 1U);
+    piol->isErr();
+}
+
+TEST_F(CacheTest, WriteListSmall)
+{
+    makeCache<true>(tempFile);
+    writeList(400U, 261U);
+    piol->isErr();
+}
+
+TEST_F(CacheTest, WriteSplit)
+{
+    // The blocks are staged by the default split I/O
+    makeCache<true>(tempFile);
+    const size_t ns = 261U;
+    writeReadSplit(400U, SEGY_utils::getMDSz(), SEGY_utils::getDFSz(ns), false);
+    writeReadSplit(400U, SEGY_utils::getMDSz(), SEGY_utils::getDFSz(ns), true);
+}
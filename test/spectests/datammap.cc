@@ -0,0 +1,110 @@
+#include "datampiiotest.hh"
+
+#include "ExSeisDat/PIOL/DataMmap.hh"
+
+// The memory-mapped data layer is checked with the same read patterns used
+// for the MPI-IO data layer.
+class MmapTest : public MPIIOTest {
+  protected:
+    DataMmap::Opt mmapopt;
+
+    void makeMmap(std::string name)
+    {
+        if (data != nullptr) {
+            data.reset();
+        }
+
+        data = std::make_shared<DataMmap>(piol, name, mmapopt, FileMode::Read);
+    }
+};
+
+typedef MmapTest MmapDeathTest;
+
+TEST_F(MmapDeathTest, FailedConstructor)
+{
+    makeMmap(notFile);
+
+    EXPECT_EQ(notFile, data->name());
+
+    EXPECT_EXIT(
+      piol->isErr(), ExitedWithCode(EXIT_FAILURE),
+      ".*8 3 Fatal Error in PIOL. . Dumping Log 0");
+}
+
+TEST_F(MmapDeathTest, WriteMode)
+{
+    data = std::make_shared<DataMmap>(piol, tempFile, FileMode::Test);
+
+    EXPECT_EXIT(
+      piol->isErr(), ExitedWithCode(EXIT_FAILURE),
+      ".*8 3 Fatal Error in PIOL. . Dumping Log 0");
+}
+
+TEST_F(MmapTest, Constructor)
+{
+    makeMmap(zeroFile);
+    piol->isErr();
+
+    auto mm = std::dynamic_pointer_cast<DataMmap>(data);
+    ASSERT_NE(nullptr, mm) << "mmap data cast failed";
+    EXPECT_FALSE(mm->isFileNull()) << "File was not opened";
+    EXPECT_EQ(static_cast<size_t>(0), data->getFileSz());
+    EXPECT_EQ(nullptr, data->map(0, 0));
+}
+
+TEST_F(MmapTest, Map)
+{
+    makeMmap(plargeFile);
+    piol->isErr();
+
+    const unsigned char* p = data->map(magicNum1, magicNum1);
+    ASSERT_NE(nullptr, p);
+    for (size_t i = 0; i < magicNum1; i++) {
+        ASSERT_EQ(getPattern(magicNum1 + i), p[i]);
+    }
+
+    EXPECT_NE(nullptr, data->map(0, largeSize));
+    EXPECT_EQ(nullptr, data->map(0, largeSize + 1));
+    EXPECT_EQ(nullptr, data->map(largeSize + 1, 0));
+
+    data->advise(AccessPattern::Sequential);
+    data->advise(AccessPattern::Random);
+    piol->isErr();
+}
+
+TEST_F(MmapTest, ReadContigSSS)
+{
+    makeMmap(smallSEGYFile);
+    readSmallBlocks<false>(400U, 261U);
+    piol->isErr();
+}
+
+TEST_F(MmapTest, ReadContigEnd)
+{
+    makeMmap(smallSEGYFile);
+    readSmallBlocks<false>(400U * 1024U, 261U, 200U);
+    piol->isErr();
+}
+
+TEST_F(MmapTest, ReadBlocksSSS)
+{
+    makeMmap(smallSEGYFile);
+    readSmallBlocks<true>(400U, 261U);
+    readBigBlocks<true>(400U, 261U);
+    piol->isErr();
+}
+
+TEST_F(MmapTest, ReadBlocksEnd)
+{
+    makeMmap(smallSEGYFile);
+    readSmallBlocks<true>(400U * 1024U, 261U, 200U);
+    piol->isErr();
+}
+
+TEST_F(MmapTest, ReadListSmall)
+{
+    makeMmap(smallSEGYFile);
+    auto vec = getRandomVec(200U, 400U, 1337);
+    readList(200U, 261U, vec.data());
+    piol->isErr();
+}
@@ -1,5 +1,7 @@
 #include "datampiiotest.hh"
 
+#include <numeric>
+
 size_t modifyNt(
   const size_t fs, const size_t offset, const size_t nt, const size_t ns)
 {
@@ -127,6 +129,26 @@ TEST_F(MPIIOTest, OffsetsBlockingReadLarge)
     }
 }
 
+TEST_F(MPIIOTest, NonBlockingReadLarge)
+{
+    // Split the read over several requests
+    ioopt.maxSize = magicNum1;
+    makeMPIIO(plargeFile);
+
+    size_t sz     = 16U * magicNum1 + 7U;
+    size_t offset = largeSize / 3U;
+    std::vector<unsigned char> d(sz);
+
+    auto req = data->iread(offset, d.size(), d.data());
+    while (!req->test()) {
+    }
+    piol->isErr();
+
+    for (size_t i = 0; i < d.size(); i++) {
+        ASSERT_EQ(d[i], getPattern(offset + i));
+    }
+}
+
 TEST_F(MPIIOTest, BlockingOneByteReadLarge)
 {
     makeMPIIO(plargeFile);
@@ -303,6 +325,60 @@ const size_t largent = 2000000U;
 const size_t smallns = 261U;
 const size_t smallnt = 400U;
 
+TEST_F(MPIIOTest, ReadBlocksIndependent)
+{
+    // The view must be restored after each strided read
+    ioopt.coll = false;
+    makeMPIIO(smallSEGYFile);
+    const size_t nt = 400;
+    const size_t ns = 261;
+    readSmallBlocks<true>(nt, ns);
+    readSmallBlocks<false>(nt, ns);
+    readSmallBlocks<true>(nt, ns);
+    piol->isErr();
+}
+
+TEST_F(MPIIOTest, ReadBlocksTypeCache)
+{
+    ioopt.coll        = true;
+    ioopt.typeCacheSz = 1U;
+    makeMPIIO(plargeFile);
+    auto mpiio = std::dynamic_pointer_cast<DataMPIIO>(data);
+    ASSERT_NE(nullptr, mpiio);
+
+    const size_t osz = 100U;
+    const size_t nb  = 50U;
+    std::vector<unsigned char> d(16U * nb);
+
+    // Same datatype and view, then the same datatype for fewer blocks, then a
+    // new datatype, then the evicted one
+    const size_t bszs[]    = {16U, 16U, 16U, 8U, 16U};
+    const size_t sizes[]   = {nb, nb, nb / 2U, nb, nb};
+    const size_t offsets[] = {1000U, 1000U, 5000U, 3000U, 2000U};
+    for (size_t c = 0; c < 5U; c++) {
+        const size_t bsz = bszs[c];
+        data->read(offsets[c], bsz, osz, sizes[c], d.data());
+        piol->isErr();
+
+        for (size_t i = 0; i < sizes[c]; i++) {
+            for (size_t j = 0; j < bsz; j++) {
+                ASSERT_EQ(
+                  getPattern(offsets[c] + i * osz + j), d[i * bsz + j]);
+            }
+        }
+    }
+
+    EXPECT_EQ(2U, mpiio->getTypeCacheHits());
+    EXPECT_EQ(3U, mpiio->getTypeCacheMisses());
+    EXPECT_EQ(1U, mpiio->getViewSetsSkipped());
+
+    // A contiguous read must see the default view again
+    data->read(0U, d.size(), d.data());
+    for (size_t i = 0; i < d.size(); i++) {
+        ASSERT_EQ(getPattern(i), d[i]);
+    }
+}
+
 TEST_F(MPIIOTest, ReadListZero)
 {
     makeMPIIO(smallSEGYFile);
@@ -318,6 +394,46 @@ TEST_F(MPIIOTest, ReadListSmall)
     piol->isErr();
 }
 
+TEST_F(MPIIOTest, ReadListSmallNoHoles)
+{
+    // Only adjacent blocks are merged
+    ioopt.maxHole = 0U;
+    makeMPIIO(smallSEGYFile);
+    auto vec = getRandomVec(smallnt / 2, smallnt, 1337);
+    readList(smallnt / 2, smallns, vec.data());
+    piol->isErr();
+}
+
+TEST_F(MPIIOTest, ReadListSmallSieved)
+{
+    // Small views force the extents to be split across several calls
+    ioopt.maxSize = 16U * SEGY_utils::getDOSz(smallns);
+    makeMPIIO(smallSEGYFile);
+    auto vec = getRandomVec(smallnt / 2, smallnt, 1337);
+    readList(smallnt / 2, smallns, vec.data());
+    piol->isErr();
+}
+
+TEST_F(MPIIOTest, ReadListSmallCollective)
+{
+    // Each process has a different number of views to set
+    ioopt.coll    = true;
+    ioopt.maxSize = 16U * SEGY_utils::getDOSz(smallns);
+    makeMPIIO(smallSEGYFile);
+    const size_t sz = smallnt / (2U + piol->comm->getRank());
+    auto vec        = getRandomVec(sz, smallnt, 1337);
+    readList(sz, smallns, vec.data());
+    piol->isErr();
+}
+
+TEST_F(MPIIOTest, ReadListContiguous)
+{
+    makeMPIIO(smallSEGYFile);
+    std::vector<size_t> vec(smallnt / 2);
+    std::iota(vec.begin(), vec.end(), smallnt / 4);
+    readList(vec.size(), smallns, vec.data());
+    piol->isErr();
+}
 
 TEST_F(MPIIOTest, FarmReadListLarge)
 {
@@ -36,7 +36,7 @@ class MPIIOTest : public Test {
         }
 
         FileMode mode = (WRITE ? FileMode::Test : FileMode::Read);
-        data          = std::make_shared<DataMPIIO>(piol, name, mode);
+        data          = std::make_shared<DataMPIIO>(piol, name, ioopt, mode);
     }
 
     void makeTestSz(size_t sz)
@@ -215,6 +215,62 @@ class MPIIOTest : public Test {
         readList(sz, ns, offset.data());
     }
 
+    // Write blocks from two arrays, then read them back both whole and split.
+    void writeReadSplit(
+      const size_t nb, const size_t bsz1, const size_t bsz2, const bool list)
+    {
+        const size_t bsz = bsz1 + bsz2;
+        std::vector<unsigned char> d1(nb * bsz1);
+        std::vector<unsigned char> d2(nb * bsz2);
+        for (size_t i = 0; i < d1.size(); i++) {
+            d1[i] = getPattern(i);
+        }
+        for (size_t i = 0; i < d2.size(); i++) {
+            d2[i] = getPattern(i + 7U);
+        }
+
+        std::vector<size_t> offset(nb);
+        auto block = getRandomVec(nb, 1337);
+        for (size_t i = 0; i < nb; i++) {
+            offset[i] = (list ? block[i] * bsz : 100U + i * bsz);
+        }
+
+        if (list) {
+            data->writeSplit(
+              bsz1, bsz2, nb, offset.data(), d1.data(), d2.data());
+        }
+        else {
+            data->writeSplit(100U, bsz1, bsz2, nb, d1.data(), d2.data());
+        }
+        piol->isErr();
+
+        std::vector<unsigned char> d(nb * bsz);
+        data->read(bsz, nb, offset.data(), d.data());
+        for (size_t i = 0; i < nb; i++) {
+            for (size_t j = 0; j < bsz1; j++) {
+                ASSERT_EQ(d1[i * bsz1 + j], d[i * bsz + j]) << i << " " << j;
+            }
+            for (size_t j = 0; j < bsz2; j++) {
+                ASSERT_EQ(d2[i * bsz2 + j], d[i * bsz + bsz1 + j])
+                  << i << " " << j;
+            }
+        }
+
+        std::vector<unsigned char> r1(nb * bsz1);
+        std::vector<unsigned char> r2(nb * bsz2);
+        if (list) {
+            data->readSplit(
+              bsz1, bsz2, nb, offset.data(), r1.data(), r2.data());
+        }
+        else {
+            data->readSplit(100U, bsz1, bsz2, nb, r1.data(), r2.data());
+        }
+        piol->isErr();
+
+        ASSERT_EQ(d1, r1);
+        ASSERT_EQ(d2, r2);
+    }
+
     void readList(const size_t sz, const size_t ns, const size_t* offset)
     {
         const size_t bsz = SEGY_utils::getDFSz(ns);
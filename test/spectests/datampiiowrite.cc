@@ -36,6 +36,29 @@ TEST_F(MPIIOTest, WriteContigSSS)
     piol->isErr();
 }
 
+TEST_F(MPIIOTest, NonBlockingWrite)
+{
+    ioopt.maxSize = magicNum1;
+    makeMPIIO<true>(tempFile);
+
+    const size_t sz = 16U * magicNum1 + 7U;
+    std::vector<unsigned char> d(sz);
+    for (size_t i = 0; i < sz; i++) {
+        d[i] = getPattern(i);
+    }
+
+    auto req = data->iwrite(0U, sz, d.data());
+    req->wait();
+    piol->isErr();
+
+    std::vector<unsigned char> check(sz);
+    data->read(0U, sz, check.data());
+    piol->isErr();
+    for (size_t i = 0; i < sz; i++) {
+        ASSERT_EQ(getPattern(i), check[i]);
+    }
+}
+
 TEST_F(MPIIOTest, WriteContigSLS)
 {
     makeMPIIO<true>(tempFile);
@@ -172,3 +195,45 @@ TEST_F(MPIIOTest, FarmWriteListLarge)
     writeList(nt, ns);
     piol->isErr();
 }
+
+////////Split blocks///////
+TEST_F(MPIIOTest, WriteSplitZero)
+{
+    makeMPIIO<true>(tempFile);
+    const size_t ns = 261U;
+    writeReadSplit(0U, SEGY_utils::getMDSz(), SEGY_utils::getDFSz(ns), false);
+    writeReadSplit(0U, SEGY_utils::getMDSz(), SEGY_utils::getDFSz(ns), true);
+}
+
+TEST_F(MPIIOTest, WriteSplitContig)
+{
+    makeMPIIO<true>(tempFile);
+    const size_t ns = 261U;
+    writeReadSplit(400U, SEGY_utils::getMDSz(), SEGY_utils::getDFSz(ns), false);
+}
+
+TEST_F(MPIIOTest, WriteSplitList)
+{
+    makeMPIIO<true>(tempFile);
+    const size_t ns = 261U;
+    writeReadSplit(400U, SEGY_utils::getMDSz(), SEGY_utils::getDFSz(ns), true);
+}
+
+TEST_F(MPIIOTest, WriteSplitListIndependent)
+{
+    // Independent list reads stage the blocks to sieve over holes
+    ioopt.coll = false;
+    makeMPIIO<true>(tempFile);
+    const size_t ns = 261U;
+    writeReadSplit(400U, SEGY_utils::getMDSz(), SEGY_utils::getDFSz(ns), true);
+}
+
+TEST_F(MPIIOTest, WriteSplitSmallMaxSize)
+{
+    // Each call holds a single block
+    ioopt.maxSize = 1000U;
+    makeMPIIO<true>(tempFile);
+    const size_t ns = 100U;
+    writeReadSplit(100U, SEGY_utils::getMDSz(), SEGY_utils::getDFSz(ns), false);
+    writeReadSplit(100U, SEGY_utils::getMDSz(), SEGY_utils::getDFSz(ns), true);
+}
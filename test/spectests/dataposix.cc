@@ -0,0 +1,169 @@
+#include "datampiiotest.hh"
+
+#include "ExSeisDat/PIOL/DataPOSIX.hh"
+
+#include <sys/stat.h>
+
+// The POSIX data layer is checked with the same read/write patterns used for
+// the MPI-IO data layer.
+class POSIXTest : public MPIIOTest {
+  protected:
+    DataPOSIX::Opt posixopt;
+
+    template<bool WRITE = false>
+    void makePOSIX(std::string name)
+    {
+        if (data != nullptr) {
+            data.reset();
+        }
+
+        FileMode mode = (WRITE ? FileMode::Test : FileMode::Read);
+        data          = std::make_shared<DataPOSIX>(piol, name, posixopt, mode);
+    }
+};
+
+typedef POSIXTest POSIXDeathTest;
+
+TEST_F(POSIXDeathTest, FailedConstructor)
+{
+    makePOSIX(notFile);
+
+    EXPECT_EQ(piol, data->piol());
+    EXPECT_EQ(notFile, data->name());
+
+    EXPECT_EXIT(
+      piol->isErr(), ExitedWithCode(EXIT_FAILURE),
+      ".*8 3 Fatal Error in PIOL. . Dumping Log 0");
+}
+
+TEST_F(POSIXTest, Constructor)
+{
+    makePOSIX(zeroFile);
+    piol->isErr();
+
+    auto pio = std::dynamic_pointer_cast<DataPOSIX>(data);
+    ASSERT_NE(nullptr, pio) << "POSIX data cast failed";
+    EXPECT_FALSE(pio->isFileNull()) << "File was not opened";
+    EXPECT_EQ(static_cast<size_t>(0), data->getFileSz());
+}
+
+TEST_F(POSIXTest, FileSize)
+{
+    makePOSIX(smallFile);
+    EXPECT_EQ(smallSize, data->getFileSz());
+    makePOSIX(largeFile);
+    EXPECT_EQ(largeSize, data->getFileSz());
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, SetFileSz)
+{
+    makePOSIX<true>(tempFile);
+    data->setFileSz(1024U);
+
+    struct stat info;
+    stat(tempFile.c_str(), &info);
+    EXPECT_EQ(1024U, static_cast<size_t>(info.st_size));
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, OffsetsBlockingReadLarge)
+{
+    makePOSIX(plargeFile);
+
+    for (size_t j = 0; j < magicNum1; j += 10U) {
+        size_t sz     = 16U * magicNum1 + j;
+        size_t offset = (largeSize / magicNum1) * j;
+        std::vector<unsigned char> d(sz);
+
+        data->read(offset, d.size(), d.data());
+        piol->isErr();
+
+        for (size_t i = 0; i < sz; i++) {
+            ASSERT_EQ(getPattern(offset + i), d[i]);
+        }
+    }
+}
+
+TEST_F(POSIXTest, ReadContigSSS)
+{
+    makePOSIX(smallSEGYFile);
+    readSmallBlocks<false>(400U, 261U);
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, ReadContigEnd)
+{
+    makePOSIX(smallSEGYFile);
+    readSmallBlocks<false>(400U * 1024U, 261U, 200U);
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, ReadBlocksSSS)
+{
+    makePOSIX(smallSEGYFile);
+    readSmallBlocks<true>(400U, 261U);
+    readBigBlocks<true>(400U, 261U);
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, ReadBlocksNoHoles)
+{
+    // Force one pread per block
+    posixopt.maxHole = 0U;
+    makePOSIX(smallSEGYFile);
+    readSmallBlocks<true>(400U, 261U);
+    readBigBlocks<true>(400U, 261U);
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, ReadBlocksEnd)
+{
+    makePOSIX(smallSEGYFile);
+    readSmallBlocks<true>(400U * 1024U, 261U, 200U);
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, ReadBlocksSLS)
+{
+    makePOSIX(bigTraceSEGYFile);
+    readSmallBlocks<true>(40U, 32000U, 1000U);
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, ReadListZero)
+{
+    makePOSIX(smallSEGYFile);
+    readList(0, 0, NULL);
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, ReadListSmall)
+{
+    makePOSIX(smallSEGYFile);
+    auto vec = getRandomVec(200U, 400U, 1337);
+    readList(200U, 261U, vec.data());
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, WriteContigSSS)
+{
+    makePOSIX<true>(tempFile);
+    writeSmallBlocks<false>(400U, 261U);
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, WriteBlocksSSS)
+{
+    makePOSIX<true>(tempFile);
+    writeSmallBlocks<true>(400U, 261U);
+    writeBigBlocks<true>(400U, 261U);
+    piol->isErr();
+}
+
+TEST_F(POSIXTest, WriteListSmall)
+{
+    makePOSIX<true>(tempFile);
+    writeList(400U, 261U);
+    piol->isErr();
+}
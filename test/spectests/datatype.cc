@@ -6,6 +6,7 @@
 #include <bitset>
 #include <cmath>
 #include <cstring>
+#include <limits>
 #include <stdint.h>
 #include <vector>
 
@@ -214,3 +215,217 @@ TEST(Datatype, IBMToIEEE)
         }
     }
 }
+
+TEST(Datatype, IBMToIEEEEdgeCases)
+{
+    // Unnormalized, denormalized and overflowing values over every exponent,
+    // checked against the value rounded once from long double.
+    for (uint32_t sign : {0U, 1U}) {
+        for (uint32_t exponent = 0; exponent < 128; exponent++) {
+            for (uint32_t significand :
+                 {0x000001U, 0x000003U, 0x00FFFFU, 0x07FFFFU, 0x100000U,
+                  0x1FFFFFU, 0x800000U, 0x800001U, 0xFFFFFFU}) {
+                const uint32_t ibm =
+                  (sign << 31) | (exponent << 24) | significand;
+                const std::array<unsigned char, 4> bytes = {
+                  {static_cast<unsigned char>(ibm >> 24),
+                   static_cast<unsigned char>(ibm >> 16),
+                   static_cast<unsigned char>(ibm >> 8),
+                   static_cast<unsigned char>(ibm >> 0)}};
+
+                const float expected = static_cast<float>(
+                  (sign ? -1.0L : 1.0L) * static_cast<long double>(significand)
+                  * std::pow(2.0L, 4.0L * (int(exponent) - 64) - 24));
+                const float ieee = from_IBM_to_float(bytes, true);
+
+                uint32_t expected_bits = 0;
+                uint32_t ieee_bits     = 0;
+                std::memcpy(&expected_bits, &expected, sizeof(float));
+                std::memcpy(&ieee_bits, &ieee, sizeof(float));
+                ASSERT_EQ(expected_bits, ieee_bits)
+                  << "IBM: " << printBinary(ibm);
+            }
+        }
+    }
+}
+
+TEST(Datatype, IBMToIEEEZero)
+{
+    // A zero fraction is zero, whatever the sign and exponent.
+    for (unsigned char byte : {0x00, 0x41, 0xC1, 0xFF}) {
+        EXPECT_EQ(0.0f, from_IBM_to_float({{byte, 0x00, 0x00, 0x00}}, true));
+    }
+}
+
+TEST(Datatype, IEEEToIBMRoundTrip)
+{
+    // Every normalized IBM number in the range of normal floats is converted
+    // to a float exactly, and back to the same bits.
+    for (uint32_t sign : {0U, 1U}) {
+        for (uint32_t exponent = 34; exponent <= 96; exponent++) {
+            for (uint32_t frac = 0x100000; frac <= 0xFFFFFF; frac += 997) {
+                const uint32_t ibm = (sign << 31) | (exponent << 24) | frac;
+                const std::array<unsigned char, 4> bytes = {
+                  {static_cast<unsigned char>(ibm >> 24),
+                   static_cast<unsigned char>(ibm >> 16),
+                   static_cast<unsigned char>(ibm >> 8),
+                   static_cast<unsigned char>(ibm >> 0)}};
+
+                const float f = from_IBM_to_float(bytes, true);
+                ASSERT_EQ(bytes, to_IBM_from_float(f, true))
+                  << "IBM: " << printBinary(ibm);
+            }
+        }
+    }
+}
+
+TEST(Datatype, IEEEToIBMRounding)
+{
+    // Random floats, including denormalized ones, are rounded half to even
+    // to a normalized IBM number, checked in long double.
+    uint32_t state = 4242;
+    for (size_t n = 0; n < 200000; n++) {
+        state = state * 1664525U + 1013904223U;
+
+        uint32_t bits = state;
+        if (n % 4 == 0) {
+            bits &= 0x807FFFFF;
+        }
+        float f = 0;
+        std::memcpy(&f, &bits, sizeof(float));
+        if (!std::isfinite(f) || f == 0.0f) {
+            continue;
+        }
+
+        const auto b        = to_IBM_from_float(f, true);
+        const uint32_t ibm  = from_big_endian<uint32_t>(b);
+        const uint32_t frac = ibm & 0x00FFFFFF;
+        const int exponent  = int((ibm >> 24) & 0x7F);
+
+        ASSERT_NE(0U, frac & 0x00F00000) << "IBM: " << printBinary(ibm);
+        ASSERT_EQ(bits >> 31, ibm >> 31);
+
+        const long double ulp    = std::pow(2.0L, 4 * exponent - 280);
+        const long double err    = std::fabs(static_cast<long double>(f))
+                                - static_cast<long double>(frac) * ulp;
+        const long double absErr = std::fabs(err);
+        ASSERT_LE(absErr, ulp / 2) << "IBM: " << printBinary(ibm);
+        if (absErr == ulp / 2) {
+            ASSERT_EQ(0U, frac & 1U) << "IBM: " << printBinary(ibm);
+        }
+    }
+}
+
+TEST(Datatype, IEEEToIBMEdgeCases)
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    using Bytes = std::array<unsigned char, 4>;
+    EXPECT_EQ(Bytes({{0x00, 0x00, 0x00, 0x00}}), to_IBM_from_float(0.0f, true));
+    EXPECT_EQ(
+      Bytes({{0x00, 0x00, 0x00, 0x00}}), to_IBM_from_float(-0.0f, true));
+    EXPECT_EQ(Bytes({{0x7F, 0xFF, 0xFF, 0xFF}}), to_IBM_from_float(inf, true));
+    EXPECT_EQ(
+      Bytes({{0xFF, 0xFF, 0xFF, 0xFF}}), to_IBM_from_float(-inf, true));
+    EXPECT_EQ(Bytes({{0x7F, 0xFF, 0xFF, 0xFF}}), to_IBM_from_float(nan, true));
+
+    // 1 is 0x1 * 16^1, and -118.625 is the example of the IBM manual.
+    EXPECT_EQ(Bytes({{0x41, 0x10, 0x00, 0x00}}), to_IBM_from_float(1.0f, true));
+    EXPECT_EQ(
+      Bytes({{0xC2, 0x76, 0xA0, 0x00}}), to_IBM_from_float(-118.625f, true));
+    EXPECT_EQ(
+      Bytes({{0x00, 0xA0, 0x76, 0xC2}}), to_IBM_from_float(-118.625f, false));
+
+    // The fraction has 3 bits fewer than the float here, so the float just
+    // below 2 rounds up to 2.
+    const float justBelow = std::nextafter(2.0f, 0.0f);
+    EXPECT_EQ(
+      Bytes({{0x41, 0x20, 0x00, 0x00}}), to_IBM_from_float(justBelow, true));
+
+    // The largest and smallest floats.
+    EXPECT_EQ(
+      std::numeric_limits<float>::max(),
+      from_IBM_to_float(
+        to_IBM_from_float(std::numeric_limits<float>::max(), true), true));
+    EXPECT_EQ(
+      std::numeric_limits<float>::denorm_min(),
+      from_IBM_to_float(
+        to_IBM_from_float(std::numeric_limits<float>::denorm_min(), true),
+        true));
+}
+
+TEST(Datatype, BulkConversion)
+{
+    // Random bit patterns, including IBM zeros, in a length which leaves a
+    // tail for every vector width.
+    const size_t n = 1003;
+    std::vector<unsigned char> src(4 * n);
+    uint32_t state = 1337;
+    for (auto& b : src) {
+        state = state * 1664525U + 1013904223U;
+        b     = static_cast<unsigned char>(state >> 24);
+    }
+    src[4 * 5 + 1] = src[4 * 5 + 2] = src[4 * 5 + 3] = 0;
+
+    const Simd_level widest = simd_level();
+    for (int l = int(Simd_level::Scalar); l <= int(widest); l++) {
+        ASSERT_EQ(Simd_level(l), set_simd_level(Simd_level(l)));
+
+        std::vector<float> out(n);
+        std::vector<unsigned char> back(4 * n);
+
+        from_big_endian_n(src.data(), n, out.data());
+        to_big_endian_n(out.data(), n, back.data());
+        for (size_t i = 0; i < n; i++) {
+            const float f = from_big_endian<float>(
+              {{src[4 * i], src[4 * i + 1], src[4 * i + 2], src[4 * i + 3]}});
+            ASSERT_EQ(0, std::memcmp(&f, &out[i], sizeof(float)))
+              << "level " << l << " value " << i;
+        }
+        ASSERT_EQ(src, back) << "level " << l;
+
+        for (bool big_endian : {true, false}) {
+            from_IBM_to_float_n(src.data(), n, out.data(), big_endian);
+
+            // The conversion may also be done in place.
+            std::vector<unsigned char> inplace(src);
+            float* inplace_out = reinterpret_cast<float*>(inplace.data());
+            from_IBM_to_float_n(inplace.data(), n, inplace_out, big_endian);
+
+            for (size_t i = 0; i < n; i++) {
+                const float f = from_IBM_to_float(
+                  {{src[4 * i], src[4 * i + 1], src[4 * i + 2],
+                    src[4 * i + 3]}},
+                  big_endian);
+                ASSERT_EQ(0, std::memcmp(&f, &out[i], sizeof(float)))
+                  << "level " << l << " value " << i;
+                ASSERT_EQ(0, std::memcmp(&f, &inplace_out[i], sizeof(float)))
+                  << "level " << l << " value " << i;
+            }
+        }
+
+        // The encoder is checked on the same bits read as floats, which
+        // includes denormals, infinities and NaNs.
+        std::vector<float> native(n);
+        std::memcpy(native.data(), src.data(), src.size());
+        for (bool big_endian : {true, false}) {
+            std::vector<unsigned char> ibm(4 * n);
+            to_IBM_from_float_n(native.data(), n, ibm.data(), big_endian);
+
+            std::vector<float> inplace(native);
+            unsigned char* inplace_ibm =
+              reinterpret_cast<unsigned char*>(inplace.data());
+            to_IBM_from_float_n(inplace.data(), n, inplace_ibm, big_endian);
+
+            for (size_t i = 0; i < n; i++) {
+                const auto b = to_IBM_from_float(native[i], big_endian);
+                ASSERT_EQ(0, std::memcmp(b.data(), &ibm[4 * i], 4))
+                  << "level " << l << " value " << i;
+                ASSERT_EQ(0, std::memcmp(b.data(), &inplace_ibm[4 * i], 4))
+                  << "level " << l << " value " << i;
+            }
+        }
+    }
+    set_simd_level(widest);
+}
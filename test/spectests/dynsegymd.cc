@@ -1,6 +1,9 @@
 #include "dynsegymdtest.hh"
 
 #include "ExSeisDat/PIOL/param_utils.hh"
+#include "ExSeisDat/PIOL/segy_utils.hh"
+
+#include "param_mpi.hh"
 
 // TODO: Add test for param_utils::cpyPrm called with different sets of rules,
 // i.e dst and
@@ -86,6 +89,245 @@ TEST_F(RuleFixEmpty, Extent)
       size_t(PIOL_TR_SrcMeas) + 4U - size_t(PIOL_TR_ScaleCoord));
 }
 
+TEST_F(RuleFixList, Compile)
+{
+    const auto& prog = rule->compile();
+    ASSERT_EQ(prog.op.size(), locs.size());
+
+    // The four coordinates share one scalar at the start of the extent
+    ASSERT_EQ(prog.scalLoc.size(), 1U);
+    ASSERT_EQ(prog.scalLoc[0], 0U);
+
+    for (size_t i = 0; i < prog.op.size(); i++) {
+        EXPECT_EQ(prog.op[i].loc, locs[i] - size_t(PIOL_TR_ScaleCoord)) << i;
+        EXPECT_EQ(prog.op[i].type, RuleEntry::MdType::Float) << i;
+        EXPECT_EQ(prog.op[i].scalLoc, 0U) << i;
+        EXPECT_EQ(prog.op[i].scal, 0U) << i;
+    }
+}
+
+TEST_F(RuleFixEmpty, CompileAfterChange)
+{
+    rule->addLong(PIOL_META_xl, PIOL_TR_il);
+    ASSERT_EQ(rule->compile().op.size(), 1U);
+    EXPECT_EQ(rule->compile().op[0].loc, 0U);
+    EXPECT_EQ(rule->compile().op[0].type, RuleEntry::MdType::Long);
+
+    // A rule before the old start moves the offsets of the others
+    rule->addSEGYFloat(PIOL_META_dsdr, PIOL_TR_SrcMeas, PIOL_TR_ScaleCoord);
+    const auto& prog = rule->compile();
+    ASSERT_EQ(prog.op.size(), 2U);
+    ASSERT_EQ(prog.scalLoc.size(), 1U);
+    EXPECT_EQ(prog.op[0].loc, size_t(PIOL_TR_il - PIOL_TR_ScaleCoord));
+    EXPECT_EQ(prog.op[1].loc, size_t(PIOL_TR_SrcMeas - PIOL_TR_ScaleCoord));
+    EXPECT_EQ(prog.op[1].type, RuleEntry::MdType::Float);
+
+    rule->rmRule(PIOL_META_dsdr);
+    ASSERT_EQ(rule->compile().op.size(), 1U);
+    EXPECT_EQ(rule->compile().scalLoc.size(), 0U);
+    EXPECT_EQ(rule->compile().op[0].loc, 0U);
+}
+
+TEST_F(RuleFixList, InsertExtract)
+{
+    rule->addLong(PIOL_META_il, PIOL_TR_il);
+    const size_t n = 10;
+    Param prm(rule, n);
+    for (size_t i = 0; i < n; i++) {
+        param_utils::setPrm(
+          i, PIOL_META_xSrc, exseis::utils::Floating_point(i) + 1., &prm);
+        param_utils::setPrm(
+          i, PIOL_META_yRcv, exseis::utils::Floating_point(i) + 4., &prm);
+        param_utils::setPrm(i, PIOL_META_il, exseis::utils::Integer(i), &prm);
+    }
+
+    // The buffer only holds the rule extent
+    std::vector<unsigned char> md(n * rule->extent());
+    SEGY_utils::insertParam(n, &prm, md.data(), 0, 0);
+
+    Param out(rule, n);
+    SEGY_utils::extractParam(n, md.data(), &out, 0, 0);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(
+          param_utils::getPrm<exseis::utils::Floating_point>(
+            i, PIOL_META_xSrc, &out),
+          exseis::utils::Floating_point(i) + 1.);
+        EXPECT_EQ(
+          param_utils::getPrm<exseis::utils::Floating_point>(
+            i, PIOL_META_yRcv, &out),
+          exseis::utils::Floating_point(i) + 4.);
+        EXPECT_EQ(
+          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_il, &out),
+          exseis::utils::Integer(i));
+    }
+}
+
+TEST_F(RuleFixList, InsertExtractColumnar)
+{
+    rule->addLong(PIOL_META_il, PIOL_TR_il);
+    const size_t n = 10;
+    Param prm(rule, n);
+    for (size_t i = 0; i < n; i++) {
+        param_utils::setPrm(
+          i, PIOL_META_xSrc, exseis::utils::Floating_point(i) + 1., &prm);
+        param_utils::setPrm(
+          i, PIOL_META_yRcv, exseis::utils::Floating_point(i) + 4., &prm);
+        param_utils::setPrm(i, PIOL_META_il, exseis::utils::Integer(i), &prm);
+    }
+
+    std::vector<unsigned char> md(n * rule->extent());
+    SEGY_utils::insertParam(n, &prm, md.data(), 0, 0);
+
+    // Each parameter is contiguous.
+    Param out(rule, n, false, true);
+    SEGY_utils::extractParam(n, md.data(), &out, 0, 0);
+    const param_utils::ParamColumn<exseis::utils::Floating_point> yRcv(
+      PIOL_META_yRcv, &out);
+    ASSERT_EQ(1U, yRcv.stride());
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(
+          yRcv.data<exseis::utils::Floating_point>()[i],
+          exseis::utils::Floating_point(i) + 4.);
+    }
+    ASSERT_TRUE(prm == out);
+
+    // Headers written from either layout are the same.
+    std::vector<unsigned char> md2(n * rule->extent());
+    SEGY_utils::insertParam(n, &out, md2.data(), 0, 0);
+    ASSERT_EQ(md, md2);
+
+    // Copies convert between the layouts.
+    Param back(rule, n);
+    for (size_t i = 0; i < n; i++) {
+        param_utils::cpyPrm(n - i - 1, &out, i, &back);
+    }
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(
+          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_il, &back),
+          exseis::utils::Integer(n - i - 1));
+    }
+}
+
+TEST_F(RuleFixList, InsertExtractCompact)
+{
+    rule->addLong(PIOL_META_il, PIOL_TR_il);
+    rule->addShort(PIOL_META_tnl, PIOL_TR_SeqNum);
+    const size_t n = 10;
+    Param prm(rule, n);
+    for (size_t i = 0; i < n; i++) {
+        param_utils::setPrm(
+          i, PIOL_META_xSrc, exseis::utils::Floating_point(i) + 1.25, &prm);
+        param_utils::setPrm(
+          i, PIOL_META_yRcv, 600000. + exseis::utils::Floating_point(i), &prm);
+        param_utils::setPrm(
+          i, PIOL_META_il, exseis::utils::Integer(i) - 5, &prm);
+        param_utils::setPrm(i, PIOL_META_tnl, short(i), &prm);
+    }
+
+    std::vector<unsigned char> md(n * rule->extent());
+    SEGY_utils::insertParam(n, &prm, md.data(), 0, 0);
+
+    rule->compact = true;
+    Param out(rule, n);
+    rule->compact = false;
+    ASSERT_TRUE(out.compact);
+    ASSERT_TRUE(out.f.empty());
+    ASSERT_TRUE(out.i.empty());
+    SEGY_utils::extractParam(n, md.data(), &out, 0, 0);
+    ASSERT_TRUE(prm == out);
+
+    // The headers are rewritten exactly as they were read.
+    std::vector<unsigned char> md2(n * rule->extent());
+    SEGY_utils::insertParam(n, &out, md2.data(), 0, 0);
+    ASSERT_EQ(md, md2);
+
+    // The floats and longs take half the memory.
+    ASSERT_EQ(
+      out.fc.size() * sizeof(int32_t) + out.ic.size() * sizeof(int32_t),
+      (prm.f.size() * sizeof(exseis::utils::Floating_point)
+       + prm.i.size() * sizeof(exseis::utils::Integer))
+        / 2);
+
+    // Setting a value which needs a finer scalar rescales its group.
+    param_utils::setPrm(
+      3, PIOL_META_xRcv, exseis::utils::Floating_point(2.5), &out);
+    param_utils::setPrm(
+      3, PIOL_META_ySrc, exseis::utils::Floating_point(7.125), &out);
+    const param_utils::ParamColumn<exseis::utils::Floating_point> xSrc(
+      PIOL_META_xSrc, &out);
+    EXPECT_EQ(exseis::utils::Floating_point(4.25), xSrc[3]);
+    EXPECT_EQ(
+      exseis::utils::Floating_point(2.5),
+      param_utils::getPrm<exseis::utils::Floating_point>(
+        3, PIOL_META_xRcv, &out));
+    EXPECT_EQ(
+      exseis::utils::Floating_point(7.125),
+      param_utils::getPrm<exseis::utils::Floating_point>(
+        3, PIOL_META_ySrc, &out));
+
+    // Copies convert to and from the full width storage.
+    Param back(rule, n);
+    for (size_t i = 0; i < n; i++) {
+        param_utils::cpyPrm(i, &out, i, &back);
+    }
+    ASSERT_TRUE(back == out);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(
+          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_il, &back),
+          exseis::utils::Integer(i) - 5);
+    }
+}
+
+TEST_F(RuleFixList, ExtractLazy)
+{
+    rule->addLong(PIOL_META_il, PIOL_TR_il);
+    const size_t n = 10;
+    Param prm(rule, n);
+    for (size_t i = 0; i < n; i++) {
+        param_utils::setPrm(
+          i, PIOL_META_xSrc, exseis::utils::Floating_point(i) + 1., &prm);
+        param_utils::setPrm(
+          i, PIOL_META_yRcv, exseis::utils::Floating_point(i) + 4., &prm);
+        param_utils::setPrm(i, PIOL_META_il, exseis::utils::Integer(i), &prm);
+    }
+
+    std::vector<unsigned char> md(n * rule->extent());
+    SEGY_utils::insertParam(n, &prm, md.data(), 0, 0);
+
+    // The first half is extracted before any column is accessed, the second
+    // half after il has been.
+    Param out(rule, n, true);
+    SEGY_utils::extractParam(n / 2, md.data(), &out, 0, 0);
+    ASSERT_EQ(rule->numFloat + rule->numLong, out.npending);
+
+    EXPECT_EQ(
+      param_utils::getPrm<exseis::utils::Integer>(1, PIOL_META_il, &out),
+      exseis::utils::Integer(1));
+    ASSERT_EQ(rule->numFloat + rule->numLong - 1, out.npending);
+    for (const auto v : out.f) {
+        ASSERT_EQ(exseis::utils::Floating_point(0), v);
+    }
+
+    SEGY_utils::extractParam(
+      n - n / 2, &md[n / 2 * rule->extent()], &out, 0, n / 2);
+    param_utils::setPrm(0, PIOL_META_il, exseis::utils::Integer(42), &out);
+
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(
+          param_utils::getPrm<exseis::utils::Floating_point>(
+            i, PIOL_META_yRcv, &out),
+          exseis::utils::Floating_point(i) + 4.);
+        EXPECT_EQ(
+          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_il, &out),
+          exseis::utils::Integer(i == 0 ? 42 : i));
+    }
+
+    // Copies and header writes see every column.
+    param_utils::setPrm(0, PIOL_META_il, exseis::utils::Integer(0), &out);
+    ASSERT_TRUE(prm == out);
+    ASSERT_EQ(0U, out.npending);
+}
+
 TEST_F(RuleFixList, setPrm)
 {
     rule->addLong(PIOL_META_dsdr, PIOL_TR_SrcMeas);
@@ -149,6 +391,221 @@ TEST_F(RuleFixList, setPrm)
     }
 }
 
+TEST_F(RuleFixList, ParamColumn)
+{
+    rule->addShort(PIOL_META_il, PIOL_TR_ScaleElev);
+    rule->addLong(PIOL_META_xl, PIOL_TR_xl);
+    rule->addIndex(PIOL_META_gtn);
+    const size_t n = 20;
+    Param prm(rule, n);
+
+    param_utils::WritableParamColumn<exseis::utils::Floating_point> yRcv(
+      PIOL_META_yRcv, &prm);
+    param_utils::WritableParamColumn<exseis::utils::Integer> il(
+      PIOL_META_il, &prm);
+    param_utils::WritableParamColumn<size_t> gtn(PIOL_META_gtn, &prm);
+    ASSERT_EQ(RuleEntry::MdType::Float, yRcv.type());
+    ASSERT_EQ(RuleEntry::MdType::Short, il.type());
+    ASSERT_EQ(rule->numFloat, yRcv.stride());
+
+    for (size_t i = 0; i < n; i++) {
+        yRcv.set(i, exseis::utils::Floating_point(i) + 4.);
+        il.set(i, exseis::utils::Integer(i + 2));
+        gtn.set(i, 3 * i);
+        param_utils::setPrm(i, PIOL_META_xl, exseis::utils::Integer(i), &prm);
+    }
+
+    const param_utils::ParamColumn<exseis::utils::Integer> xl(
+      PIOL_META_xl, &prm);
+    const auto* raw = xl.data<exseis::utils::Integer>();
+    static_assert(
+      std::is_same<decltype(raw), const exseis::utils::Integer*>::value,
+      "A read-only handle gives const pointers");
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(
+          param_utils::getPrm<exseis::utils::Floating_point>(
+            i, PIOL_META_yRcv, &prm),
+          exseis::utils::Floating_point(i) + 4.);
+        EXPECT_EQ(param_utils::getPrm<short>(i, PIOL_META_il, &prm), i + 2);
+        EXPECT_EQ(param_utils::getPrm<size_t>(i, PIOL_META_gtn, &prm), 3 * i);
+        EXPECT_EQ(xl[i], exseis::utils::Integer(i));
+        EXPECT_EQ(raw[xl.stride() * i], exseis::utils::Integer(i));
+    }
+
+    // Entries without a rule read as zero.
+    const param_utils::ParamColumn<exseis::utils::Integer> none(
+      PIOL_META_Misc1, &prm);
+    ASSERT_EQ(nullptr, none.data<exseis::utils::Integer>());
+    ASSERT_EQ(exseis::utils::Integer(0), none[0]);
+
+    // Removing a rule renumbers the others, and the lookup follows.
+    rule->rmRule(PIOL_META_xSrc);
+    ASSERT_EQ(nullptr, rule->getEntry(PIOL_META_xSrc));
+    ASSERT_EQ(
+      rule->translate.at(PIOL_META_yRcv), rule->getEntry(PIOL_META_yRcv));
+    ASSERT_EQ(nullptr, rule->getEntry(static_cast<Meta>(1000)));
+}
+
+TEST_F(RuleFixList, CopyPermute)
+{
+    rule->addLong(PIOL_META_il, PIOL_TR_il);
+    rule->addShort(PIOL_META_tnl, PIOL_TR_SeqNum);
+    rule->addIndex(PIOL_META_gtn);
+    rule->addCopy();
+    const size_t n = 12;
+
+    // The set which ends up at each position, and its inverse.
+    const std::vector<size_t> idx = {3, 7, 0, 11, 5, 1, 9, 2, 10, 4, 8, 6};
+    std::vector<size_t> inv(n);
+    for (size_t j = 0; j < n; j++) {
+        inv[idx[j]] = j;
+    }
+
+    auto fill = [](Param* prm) {
+        for (size_t i = 0; i < prm->size(); i++) {
+            param_utils::setPrm(
+              i, PIOL_META_xSrc, exseis::utils::Floating_point(i) + 1.5, prm);
+            param_utils::setPrm(
+              i, PIOL_META_il, exseis::utils::Integer(i) - 5, prm);
+            param_utils::setPrm(i, PIOL_META_tnl, short(i), prm);
+            param_utils::setPrm(i, PIOL_META_gtn, 2 * i, prm);
+            prm->c[i * SEGY_utils::getMDSz()] = static_cast<unsigned char>(i);
+        }
+    };
+
+    // Check set j of prm holds what set i held when filled.
+    auto check = [](const Param* prm, size_t j, size_t i) {
+        EXPECT_EQ(
+          exseis::utils::Floating_point(i) + 1.5,
+          param_utils::getPrm<exseis::utils::Floating_point>(
+            j, PIOL_META_xSrc, prm));
+        EXPECT_EQ(
+          exseis::utils::Integer(i) - 5,
+          param_utils::getPrm<exseis::utils::Integer>(j, PIOL_META_il, prm));
+        EXPECT_EQ(short(i), param_utils::getPrm<short>(j, PIOL_META_tnl, prm));
+        EXPECT_EQ(2 * i, param_utils::getPrm<size_t>(j, PIOL_META_gtn, prm));
+        EXPECT_EQ(i, prm->c[j * SEGY_utils::getMDSz()]);
+    };
+
+    for (bool columnar : {false, true}) {
+        for (bool compact : {false, true}) {
+            rule->compact = compact;
+            Param prm(rule, n, false, columnar);
+            Param dst(rule, n + 4, false, columnar);
+            Param other(rule, n, false, !columnar);
+            rule->compact = false;
+            fill(&prm);
+
+            param_utils::cpyPrm(2, &prm, 4, &dst, n - 2);
+            for (size_t j = 2; j < n; j++) {
+                check(&dst, j + 2, j);
+            }
+
+            param_utils::permutePrm(n, idx.data(), &prm, 1, &dst);
+            for (size_t j = 0; j < n; j++) {
+                check(&dst, j + 1, idx[j]);
+            }
+
+            // Copies between layouts go set by set.
+            param_utils::cpyPrm(0, &prm, 0, &other, n);
+            param_utils::permutePrm(n, idx.data(), &other);
+            for (size_t j = 0; j < n; j++) {
+                check(&other, j, idx[j]);
+            }
+
+            param_utils::permutePrm(n, idx.data(), &prm);
+            for (size_t j = 0; j < n; j++) {
+                check(&prm, j, idx[j]);
+            }
+
+            // Applying the inverse restores the original order.
+            param_utils::permutePrm(n, inv.data(), &prm);
+            for (size_t j = 0; j < n; j++) {
+                check(&prm, j, j);
+            }
+        }
+    }
+
+    const size_t ns = 5;
+    std::vector<exseis::utils::Trace_value> trc(n * ns);
+    for (size_t i = 0; i < trc.size(); i++) {
+        trc[i] = exseis::utils::Trace_value(i);
+    }
+
+    std::vector<exseis::utils::Trace_value> out(n * ns);
+    param_utils::permuteTrc(n, idx.data(), ns, trc.data(), out.data());
+    param_utils::permuteTrc(n, idx.data(), ns, trc.data());
+    ASSERT_EQ(out, trc);
+    for (size_t j = 0; j < n; j++) {
+        for (size_t k = 0; k < ns; k++) {
+            EXPECT_EQ(
+              exseis::utils::Trace_value(idx[j] * ns + k), trc[j * ns + k]);
+        }
+    }
+}
+
+TEST_F(RuleFixList, MPIType)
+{
+    rule->addLong(PIOL_META_il, PIOL_TR_il);
+    rule->addShort(PIOL_META_tnl, PIOL_TR_SeqNum);
+    rule->addIndex(PIOL_META_gtn);
+    rule->addCopy();
+    const size_t n  = 12;
+    const size_t md = SEGY_utils::getMDSz();
+
+    for (bool columnar : {false, true}) {
+        for (bool compact : {false, true}) {
+            rule->compact = compact;
+            Param prm(rule, n, false, columnar);
+            Param out(rule, n + 3, false, columnar);
+            rule->compact = false;
+
+            for (size_t i = 0; i < n; i++) {
+                param_utils::setPrm(
+                  i, PIOL_META_xSrc, exseis::utils::Floating_point(i) + 1.5,
+                  &prm);
+                param_utils::setPrm(
+                  i, PIOL_META_il, exseis::utils::Integer(i) - 5, &prm);
+                param_utils::setPrm(i, PIOL_META_tnl, short(i), &prm);
+                param_utils::setPrm(i, PIOL_META_gtn, 2 * i, &prm);
+                prm.c[i * md] = static_cast<unsigned char>(i);
+            }
+
+            // A range lands at another offset of a structure of another size.
+            MPI_Datatype stype;
+            MPI_Datatype rtype;
+            ASSERT_EQ(
+              MPI_SUCCESS, param_utils::createMPIType(&prm, 4, 6, &stype));
+            ASSERT_EQ(
+              MPI_SUCCESS, param_utils::createMPIType(&out, 2, 6, &rtype));
+            ASSERT_EQ(
+              MPI_SUCCESS,
+              MPI_Sendrecv(
+                MPI_BOTTOM, 1, stype, 0, 0, MPI_BOTTOM, 1, rtype, 0, 0,
+                MPI_COMM_SELF, MPI_STATUS_IGNORE));
+            MPI_Type_free(&stype);
+            MPI_Type_free(&rtype);
+
+            for (size_t j = 2; j < 8; j++) {
+                const size_t i = j + 2;
+                EXPECT_EQ(
+                  exseis::utils::Floating_point(i) + 1.5,
+                  param_utils::getPrm<exseis::utils::Floating_point>(
+                    j, PIOL_META_xSrc, &out));
+                EXPECT_EQ(
+                  exseis::utils::Integer(i) - 5,
+                  param_utils::getPrm<exseis::utils::Integer>(
+                    j, PIOL_META_il, &out));
+                EXPECT_EQ(
+                  short(i), param_utils::getPrm<short>(j, PIOL_META_tnl, &out));
+                EXPECT_EQ(
+                  2 * i, param_utils::getPrm<size_t>(j, PIOL_META_gtn, &out));
+                EXPECT_EQ(i, out.c[j * md]);
+            }
+        }
+    }
+}
+
 TEST_F(RuleFixDefault, Constructor)
 {
     ASSERT_EQ(rule->translate.size(), static_cast<size_t>(12));
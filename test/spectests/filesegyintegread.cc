@@ -1,5 +1,10 @@
 #include "filesegytest.hh"
 
+#include "ExSeisDat/PIOL/ParamIndex.hh"
+
+#include <cstdio>
+#include <sys/stat.h>
+
 const size_t largens = 1000U;
 const size_t largent = 2000000U;
 const size_t bigtns  = 32000U;
@@ -62,6 +67,227 @@ TEST_F(FileSEGYIntegRead, FileReadRandomTraceWPrmSmall)
     readRandomTraceTest<true, false>(size, offsets);
 }
 
+TEST_F(FileSEGYIntegRead, FileReadTraceWPrmSmallMmap)
+{
+    nt = smallnt;
+    ns = smallns;
+    makeMmapSEGY(smallSEGYFile);
+    readTraceTest<false, false>(0, nt);
+    readTraceTest<true, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegRead, FileReadRandomTraceWPrmSmallMmap)
+{
+    nt           = smallnt;
+    ns           = smallns;
+    size_t size  = nt;
+    auto offsets = getRandomVec(size, nt, 1337);
+    makeMmapSEGY(smallSEGYFile);
+    readRandomTraceTest<false, false>(size, offsets);
+    readRandomTraceTest<true, false>(size, offsets);
+}
+
+TEST_F(FileSEGYIntegRead, FileReadTraceWPrmSmallThreads)
+{
+    piol->numThreads = 4;
+    nt               = smallnt;
+    ns               = smallns;
+    makeSEGY<false>(smallSEGYFile);
+    readTraceTest<false, false>(0, nt);
+    readTraceTest<true, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegRead, FileReadRandomTraceWPrmSmallThreads)
+{
+    piol->numThreads = 4;
+    nt               = smallnt;
+    ns               = smallns;
+    size_t size      = nt;
+    auto offsets     = getRandomVec(size, nt, 1337);
+    makeSEGY<false>(smallSEGYFile);
+    readRandomTraceTest<false, false>(size, offsets);
+    readRandomTraceTest<true, false>(size, offsets);
+}
+
+TEST_F(FileSEGYIntegRead, FileIReadTraceWPrmSmall)
+{
+    nt = smallnt;
+    ns = smallns;
+    makeSEGY<false>(smallSEGYFile);
+
+    // Double buffer: start the second half before decoding the first.
+    const size_t half = nt / 2U;
+    std::vector<exseis::utils::Trace_value> trc(nt * ns);
+    Param prm(nt);
+    auto req1 = (*file)->ireadTrace(0U, half, trc.data(), &prm);
+    auto req2 =
+      (*file)->ireadTrace(half, nt - half, &trc[half * ns], &prm, half);
+    req1->wait();
+    while (!req2->test()) {
+    }
+    piol->isErr();
+
+    std::vector<exseis::utils::Trace_value> check(nt * ns);
+    Param cprm(nt);
+    file->readTrace(0U, nt, check.data(), &cprm);
+    piol->isErr();
+
+    for (size_t i = 0; i < nt; i++) {
+        ASSERT_EQ(
+          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_il, &cprm),
+          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_il, &prm));
+        ASSERT_EQ(
+          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_xl, &cprm),
+          param_utils::getPrm<exseis::utils::Integer>(i, PIOL_META_xl, &prm));
+        ASSERT_EQ(i, param_utils::getPrm<size_t>(i, PIOL_META_ltn, &prm));
+    }
+    for (size_t i = 0; i < nt * ns; i++) {
+        ASSERT_EQ(check[i], trc[i]);
+    }
+}
+
+TEST_F(FileSEGYIntegRead, FileReadParamIndex)
+{
+    nt = smallnt;
+    ns = smallns;
+    makeSEGY<false>(smallSEGYFile);
+
+    Param check(nt);
+    file->readParam(0U, nt, &check);
+    auto offsets = getRandomVec(nt, nt, 1337);
+    Param rcheck(nt);
+    file->readParamNonContiguous(nt, offsets.data(), &rcheck);
+    piol->isErr();
+
+    {
+        ReadSEGY::Opt fopt;
+        fopt.index = tempFile;
+        ReadDirect ifile(
+          piol, smallSEGYFile, DataMPIIO::Opt(), ObjectSEGY::Opt(), fopt);
+
+        // The first read builds the index, the second reads from it.
+        for (size_t pass = 0; pass < 2; pass++) {
+            Param prm(nt);
+            ifile.readParam(0U, nt, &prm);
+            piol->isErr();
+            ASSERT_TRUE(prm == check) << pass;
+
+            Param rprm(nt);
+            ifile.readParamNonContiguous(nt, offsets.data(), &rprm);
+            piol->isErr();
+            ASSERT_TRUE(rprm == rcheck) << pass;
+        }
+
+        // Copies of whole headers are read from the file.
+        auto rule = std::make_shared<Rule>(true, true);
+        rule->addCopy();
+        Param cprm(rule, nt);
+        Param ccheck(rule, nt);
+        ifile.readParam(0U, nt, &cprm);
+        file->readParam(0U, nt, &ccheck);
+        piol->isErr();
+        ASSERT_TRUE(cprm == ccheck);
+    }
+
+    const size_t fsz = SEGY_utils::getFileSz(nt, ns);
+    {
+        // An index which is not there is not created until it is built.
+        const std::string none = "tmp/noindex.tmp";
+        ParamIndex index(piol, none, smallSEGYFile, fsz, nt);
+        piol->isErr();
+        EXPECT_FALSE(index.isValid());
+        struct stat st;
+        EXPECT_NE(0, stat(none.c_str(), &st));
+    }
+    {
+        ParamIndex index(piol, tempFile, smallSEGYFile, fsz, nt);
+        piol->isErr();
+        EXPECT_TRUE(index.isValid());
+
+        Rule rule(true, true);
+        size_t ncol = 0;
+        for (const auto& t : rule.translate) {
+            ncol += (t.second->type() != RuleEntry::MdType::Index);
+        }
+        EXPECT_EQ(ncol, index.getColumns().size());
+    }
+    {
+        // An index of a file of another size is not used.
+        ParamIndex index(piol, tempFile, smallSEGYFile, fsz + 1U, nt);
+        piol->isErr();
+        EXPECT_FALSE(index.isValid());
+    }
+
+    if (piol->getRank() == 0) {
+        std::remove(tempFile.c_str());
+    }
+}
+
+TEST_F(FileSEGYIntegRead, FileReadParamPartialRule)
+{
+    nt = smallnt;
+    ns = smallns;
+    makeSEGY<false>(smallSEGYFile);
+
+    auto full = std::make_shared<Rule>(true, true, true);
+    Param check(full, nt);
+    file->readParam(0U, nt, &check);
+    auto offsets = getRandomVec(nt, nt, 1337);
+    Param rcheck(full, nt);
+    file->readParamNonContiguous(nt, offsets.data(), &rcheck);
+    piol->isErr();
+
+    // A single part of the header, then parts far enough apart to be read
+    // separately.
+    const std::vector<std::vector<Meta>> metas = {
+      {PIOL_META_il, PIOL_META_xl},
+      {PIOL_META_tnl, PIOL_META_xSrc, PIOL_META_il, PIOL_META_xl}};
+
+    for (const auto& m : metas) {
+        auto rule = std::make_shared<Rule>(m, false);
+        ASSERT_LT(rule->extent(), SEGY_utils::getMDSz());
+
+        Param prm(rule, nt);
+        file->readParam(0U, nt, &prm);
+        Param rprm(rule, nt);
+        file->readParamNonContiguous(nt, offsets.data(), &rprm);
+        std::vector<exseis::utils::Trace_value> trc(nt * ns);
+        Param tprm(rule, nt);
+        file->readTrace(0U, nt, trc.data(), &tprm);
+        piol->isErr();
+
+        for (size_t i = 0; i < nt; i++) {
+            ASSERT_EQ(i, param_utils::getPrm<size_t>(i, PIOL_META_ltn, &prm));
+            for (auto e : m) {
+                if (e == PIOL_META_xSrc) {
+                    using exseis::utils::Floating_point;
+                    ASSERT_EQ(
+                      param_utils::getPrm<Floating_point>(i, e, &check),
+                      param_utils::getPrm<Floating_point>(i, e, &prm));
+                    ASSERT_EQ(
+                      param_utils::getPrm<Floating_point>(i, e, &rcheck),
+                      param_utils::getPrm<Floating_point>(i, e, &rprm));
+                    ASSERT_EQ(
+                      param_utils::getPrm<Floating_point>(i, e, &check),
+                      param_utils::getPrm<Floating_point>(i, e, &tprm));
+                }
+                else {
+                    using exseis::utils::Integer;
+                    ASSERT_EQ(
+                      param_utils::getPrm<Integer>(i, e, &check),
+                      param_utils::getPrm<Integer>(i, e, &prm));
+                    ASSERT_EQ(
+                      param_utils::getPrm<Integer>(i, e, &rcheck),
+                      param_utils::getPrm<Integer>(i, e, &rprm));
+                    ASSERT_EQ(
+                      param_utils::getPrm<Integer>(i, e, &check),
+                      param_utils::getPrm<Integer>(i, e, &tprm));
+                }
+            }
+        }
+    }
+}
+
 TEST_F(FileSEGYIntegRead, FileReadTraceSmallOpts)
 {
     nt = smallnt;
@@ -73,6 +73,36 @@ TEST_F(FileSEGYIntegWrite, FileWriteTraceWPrmNormal)
     writeTraceTest<true, false>(0, nt);
 }
 
+TEST_F(FileSEGYIntegWrite, FileIWriteTraceWPrmNormal)
+{
+    nt = 100;
+    ns = 300;
+    makeSEGY(tempFile);
+
+    std::vector<exseis::utils::Trace_value> trc(nt * ns);
+    Param prm(nt);
+    for (size_t i = 0U; i < nt; i++) {
+        param_utils::setPrm(i, PIOL_META_xSrc, xNum(i), &prm);
+        param_utils::setPrm(i, PIOL_META_ySrc, yNum(i), &prm);
+        param_utils::setPrm(i, PIOL_META_il, ilNum(i), &prm);
+        param_utils::setPrm(i, PIOL_META_xl, xlNum(i), &prm);
+        param_utils::setPrm(i, PIOL_META_tn, i, &prm);
+        for (size_t j = 0U; j < ns; j++) {
+            trc[i * ns + j] = exseis::utils::Trace_value(i + j);
+        }
+    }
+
+    WriteInterface& wfile = *file;
+    auto req              = wfile.iwriteTrace(0U, nt, trc.data(), &prm);
+
+    // The input is encoded before the call returns, so it can be reused.
+    std::fill(trc.begin(), trc.end(), exseis::utils::Trace_value(0));
+    req->wait();
+    piol->isErr();
+
+    readTraceTest<true>(0, nt);
+}
+
 TEST_F(FileSEGYIntegWrite, FileWriteRandomTraceNormal)
 {
     nt           = 100;
@@ -93,6 +123,26 @@ TEST_F(FileSEGYIntegWrite, FileWriteRandomTraceWPrmNormal)
     writeRandomTraceTest<true, false>(size, offsets);
 }
 
+TEST_F(FileSEGYIntegWrite, FileWriteTraceWPrmNormalThreads)
+{
+    piol->numThreads = 4;
+    nt               = 100;
+    ns               = 300;
+    makeSEGY(tempFile);
+    writeTraceTest<true, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteRandomTraceNormalThreads)
+{
+    piol->numThreads = 4;
+    nt               = 100;
+    ns               = 300;
+    size_t size      = nt;
+    auto offsets     = getRandomVec(size, nt, 1337);
+    makeSEGY(tempFile);
+    writeRandomTraceTest<false, false>(size, offsets);
+}
+
 TEST_F(FileSEGYIntegWrite, FileWriteTraceNormalOpt)
 {
     nt = 100;
@@ -288,3 +338,605 @@ TEST_F(FileSEGYIntegWrite, FileWriteRandomTraceWPrmZeroNs)
     makeSEGY(tempFile);
     writeRandomTraceTest<true, false>(size, offsets);
 }
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceWPrmWriteBehind)
+{
+    nt                 = 100;
+    ns                 = 300;
+    wopt.writeBehindSz = 1024U * 1024U;
+    makeSEGY(tempFile);
+    writeTraceTest<true, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteRandomTraceWPrmWriteBehind)
+{
+    nt                 = 100;
+    ns                 = 300;
+    size_t size        = nt;
+    auto offsets       = getRandomVec(size, nt, 1337);
+    wopt.writeBehindSz = 1024U * 1024U;
+    makeSEGY(tempFile);
+    writeRandomTraceTest<true, false>(size, offsets);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceWPrmWriteBehindSmall)
+{
+    // The buffer fills every few traces, so it is flushed many times.
+    nt                 = 100;
+    ns                 = 300;
+    wopt.writeBehindSz = 3U * SEGY_utils::getDOSz(ns);
+    makeSEGY(tempFile);
+    for (size_t i = 0; i < nt; i += 7U) {
+        writeTraceTest<true, false>(i, std::min<size_t>(7U, nt - i));
+    }
+    readTraceTest<true>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceWPrmWriteBehindOverlap)
+{
+    nt                 = 100;
+    ns                 = 300;
+    wopt.writeBehindSz = 1024U * 1024U;
+    makeSEGY(tempFile);
+
+    // Runs held back before and after are merged with the later write, and
+    // the later write replaces the traces it overlaps.
+    std::vector<exseis::utils::Trace_value> trc(20U * ns);
+    Param prm(20U);
+    file->writeTrace(10U, 20U, trc.data(), &prm);
+    file->writeTrace(60U, 20U, trc.data(), &prm);
+    file->writeTrace(80U, 20U, trc.data(), &prm);
+    writeTraceTest<true, false>(0, 70U);
+    readTraceTest<true>(0, 70U);
+
+    std::vector<exseis::utils::Trace_value> rest(30U * ns);
+    readfile->readTrace(70U, 30U, rest.data());
+    for (auto t : rest) {
+        ASSERT_EQ(exseis::utils::Trace_value(0), t);
+    }
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceWriteBehindPart)
+{
+    // Writes of only parameters or only traces are not held back, so the
+    // buffered traces go out first and the later write lands on top.
+    nt                 = 100;
+    ns                 = 300;
+    wopt.writeBehindSz = 1024U * 1024U;
+    makeSEGY(tempFile);
+
+    std::vector<exseis::utils::Trace_value> trc(nt * ns);
+    Param prm(nt);
+    file->writeTrace(0U, nt, trc.data(), &prm);
+    writeTraceTest<false, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceIBM)
+{
+    nt                 = 100;
+    ns                 = 300;
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::IBM;
+    makeSEGY(tempFile);
+    writeTraceTest<false, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceWPrmIBM)
+{
+    nt                 = 100;
+    ns                 = 300;
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::IBM;
+    makeSEGY(tempFile);
+    writeTraceTest<true, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteRandomTraceWPrmTC4)
+{
+    nt                 = 100;
+    ns                 = 300;
+    size_t size        = nt;
+    auto offsets       = getRandomVec(size, nt, 1337);
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::TC4;
+    makeSEGY(tempFile);
+    writeRandomTraceTest<true, false>(size, offsets);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceTC2)
+{
+    nt                 = 100;
+    ns                 = 301;
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::TC2;
+    makeSEGY(tempFile);
+    writeTraceTest<false, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceWPrmTC2)
+{
+    nt                 = 100;
+    ns                 = 301;
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::TC2;
+    makeSEGY(tempFile);
+    writeTraceTest<true, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceWPrmTC1)
+{
+    // The trace values stay within the range of a byte.
+    nt                 = 20;
+    ns                 = 101;
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::TC1;
+    makeSEGY(tempFile);
+    writeTraceTest<true, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceIEEE8)
+{
+    nt                 = 100;
+    ns                 = 300;
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::IEEE8;
+    makeSEGY(tempFile);
+    writeTraceTest<false, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceWPrmIEEE8WriteBehind)
+{
+    nt                 = 100;
+    ns                 = 300;
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::IEEE8;
+    wopt.writeBehindSz = 1024U * 1024U;
+    makeSEGY(tempFile);
+    writeTraceTest<true, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceWPrmLittleEndian)
+{
+    nt                 = 100;
+    ns                 = 300;
+    wopt.is_big_endian = false;
+    makeSEGY(tempFile);
+    writeTraceTest<true, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteRandomTraceWPrmLittleEndianIBM)
+{
+    nt                 = 100;
+    ns                 = 300;
+    size_t size        = nt;
+    auto offsets       = getRandomVec(size, nt, 1337);
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::IBM;
+    wopt.is_big_endian = false;
+    makeSEGY(tempFile);
+    writeRandomTraceTest<true, false>(size, offsets);
+}
+
+TEST_F(FileSEGYIntegWrite, FileWriteTraceWPrmLittleEndianTC2WriteBehind)
+{
+    nt                 = 100;
+    ns                 = 301;
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::TC2;
+    wopt.is_big_endian = false;
+    wopt.writeBehindSz = 1024U * 1024U;
+    makeSEGY(tempFile);
+    writeTraceTest<true, false>(0, nt);
+}
+
+TEST_F(FileSEGYIntegWrite, SEGYWriteReadFormat)
+{
+    // The format is stamped in the file header and the size of the file
+    // follows the sample size, so a new reader finds both.
+    nt = 50;
+    ns = 261;
+
+    auto data = std::make_shared<DataMPIIO>(piol, tempFile, FileMode::Test);
+    auto obj = std::make_shared<ObjectSEGY>(
+      piol, tempFile, ObjectSEGY::Opt(), data, FileMode::Test);
+
+    std::vector<exseis::utils::Trace_value> trc(nt * ns);
+    for (size_t i = 0; i < trc.size(); i++) {
+        trc[i] = exseis::utils::Trace_value(int(i % 1000) - 500);
+    }
+
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::TC2;
+    {
+        WriteDirect write(
+          std::make_shared<WriteSEGY>(piol, tempFile, wopt, obj));
+        write.writeNs(ns);
+        write.writeNt(nt);
+        write.writeInc(1e-3);
+        write.writeTrace(0, nt, trc.data());
+        piol->isErr();
+    }
+    ASSERT_EQ(SEGY_utils::getFileSz(nt, ns, 2LU), obj->getFileSz());
+
+    // The reader sets the sample size from the header.
+    obj->setSampleSz(sizeof(float));
+    ReadDirect read(std::make_shared<ReadSEGY>(piol, tempFile, obj));
+    piol->isErr();
+    ASSERT_EQ(2LU, obj->getSampleSz());
+    ASSERT_EQ(nt, read.readNt());
+    ASSERT_EQ(ns, read.readNs());
+
+    std::vector<exseis::utils::Trace_value> back(nt * ns);
+    read.readTrace(0, nt, back.data());
+    piol->isErr();
+    ASSERT_EQ(trc, back);
+}
+
+TEST_F(FileSEGYIntegWrite, SEGYWriteReadWindow)
+{
+    // A window written over whole traces leaves the other samples and the
+    // headers alone, and window reads return just the window.
+    nt              = 60;
+    ns              = 301;
+    const size_t s0 = 17;
+    const size_t n  = 40;
+
+    auto data = std::make_shared<DataMPIIO>(piol, tempFile, FileMode::Test);
+    auto obj  = std::make_shared<ObjectSEGY>(
+      piol, tempFile, ObjectSEGY::Opt(), data, FileMode::Test);
+
+    std::vector<exseis::utils::Trace_value> trc(nt * ns);
+    Param prm(nt);
+    for (size_t i = 0; i < nt; i++) {
+        param_utils::setPrm(i, PIOL_META_il, ilNum(i), &prm);
+        param_utils::setPrm(i, PIOL_META_xl, xlNum(i), &prm);
+        for (size_t k = 0; k < ns; k++) {
+            trc[i * ns + k] = exseis::utils::Trace_value(i * ns + k);
+        }
+    }
+
+    // Every other trace gets a new window.
+    std::vector<size_t> offset;
+    std::vector<exseis::utils::Trace_value> win;
+    for (size_t i = 0; i < nt; i += 2) {
+        offset.push_back(i);
+        for (size_t k = 0; k < n; k++) {
+            win.push_back(-exseis::utils::Trace_value(i * n + k));
+            trc[i * ns + s0 + k] = win.back();
+        }
+    }
+
+    wopt.number_format = SEGY_utils::SEGYNumberFormat::TC4;
+    {
+        WriteDirect write(
+          std::make_shared<WriteSEGY>(piol, tempFile, wopt, obj));
+        write.writeNs(ns);
+        write.writeNt(nt);
+        write.writeInc(1e-3);
+        write.writeTrace(0, nt, trc.data(), &prm);
+        write.writeTraceWindowNonContiguous(
+          offset.size(), offset.data(), s0, n, win.data());
+        piol->isErr();
+    }
+
+    ReadDirect read(std::make_shared<ReadSEGY>(piol, tempFile, obj));
+    piol->isErr();
+
+    std::vector<exseis::utils::Trace_value> back(nt * ns);
+    read.readTrace(0, nt, back.data());
+    piol->isErr();
+    ASSERT_EQ(trc, back);
+
+    const size_t rs0 = 11;
+    const size_t rn  = 100;
+    auto expect      = [&](size_t i, size_t k) {
+        return trc[i * ns + rs0 + k];
+    };
+
+    std::vector<exseis::utils::Trace_value> rwin(nt * rn);
+    Param rprm(nt);
+    read.readTraceWindow(0, nt, rs0, rn, rwin.data(), &rprm);
+    piol->isErr();
+    for (size_t i = 0; i < nt; i++) {
+        ASSERT_EQ(
+          ilNum(i), param_utils::getPrm<exseis::utils::Integer>(
+                      i, PIOL_META_il, &rprm));
+        ASSERT_EQ(
+          xlNum(i), param_utils::getPrm<exseis::utils::Integer>(
+                      i, PIOL_META_xl, &rprm));
+        for (size_t k = 0; k < rn; k++) {
+            ASSERT_EQ(expect(i, k), rwin[i * rn + k]);
+        }
+    }
+
+    rwin.assign(offset.size() * rn, 0);
+    read.readTraceWindowNonContiguous(
+      offset.size(), offset.data(), rs0, rn, rwin.data());
+    piol->isErr();
+    for (size_t j = 0; j < offset.size(); j++) {
+        for (size_t k = 0; k < rn; k++) {
+            ASSERT_EQ(expect(offset[j], k), rwin[j * rn + k]);
+        }
+    }
+
+    std::vector<size_t> list = {5, 3, 59, 3, 0, 42};
+    rwin.assign(list.size() * rn, 0);
+    Param lprm(list.size());
+    read.readTraceWindowNonMonotonic(
+      list.size(), list.data(), rs0, rn, rwin.data(), &lprm);
+    piol->isErr();
+    for (size_t j = 0; j < list.size(); j++) {
+        ASSERT_EQ(
+          ilNum(list[j]), param_utils::getPrm<exseis::utils::Integer>(
+                            j, PIOL_META_il, &lprm));
+        for (size_t k = 0; k < rn; k++) {
+            ASSERT_EQ(expect(list[j], k), rwin[j * rn + k]);
+        }
+    }
+}
+
+TEST_F(FileSEGYIntegWrite, SEGYWriteReadLittleEndian)
+{
+    // A little-endian file carries the byte order marker, which a new reader
+    // finds. Its IEEE samples are the native floats.
+    nt = 40;
+    ns = 117;
+
+    auto data = std::make_shared<DataMPIIO>(piol, tempFile, FileMode::Test);
+    auto obj  = std::make_shared<ObjectSEGY>(
+      piol, tempFile, ObjectSEGY::Opt(), data, FileMode::Test);
+
+    std::vector<exseis::utils::Trace_value> trc(nt * ns);
+    Param prm(nt);
+    for (size_t i = 0; i < nt; i++) {
+        param_utils::setPrm(i, PIOL_META_il, ilNum(i), &prm);
+        param_utils::setPrm(i, PIOL_META_xl, xlNum(i), &prm);
+        param_utils::setPrm(
+          i, PIOL_META_xSrc, exseis::utils::Floating_point(i) + 0.25, &prm);
+        for (size_t k = 0; k < ns; k++) {
+            trc[i * ns + k] = exseis::utils::Trace_value(i) - 0.5f * k;
+        }
+    }
+
+    wopt.is_big_endian = false;
+    {
+        WriteDirect write(
+          std::make_shared<WriteSEGY>(piol, tempFile, wopt, obj));
+        write.writeNs(ns);
+        write.writeNt(nt);
+        write.writeInc(1e-3);
+        write.writeTrace(0, nt, trc.data(), &prm);
+        piol->isErr();
+    }
+
+    std::vector<unsigned char> ho(SEGY_utils::getHOSz());
+    obj->readHO(ho.data());
+    const size_t bom = SEGY_utils::SEGYFileHeaderByte::ByteOrder;
+    ASSERT_EQ(4, ho[bom + 0]);
+    ASSERT_EQ(3, ho[bom + 1]);
+    ASSERT_EQ(2, ho[bom + 2]);
+    ASSERT_EQ(1, ho[bom + 3]);
+
+    std::vector<exseis::utils::Trace_value> raw(nt * ns);
+    obj->readDODF(
+      0LU, ns, nt, reinterpret_cast<unsigned char*>(raw.data()));
+    ASSERT_EQ(trc, raw);
+
+    std::vector<unsigned char> md(SEGY_utils::getMDSz());
+    obj->readDOMD(1LU, ns, 1LU, md.data());
+    const unsigned char* il = &md[PIOL_TR_il - 1U];
+    ASSERT_EQ(
+      ilNum(1), from_little_endian<int32_t>({{il[0], il[1], il[2], il[3]}}));
+
+    ReadDirect read(std::make_shared<ReadSEGY>(piol, tempFile, obj));
+    piol->isErr();
+    ASSERT_EQ(nt, read.readNt());
+    ASSERT_EQ(ns, read.readNs());
+    ASSERT_DOUBLE_EQ(1e-3, read.readInc());
+
+    std::vector<exseis::utils::Trace_value> back(nt * ns);
+    Param rprm(nt);
+    read.readTrace(0, nt, back.data(), &rprm);
+    piol->isErr();
+    ASSERT_EQ(trc, back);
+    for (size_t i = 0; i < nt; i++) {
+        ASSERT_EQ(
+          ilNum(i), param_utils::getPrm<exseis::utils::Integer>(
+                      i, PIOL_META_il, &rprm));
+        ASSERT_EQ(
+          xlNum(i), param_utils::getPrm<exseis::utils::Integer>(
+                      i, PIOL_META_xl, &rprm));
+        ASSERT_DOUBLE_EQ(
+          exseis::utils::Floating_point(i) + 0.25,
+          param_utils::getPrm<exseis::utils::Floating_point>(
+            i, PIOL_META_xSrc, &rprm));
+    }
+}
+
+TEST_F(FileSEGYIntegWrite, SEGYWriteReadLittleEndianCustomRule)
+{
+    // Ruled fields at any location are stored in the order of the file and
+    // read back both from the extracted and the lazily held headers.
+    nt = 24;
+    ns = 53;
+
+    auto data = std::make_shared<DataMPIIO>(piol, tempFile, FileMode::Test);
+    auto obj  = std::make_shared<ObjectSEGY>(
+      piol, tempFile, ObjectSEGY::Opt(), data, FileMode::Test);
+
+    auto rule = std::make_shared<Rule>(true, false);
+    rule->addLong(PIOL_META_Misc1, 233U);
+    rule->addShort(PIOL_META_Tic, PIOL_TR_TIC);
+
+    auto misc = [](size_t i) {
+        return exseis::utils::Integer(i) * 65537 - 100000;
+    };
+    auto tic = [](size_t i) { return short(i) * short(-257); };
+
+    std::vector<exseis::utils::Trace_value> trc(nt * ns);
+    Param prm(rule, nt);
+    for (size_t i = 0; i < nt; i++) {
+        param_utils::setPrm(i, PIOL_META_Misc1, misc(i), &prm);
+        param_utils::setPrm(i, PIOL_META_Tic, tic(i), &prm);
+        for (size_t k = 0; k < ns; k++) {
+            trc[i * ns + k] = exseis::utils::Trace_value(i) + 0.25f * k;
+        }
+    }
+
+    wopt.is_big_endian = false;
+    {
+        WriteDirect write(
+          std::make_shared<WriteSEGY>(piol, tempFile, wopt, obj));
+        write.writeNs(ns);
+        write.writeNt(nt);
+        write.writeInc(1e-3);
+        write.writeTrace(0, nt, trc.data(), &prm);
+        piol->isErr();
+    }
+
+    std::vector<unsigned char> md(nt * SEGY_utils::getMDSz());
+    obj->readDOMD(0LU, ns, nt, md.data());
+    for (size_t i = 0; i < nt; i++) {
+        const unsigned char* l = &md[i * SEGY_utils::getMDSz() + 232U];
+        const unsigned char* s =
+          &md[i * SEGY_utils::getMDSz() + PIOL_TR_TIC - 1U];
+        ASSERT_EQ(
+          misc(i), from_little_endian<int32_t>({{l[0], l[1], l[2], l[3]}}));
+        ASSERT_EQ(tic(i), from_little_endian<int16_t>({{s[0], s[1]}}));
+    }
+
+    ReadDirect read(std::make_shared<ReadSEGY>(piol, tempFile, obj));
+    piol->isErr();
+
+    for (bool lazy : {false, true}) {
+        std::vector<exseis::utils::Trace_value> back(nt * ns);
+        Param rprm(rule, nt, lazy);
+        read.readTrace(0, nt, back.data(), &rprm);
+        piol->isErr();
+        ASSERT_EQ(trc, back);
+        for (size_t i = 0; i < nt; i++) {
+            ASSERT_EQ(
+              misc(i), param_utils::getPrm<exseis::utils::Integer>(
+                         i, PIOL_META_Misc1, &rprm));
+            ASSERT_EQ(
+              tic(i), param_utils::getPrm<short>(i, PIOL_META_Tic, &rprm));
+        }
+    }
+}
+
+TEST_F(FileSEGYIntegWrite, SUWriteRead)
+{
+    // Seismic Unix files have no file header, so the number of samples and
+    // the increment are kept in every trace header.
+    nt = 30;
+    ns = 211;
+
+    auto data = std::make_shared<DataMPIIO>(piol, tempFile, FileMode::Test);
+    auto obj  = std::make_shared<ObjectSU>(
+      piol, tempFile, ObjectSU::Opt(), data, FileMode::Test);
+
+    std::vector<exseis::utils::Trace_value> trc(nt * ns);
+    Param prm(nt);
+    for (size_t i = 0; i < nt; i++) {
+        param_utils::setPrm(i, PIOL_META_il, ilNum(i), &prm);
+        param_utils::setPrm(i, PIOL_META_xl, xlNum(i), &prm);
+        for (size_t k = 0; k < ns; k++) {
+            trc[i * ns + k] = exseis::utils::Trace_value(i * ns + k);
+        }
+    }
+
+    {
+        WriteDirect write(
+          std::make_shared<WriteSEGY>(piol, tempFile, wopt, obj));
+        write.writeNs(ns);
+        write.writeNt(nt);
+        write.writeInc(4e-3);
+        write.writeTrace(0, nt, trc.data(), &prm);
+        piol->isErr();
+    }
+    ASSERT_EQ(nt * SEGY_utils::getDOSz(ns, sizeof(float)), obj->getFileSz());
+
+    std::vector<unsigned char> md(SEGY_utils::getMDSz());
+    obj->readDOMD(0LU, ns, 1LU, md.data());
+    int16_t mdNs  = 0;
+    int16_t mdInc = 0;
+    std::memcpy(&mdNs, &md[PIOL_TR_Ns - 1U], sizeof(int16_t));
+    std::memcpy(&mdInc, &md[PIOL_TR_Inc - 1U], sizeof(int16_t));
+    ASSERT_EQ(ns, size_t(mdNs));
+    ASSERT_EQ(4000, mdInc);
+
+    std::vector<exseis::utils::Trace_value> raw(nt * ns);
+    obj->readDODF(
+      0LU, ns, nt, reinterpret_cast<unsigned char*>(raw.data()));
+    ASSERT_EQ(trc, raw);
+
+    ReadDirect read(std::make_shared<ReadSEGY>(piol, tempFile, obj));
+    piol->isErr();
+    ASSERT_EQ(nt, read.readNt());
+    ASSERT_EQ(ns, read.readNs());
+    ASSERT_DOUBLE_EQ(4e-3, read.readInc());
+
+    std::vector<exseis::utils::Trace_value> back(nt * ns);
+    Param rprm(nt);
+    read.readTrace(0, nt, back.data(), &rprm);
+    piol->isErr();
+    ASSERT_EQ(trc, back);
+    for (size_t i = 0; i < nt; i++) {
+        ASSERT_EQ(
+          ilNum(i), param_utils::getPrm<exseis::utils::Integer>(
+                      i, PIOL_META_il, &rprm));
+        ASSERT_EQ(
+          xlNum(i), param_utils::getPrm<exseis::utils::Integer>(
+                      i, PIOL_META_xl, &rprm));
+    }
+}
+
+TEST_F(FileSEGYIntegWrite, SUWriteReadByName)
+{
+    // A file named with the extension ".su" is opened as a Seismic Unix file
+    // by the constructors without options.
+    const std::string name = "tmp/tempFile.su";
+    EXPECT_TRUE(isSUFile(name));
+    EXPECT_FALSE(isSUFile(tempFile));
+    EXPECT_FALSE(isSUFile(".su"));
+
+    nt = 30;
+    ns = 211;
+
+    std::vector<exseis::utils::Trace_value> trc(nt * ns);
+    Param prm(nt);
+    for (size_t i = 0; i < nt; i++) {
+        param_utils::setPrm(i, PIOL_META_il, ilNum(i), &prm);
+        for (size_t k = 0; k < ns; k++) {
+            trc[i * ns + k] = exseis::utils::Trace_value(i * ns + k);
+        }
+    }
+
+    {
+        WriteDirect write(piol, name);
+        write.writeNs(ns);
+        write.writeNt(nt);
+        write.writeInc(4e-3);
+        write.writeTrace(0, nt, trc.data(), &prm);
+        piol->isErr();
+    }
+
+    {
+        DataMPIIO data(piol, name, FileMode::Read);
+        ASSERT_EQ(
+          nt * SEGY_utils::getDOSz(ns, sizeof(float)), data.getFileSz());
+    }
+
+    {
+        ReadDirect read(piol, name);
+        piol->isErr();
+        ASSERT_EQ(nt, read.readNt());
+        ASSERT_EQ(ns, read.readNs());
+        ASSERT_DOUBLE_EQ(4e-3, read.readInc());
+
+        std::vector<exseis::utils::Trace_value> back(nt * ns);
+        Param rprm(nt);
+        read.readTrace(0, nt, back.data(), &rprm);
+        piol->isErr();
+        ASSERT_EQ(trc, back);
+        for (size_t i = 0; i < nt; i++) {
+            ASSERT_EQ(
+              ilNum(i), param_utils::getPrm<exseis::utils::Integer>(
+                          i, PIOL_META_il, &rprm));
+        }
+    }
+
+    piol->comm->barrier();
+    if (piol->getRank() == 0) {
+        std::remove(name.c_str());
+    }
+}
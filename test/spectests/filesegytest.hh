@@ -7,8 +7,10 @@
 
 #include "ExSeisDat/PIOL/CommunicatorMPI.hh"
 #include "ExSeisDat/PIOL/DataMPIIO.hh"
+#include "ExSeisDat/PIOL/DataMmap.hh"
 #include "ExSeisDat/PIOL/ExSeis.hh"
 #include "ExSeisDat/PIOL/ObjectSEGY.hh"
+#include "ExSeisDat/PIOL/ObjectSU.hh"
 #include "ExSeisDat/PIOL/ReadDirect.hh"
 #include "ExSeisDat/PIOL/ReadSEGY.hh"
 #include "ExSeisDat/PIOL/WriteDirect.hh"
@@ -39,6 +41,8 @@ struct ReadSEGY_public : public ReadSEGY {
     using ReadSEGY::inc;
     using ReadSEGY::ns;
     using ReadSEGY::nt;
+    using ReadSEGY::is_big_endian;
+    using ReadSEGY::number_format;
     using ReadSEGY::text;
 
     static ReadSEGY_public* get(ReadInterface* read_interface)
@@ -220,6 +224,21 @@ struct FileReadSEGYTest : public Test {
         piol->isErr();
     }
 
+    // Make a ReadDirect with SEGY object layer on a memory-mapped data layer.
+    void makeMmapSEGY(std::string name)
+    {
+        if (file.get() != nullptr) {
+            file.reset();
+        }
+
+        DataMmap::Opt dopt;
+        ObjectSEGY::Opt oopt;
+        ReadSEGY::Opt fopt;
+        file = std::make_unique<ReadDirect>(piol, name, dopt, oopt, fopt);
+
+        piol->isErr();
+    }
+
     // Make a ReadDirect with mock Object layer instance. Set this.file to it.
     void makeMockSEGY()
     {
@@ -704,6 +723,7 @@ struct FileWriteSEGYTest : public Test {
       std::vector<unsigned char>(SEGY_utils::getHOSz());
     std::unique_ptr<WriteDirect> file = nullptr;
     std::unique_ptr<ReadDirect> readfile;
+    WriteSEGY::Opt wopt;
 
     ~FileWriteSEGYTest() { Mock::VerifyAndClearExpectations(&mock); }
 
@@ -715,7 +735,6 @@ struct FileWriteSEGYTest : public Test {
         }
         piol->isErr();
 
-        WriteSEGY::Opt f;
         ReadSEGY::Opt rf;
         ObjectSEGY::Opt o;
         DataMPIIO::Opt d;
@@ -723,7 +742,7 @@ struct FileWriteSEGYTest : public Test {
         auto obj =
           std::make_shared<ObjectSEGY>(piol, name, o, data, FileMode::Test);
 
-        auto fi = std::make_shared<WriteSEGY>(piol, name, f, obj);
+        auto fi = std::make_shared<WriteSEGY>(piol, name, wopt, obj);
         file    = std::make_unique<WriteDirect>(std::move(fi));
         // file->file = std::move(fi);
 
@@ -735,7 +754,15 @@ struct FileWriteSEGYTest : public Test {
         rfi->inc  = inc;
         rfi->text = testString;
 
+        // The file is still empty, so the format is not read from it.
+        rfi->number_format = wopt.number_format;
+        rfi->is_big_endian = wopt.is_big_endian;
+
         readfile = std::make_unique<ReadDirect>(rfi);
+
+        // The reader takes the file size when it is made, and buffered
+        // traces are written by each process on its own.
+        piol->comm->barrier();
     }
 
     template<bool callHO = true>
@@ -1009,6 +1036,7 @@ struct FileWriteSEGYTest : public Test {
         }
 
         if (MOCK == false) {
+            file->flush();
             ReadSEGY_public::get(*readfile)->nt =
               std::max(offset + tn, ReadSEGY_public::get(*readfile)->nt);
             readTraceTest<writePrm>(offset, tn);
@@ -1152,6 +1180,7 @@ struct FileWriteSEGYTest : public Test {
         }
 
         if (MOCK == false) {
+            file->flush();
             for (size_t i = 0U; i < tn; i++) {
                 ReadSEGY_public::get(*readfile)->nt =
                   std::max(offset[i], ReadSEGY_public::get(*readfile)->nt);
@@ -66,6 +66,37 @@ TEST_F(ObjIntegTest, FarmSEGYBigRead)
     readTest<Block::DO, false>(10U, 300000, 5000);
 }
 
+TEST_F(ObjIntegTest, SEGYReadStrided)
+{
+    opt.strategy = ObjectSEGY::ReadStrategy::Strided;
+    makeRealSEGY<false>(plargeFile);
+    readTest<Block::DOMD, false>(10U, 1000U, 20);
+    readTest<Block::DODF, false>(10U, 1000U, 20);
+    readTest<Block::DOMD, false>(10U, 100U, 2000);
+    readTest<Block::DODF, false>(10U, 100U, 2000);
+}
+
+TEST_F(ObjIntegTest, SEGYReadWhole)
+{
+    opt.strategy   = ObjectSEGY::ReadStrategy::Whole;
+    opt.wholeBufSz = 10000U;
+    makeRealSEGY<false>(plargeFile);
+    readTest<Block::DOMD, false>(10U, 1000U, 20);
+    readTest<Block::DODF, false>(10U, 1000U, 20);
+    readTest<Block::DOMD, false>(10U, 100U, 2000);
+    readTest<Block::DODF, false>(10U, 100U, 2000);
+}
+
+TEST_F(ObjIntegTest, SEGYReadAdaptive)
+{
+    // Both approaches are timed once and the threshold is then updated
+    makeRealSEGY<false>(plargeFile);
+    for (size_t i = 0; i < 3U; i++) {
+        readTest<Block::DOMD, false>(10U, 1000U, 500);
+        readTest<Block::DODF, false>(10U, 1000U, 500);
+    }
+}
+
 // Random reads
 TEST_F(ObjIntegTest, SEGYRandomReadSingle1)
 {
@@ -120,3 +151,75 @@ TEST_F(ObjIntegTest, FarmSEGYRandomBigRead)
     readRandomTest<Block::DODF, false>(5000U, vec);
     readRandomTest<Block::DO, false>(5000U, vec);
 }
+
+TEST_F(ObjIntegTest, SEGYReadDOMDPart)
+{
+    const size_t ns   = 2000U;
+    const size_t nt   = 100U;
+    const size_t mdsz = SEGY_utils::getMDSz();
+    const size_t skip = 188U;
+    const size_t bsz  = 8U;
+
+    for (auto strategy :
+         {ObjectSEGY::ReadStrategy::Strided, ObjectSEGY::ReadStrategy::Whole}) {
+        opt.strategy = strategy;
+        makeRealSEGY<false>(plargeFile);
+
+        std::vector<unsigned char> md(nt * mdsz);
+        std::vector<unsigned char> part(nt * bsz);
+        obj->readDOMD(10U, ns, nt, md.data());
+        obj->readDOMD(10U, ns, nt, skip, bsz, part.data());
+        piol->isErr();
+        for (size_t i = 0; i < nt; i++) {
+            for (size_t j = 0; j < bsz; j++) {
+                ASSERT_EQ(md[i * mdsz + skip + j], part[i * bsz + j]) << i;
+            }
+        }
+
+        auto vec = getRandomVec(nt, 1337);
+        obj->readDOMD(vec.data(), ns, nt, md.data());
+        obj->readDOMD(vec.data(), ns, nt, skip, bsz, part.data());
+        piol->isErr();
+        for (size_t i = 0; i < nt; i++) {
+            for (size_t j = 0; j < bsz; j++) {
+                ASSERT_EQ(md[i * mdsz + skip + j], part[i * bsz + j]) << i;
+            }
+        }
+    }
+}
+
+TEST_F(ObjIntegTest, SEGYReadDODFPart)
+{
+    const size_t ns   = 2000U;
+    const size_t nt   = 100U;
+    const size_t dfsz = SEGY_utils::getDFSz(ns, sizeof(float));
+    const size_t skip = 400U;
+    const size_t bsz  = 160U;
+
+    for (auto strategy :
+         {ObjectSEGY::ReadStrategy::Strided, ObjectSEGY::ReadStrategy::Whole}) {
+        opt.strategy = strategy;
+        makeRealSEGY<false>(plargeFile);
+
+        std::vector<unsigned char> df(nt * dfsz);
+        std::vector<unsigned char> part(nt * bsz);
+        obj->readDODF(10U, ns, nt, df.data());
+        obj->readDODF(10U, ns, nt, skip, bsz, part.data());
+        piol->isErr();
+        for (size_t i = 0; i < nt; i++) {
+            for (size_t j = 0; j < bsz; j++) {
+                ASSERT_EQ(df[i * dfsz + skip + j], part[i * bsz + j]) << i;
+            }
+        }
+
+        auto vec = getRandomVec(nt, 1337);
+        obj->readDODF(vec.data(), ns, nt, df.data());
+        obj->readDODF(vec.data(), ns, nt, skip, bsz, part.data());
+        piol->isErr();
+        for (size_t i = 0; i < nt; i++) {
+            for (size_t j = 0; j < bsz; j++) {
+                ASSERT_EQ(df[i * dfsz + skip + j], part[i * bsz + j]) << i;
+            }
+        }
+    }
+}
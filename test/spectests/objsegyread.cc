@@ -57,6 +57,28 @@ TEST_F(ObjSpecTest, FarmSEGYBigRead)
     readTest<Block::DO>(10U, 300000, 5000);
 }
 
+TEST_F(ObjSpecTest, SEGYReadWhole)
+{
+    opt.strategy = ObjectSEGY::ReadStrategy::Whole;
+    makeSEGY();
+    readTest<Block::DOMD>(10U, 100U, 20, 13, 117);
+    readTest<Block::DODF>(10U, 100U, 20, 13, 117);
+    readTest<Block::DOMD>(10U, 0U, 20);
+    readTest<Block::DODF>(10U, 100U, 0U);
+}
+
+TEST_F(ObjSpecTest, SEGYReadWholeChunked)
+{
+    // Several staging buffers are needed for the read
+    opt.strategy   = ObjectSEGY::ReadStrategy::Whole;
+    opt.wholeBufSz = 1000U;
+    makeSEGY();
+    std::vector<unsigned char> tr(100U * SEGY_utils::getDOSz(20U));
+    EXPECT_CALL(*mock, read(_, _, _)).Times(34);
+    obj->readDOMD(10U, 20U, 100U, tr.data());
+    piol->isErr();
+}
+
 // random read
 
 TEST_F(ObjSpecTest, SEGYRandomReadSingle1)
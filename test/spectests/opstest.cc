@@ -189,6 +189,45 @@ TEST_F(OpsTest, SortSrcRcvBackwards)
     }
 }
 
+TEST_F(OpsTest, SortSrcRcvBackwardsLayouts)
+{
+    // The sort gives the same order whichever way the parameters are held.
+    enum class Layout { Default, Columnar, Compact };
+    for (Layout layout : {Layout::Default, Layout::Columnar, Layout::Compact}) {
+        SCOPED_TRACE(static_cast<int>(layout));
+
+        auto rule      = std::make_shared<Rule>(true, true);
+        rule->columnar = (layout == Layout::Columnar);
+        rule->compact  = (layout == Layout::Compact);
+        Param prm(rule, 200);
+        ASSERT_EQ(rule->columnar, prm.columnar);
+        ASSERT_EQ(rule->compact, prm.compact);
+
+        const size_t offset = piol->comm->offset(prm.size());
+        const size_t nt     = piol->comm->sum(prm.size());
+        for (size_t i = 0; i < prm.size(); i++) {
+            const size_t g = offset + i;
+            param_utils::setPrm(
+              i, PIOL_META_xSrc,
+              1000.0 - exseis::utils::Floating_point(g / 20), &prm);
+            param_utils::setPrm(
+              i, PIOL_META_ySrc,
+              1000.0 - exseis::utils::Floating_point(g % 20), &prm);
+            param_utils::setPrm(
+              i, PIOL_META_xRcv,
+              1000.0 - exseis::utils::Floating_point(g / 10), &prm);
+            param_utils::setPrm(
+              i, PIOL_META_yRcv,
+              1000.0 - exseis::utils::Floating_point(g % 10), &prm);
+            param_utils::setPrm(i, PIOL_META_gtn, g, &prm);
+        }
+        auto list = sort(piol.get(), PIOL_SORTTYPE_SrcRcv, &prm);
+        for (size_t i = 0; i < list.size(); i++) {
+            ASSERT_EQ(nt - offset - i - 1, list[i]);
+        }
+    }
+}
+
 TEST_F(OpsTest, SortSrcRcvForwards)
 {
     Param prm(200);
@@ -1,6 +1,8 @@
 #include "tglobal.hh"
 
 template bool testing::internal::TypeIdHelper<MPIIOTest>::dummy_;
+template bool testing::internal::TypeIdHelper<POSIXTest>::dummy_;
+template bool testing::internal::TypeIdHelper<MmapTest>::dummy_;
 template bool testing::internal::TypeIdHelper<RuleFixList>::dummy_;
 template bool testing::internal::TypeIdHelper<RuleFixEmpty>::dummy_;
 template bool testing::internal::TypeIdHelper<RuleFixDefault>::dummy_;
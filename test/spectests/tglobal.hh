@@ -40,6 +40,12 @@ extern std::vector<size_t> getRandomVec(size_t nt, size_t max, int seed);
 class MPIIOTest;
 extern template bool testing::internal::TypeIdHelper<MPIIOTest>::dummy_;
 
+class POSIXTest;
+extern template bool testing::internal::TypeIdHelper<POSIXTest>::dummy_;
+
+class MmapTest;
+extern template bool testing::internal::TypeIdHelper<MmapTest>::dummy_;
+
 struct RuleFixList;
 extern template bool testing::internal::TypeIdHelper<RuleFixList>::dummy_;
 
@@ -5,7 +5,13 @@ using namespace exseis::utils;
 namespace exseis {
 namespace PIOL {
 
-Param::Param(std::shared_ptr<Rule> r_, const size_t sz)
+Param::Param(std::shared_ptr<Rule> r_, const size_t sz, const bool)
+{
+    mockParam().ctor(this, r_, sz);
+}
+
+Param::Param(
+  std::shared_ptr<Rule> r_, const size_t sz, const bool, const bool)
 {
     mockParam().ctor(this, r_, sz);
 }
@@ -65,6 +65,7 @@ std::unique_ptr<Coords> getCoords(
                    - (lnt / max + (lnt % max > 0 ? 1 : 0));
 
     Param prm(rule, lnt);
+    param_utils::WritableParamColumn<size_t> gtn(PIOL_META_gtn, &prm);
     for (size_t i = 0; i < lnt; i += max) {
         size_t rblock = (i + max < lnt ? max : lnt - i);
 
@@ -73,7 +74,7 @@ std::unique_ptr<Coords> getCoords(
         file->readParam(offset + i, rblock, &prm, i);
 
         for (size_t j = 0; j < rblock; j++) {
-            param_utils::setPrm(i + j, PIOL_META_gtn, offset + i + j, &prm);
+            gtn.set(i + j, offset + i + j);
         }
     }
 
@@ -86,18 +87,16 @@ std::unique_ptr<Coords> getCoords(
     auto trlist = sort(
       piol.get(), &prm,
       [](const Param* prm, const size_t i, const size_t j) -> bool {
-          return (
-            param_utils::getPrm<exseis::utils::Floating_point>(
-              i, PIOL_META_xSrc, prm)
-                < param_utils::getPrm<exseis::utils::Floating_point>(
-                    j, PIOL_META_xSrc, prm) ?
-              true :
-              param_utils::getPrm<exseis::utils::Floating_point>(
-                i, PIOL_META_xSrc, prm)
-                  == param_utils::getPrm<exseis::utils::Floating_point>(
-                       j, PIOL_META_xSrc, prm)
-                && param_utils::getPrm<size_t>(i, PIOL_META_gtn, prm)
-                     < param_utils::getPrm<size_t>(j, PIOL_META_gtn, prm));
+          const param_utils::ParamColumn<exseis::utils::Floating_point> xSrc(
+            PIOL_META_xSrc, prm);
+          const auto e1sx = xSrc[i];
+          const auto e2sx = xSrc[j];
+          if (e1sx != e2sx) {
+              return e1sx < e2sx;
+          }
+
+          const param_utils::ParamColumn<size_t> gtn(PIOL_META_gtn, prm);
+          return gtn[i] < gtn[j];
       },
       false);
 
@@ -132,28 +131,29 @@ std::unique_ptr<Coords> getCoords(
 
             file.readParamNonContiguous(rblock, sortlist.data(), &prm2);
 
+            const param_utils::ParamColumn<exseis::utils::Floating_point> xSrc(
+              PIOL_META_xSrc, &prm2);
+            const param_utils::ParamColumn<exseis::utils::Floating_point> ySrc(
+              PIOL_META_ySrc, &prm2);
+            const param_utils::ParamColumn<exseis::utils::Floating_point> xRcv(
+              PIOL_META_xRcv, &prm2);
+            const param_utils::ParamColumn<exseis::utils::Floating_point> yRcv(
+              PIOL_META_yRcv, &prm2);
             for (size_t j = 0; j < rblock; j++) {
-                coords->xSrc[i + orig[j]] =
-                  param_utils::getPrm<exseis::utils::Floating_point>(
-                    j, PIOL_META_xSrc, &prm2);
-                coords->ySrc[i + orig[j]] =
-                  param_utils::getPrm<exseis::utils::Floating_point>(
-                    j, PIOL_META_ySrc, &prm2);
-                coords->xRcv[i + orig[j]] =
-                  param_utils::getPrm<exseis::utils::Floating_point>(
-                    j, PIOL_META_xRcv, &prm2);
-                coords->yRcv[i + orig[j]] =
-                  param_utils::getPrm<exseis::utils::Floating_point>(
-                    j, PIOL_META_yRcv, &prm2);
-                coords->tn[i + orig[j]] = trlist[i + orig[j]];
+                coords->xSrc[i + orig[j]] = xSrc[j];
+                coords->ySrc[i + orig[j]] = ySrc[j];
+                coords->xRcv[i + orig[j]] = xRcv[j];
+                coords->yRcv[i + orig[j]] = yRcv[j];
+                coords->tn[i + orig[j]]   = trlist[i + orig[j]];
             }
+
+            const param_utils::ParamColumn<exseis::utils::Integer> il(
+              PIOL_META_il, &prm2);
+            const param_utils::ParamColumn<exseis::utils::Integer> xl(
+              PIOL_META_xl, &prm2);
             for (size_t j = 0; ixline && j < rblock; j++) {
-                coords->il[i + orig[j]] =
-                  param_utils::getPrm<exseis::utils::Integer>(
-                    j, PIOL_META_il, &prm2);
-                coords->xl[i + orig[j]] =
-                  param_utils::getPrm<exseis::utils::Integer>(
-                    j, PIOL_META_xl, &prm2);
+                coords->il[i + orig[j]] = il[j];
+                coords->xl[i + orig[j]] = xl[j];
             }
         }
     }
@@ -240,8 +240,10 @@ void outputNonMono(
         size_t rblock = (i + max < lnt ? max : lnt - i);
         src.readTraceNonMonotonic(rblock, &list[i], trc.data(), &prm);
         if (printDsr) {
+            param_utils::WritableParamColumn<exseis::utils::Floating_point>
+              dsdr(PIOL_META_dsdr, &prm);
             for (size_t j = 0; j < rblock; j++) {
-                param_utils::setPrm(j, PIOL_META_dsdr, minrs[i + j], &prm);
+                dsdr.set(j, minrs[i + j]);
             }
         }
         dst.writeTrace(offset + i, rblock, trc.data(), &prm);